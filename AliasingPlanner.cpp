@@ -0,0 +1,312 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "AliasingPlanner.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Returns the heap category of a resource (buffers, render target/depth textures, other textures)
+static uint32_t GetHeapCategory(
+    const ResourceBuilder& builder)
+{
+    if (builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return 0;
+    }
+
+    const D3D12_RESOURCE_FLAGS targetFlags =
+        D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+    return ((builder.Flags & targetFlags) != 0) ? 1 : 2;
+}
+
+//=====================================================================================================================
+// Returns the heap flags restricting a heap to a resource category
+static D3D12_HEAP_FLAGS GetCategoryHeapFlags(
+    uint32_t category, bool separateCategories)
+{
+    if (separateCategories == false)
+    {
+        return D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES;
+    }
+
+    return (category == 0) ? D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS :
+           (category == 1) ? D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES :
+                             D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+}
+
+//=====================================================================================================================
+// Initialise planner
+AliasingPlanner::AliasingPlanner(
+    uint64_t maxHeapSize, bool separateCategories)
+    :
+    m_maxHeapSize(maxHeapSize),
+    m_separateCategories(separateCategories),
+    m_plan(),
+    m_heapCount(0)
+{
+}
+
+//=====================================================================================================================
+// Builds an aliasing plan
+const AliasingPlan& AliasingPlanner::Plan(
+    const TransientResource* pResources, uint32_t count)
+{
+    m_plan.Placements.resize(count);
+    m_plan.Heaps.clear();
+    m_plan.Barriers.clear();
+    m_plan.HeapBytes      = 0;
+    m_plan.UnaliasedBytes = 0;
+    m_heapCount           = 0;
+
+    m_order.clear();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const D3D12_RESOURCE_ALLOCATION_INFO Info = pResources[i].Builder.GetAllocationInfo();
+
+        TransientPlacement& placement = m_plan.Placements[i];
+        placement.HeapIndex   = UINT32_MAX;
+        placement.Offset      = UINT64_MAX;
+        placement.SizeInBytes = Info.SizeInBytes;
+        placement.Alignment   = Info.Alignment;
+
+        // Descriptions the estimator rejects are left unplaced, as are inverted lifetimes (they would overlap nothing
+        // and alias every other resource)
+        if ((Info.SizeInBytes != UINT64_MAX) && (pResources[i].FirstPass <= pResources[i].LastPass))
+        {
+            m_plan.UnaliasedBytes += Info.SizeInBytes;
+            m_order.push_back(i);
+        }
+    }
+
+    // Place large, long-lived resources first so smaller ones fill the gaps around them
+    std::sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b)
+    {
+        const uint64_t sizeA = m_plan.Placements[a].SizeInBytes;
+        const uint64_t sizeB = m_plan.Placements[b].SizeInBytes;
+
+        if (sizeA != sizeB)
+        {
+            return sizeA > sizeB;
+        }
+
+        return (pResources[a].FirstPass != pResources[b].FirstPass) ?
+            (pResources[a].FirstPass < pResources[b].FirstPass) : (a < b);
+    });
+
+    for (uint32_t index : m_order)
+    {
+        const TransientResource& resource  = pResources[index];
+        TransientPlacement&      placement = m_plan.Placements[index];
+        const uint32_t           category  = m_separateCategories ? GetHeapCategory(resource.Builder) : 0;
+
+        for (uint32_t heapIndex = 0; heapIndex < m_heapCount; heapIndex++)
+        {
+            const HeapState& heap = m_heaps[heapIndex];
+
+            if (heap.Category == category)
+            {
+                const uint64_t offset = FindOffset(heap, resource, placement.SizeInBytes, placement.Alignment);
+
+                if ((offset + placement.SizeInBytes) <= m_maxHeapSize)
+                {
+                    placement.HeapIndex = heapIndex;
+                    placement.Offset    = offset;
+                    break;
+                }
+            }
+        }
+
+        if (placement.HeapIndex == UINT32_MAX)
+        {
+            if (m_heapCount == m_heaps.size())
+            {
+                m_heaps.emplace_back();
+            }
+
+            m_heaps[m_heapCount].Category = category;
+            m_heaps[m_heapCount].Allocations.clear();
+
+            TransientHeap heap = {};
+            heap.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            heap.Flags     = GetCategoryHeapFlags(category, m_separateCategories);
+            m_plan.Heaps.push_back(heap);
+
+            placement.HeapIndex = m_heapCount++;
+            placement.Offset    = 0;
+        }
+
+        Allocation allocation = {};
+        allocation.Offset    = placement.Offset;
+        allocation.End       = placement.Offset + placement.SizeInBytes;
+        allocation.FirstPass = resource.FirstPass;
+        allocation.LastPass  = resource.LastPass;
+        allocation.Resource  = index;
+
+        m_heaps[placement.HeapIndex].Allocations.push_back(allocation);
+
+        TransientHeap& heap = m_plan.Heaps[placement.HeapIndex];
+        heap.SizeInBytes = std::max(heap.SizeInBytes, allocation.End);
+        heap.Alignment   = std::max(heap.Alignment, placement.Alignment);
+    }
+
+    for (TransientHeap& heap : m_plan.Heaps)
+    {
+        heap.SizeInBytes  = AlignUp(heap.SizeInBytes, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+        m_plan.HeapBytes += heap.SizeInBytes;
+    }
+
+    BuildBarriers(pResources);
+    MeasurePeak(pResources, count);
+
+    return m_plan;
+}
+
+//=====================================================================================================================
+// Returns the lowest aligned heap offset free for the resource lifetime
+uint64_t AliasingPlanner::FindOffset(
+    const HeapState&         heap,
+    const TransientResource& resource,
+    uint64_t                 size,
+    uint64_t                 alignment)
+{
+    m_overlaps.clear();
+
+    for (const Allocation& allocation : heap.Allocations)
+    {
+        if ((allocation.FirstPass <= resource.LastPass) && (resource.FirstPass <= allocation.LastPass))
+        {
+            m_overlaps.push_back(allocation);
+        }
+    }
+
+    std::sort(m_overlaps.begin(), m_overlaps.end(), [](const Allocation& a, const Allocation& b)
+    {
+        return a.Offset < b.Offset;
+    });
+
+    uint64_t offset = 0;
+
+    for (const Allocation& allocation : m_overlaps)
+    {
+        offset = AlignUp(offset, alignment);
+
+        if ((offset + size) <= allocation.Offset)
+        {
+            break;
+        }
+
+        offset = std::max(offset, allocation.End);
+    }
+
+    return AlignUp(offset, alignment);
+}
+
+//=====================================================================================================================
+// Builds aliasing barriers from the final placements
+void AliasingPlanner::BuildBarriers(
+    const TransientResource* pResources)
+{
+    for (uint32_t heapIndex = 0; heapIndex < m_heapCount; heapIndex++)
+    {
+        const std::vector<Allocation>& allocations = m_heaps[heapIndex].Allocations;
+
+        for (const Allocation& after : allocations)
+        {
+            const Allocation* pLatest     = nullptr;
+            uint32_t          predecessors = 0;
+
+            // Memory previously used by resources whose lifetime ended before this one starts
+            for (const Allocation& before : allocations)
+            {
+                if ((before.LastPass < after.FirstPass) && (before.Offset < after.End) && (after.Offset < before.End))
+                {
+                    predecessors++;
+
+                    if ((pLatest == nullptr) || (before.LastPass > pLatest->LastPass))
+                    {
+                        pLatest = &before;
+                    }
+                }
+            }
+
+            if (pLatest != nullptr)
+            {
+                // A single resource can be named only when the latest user covers the whole range
+                const bool coversRange = (pLatest->Offset <= after.Offset) && (pLatest->End >= after.End);
+
+                AliasingBarrier barrier = {};
+                barrier.PassIndex      = pResources[after.Resource].FirstPass;
+                barrier.ResourceBefore = ((predecessors == 1) || coversRange) ? pLatest->Resource : AnyAliasedResource;
+                barrier.ResourceAfter  = after.Resource;
+
+                m_plan.Barriers.push_back(barrier);
+            }
+        }
+    }
+
+    std::sort(m_plan.Barriers.begin(), m_plan.Barriers.end(), [](const AliasingBarrier& a, const AliasingBarrier& b)
+    {
+        return (a.PassIndex != b.PassIndex) ? (a.PassIndex < b.PassIndex) : (a.ResourceAfter < b.ResourceAfter);
+    });
+}
+
+//=====================================================================================================================
+// Measures the live memory peak over all passes
+void AliasingPlanner::MeasurePeak(
+    const TransientResource* pResources, uint32_t count)
+{
+    m_events.clear();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const int64_t size = static_cast<int64_t>(m_plan.Placements[i].SizeInBytes);
+
+        if (m_plan.Placements[i].HeapIndex != UINT32_MAX)
+        {
+            m_events.push_back({ pResources[i].FirstPass, size });
+            m_events.push_back({ uint64_t(pResources[i].LastPass) + 1, -size });
+        }
+    }
+
+    // Releases sort before acquisitions within the same pass
+    std::sort(m_events.begin(), m_events.end(), [](const LifetimeEvent& a, const LifetimeEvent& b)
+    {
+        return (a.Pass != b.Pass) ? (a.Pass < b.Pass) : (a.Delta < b.Delta);
+    });
+
+    int64_t live = 0;
+
+    m_plan.PeakLiveBytes = 0;
+    m_plan.PeakPass      = 0;
+
+    for (const LifetimeEvent& event : m_events)
+    {
+        live += event.Delta;
+
+        if (live > static_cast<int64_t>(m_plan.PeakLiveBytes))
+        {
+            m_plan.PeakLiveBytes = static_cast<uint64_t>(live);
+            m_plan.PeakPass      = static_cast<uint32_t>(event.Pass); // Peaks are reached on acquisitions
+        }
+    }
+}
+} // AR
@@ -0,0 +1,149 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <vector>
+
+namespace AR {
+
+/// Resource index used by aliasing barriers when several resources previously occupied the memory
+constexpr uint32_t AnyAliasedResource = UINT32_MAX;
+
+//=====================================================================================================================
+// Transient resource with its pass lifetime
+struct TransientResource
+{
+    ResourceBuilder Builder;   ///< Resource description (flags decide the tier 1 heap category)
+    uint32_t        FirstPass; ///< First pass index using the resource
+    uint32_t        LastPass;  ///< Last pass index using the resource (inclusive)
+};
+
+//=====================================================================================================================
+// Placement assigned to a transient resource
+struct TransientPlacement
+{
+    uint32_t HeapIndex;   ///< Index into AliasingPlan::Heaps
+    uint64_t Offset;      ///< Heap offset in bytes
+    uint64_t SizeInBytes; ///< Estimated resource size in bytes
+    uint64_t Alignment;   ///< Placement alignment (write into the description before CreatePlacedResource)
+};
+
+//=====================================================================================================================
+// Placed heap required by the plan
+struct TransientHeap
+{
+    uint64_t         SizeInBytes; ///< Heap size in bytes
+    uint64_t         Alignment;   ///< Heap alignment (4MB when the heap holds MSAA resources)
+    D3D12_HEAP_FLAGS Flags;       ///< Heap flags (resource category restriction on resource heap tier 1)
+};
+
+//=====================================================================================================================
+// Aliasing barrier to issue before a pass
+struct AliasingBarrier
+{
+    uint32_t PassIndex;      ///< Pass before which the barrier is issued
+    uint32_t ResourceBefore; ///< Resource index previously using the memory, or AnyAliasedResource
+    uint32_t ResourceAfter;  ///< Resource index about to use the memory
+};
+
+//=====================================================================================================================
+// Aliasing plan output
+struct AliasingPlan
+{
+    std::vector<TransientPlacement> Placements;     ///< Per-resource placement (same order as the input)
+    std::vector<TransientHeap>      Heaps;          ///< Heaps to create
+    std::vector<AliasingBarrier>    Barriers;       ///< Aliasing barriers sorted by pass index
+    uint64_t                        HeapBytes;      ///< Total heap memory (peak memory of the plan)
+    uint64_t                        UnaliasedBytes; ///< Memory required without aliasing
+    uint64_t                        PeakLiveBytes;  ///< Largest sum of simultaneously live resources (lower bound)
+    uint32_t                        PeakPass;       ///< Pass index at which PeakLiveBytes is reached
+};
+
+//=====================================================================================================================
+// Lifetime-aware heap aliasing planner for transient resources. Resources whose pass lifetimes do not overlap share
+// heap memory. The planner keeps its scratch storage between calls so replanning after a frame graph change does not
+// allocate in the steady state.
+class AliasingPlanner
+{
+public:
+    /// Initialise planner
+    ///
+    /// @param maxHeapSize        [optional] Largest heap the planner creates (bigger resources get a dedicated heap)
+    /// @param separateCategories [optional] Keep buffers, render target/depth textures and other textures in
+    ///                                      separate heaps (required on D3D12_RESOURCE_HEAP_TIER_1)
+    ///
+    explicit AliasingPlanner(uint64_t maxHeapSize = 256ull << 20, bool separateCategories = false);
+
+    /// Builds an aliasing plan. Resources the size estimator rejects or whose FirstPass is after their LastPass are
+    /// left unplaced (HeapIndex and Offset set to their maximum values).
+    ///
+    /// @param pResources [in] Transient resource array
+    /// @param count      [in] Resource count
+    ///
+    const AliasingPlan& Plan(const TransientResource* pResources, uint32_t count);
+
+    /// Returns the most recent plan
+    const AliasingPlan& GetPlan() const { return m_plan; }
+
+private:
+    /// @internal Placed range inside a heap
+    struct Allocation
+    {
+        uint64_t Offset;
+        uint64_t End;
+        uint32_t FirstPass;
+        uint32_t LastPass;
+        uint32_t Resource;
+    };
+
+    /// @internal Heap under construction
+    struct HeapState
+    {
+        uint32_t                Category;
+        std::vector<Allocation> Allocations;
+    };
+
+    /// @internal Lifetime event used to measure the live memory peak
+    struct LifetimeEvent
+    {
+        uint64_t Pass; ///< 64-bit so the release after pass UINT32_MAX does not wrap
+        int64_t  Delta;
+    };
+
+    /// @internal Returns the lowest aligned heap offset free for the resource lifetime
+    uint64_t FindOffset(const HeapState& heap, const TransientResource& resource, uint64_t size, uint64_t alignment);
+
+    /// @internal Builds aliasing barriers from the final placements
+    void BuildBarriers(const TransientResource* pResources);
+
+    /// @internal Measures the live memory peak over all passes
+    void MeasurePeak(const TransientResource* pResources, uint32_t count);
+
+    uint64_t                   m_maxHeapSize;        ///< Heap size limit
+    bool                       m_separateCategories; ///< Tier 1 heap categories
+    AliasingPlan               m_plan;               ///< Plan output
+    std::vector<HeapState>     m_heaps;              ///< Heap allocation state (entries are reused between plans)
+    uint32_t                   m_heapCount;          ///< Heaps in use in m_heaps
+    std::vector<uint32_t>      m_order;              ///< Placement order scratch
+    std::vector<Allocation>    m_overlaps;           ///< Live-range overlap scratch
+    std::vector<LifetimeEvent> m_events;             ///< Peak measurement scratch
+};
+} // AR
@@ -0,0 +1,1079 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "BlockCompress.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace AR {
+
+// Block rows per parallel compression tile
+static constexpr uint32_t BlockRowsPerTile = 4;
+
+// Smallest number of tiles worth handing to a worker thread
+static constexpr uint32_t MinTilesPerThread = 2;
+
+// Least-squares endpoint refinement passes
+static constexpr uint32_t RefinePasses = 2;
+
+// BC7 4-bit index interpolation weights (in 64ths of the second endpoint)
+static constexpr uint32_t Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+//=====================================================================================================================
+// Texels of a 4x4 block, channel-major so kernels load four texels of one channel at a time. Values are in [0, 255].
+struct BlockTexels
+{
+    alignas(16) float Channels[4][16];
+};
+
+//=====================================================================================================================
+// Finds the nearest palette entry of every texel over the first channelCount channels, writing its index and squared
+// distance. Ties go to the lower index.
+using FindIndicesFunc = void (*)(
+    const BlockTexels& block, uint32_t channelCount, const float (*pPalette)[4], uint32_t paletteSize,
+    uint8_t* pIndices, float* pErrors);
+
+//=====================================================================================================================
+// Scalar index search
+static void FindIndicesScalar(
+    const BlockTexels& block,
+    uint32_t           channelCount,
+    const float      (*pPalette)[4],
+    uint32_t           paletteSize,
+    uint8_t*           pIndices,
+    float*             pErrors)
+{
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        float   best      = FLT_MAX;
+        uint8_t bestIndex = 0;
+
+        for (uint32_t k = 0; k < paletteSize; k++)
+        {
+            float distance = 0.0f;
+
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                const float diff = block.Channels[c][t] - pPalette[k][c];
+                distance += diff * diff;
+            }
+
+            if (distance < best)
+            {
+                best      = distance;
+                bestIndex = static_cast<uint8_t>(k);
+            }
+        }
+
+        pIndices[t] = bestIndex;
+        pErrors[t]  = best;
+    }
+}
+
+#if AR_SIMD_X86
+//=====================================================================================================================
+// SSE4.1 index search: four texels per register against each palette entry
+AR_TARGET_SSE41 static void FindIndicesSse41(
+    const BlockTexels& block,
+    uint32_t           channelCount,
+    const float      (*pPalette)[4],
+    uint32_t           paletteSize,
+    uint8_t*           pIndices,
+    float*             pErrors)
+{
+    for (uint32_t t = 0; t < 16; t += 4)
+    {
+        __m128 texel[4];
+
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            texel[c] = _mm_load_ps(&block.Channels[c][t]);
+        }
+
+        __m128  best      = _mm_set1_ps(FLT_MAX);
+        __m128i bestIndex = _mm_setzero_si128();
+
+        for (uint32_t k = 0; k < paletteSize; k++)
+        {
+            __m128 distance = _mm_setzero_ps();
+
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                const __m128 diff = _mm_sub_ps(texel[c], _mm_set1_ps(pPalette[k][c]));
+                distance = _mm_add_ps(distance, _mm_mul_ps(diff, diff));
+            }
+
+            const __m128 closer = _mm_cmplt_ps(distance, best);
+
+            best      = _mm_blendv_ps(best, distance, closer);
+            bestIndex = _mm_blendv_epi8(bestIndex, _mm_set1_epi32(static_cast<int32_t>(k)), _mm_castps_si128(closer));
+        }
+
+        _mm_storeu_ps(pErrors + t, best);
+
+        // Indices are below 16, so packing the 32-bit lanes to bytes is lossless
+        const __m128i bytes = _mm_packus_epi16(_mm_packus_epi32(bestIndex, bestIndex), bestIndex);
+        const int32_t packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(pIndices + t, &packed, sizeof(packed));
+    }
+}
+#endif
+
+//=====================================================================================================================
+// Returns the index search kernel of an instruction set
+static FindIndicesFunc GetFindIndices(
+    ConvertIsa isa)
+{
+    const ConvertIsa supported = GetSupportedConvertIsa();
+
+    if ((isa == ConvertIsa::Auto) || (isa > supported))
+    {
+        isa = supported;
+    }
+
+#if AR_SIMD_X86
+    if (isa >= ConvertIsa::Sse41)
+    {
+        return FindIndicesSse41;
+    }
+#endif
+
+    return FindIndicesScalar;
+}
+
+//=====================================================================================================================
+// Returns the sum of the texel errors selected by a mask
+static float SumErrors(
+    const float* pErrors, uint32_t mask)
+{
+    float error = 0.0f;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((mask & (1u << t)) != 0)
+        {
+            error += pErrors[t];
+        }
+    }
+
+    return error;
+}
+
+//=====================================================================================================================
+// Computes the mean and principal axis (power iteration on the covariance) of the texels selected by a mask
+static void GetPrincipalAxis(
+    const BlockTexels& block, uint32_t channelCount, uint32_t mask, float* pMean, float* pAxis)
+{
+    float count = 0.0f;
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        pMean[c] = 0.0f;
+    }
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((mask & (1u << t)) != 0)
+        {
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                pMean[c] += block.Channels[c][t];
+            }
+
+            count += 1.0f;
+        }
+    }
+
+    float covariance[4][4] = {};
+    float low[4]           = { 255.0f, 255.0f, 255.0f, 255.0f };
+    float high[4]          = {};
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        pMean[c] /= count;
+    }
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((mask & (1u << t)) == 0)
+        {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < channelCount; i++)
+        {
+            const float di = block.Channels[i][t] - pMean[i];
+
+            low[i]  = std::min(low[i], block.Channels[i][t]);
+            high[i] = std::max(high[i], block.Channels[i][t]);
+
+            for (uint32_t j = i; j < channelCount; j++)
+            {
+                covariance[i][j] += di * (block.Channels[j][t] - pMean[j]);
+            }
+        }
+    }
+
+    // Start from the bounding box diagonal, which converges quickly for the typical elongated block distribution
+    float norm = 0.0f;
+
+    for (uint32_t i = 0; i < channelCount; i++)
+    {
+        for (uint32_t j = 0; j < i; j++)
+        {
+            covariance[i][j] = covariance[j][i];
+        }
+
+        pAxis[i] = high[i] - low[i];
+        norm    += pAxis[i] * pAxis[i];
+    }
+
+    if (norm == 0.0f)
+    {
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            pAxis[c] = 1.0f;
+        }
+    }
+
+    for (uint32_t iteration = 0; iteration < 8; iteration++)
+    {
+        float next[4] = {};
+        norm          = 0.0f;
+
+        for (uint32_t i = 0; i < channelCount; i++)
+        {
+            for (uint32_t j = 0; j < channelCount; j++)
+            {
+                next[i] += covariance[i][j] * pAxis[j];
+            }
+
+            norm += next[i] * next[i];
+        }
+
+        if (norm < 1.0e-12f)
+        {
+            break;
+        }
+
+        const float scale = 1.0f / std::sqrt(norm);
+
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            pAxis[c] = next[c] * scale;
+        }
+    }
+
+    norm = 0.0f;
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        norm += pAxis[c] * pAxis[c];
+    }
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        pAxis[c] /= std::sqrt(norm);
+    }
+}
+
+//=====================================================================================================================
+// Returns the endpoints spanning the projections of the selected texels on an axis, pulled in by inset (a fraction
+// of the span) to reduce the error of the interpolated palette entries
+static void GetAxisEndpoints(
+    const BlockTexels& block,
+    uint32_t           channelCount,
+    uint32_t           mask,
+    const float*       pMean,
+    const float*       pAxis,
+    float              inset,
+    float*             pEndpoint0,
+    float*             pEndpoint1)
+{
+    float low  = FLT_MAX;
+    float high = -FLT_MAX;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((mask & (1u << t)) != 0)
+        {
+            float projection = 0.0f;
+
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                projection += (block.Channels[c][t] - pMean[c]) * pAxis[c];
+            }
+
+            low  = std::min(low, projection);
+            high = std::max(high, projection);
+        }
+    }
+
+    const float margin = (high - low) * inset;
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        pEndpoint0[c] = std::min(std::max(pMean[c] + ((low + margin) * pAxis[c]), 0.0f), 255.0f);
+        pEndpoint1[c] = std::min(std::max(pMean[c] + ((high - margin) * pAxis[c]), 0.0f), 255.0f);
+    }
+}
+
+//=====================================================================================================================
+// Solves the least-squares endpoints of the selected texels for fixed interpolation weights (texel ~ (1 - w) * e0 +
+// w * e1). Returns false when the weights do not determine both endpoints.
+static bool SolveEndpoints(
+    const BlockTexels& block,
+    uint32_t           channelCount,
+    uint32_t           mask,
+    const float*       pWeights,
+    float*             pEndpoint0,
+    float*             pEndpoint1)
+{
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float ax[4] = {};
+    float bx[4] = {};
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((mask & (1u << t)) == 0)
+        {
+            continue;
+        }
+
+        const float b = pWeights[t];
+        const float a = 1.0f - b;
+
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            ax[c] += a * block.Channels[c][t];
+            bx[c] += b * block.Channels[c][t];
+        }
+    }
+
+    const float determinant = (aa * bb) - (ab * ab);
+
+    if (std::fabs(determinant) < 1.0e-6f)
+    {
+        return false;
+    }
+
+    for (uint32_t c = 0; c < channelCount; c++)
+    {
+        pEndpoint0[c] = std::min(std::max(((bb * ax[c]) - (ab * bx[c])) / determinant, 0.0f), 255.0f);
+        pEndpoint1[c] = std::min(std::max(((aa * bx[c]) - (ab * ax[c])) / determinant, 0.0f), 255.0f);
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Quantizes a [0, 255] value to an unsigned bit count
+static inline uint32_t Quantize(
+    float value, uint32_t bits)
+{
+    const float maxValue = float((1u << bits) - 1);
+    return static_cast<uint32_t>(std::lround(std::min(std::max(value, 0.0f), 255.0f) * maxValue / 255.0f));
+}
+
+//=====================================================================================================================
+// Expands a 5- or 6-bit value to 8 bits by bit replication
+static inline uint32_t Expand(
+    uint32_t value, uint32_t bits)
+{
+    return (value << (8 - bits)) | (value >> ((2 * bits) - 8));
+}
+
+//=====================================================================================================================
+// Writes value into a little-endian bit stream
+static inline void WriteBits(
+    uint8_t* pData, uint32_t* pPosition, uint32_t value, uint32_t bits)
+{
+    for (uint32_t i = 0; i < bits; i++, (*pPosition)++)
+    {
+        if (((value >> i) & 1) != 0)
+        {
+            pData[*pPosition >> 3] |= static_cast<uint8_t>(1u << (*pPosition & 7));
+        }
+    }
+}
+
+//=====================================================================================================================
+// BC1 color block candidate
+struct ColorBlock
+{
+    uint32_t Color0;      ///< First 5:6:5 endpoint
+    uint32_t Color1;      ///< Second 5:6:5 endpoint
+    uint8_t  Indices[16]; ///< 2-bit indices
+    float    Error;       ///< Squared error of the opaque texels
+};
+
+//=====================================================================================================================
+// Quantizes candidate endpoints, orders them for the four-color (color0 > color1) or three-color (color0 <= color1)
+// mode and selects indices. Transparent texels take index 3 in three-color mode.
+static void EvaluateColorBlock(
+    const BlockTexels& block,
+    const float*       pEndpoint0,
+    const float*       pEndpoint1,
+    bool               threeColor,
+    uint32_t           transparentMask,
+    FindIndicesFunc    findIndices,
+    ColorBlock*        pBest)
+{
+    ColorBlock candidate = {};
+
+    candidate.Color0 = (Quantize(pEndpoint0[0], 5) << 11) | (Quantize(pEndpoint0[1], 6) << 5) |
+                       Quantize(pEndpoint0[2], 5);
+    candidate.Color1 = (Quantize(pEndpoint1[0], 5) << 11) | (Quantize(pEndpoint1[1], 6) << 5) |
+                       Quantize(pEndpoint1[2], 5);
+
+    if ((candidate.Color0 < candidate.Color1) != threeColor)
+    {
+        std::swap(candidate.Color0, candidate.Color1);
+    }
+
+    float palette[4][4] = {};
+
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        const uint32_t shift = (c == 0) ? 11 : ((c == 1) ? 5 : 0);
+        const uint32_t bits  = (c == 1) ? 6 : 5;
+        const uint32_t a     = Expand((candidate.Color0 >> shift) & ((1u << bits) - 1), bits);
+        const uint32_t b     = Expand((candidate.Color1 >> shift) & ((1u << bits) - 1), bits);
+
+        palette[0][c] = float(a);
+        palette[1][c] = float(b);
+        palette[2][c] = threeColor ? float((a + b + 1) / 2) : float(((2 * a) + b + 1) / 3);
+        palette[3][c] = float((a + (2 * b) + 1) / 3);
+    }
+
+    float errors[16];
+    findIndices(block, 3, palette, threeColor ? 3 : 4, candidate.Indices, errors);
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        if ((transparentMask & (1u << t)) != 0)
+        {
+            candidate.Indices[t] = 3;
+        }
+    }
+
+    candidate.Error = SumErrors(errors, ~transparentMask & 0xffff);
+
+    if (candidate.Error < pBest->Error)
+    {
+        *pBest = candidate;
+    }
+}
+
+//=====================================================================================================================
+// Compresses the color of a block to an 8-byte BC1 block. allowTransparent selects the BC1 three-color mode for
+// texels with alpha below 128 (BC3 color blocks are always decoded in four-color mode).
+static void CompressColorBlock(
+    const BlockTexels& block, bool allowTransparent, FindIndicesFunc findIndices, uint8_t* pBlock)
+{
+    uint32_t transparentMask = 0;
+
+    if (allowTransparent)
+    {
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            transparentMask |= (block.Channels[3][t] < 128.0f) ? (1u << t) : 0;
+        }
+    }
+
+    ColorBlock best = {};
+
+    if (transparentMask == 0xffff)
+    {
+        // Equal endpoints select the three-color mode; index 3 is transparent
+        std::memset(best.Indices, 3, sizeof(best.Indices));
+    }
+    else
+    {
+        const uint32_t opaqueMask = ~transparentMask & 0xffff;
+
+        float mean[4];
+        float axis[4];
+        GetPrincipalAxis(block, 3, opaqueMask, mean, axis);
+
+        best.Error = FLT_MAX;
+
+        // Blocks with transparent texels need the three-color mode; opaque blocks try both
+        for (uint32_t mode = (transparentMask != 0) ? 1 : 0; mode < (allowTransparent ? 2u : 1u); mode++)
+        {
+            const bool threeColor = (mode == 1);
+
+            for (float inset : { 0.0f, 1.0f / 16.0f })
+            {
+                float endpoint0[4];
+                float endpoint1[4];
+
+                GetAxisEndpoints(block, 3, opaqueMask, mean, axis, inset, endpoint0, endpoint1);
+                EvaluateColorBlock(block, endpoint0, endpoint1, threeColor, transparentMask, findIndices, &best);
+            }
+        }
+
+        for (uint32_t pass = 0; pass < RefinePasses; pass++)
+        {
+            const bool threeColor = (best.Color0 <= best.Color1);
+
+            // Weight of color1 for each index
+            const float fourColorWeights[4]  = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            const float threeColorWeights[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+            float weights[16];
+
+            for (uint32_t t = 0; t < 16; t++)
+            {
+                weights[t] = threeColor ? threeColorWeights[best.Indices[t]] : fourColorWeights[best.Indices[t]];
+            }
+
+            float endpoint0[4];
+            float endpoint1[4];
+
+            if (SolveEndpoints(block, 3, opaqueMask, weights, endpoint0, endpoint1) == false)
+            {
+                break;
+            }
+
+            EvaluateColorBlock(block, endpoint0, endpoint1, threeColor, transparentMask, findIndices, &best);
+        }
+    }
+
+    uint32_t indices = 0;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        indices |= uint32_t(best.Indices[t]) << (t * 2);
+    }
+
+    const uint16_t colors[2] = { static_cast<uint16_t>(best.Color0), static_cast<uint16_t>(best.Color1) };
+
+    std::memcpy(pBlock, colors, sizeof(colors));
+    std::memcpy(pBlock + 4, &indices, sizeof(indices));
+}
+
+//=====================================================================================================================
+// BC4 channel block candidate
+struct ChannelBlock
+{
+    uint32_t Value0;      ///< First endpoint
+    uint32_t Value1;      ///< Second endpoint
+    uint8_t  Indices[16]; ///< 3-bit indices
+    float    Error;       ///< Squared error
+};
+
+//=====================================================================================================================
+// Selects indices for BC4 endpoints: eight interpolated values when value0 > value1, otherwise six plus 0 and 255
+static void EvaluateChannelBlock(
+    const BlockTexels& block, uint32_t value0, uint32_t value1, FindIndicesFunc findIndices, ChannelBlock* pBest)
+{
+    ChannelBlock candidate = {};
+    candidate.Value0 = value0;
+    candidate.Value1 = value1;
+
+    float palette[8][4] = {};
+    palette[0][0] = float(value0);
+    palette[1][0] = float(value1);
+
+    if (value0 > value1)
+    {
+        for (uint32_t i = 1; i < 7; i++)
+        {
+            palette[i + 1][0] = float((((7 - i) * value0) + (i * value1) + 3) / 7);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 1; i < 5; i++)
+        {
+            palette[i + 1][0] = float((((5 - i) * value0) + (i * value1) + 2) / 5);
+        }
+
+        palette[6][0] = 0.0f;
+        palette[7][0] = 255.0f;
+    }
+
+    float errors[16];
+    findIndices(block, 1, palette, 8, candidate.Indices, errors);
+
+    candidate.Error = SumErrors(errors, 0xffff);
+
+    if (candidate.Error < pBest->Error)
+    {
+        *pBest = candidate;
+    }
+}
+
+//=====================================================================================================================
+// Compresses one channel of a block to an 8-byte BC4 block
+static void CompressChannelBlock(
+    const BlockTexels& block, uint32_t channel, FindIndicesFunc findIndices, uint8_t* pBlock)
+{
+    BlockTexels single = {};
+    std::memcpy(single.Channels[0], block.Channels[channel], sizeof(single.Channels[0]));
+
+    float low        = 255.0f;
+    float high       = 0.0f;
+    float innerLow   = 255.0f;
+    float innerHigh  = 0.0f;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        const float value = single.Channels[0][t];
+
+        low  = std::min(low, value);
+        high = std::max(high, value);
+
+        // The six-value mode stores 0 and 255 exactly, so its endpoints only need to span the other values
+        if ((value > 0.0f) && (value < 255.0f))
+        {
+            innerLow  = std::min(innerLow, value);
+            innerHigh = std::max(innerHigh, value);
+        }
+    }
+
+    ChannelBlock best = {};
+    best.Error = FLT_MAX;
+
+    for (float inset : { 0.0f, 1.0f / 32.0f, 1.0f / 16.0f })
+    {
+        const float margin = (high - low) * inset;
+
+        EvaluateChannelBlock(single, Quantize(high - margin, 8), Quantize(low + margin, 8), findIndices, &best);
+    }
+
+    if (innerLow <= innerHigh)
+    {
+        EvaluateChannelBlock(single, Quantize(innerLow, 8), Quantize(innerHigh, 8), findIndices, &best);
+    }
+    else
+    {
+        EvaluateChannelBlock(single, 0, 0, findIndices, &best);
+    }
+
+    for (uint32_t pass = 0; pass < RefinePasses; pass++)
+    {
+        const bool eightValues = (best.Value0 > best.Value1);
+        uint32_t   mask        = 0;
+        float      weights[16] = {};
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            const uint32_t index = best.Indices[t];
+
+            // Weight of value1 for each index; the explicit 0 and 255 of the six-value mode are left out
+            if (eightValues || (index < 6))
+            {
+                weights[t] = (index == 0) ? 0.0f : ((index == 1) ? 1.0f :
+                             (float(index - 1) / (eightValues ? 7.0f : 5.0f)));
+                mask      |= 1u << t;
+            }
+        }
+
+        float value0 = 0.0f;
+        float value1 = 0.0f;
+
+        if (SolveEndpoints(single, 1, mask, weights, &value0, &value1) == false)
+        {
+            break;
+        }
+
+        uint32_t quantized0 = Quantize(value0, 8);
+        uint32_t quantized1 = Quantize(value1, 8);
+
+        if ((quantized0 > quantized1) != eightValues)
+        {
+            std::swap(quantized0, quantized1);
+        }
+
+        EvaluateChannelBlock(single, quantized0, quantized1, findIndices, &best);
+    }
+
+    uint64_t indices = 0;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        indices |= uint64_t(best.Indices[t]) << (t * 3);
+    }
+
+    pBlock[0] = static_cast<uint8_t>(best.Value0);
+    pBlock[1] = static_cast<uint8_t>(best.Value1);
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        pBlock[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+}
+
+//=====================================================================================================================
+// BC7 mode 6 candidate
+struct Bc7Block
+{
+    uint32_t Endpoints[2][4]; ///< 7-bit RGBA endpoints
+    uint32_t PBits[2];        ///< Endpoint p-bits (appended as the least significant bit)
+    uint8_t  Indices[16];     ///< 4-bit indices
+    float    Error;           ///< Squared error
+};
+
+//=====================================================================================================================
+// Quantizes candidate endpoints with every p-bit combination and selects indices
+static void EvaluateBc7Block(
+    const BlockTexels& block,
+    const float*       pEndpoint0,
+    const float*       pEndpoint1,
+    FindIndicesFunc    findIndices,
+    Bc7Block*          pBest)
+{
+    for (uint32_t pbits = 0; pbits < 4; pbits++)
+    {
+        Bc7Block candidate = {};
+        candidate.PBits[0] = pbits & 1;
+        candidate.PBits[1] = pbits >> 1;
+
+        uint32_t values[2][4];
+
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            const float endpoints[2] = { pEndpoint0[c], pEndpoint1[c] };
+
+            for (uint32_t e = 0; e < 2; e++)
+            {
+                const int32_t quantized = static_cast<int32_t>(std::lround((endpoints[e] - candidate.PBits[e]) / 2.0f));
+
+                candidate.Endpoints[e][c] = static_cast<uint32_t>(std::min(std::max(quantized, 0), 127));
+                values[e][c]              = (candidate.Endpoints[e][c] << 1) | candidate.PBits[e];
+            }
+        }
+
+        float palette[16][4];
+
+        for (uint32_t k = 0; k < 16; k++)
+        {
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                const uint32_t weight = Bc7Weights[k];
+                palette[k][c] = float((((64 - weight) * values[0][c]) + (weight * values[1][c]) + 32) >> 6);
+            }
+        }
+
+        float errors[16];
+        findIndices(block, 4, palette, 16, candidate.Indices, errors);
+
+        candidate.Error = SumErrors(errors, 0xffff);
+
+        if (candidate.Error < pBest->Error)
+        {
+            *pBest = candidate;
+        }
+    }
+}
+
+//=====================================================================================================================
+// Compresses a block to a 16-byte BC7 mode 6 block (one RGBA subset, 7-bit endpoints with p-bits, 4-bit indices)
+static void CompressBc7Block(
+    const BlockTexels& block, FindIndicesFunc findIndices, uint8_t* pBlock)
+{
+    float mean[4];
+    float axis[4];
+    GetPrincipalAxis(block, 4, 0xffff, mean, axis);
+
+    Bc7Block best = {};
+    best.Error = FLT_MAX;
+
+    for (float inset : { 0.0f, 1.0f / 32.0f })
+    {
+        float endpoint0[4];
+        float endpoint1[4];
+
+        GetAxisEndpoints(block, 4, 0xffff, mean, axis, inset, endpoint0, endpoint1);
+        EvaluateBc7Block(block, endpoint0, endpoint1, findIndices, &best);
+    }
+
+    for (uint32_t pass = 0; pass < RefinePasses; pass++)
+    {
+        float weights[16];
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            weights[t] = Bc7Weights[best.Indices[t]] / 64.0f;
+        }
+
+        float endpoint0[4];
+        float endpoint1[4];
+
+        if (SolveEndpoints(block, 4, 0xffff, weights, endpoint0, endpoint1) == false)
+        {
+            break;
+        }
+
+        EvaluateBc7Block(block, endpoint0, endpoint1, findIndices, &best);
+    }
+
+    // The anchor (first) index is stored without its most significant bit, which must therefore be zero
+    if ((best.Indices[0] & 8) != 0)
+    {
+        std::swap(best.Endpoints[0], best.Endpoints[1]);
+        std::swap(best.PBits[0], best.PBits[1]);
+
+        for (uint8_t& index : best.Indices)
+        {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    std::memset(pBlock, 0, 16);
+
+    uint32_t position = 0;
+
+    WriteBits(pBlock, &position, 1u << 6, 7);
+
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        WriteBits(pBlock, &position, best.Endpoints[0][c], 7);
+        WriteBits(pBlock, &position, best.Endpoints[1][c], 7);
+    }
+
+    WriteBits(pBlock, &position, best.PBits[0], 1);
+    WriteBits(pBlock, &position, best.PBits[1], 1);
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        WriteBits(pBlock, &position, best.Indices[t], (t == 0) ? 3 : 4);
+    }
+}
+
+//=====================================================================================================================
+// Returns the typed block compressed format, or DXGI_FORMAT_UNKNOWN when it cannot be compressed
+static DXGI_FORMAT GetCompressFormat(
+    DXGI_FORMAT format)
+{
+    if (IsTypeless(format))
+    {
+        format = GetDefaultViewFormat(format);
+    }
+
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        return format;
+    default:
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+//=====================================================================================================================
+// Compresses one block of loaded texels
+static void CompressTexels(
+    DXGI_FORMAT format, const BlockTexels& block, FindIndicesFunc findIndices, uint8_t* pBlock)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+        CompressColorBlock(block, true, findIndices, pBlock);
+        break;
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+        CompressChannelBlock(block, 3, findIndices, pBlock);
+        CompressColorBlock(block, false, findIndices, pBlock + 8);
+        break;
+    case DXGI_FORMAT_BC4_UNORM:
+        CompressChannelBlock(block, 0, findIndices, pBlock);
+        break;
+    case DXGI_FORMAT_BC5_UNORM:
+        CompressChannelBlock(block, 0, findIndices, pBlock);
+        CompressChannelBlock(block, 1, findIndices, pBlock + 8);
+        break;
+    default:
+        CompressBc7Block(block, findIndices, pBlock);
+        break;
+    }
+}
+
+//=====================================================================================================================
+// Returns whether a format can be produced by the block compressor
+bool IsBlockCompressionSupported(
+    DXGI_FORMAT format)
+{
+    return GetCompressFormat(format) != DXGI_FORMAT_UNKNOWN;
+}
+
+//=====================================================================================================================
+// Compresses one 4x4 block of RGBA8 texels
+bool CompressBlock(
+    DXGI_FORMAT format, const uint8_t* pTexels, uint8_t* pBlock, ConvertIsa isa)
+{
+    format = GetCompressFormat(format);
+
+    if (format == DXGI_FORMAT_UNKNOWN)
+    {
+        return false;
+    }
+
+    BlockTexels block;
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            block.Channels[c][t] = pTexels[(t * 4) + c];
+        }
+    }
+
+    CompressTexels(format, block, GetFindIndices(isa), pBlock);
+
+    return true;
+}
+
+//=====================================================================================================================
+// Block rows of one subresource depth slice compressed by one worker
+struct CompressTile
+{
+    uint32_t Index;         ///< Subresource index relative to the first subresource
+    uint32_t Slice;         ///< Depth slice
+    uint32_t FirstBlockRow; ///< First block row
+    uint32_t BlockRowCount; ///< Block row count
+};
+
+//=====================================================================================================================
+// Compresses source subresources to the builder format in upload footprint layout
+bool CompressSubresources(
+    const ResourceBuilder& builder,
+    uint32_t               firstSubresource,
+    uint32_t               numSubresources,
+    uint64_t               baseOffset,
+    const ConvertSource*   pSources,
+    void*                  pDstData,
+    uint32_t               threadCount,
+    ConvertIsa             isa)
+{
+    const DXGI_FORMAT format = GetCompressFormat(builder.Format);
+
+    if ((builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) || (format == DXGI_FORMAT_UNKNOWN))
+    {
+        return false;
+    }
+
+    // Sources are converted to RGBA8 with the encoding of the compressed format
+    const DXGI_FORMAT texelFormat = IsSrgb(format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    const uint32_t    blockBytes  = GetBytesPerBlock(format);
+    const uint32_t    mipCount    = builder.GetMipCount();
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(numSubresources);
+    std::vector<uint32_t>                           numRows(numSubresources);
+    std::vector<CompressTile>                       tiles;
+
+    builder.GetCopyableFootprints(
+        firstSubresource, numSubresources, baseOffset, layouts.data(), numRows.data(), nullptr, nullptr);
+
+    for (uint32_t i = 0; i < numSubresources; i++)
+    {
+        if ((numRows[i] == UINT32_MAX) || (IsConversionSupported(pSources[i].Format, texelFormat) == false))
+        {
+            return false;
+        }
+
+        for (uint32_t z = 0; z < layouts[i].Footprint.Depth; z++)
+        {
+            for (uint32_t y = 0; y < numRows[i]; y += BlockRowsPerTile)
+            {
+                tiles.push_back({ i, z, y, std::min(BlockRowsPerTile, numRows[i] - y) });
+            }
+        }
+    }
+
+    const FindIndicesFunc findIndices = GetFindIndices(isa);
+
+    ParallelFor(static_cast<uint32_t>(tiles.size()), threadCount, MinTilesPerThread,
+                [&](uint32_t begin, uint32_t end)
+    {
+        std::vector<uint8_t> rows;
+
+        for (uint32_t t = begin; t < end; t++)
+        {
+            const CompressTile&                       tile   = tiles[t];
+            const ConvertSource&                      source = pSources[tile.Index];
+            const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[tile.Index];
+
+            const uint32_t mip    = (firstSubresource + tile.Index) % mipCount;
+            const uint32_t width  = static_cast<uint32_t>(std::max<uint64_t>(1, builder.Width >> mip));
+            const uint32_t height = std::max(1u, builder.Height >> mip);
+            const uint32_t blocks = (width + 3) / 4;
+
+            rows.resize(size_t(width) * 16);
+
+            const uint8_t* pSlice = static_cast<const uint8_t*>(source.pData) + (source.SlicePitch * tile.Slice);
+
+            for (uint32_t blockRow = tile.FirstBlockRow; blockRow < tile.FirstBlockRow + tile.BlockRowCount; blockRow++)
+            {
+                // Rows past the bottom edge repeat the last row
+                for (uint32_t r = 0; r < 4; r++)
+                {
+                    const uint32_t y = std::min((blockRow * 4) + r, height - 1);
+
+                    ConvertRows(source.Format, pSlice + (source.RowPitch * y), 0, texelFormat,
+                                rows.data() + (size_t(width) * 4 * r), 0, width, 1, isa);
+                }
+
+                uint8_t* pDst = static_cast<uint8_t*>(pDstData) + layout.Offset +
+                                (uint64_t(layout.Footprint.RowPitch) *
+                                 ((uint64_t(numRows[tile.Index]) * tile.Slice) + blockRow));
+
+                for (uint32_t bx = 0; bx < blocks; bx++)
+                {
+                    BlockTexels block;
+
+                    for (uint32_t texel = 0; texel < 16; texel++)
+                    {
+                        // Columns past the right edge repeat the last column
+                        const uint32_t x       = std::min((bx * 4) + (texel & 3), width - 1);
+                        const uint8_t* pSource = rows.data() + (((size_t(width) * (texel >> 2)) + x) * 4);
+
+                        for (uint32_t c = 0; c < 4; c++)
+                        {
+                            block.Channels[c][texel] = pSource[c];
+                        }
+                    }
+
+                    CompressTexels(format, block, findIndices, pDst + (size_t(bx) * blockBytes));
+                }
+            }
+        }
+    });
+
+    return true;
+}
+} // AR
@@ -0,0 +1,72 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "FormatConvert.h"
+
+namespace AR {
+
+/// Returns whether a format can be produced by CompressBlock and CompressSubresources: BC1, BC3 and BC7 (UNORM and
+/// sRGB), BC4_UNORM and BC5_UNORM. Typeless formats compress as their default view format.
+///
+/// @param format [in] Block compressed format
+///
+bool IsBlockCompressionSupported(DXGI_FORMAT format);
+
+/// Compresses one 4x4 block of RGBA8 texels. BC1 blocks with texels of alpha below 128 use the three-color mode with
+/// those texels transparent; BC4 reads the red channel and BC5 red and green; BC7 blocks are written in mode 6 (one
+/// RGBA subset with 4-bit indices). Endpoints are searched along the principal axis of the block colors and refined
+/// by least squares, and indices are selected with SIMD kernels.
+///
+/// @param format  [in]  Block compressed format
+/// @param pTexels [in]  16 RGBA8 texels in row order
+/// @param pBlock  [out] Block data (8 bytes for BC1 and BC4, 16 bytes otherwise)
+/// @param isa     [optional] Kernel instruction set (clamped to the supported one)
+///
+/// Returns false when the format is not supported.
+bool CompressBlock(DXGI_FORMAT format, const uint8_t* pTexels, uint8_t* pBlock, ConvertIsa isa = ConvertIsa::Auto);
+
+/// Compresses source subresources to the builder's block compressed format, writing them in the layout of
+/// ResourceBuilder::GetCopyableFootprints. Sources may be in any format ConvertRows accepts; they are converted to
+/// RGBA8 (sRGB encoded for sRGB builder formats) a block row at a time. Block rows of every subresource are split
+/// into tiles compressed across worker threads. Sources have the dimensions of their subresource; blocks that
+/// extend past the edge repeat the last row and column.
+///
+/// @param builder          [in]  Destination resource description
+/// @param firstSubresource [in]  First subresource index
+/// @param numSubresources  [in]  Subresource count
+/// @param baseOffset       [in]  Offset of the first subresource in the destination buffer
+/// @param pSources         [in]  Source data of every subresource
+/// @param pDstData         [out] Destination buffer start (footprint offsets are relative to it)
+/// @param threadCount      [optional] Worker thread count (0 selects the hardware concurrency)
+/// @param isa              [optional] Kernel instruction set (clamped to the supported one)
+///
+/// Returns false when the builder format cannot be compressed or a source format cannot be converted to RGBA8.
+/// Nothing is written in that case.
+bool CompressSubresources(
+    const ResourceBuilder& builder,
+    uint32_t               firstSubresource,
+    uint32_t               numSubresources,
+    uint64_t               baseOffset,
+    const ConvertSource*   pSources,
+    void*                  pDstData,
+    uint32_t               threadCount = 0,
+    ConvertIsa             isa         = ConvertIsa::Auto);
+} // AR
@@ -0,0 +1,437 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "DescriptorAllocator.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Packs a free list head
+static uint64_t PackFreeHead(
+    uint32_t tag, uint32_t index)
+{
+    return (static_cast<uint64_t>(tag) << 32) | index;
+}
+
+//=====================================================================================================================
+// Constructor
+DescriptorAllocator::DescriptorAllocator()
+    :
+    m_pDevice(nullptr),
+    m_pHeap(nullptr),
+    m_type(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV),
+    m_cpuStart{},
+    m_gpuStart{},
+    m_increment(0),
+    m_persistentCount(0),
+    m_transientCount(0),
+    m_frameCount(0),
+    m_frameBase(0),
+    m_transientOffset(0),
+    m_bumpNext(0),
+    m_freeHead(PackFreeHead(0, InvalidDescriptorIndex))
+{
+}
+
+//=====================================================================================================================
+// Destructor
+DescriptorAllocator::~DescriptorAllocator()
+{
+    Destroy();
+}
+
+//=====================================================================================================================
+// Creates the descriptor heap
+HRESULT DescriptorAllocator::Init(
+    ID3D12Device*              pDevice,
+    D3D12_DESCRIPTOR_HEAP_TYPE type,
+    uint32_t                   persistentCount,
+    uint32_t                   transientCount,
+    uint32_t                   frameCount,
+    bool                       shaderVisible)
+{
+    Destroy();
+
+    const bool canBeShaderVisible = (type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) ||
+                                    (type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    if ((pDevice == nullptr) || (shaderVisible && (canBeShaderVisible == false)) || (frameCount == 0))
+    {
+        return E_INVALIDARG;
+    }
+
+    const uint64_t totalCount = persistentCount + static_cast<uint64_t>(transientCount) * frameCount;
+
+    if ((totalCount == 0) || (totalCount >= InvalidDescriptorIndex))
+    {
+        return E_INVALIDARG;
+    }
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.Type           = type;
+    heapDesc.NumDescriptors = static_cast<uint32_t>(totalCount);
+    heapDesc.Flags          = shaderVisible ?
+                              D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    HRESULT hr = pDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_pHeap));
+
+    if (hr == S_OK)
+    {
+        m_pDevice         = pDevice;
+        m_type            = type;
+        m_cpuStart        = m_pHeap->GetCPUDescriptorHandleForHeapStart();
+        m_gpuStart        = shaderVisible ?
+                            m_pHeap->GetGPUDescriptorHandleForHeapStart() : D3D12_GPU_DESCRIPTOR_HANDLE{};
+        m_increment       = pDevice->GetDescriptorHandleIncrementSize(type);
+        m_persistentCount = persistentCount;
+        m_transientCount  = transientCount;
+        m_frameCount      = frameCount;
+        m_frameBase       = persistentCount;
+        m_freeNext.reset(new std::atomic<uint32_t>[persistentCount]);
+
+        m_transientOffset.store(0, std::memory_order_relaxed);
+        m_bumpNext.store(0, std::memory_order_relaxed);
+        m_freeHead.store(PackFreeHead(0, InvalidDescriptorIndex), std::memory_order_relaxed);
+    }
+    else
+    {
+        m_pHeap = nullptr;
+    }
+
+    return hr;
+}
+
+//=====================================================================================================================
+// Releases the descriptor heap
+void DescriptorAllocator::Destroy()
+{
+    if (m_pHeap != nullptr)
+    {
+        m_pHeap->Release();
+        m_pHeap = nullptr;
+    }
+
+    m_pDevice         = nullptr;
+    m_persistentCount = 0;
+    m_transientCount  = 0;
+    m_freeNext.reset();
+}
+
+//=====================================================================================================================
+// Reserves a block of never-used persistent descriptors
+bool DescriptorAllocator::ReserveBlock(
+    DescriptorCache* pCache)
+{
+    uint32_t begin = m_bumpNext.load(std::memory_order_relaxed);
+    uint32_t end   = 0;
+
+    do
+    {
+        if (begin >= m_persistentCount)
+        {
+            return false;
+        }
+
+        end = (m_persistentCount - begin > BlockSize) ? (begin + BlockSize) : m_persistentCount;
+    }
+    while (m_bumpNext.compare_exchange_weak(begin, end, std::memory_order_relaxed) == false);
+
+    pCache->BumpNext = begin;
+    pCache->BumpEnd  = end;
+
+    return true;
+}
+
+//=====================================================================================================================
+// Pushes a chain of descriptors on the global free list (Treiber stack; the tag in the head's high half changes on
+// every update so a head that was popped and pushed back between a load and a compare-exchange is detected)
+void DescriptorAllocator::PushFreeList(
+    const uint32_t* pIndices, uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i + 1 < count; i++)
+    {
+        m_freeNext[pIndices[i]].store(pIndices[i + 1], std::memory_order_relaxed);
+    }
+
+    const uint32_t last = pIndices[count - 1];
+    uint64_t       head = m_freeHead.load(std::memory_order_relaxed);
+    uint64_t       next = 0;
+
+    do
+    {
+        m_freeNext[last].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = PackFreeHead(static_cast<uint32_t>(head >> 32) + 1, pIndices[0]);
+    }
+    while (m_freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed) == false);
+}
+
+//=====================================================================================================================
+// Pops a descriptor from the global free list
+uint32_t DescriptorAllocator::PopFreeList()
+{
+    uint64_t head = m_freeHead.load(std::memory_order_acquire);
+    uint64_t next = 0;
+    uint32_t index = InvalidDescriptorIndex;
+
+    do
+    {
+        index = static_cast<uint32_t>(head);
+
+        if (index == InvalidDescriptorIndex)
+        {
+            break;
+        }
+
+        // The link may be stale when another thread pops the same head first; the tag makes the exchange fail then
+        next = PackFreeHead(static_cast<uint32_t>(head >> 32) + 1, m_freeNext[index].load(std::memory_order_relaxed));
+    }
+    while (m_freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire) == false);
+
+    return index;
+}
+
+//=====================================================================================================================
+// Allocates a persistent descriptor
+Descriptor DescriptorAllocator::Allocate(
+    DescriptorCache* pCache)
+{
+    uint32_t index = InvalidDescriptorIndex;
+
+    if (pCache->FreeCount > 0)
+    {
+        index = pCache->Free[--pCache->FreeCount];
+    }
+    else if ((pCache->BumpNext < pCache->BumpEnd) || ReserveBlock(pCache))
+    {
+        index = pCache->BumpNext++;
+    }
+    else
+    {
+        index = PopFreeList();
+    }
+
+    return GetDescriptor(index);
+}
+
+//=====================================================================================================================
+// Frees a persistent descriptor
+void DescriptorAllocator::Free(
+    DescriptorCache* pCache, uint32_t index)
+{
+    if (index >= m_persistentCount)
+    {
+        return;
+    }
+
+    if (pCache->FreeCount == DescriptorCache::Capacity)
+    {
+        // Hand the older half to other threads in a single exchange
+        constexpr uint32_t SpillCount = DescriptorCache::Capacity / 2;
+
+        PushFreeList(pCache->Free, SpillCount);
+
+        for (uint32_t i = SpillCount; i < DescriptorCache::Capacity; i++)
+        {
+            pCache->Free[i - SpillCount] = pCache->Free[i];
+        }
+
+        pCache->FreeCount -= SpillCount;
+    }
+
+    pCache->Free[pCache->FreeCount++] = index;
+}
+
+//=====================================================================================================================
+// Returns every descriptor held by a cache to the allocator
+void DescriptorAllocator::FlushCache(
+    DescriptorCache* pCache)
+{
+    PushFreeList(pCache->Free, pCache->FreeCount);
+    pCache->FreeCount = 0;
+
+    while (pCache->BumpNext < pCache->BumpEnd)
+    {
+        uint32_t chain[BlockSize];
+        uint32_t count = 0;
+
+        while ((pCache->BumpNext < pCache->BumpEnd) && (count < BlockSize))
+        {
+            chain[count++] = pCache->BumpNext++;
+        }
+
+        PushFreeList(chain, count);
+    }
+
+    pCache->BumpNext = 0;
+    pCache->BumpEnd  = 0;
+}
+
+//=====================================================================================================================
+// Starts a frame
+void DescriptorAllocator::BeginFrame(
+    uint64_t frameIndex)
+{
+    if (m_frameCount > 0)
+    {
+        m_frameBase = m_persistentCount + static_cast<uint32_t>(frameIndex % m_frameCount) * m_transientCount;
+    }
+
+    m_transientOffset.store(0, std::memory_order_relaxed);
+}
+
+//=====================================================================================================================
+// Allocates a contiguous range of transient descriptors
+Descriptor DescriptorAllocator::AllocateTransient(
+    uint32_t count)
+{
+    uint32_t offset = m_transientOffset.load(std::memory_order_relaxed);
+
+    do
+    {
+        if ((count == 0) || (count > m_transientCount - offset))
+        {
+            return GetDescriptor(InvalidDescriptorIndex);
+        }
+    }
+    while (m_transientOffset.compare_exchange_weak(offset, offset + count, std::memory_order_relaxed) == false);
+
+    return GetDescriptor(m_frameBase + offset);
+}
+
+//=====================================================================================================================
+// Returns the descriptor at a heap index
+Descriptor DescriptorAllocator::GetDescriptor(
+    uint32_t index) const
+{
+    Descriptor descriptor = {};
+    descriptor.Index = index;
+
+    if (index != InvalidDescriptorIndex)
+    {
+        descriptor.Cpu.ptr = m_cpuStart.ptr + static_cast<SIZE_T>(index) * m_increment;
+
+        if (m_gpuStart.ptr != 0)
+        {
+            descriptor.Gpu.ptr = m_gpuStart.ptr + static_cast<uint64_t>(index) * m_increment;
+        }
+    }
+
+    return descriptor;
+}
+
+//=====================================================================================================================
+// Allocates a persistent descriptor and writes the builder's shader resource view into it
+Descriptor DescriptorAllocator::CreateShaderResourceView(
+    DescriptorCache*                pCache,
+    ID3D12Resource*                 pResource,
+    const ResourceBuilder&          builder,
+    const ShaderResourceViewParams& params)
+{
+    Descriptor descriptor = GetDescriptor(InvalidDescriptorIndex);
+
+    if (m_type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
+    {
+        descriptor = Allocate(pCache);
+
+        if (descriptor.IsValid())
+        {
+            const D3D12_SHADER_RESOURCE_VIEW_DESC viewDesc = BuildShaderResourceView(builder, params);
+            m_pDevice->CreateShaderResourceView(pResource, &viewDesc, descriptor.Cpu);
+        }
+    }
+
+    return descriptor;
+}
+
+//=====================================================================================================================
+// Allocates a transient descriptor and writes the builder's shader resource view into it
+Descriptor DescriptorAllocator::CreateTransientShaderResourceView(
+    ID3D12Resource*                 pResource,
+    const ResourceBuilder&          builder,
+    const ShaderResourceViewParams& params)
+{
+    Descriptor descriptor = GetDescriptor(InvalidDescriptorIndex);
+
+    if (m_type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
+    {
+        descriptor = AllocateTransient(1);
+
+        if (descriptor.IsValid())
+        {
+            const D3D12_SHADER_RESOURCE_VIEW_DESC viewDesc = BuildShaderResourceView(builder, params);
+            m_pDevice->CreateShaderResourceView(pResource, &viewDesc, descriptor.Cpu);
+        }
+    }
+
+    return descriptor;
+}
+
+//=====================================================================================================================
+// Allocates a persistent descriptor and writes the builder's color target view into it
+Descriptor DescriptorAllocator::CreateColorTargetView(
+    DescriptorCache*             pCache,
+    ID3D12Resource*              pResource,
+    const ResourceBuilder&       builder,
+    const ColorTargetViewParams& params)
+{
+    Descriptor descriptor = GetDescriptor(InvalidDescriptorIndex);
+
+    if (m_type == D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
+    {
+        descriptor = Allocate(pCache);
+
+        if (descriptor.IsValid())
+        {
+            const D3D12_RENDER_TARGET_VIEW_DESC viewDesc = BuildColorTargetView(builder, params);
+            m_pDevice->CreateRenderTargetView(pResource, &viewDesc, descriptor.Cpu);
+        }
+    }
+
+    return descriptor;
+}
+
+//=====================================================================================================================
+// Allocates a persistent descriptor and writes the builder's depth-stencil view into it
+Descriptor DescriptorAllocator::CreateDepthStencilView(
+    DescriptorCache*              pCache,
+    ID3D12Resource*               pResource,
+    const ResourceBuilder&        builder,
+    const DepthStencilViewParams& params)
+{
+    Descriptor descriptor = GetDescriptor(InvalidDescriptorIndex);
+
+    if (m_type == D3D12_DESCRIPTOR_HEAP_TYPE_DSV)
+    {
+        descriptor = Allocate(pCache);
+
+        if (descriptor.IsValid())
+        {
+            const D3D12_DEPTH_STENCIL_VIEW_DESC viewDesc = BuildDepthStencilView(builder, params);
+            m_pDevice->CreateDepthStencilView(pResource, &viewDesc, descriptor.Cpu);
+        }
+    }
+
+    return descriptor;
+}
+} // AR
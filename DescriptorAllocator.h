@@ -0,0 +1,217 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ViewBatch.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace AR {
+
+/// Heap index of an invalid descriptor
+constexpr uint32_t InvalidDescriptorIndex = UINT32_MAX;
+
+//=====================================================================================================================
+// Descriptor handed out by a DescriptorAllocator
+struct Descriptor
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE Cpu;   ///< CPU handle
+    D3D12_GPU_DESCRIPTOR_HANDLE Gpu;   ///< GPU handle (zero unless the heap is shader visible)
+    uint32_t                    Index; ///< Heap index, or InvalidDescriptorIndex when allocation failed
+
+    /// Returns true when the descriptor was allocated
+    bool IsValid() const { return Index != InvalidDescriptorIndex; }
+};
+
+//=====================================================================================================================
+// Per-thread descriptor cache. Each recording thread owns one cache per allocator: allocations bump through a block
+// reserved from the allocator and frees are kept locally, so the allocator's shared state is only touched when the
+// cache runs dry or overflows. A cache must not be used by two threads at the same time.
+struct DescriptorCache
+{
+    static constexpr uint32_t Capacity = 64; ///< Locally kept free descriptors
+
+    uint32_t BumpNext  = 0;  ///< Next index of the reserved block
+    uint32_t BumpEnd   = 0;  ///< End of the reserved block
+    uint32_t FreeCount = 0;  ///< Locally kept free descriptors
+    uint32_t Free[Capacity]; ///< Locally kept free descriptor indices
+};
+
+//=====================================================================================================================
+// Descriptor heap allocator for one heap type. The heap is split into a persistent section, served through per-thread
+// caches backed by a lock-free global free list, and per-frame transient ring sections that are reset as a whole
+// by BeginFrame. Every allocation path is wait-free or lock-free so command recording threads never serialise on it.
+class DescriptorAllocator
+{
+public:
+    DescriptorAllocator();
+    ~DescriptorAllocator();
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    /// Creates the descriptor heap
+    ///
+    /// @param pDevice         [in] Device (must outlive the allocator)
+    /// @param type            [in] Descriptor heap type
+    /// @param persistentCount [in] Persistent descriptor count
+    /// @param transientCount  [optional] Transient descriptors per frame
+    /// @param frameCount      [optional] Frames in flight (transient ring sections)
+    /// @param shaderVisible   [optional] Create a shader-visible heap (CBV_SRV_UAV and SAMPLER heaps only)
+    ///
+    HRESULT Init(
+        ID3D12Device*              pDevice,
+        D3D12_DESCRIPTOR_HEAP_TYPE type,
+        uint32_t                   persistentCount,
+        uint32_t                   transientCount = 0,
+        uint32_t                   frameCount     = 1,
+        bool                       shaderVisible  = false);
+
+    /// Releases the descriptor heap
+    void Destroy();
+
+    /// Allocates a persistent descriptor
+    ///
+    /// @param pCache [in] Calling thread's cache
+    ///
+    Descriptor Allocate(DescriptorCache* pCache);
+
+    /// Frees a persistent descriptor. The caller guarantees the GPU no longer references it.
+    ///
+    /// @param pCache [in] Calling thread's cache
+    /// @param index  [in] Heap index of the descriptor
+    ///
+    void Free(DescriptorCache* pCache, uint32_t index);
+
+    /// Returns every descriptor held by a cache to the allocator (call before the owning thread exits)
+    ///
+    /// @param pCache [in] Cache to flush
+    ///
+    void FlushCache(DescriptorCache* pCache);
+
+    /// Starts a frame: transient allocations move to the frame's ring section, discarding its previous contents. The
+    /// caller guarantees the GPU finished the frame that last used the section and that no thread allocates
+    /// transient descriptors concurrently.
+    ///
+    /// @param frameIndex [in] Frame index (wrapped by the frame count)
+    ///
+    void BeginFrame(uint64_t frameIndex);
+
+    /// Allocates a contiguous range of transient descriptors valid until the frame's section is reused
+    ///
+    /// @param count [optional] Descriptor count
+    ///
+    Descriptor AllocateTransient(uint32_t count = 1);
+
+    /// Allocates a persistent descriptor and writes the builder's shader resource view into it
+    ///
+    /// @param pCache    [in] Calling thread's cache
+    /// @param pResource [in] Resource described by the builder
+    /// @param builder   [in] Resource builder
+    /// @param params    [optional] View parameters
+    ///
+    Descriptor CreateShaderResourceView(
+        DescriptorCache*                pCache,
+        ID3D12Resource*                 pResource,
+        const ResourceBuilder&          builder,
+        const ShaderResourceViewParams& params = {});
+
+    /// Allocates a transient descriptor and writes the builder's shader resource view into it
+    ///
+    /// @param pResource [in] Resource described by the builder
+    /// @param builder   [in] Resource builder
+    /// @param params    [optional] View parameters
+    ///
+    Descriptor CreateTransientShaderResourceView(
+        ID3D12Resource*                 pResource,
+        const ResourceBuilder&          builder,
+        const ShaderResourceViewParams& params = {});
+
+    /// Allocates a persistent descriptor and writes the builder's color target view into it
+    ///
+    /// @param pCache    [in] Calling thread's cache
+    /// @param pResource [in] Resource described by the builder
+    /// @param builder   [in] Resource builder
+    /// @param params    [optional] View parameters
+    ///
+    Descriptor CreateColorTargetView(
+        DescriptorCache*             pCache,
+        ID3D12Resource*              pResource,
+        const ResourceBuilder&       builder,
+        const ColorTargetViewParams& params = {});
+
+    /// Allocates a persistent descriptor and writes the builder's depth-stencil view into it
+    ///
+    /// @param pCache    [in] Calling thread's cache
+    /// @param pResource [in] Resource described by the builder
+    /// @param builder   [in] Resource builder
+    /// @param params    [optional] View parameters
+    ///
+    Descriptor CreateDepthStencilView(
+        DescriptorCache*              pCache,
+        ID3D12Resource*               pResource,
+        const ResourceBuilder&        builder,
+        const DepthStencilViewParams& params = {});
+
+    /// Returns the descriptor at a heap index
+    Descriptor GetDescriptor(uint32_t index) const;
+
+    /// Returns the descriptor heap
+    ID3D12DescriptorHeap* GetHeap() const { return m_pHeap; }
+
+    /// Returns the descriptor heap type
+    D3D12_DESCRIPTOR_HEAP_TYPE GetType() const { return m_type; }
+
+    /// Returns the persistent descriptor count
+    uint32_t GetPersistentCount() const { return m_persistentCount; }
+
+    /// Returns the transient descriptor count per frame
+    uint32_t GetTransientCount() const { return m_transientCount; }
+
+private:
+    /// @internal Descriptors reserved from the persistent section per cache refill
+    static constexpr uint32_t BlockSize = 32;
+
+    /// @internal Reserves a block of never-used persistent descriptors
+    bool ReserveBlock(DescriptorCache* pCache);
+
+    /// @internal Pushes a chain of descriptors on the global free list
+    void PushFreeList(const uint32_t* pIndices, uint32_t count);
+
+    /// @internal Pops a descriptor from the global free list
+    uint32_t PopFreeList();
+
+    ID3D12Device*                            m_pDevice;          ///< Device
+    ID3D12DescriptorHeap*                    m_pHeap;            ///< Descriptor heap
+    D3D12_DESCRIPTOR_HEAP_TYPE               m_type;             ///< Descriptor heap type
+    D3D12_CPU_DESCRIPTOR_HANDLE              m_cpuStart;         ///< CPU handle of heap index 0
+    D3D12_GPU_DESCRIPTOR_HANDLE              m_gpuStart;         ///< GPU handle of heap index 0 (shader visible only)
+    uint32_t                                 m_increment;        ///< Descriptor handle increment
+    uint32_t                                 m_persistentCount;  ///< Persistent section size
+    uint32_t                                 m_transientCount;   ///< Transient section size per frame
+    uint32_t                                 m_frameCount;       ///< Transient ring sections
+    uint32_t                                 m_frameBase;        ///< First heap index of the current section
+    std::atomic<uint32_t>                    m_transientOffset;  ///< Allocated descriptors in the current section
+    std::atomic<uint32_t>                    m_bumpNext;         ///< First never-used persistent descriptor
+    std::atomic<uint64_t>                    m_freeHead;         ///< Free list head: ABA tag (high) and index (low)
+    std::unique_ptr<std::atomic<uint32_t>[]> m_freeNext;         ///< Free list links per persistent descriptor
+};
+} // AR
@@ -0,0 +1,1067 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "FormatConvert.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <cmath>
+#include <cstring>
+
+namespace AR {
+
+// Texels converted per row segment (the float scratch row stays in L1)
+static constexpr uint32_t ScratchTexels = 512;
+
+// Rows per parallel conversion tile
+static constexpr uint32_t RowsPerTile = 32;
+
+// Smallest number of tiles worth handing to a worker thread
+static constexpr uint32_t MinTilesPerThread = 4;
+
+// Steps of the linear to sRGB encode table
+static constexpr uint32_t SrgbEncodeSteps = 65536;
+
+//=====================================================================================================================
+// Texel layouts handled by the conversion kernels
+enum TexelLayout : uint32_t
+{
+    TexelLayoutUnsupported,
+    TexelLayoutRgba8,       ///< R8G8B8A8 UNORM or sRGB
+    TexelLayoutBgra8,       ///< B8G8R8A8 UNORM or sRGB
+    TexelLayoutBgrx8,       ///< B8G8R8X8 UNORM or sRGB (alpha reads as one)
+    TexelLayoutRgba16f,     ///< R16G16B16A16_FLOAT
+    TexelLayoutRgb32f,      ///< R32G32B32_FLOAT (alpha reads as one)
+    TexelLayoutRgba32f,     ///< R32G32B32A32_FLOAT
+    TexelLayoutR11G11B10f,  ///< R11G11B10_FLOAT (destination only)
+    TexelLayoutR10G10B10A2, ///< R10G10B10A2_UNORM (destination only)
+    TexelLayoutCount
+};
+
+//=====================================================================================================================
+// Kernel flags
+enum ConvertFlags : uint32_t
+{
+    ConvertFlagSrgb   = 0x1, ///< sRGB encoded color channels
+    ConvertFlagSwapRB = 0x2, ///< Red and blue are stored swapped
+    ConvertFlagOpaque = 0x4, ///< Alpha is not stored (reads as one, written as one)
+};
+
+//=====================================================================================================================
+// Texel layout and kernel flags of a format
+struct TexelFormat
+{
+    TexelLayout Layout;
+    uint32_t    Flags;
+    uint32_t    Size;   ///< Bytes per texel
+};
+
+//=====================================================================================================================
+// Returns the texel layout of a format (typeless formats resolve to their default view format)
+static TexelFormat GetTexelFormat(
+    DXGI_FORMAT format)
+{
+    if (IsTypeless(format))
+    {
+        format = GetDefaultViewFormat(format);
+    }
+
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:      return { TexelLayoutRgba8, 0, 4 };
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: return { TexelLayoutRgba8, ConvertFlagSrgb, 4 };
+    case DXGI_FORMAT_B8G8R8A8_UNORM:      return { TexelLayoutBgra8, ConvertFlagSwapRB, 4 };
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: return { TexelLayoutBgra8, ConvertFlagSwapRB | ConvertFlagSrgb, 4 };
+    case DXGI_FORMAT_B8G8R8X8_UNORM:      return { TexelLayoutBgrx8, ConvertFlagSwapRB | ConvertFlagOpaque, 4 };
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return { TexelLayoutBgrx8, ConvertFlagSwapRB | ConvertFlagOpaque | ConvertFlagSrgb, 4 };
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:  return { TexelLayoutRgba16f, 0, 8 };
+    case DXGI_FORMAT_R32G32B32_FLOAT:     return { TexelLayoutRgb32f, ConvertFlagOpaque, 12 };
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:  return { TexelLayoutRgba32f, 0, 16 };
+    case DXGI_FORMAT_R11G11B10_FLOAT:     return { TexelLayoutR11G11B10f, ConvertFlagOpaque, 4 };
+    case DXGI_FORMAT_R10G10B10A2_UNORM:   return { TexelLayoutR10G10B10A2, 0, 4 };
+    default:                              return { TexelLayoutUnsupported, 0, 0 };
+    }
+}
+
+//=====================================================================================================================
+// Returns whether a layout stores 8-bit RGBA or BGRA texels
+static bool IsUnorm8Layout(
+    TexelLayout layout)
+{
+    return (layout == TexelLayoutRgba8) || (layout == TexelLayoutBgra8) || (layout == TexelLayoutBgrx8);
+}
+
+//=====================================================================================================================
+// sRGB decode and encode tables. Both the scalar and the SIMD kernels read them, so every instruction set rounds the
+// same way.
+struct SrgbTables
+{
+    SrgbTables()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            const double value = i / 255.0;
+
+            ToLinear[i]       = static_cast<float>((value <= 0.04045) ? (value / 12.92) :
+                                                                         std::pow((value + 0.055) / 1.055, 2.4));
+            ToLinear[256 + i] = static_cast<float>(i) * (1.0f / 255.0f);
+        }
+
+        for (uint32_t i = 0; i < SrgbEncodeSteps; i++)
+        {
+            const double value = i / double(SrgbEncodeSteps - 1);
+            const double srgb  = (value <= 0.0031308) ? (value * 12.92) :
+                                                        ((1.055 * std::pow(value, 1.0 / 2.4)) - 0.055);
+
+            FromLinear[i] = static_cast<uint8_t>(std::lround(srgb * 255.0));
+        }
+
+        std::memset(FromLinear + SrgbEncodeSteps, 0, sizeof(FromLinear) - SrgbEncodeSteps);
+    }
+
+    float   ToLinear[512];                    ///< sRGB byte to linear value, then UNORM byte to value
+    uint8_t FromLinear[SrgbEncodeSteps + 4];  ///< Quantized linear value to sRGB byte (padded for 32-bit gathers)
+};
+
+//=====================================================================================================================
+// Returns the sRGB tables
+static const SrgbTables& GetSrgbTables()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+
+//=====================================================================================================================
+// Clamps to [0, 1], mapping NaN to zero like SSE max/min
+static inline float Saturate(
+    float value)
+{
+    return (value > 0.0f) ? ((value < 1.0f) ? value : 1.0f) : 0.0f;
+}
+
+//=====================================================================================================================
+// Rounds to the nearest integer, ties to even (the default rounding mode, as used by cvtps2dq)
+static inline int32_t RoundToInt(
+    float value)
+{
+    return static_cast<int32_t>(std::lrintf(value));
+}
+
+//=====================================================================================================================
+// Returns the bits of a float
+static inline uint32_t FloatBits(
+    float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//=====================================================================================================================
+// Returns the float with the given bits
+static inline float BitsToFloat(
+    uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//=====================================================================================================================
+// Converts a float to half precision, rounding to nearest even like F16C. NaNs keep their upper payload bits and
+// become quiet.
+static inline uint16_t FloatToHalf(
+    float value)
+{
+    uint32_t       bits = FloatBits(value);
+    const uint32_t sign = (bits >> 16) & 0x8000;
+
+    bits &= 0x7fffffff;
+
+    if (bits > 0x7f800000)
+    {
+        return static_cast<uint16_t>(sign | 0x7e00 | ((bits >> 13) & 0x3ff));
+    }
+
+    if (bits >= 0x47800000)
+    {
+        // Infinity and values of 2^16 or more
+        return static_cast<uint16_t>(sign | 0x7c00);
+    }
+
+    if (bits >= 0x38800000)
+    {
+        // Normal halves; rounding may carry into the exponent up to infinity
+        bits += 0xfff + ((bits >> 13) & 1);
+        return static_cast<uint16_t>(sign | ((bits - (112u << 23)) >> 13));
+    }
+
+    const uint32_t exponent = bits >> 23;
+
+    if (exponent < 102)
+    {
+        // Below half of the smallest denormal
+        return static_cast<uint16_t>(sign);
+    }
+
+    // Denormal halves: the significand shifted to units of 2^-24
+    const uint32_t mantissa = (bits & 0x7fffff) | 0x800000;
+    const uint32_t shift    = 126 - exponent;
+
+    return static_cast<uint16_t>(sign | ((mantissa + (1u << (shift - 1)) - 1 + ((mantissa >> shift) & 1)) >> shift));
+}
+
+//=====================================================================================================================
+// Converts a half to a float (exact; NaNs become quiet like F16C)
+static inline float HalfToFloat(
+    uint16_t half)
+{
+    const uint32_t sign     = uint32_t(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t       mantissa = half & 0x3ff;
+
+    if (exponent == 0x1f)
+    {
+        return BitsToFloat(sign | 0x7f800000 | ((mantissa != 0) ? (0x400000 | (mantissa << 13)) : 0));
+    }
+
+    if (exponent != 0)
+    {
+        return BitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    if (mantissa == 0)
+    {
+        return BitsToFloat(sign);
+    }
+
+    // Denormal half: normalise the mantissa
+    uint32_t floatExponent = 113;
+
+    while ((mantissa & 0x400) == 0)
+    {
+        mantissa <<= 1;
+        floatExponent--;
+    }
+
+    return BitsToFloat(sign | (floatExponent << 23) | ((mantissa & 0x3ff) << 13));
+}
+
+//=====================================================================================================================
+// Converts a float to an unsigned float with 5 exponent bits and 6 or 5 mantissa bits (R11G11B10_FLOAT channels),
+// saturating negative values and NaN to zero and large values to the largest finite value
+static inline uint32_t FloatToPackedFloat(
+    float value, uint32_t mantissaBits)
+{
+    const float maxValue = (mantissaBits == 6) ? 65024.0f : 64512.0f;
+    const float clamped  = (value > 0.0f) ? ((value < maxValue) ? value : maxValue) : 0.0f;
+
+    if (clamped < (1.0f / 16384.0f))
+    {
+        // Denormal: the value in units of 2^(-14 - mantissaBits)
+        return static_cast<uint32_t>(RoundToInt(clamped * ((mantissaBits == 6) ? 1048576.0f : 524288.0f)));
+    }
+
+    const uint32_t shift = 23 - mantissaBits;
+    uint32_t       bits  = FloatBits(clamped);
+
+    bits += ((1u << (shift - 1)) - 1) + ((bits >> shift) & 1);
+
+    return (bits >> shift) - (112u << mantissaBits);
+}
+
+//=====================================================================================================================
+// Row kernels: decode width texels to linear RGBA floats, encode RGBA floats to texels, or swizzle 8-bit texels
+using DecodeFunc  = void (*)(const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t flags);
+using EncodeFunc  = void (*)(const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags);
+using SwizzleFunc = void (*)(const uint8_t* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags);
+
+//=====================================================================================================================
+// Kernels of one instruction set
+struct ConvertKernels
+{
+    DecodeFunc  Decode[TexelLayoutCount];
+    EncodeFunc  Encode[TexelLayoutCount];
+    SwizzleFunc Swizzle;
+};
+
+//=====================================================================================================================
+// Scalar kernels (reference for every SIMD kernel)
+
+static void DecodeUnorm8Scalar(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t flags)
+{
+    const SrgbTables& tables = GetSrgbTables();
+    const float*      pColor = tables.ToLinear + (((flags & ConvertFlagSrgb) != 0) ? 0 : 256);
+    const float*      pAlpha = tables.ToLinear + 256;
+    const uint32_t    red    = ((flags & ConvertFlagSwapRB) != 0) ? 2 : 0;
+
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 4)
+    {
+        pDst[0] = pColor[pSrc[red]];
+        pDst[1] = pColor[pSrc[1]];
+        pDst[2] = pColor[pSrc[2 - red]];
+        pDst[3] = ((flags & ConvertFlagOpaque) != 0) ? 1.0f : pAlpha[pSrc[3]];
+    }
+}
+
+static void EncodeUnorm8Scalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    const uint8_t* pTable = GetSrgbTables().FromLinear;
+    const bool     isSrgb = ((flags & ConvertFlagSrgb) != 0);
+    const uint32_t red    = ((flags & ConvertFlagSwapRB) != 0) ? 2 : 0;
+
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 4)
+    {
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            const float   value = Saturate(pSrc[c]);
+            const uint8_t texel = isSrgb ? pTable[RoundToInt(value * float(SrgbEncodeSteps - 1))] :
+                                           static_cast<uint8_t>(RoundToInt(value * 255.0f));
+
+            pDst[(c == 1) ? 1 : ((c == 0) ? red : (2 - red))] = texel;
+        }
+
+        pDst[3] = ((flags & ConvertFlagOpaque) != 0) ? 255 :
+                                                       static_cast<uint8_t>(RoundToInt(Saturate(pSrc[3]) * 255.0f));
+    }
+}
+
+static void SwizzleUnorm8Scalar(
+    const uint8_t* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    const uint32_t red = ((flags & ConvertFlagSwapRB) != 0) ? 2 : 0;
+
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 4)
+    {
+        const uint8_t texel[4] = { pSrc[red], pSrc[1], pSrc[2 - red], pSrc[3] };
+
+        pDst[0] = texel[0];
+        pDst[1] = texel[1];
+        pDst[2] = texel[2];
+        pDst[3] = ((flags & ConvertFlagOpaque) != 0) ? 255 : texel[3];
+    }
+}
+
+static void DecodeRgba16fScalar(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t i = 0; i < width * 4; i++)
+    {
+        uint16_t half;
+        std::memcpy(&half, pSrc + (i * 2), sizeof(half));
+        pDst[i] = HalfToFloat(half);
+    }
+}
+
+static void EncodeRgba16fScalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t i = 0; i < width * 4; i++)
+    {
+        const uint16_t half = FloatToHalf(pSrc[i]);
+        std::memcpy(pDst + (i * 2), &half, sizeof(half));
+    }
+}
+
+static void DecodeRgb32fScalar(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t x = 0; x < width; x++, pSrc += 12, pDst += 4)
+    {
+        std::memcpy(pDst, pSrc, 12);
+        pDst[3] = 1.0f;
+    }
+}
+
+static void EncodeRgb32fScalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 12)
+    {
+        std::memcpy(pDst, pSrc, 12);
+    }
+}
+
+static void DecodeRgba32fScalar(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t)
+{
+    std::memcpy(pDst, pSrc, size_t(width) * 16);
+}
+
+static void EncodeRgba32fScalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    std::memcpy(pDst, pSrc, size_t(width) * 16);
+}
+
+static void EncodeR11G11B10fScalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 4)
+    {
+        const uint32_t texel = FloatToPackedFloat(pSrc[0], 6) | (FloatToPackedFloat(pSrc[1], 6) << 11) |
+                               (FloatToPackedFloat(pSrc[2], 5) << 22);
+        std::memcpy(pDst, &texel, sizeof(texel));
+    }
+}
+
+static void EncodeR10G10B10A2Scalar(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    for (uint32_t x = 0; x < width; x++, pSrc += 4, pDst += 4)
+    {
+        const uint32_t texel = uint32_t(RoundToInt(Saturate(pSrc[0]) * 1023.0f)) |
+                               (uint32_t(RoundToInt(Saturate(pSrc[1]) * 1023.0f)) << 10) |
+                               (uint32_t(RoundToInt(Saturate(pSrc[2]) * 1023.0f)) << 20) |
+                               (uint32_t(RoundToInt(Saturate(pSrc[3]) * 3.0f)) << 30);
+        std::memcpy(pDst, &texel, sizeof(texel));
+    }
+}
+
+//=====================================================================================================================
+// Returns the scalar kernels
+static ConvertKernels GetScalarKernels()
+{
+    ConvertKernels kernels = {};
+
+    kernels.Decode[TexelLayoutRgba8]       = DecodeUnorm8Scalar;
+    kernels.Decode[TexelLayoutBgra8]       = DecodeUnorm8Scalar;
+    kernels.Decode[TexelLayoutBgrx8]       = DecodeUnorm8Scalar;
+    kernels.Decode[TexelLayoutRgba16f]     = DecodeRgba16fScalar;
+    kernels.Decode[TexelLayoutRgb32f]      = DecodeRgb32fScalar;
+    kernels.Decode[TexelLayoutRgba32f]     = DecodeRgba32fScalar;
+    kernels.Encode[TexelLayoutRgba8]       = EncodeUnorm8Scalar;
+    kernels.Encode[TexelLayoutBgra8]       = EncodeUnorm8Scalar;
+    kernels.Encode[TexelLayoutBgrx8]       = EncodeUnorm8Scalar;
+    kernels.Encode[TexelLayoutRgba16f]     = EncodeRgba16fScalar;
+    kernels.Encode[TexelLayoutRgb32f]      = EncodeRgb32fScalar;
+    kernels.Encode[TexelLayoutRgba32f]     = EncodeRgba32fScalar;
+    kernels.Encode[TexelLayoutR11G11B10f]  = EncodeR11G11B10fScalar;
+    kernels.Encode[TexelLayoutR10G10B10A2] = EncodeR10G10B10A2Scalar;
+    kernels.Swizzle                        = SwizzleUnorm8Scalar;
+
+    return kernels;
+}
+
+#if AR_SIMD_X86
+//=====================================================================================================================
+// SSE4.1 kernels. Each processes whole vectors and hands the remaining texels to its scalar counterpart.
+
+AR_TARGET_SSE41 static inline __m128i GetSwizzleMask128(
+    uint32_t flags)
+{
+    return ((flags & ConvertFlagSwapRB) != 0) ?
+        _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) :
+        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+AR_TARGET_SSE41 static inline __m128 SaturateSse41(
+    __m128 value)
+{
+    // max returns its second operand for NaN, mapping NaN to zero like Saturate
+    return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+AR_TARGET_SSE41 static inline uint32_t OrLanesSse41(
+    __m128i value)
+{
+    value = _mm_or_si128(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+    value = _mm_or_si128(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(value));
+}
+
+AR_TARGET_SSE41 static void DecodeUnorm8Sse41(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t flags)
+{
+    uint32_t x = 0;
+
+    // sRGB decoding is a table lookup per channel; the scalar kernel is as fast without gathers
+    if ((flags & ConvertFlagSrgb) == 0)
+    {
+        const __m128i order  = GetSwizzleMask128(flags);
+        const __m128  scale  = _mm_set1_ps(1.0f / 255.0f);
+        const __m128  one    = _mm_set1_ps(1.0f);
+        const bool    opaque = ((flags & ConvertFlagOpaque) != 0);
+
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128i texels = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + (x * 4))),
+                                                    order);
+            const __m128i words[4] =
+            {
+                texels, _mm_srli_si128(texels, 4), _mm_srli_si128(texels, 8), _mm_srli_si128(texels, 12)
+            };
+
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(words[i])), scale);
+
+                if (opaque)
+                {
+                    value = _mm_blend_ps(value, one, 0x8);
+                }
+
+                _mm_storeu_ps(pDst + ((x + i) * 4), value);
+            }
+        }
+    }
+
+    DecodeUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_SSE41 static void EncodeUnorm8Sse41(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    uint32_t x = 0;
+
+    if ((flags & ConvertFlagSrgb) == 0)
+    {
+        const __m128 scale  = _mm_set1_ps(255.0f);
+        const __m128 one    = _mm_set1_ps(1.0f);
+        const bool   swapRB = ((flags & ConvertFlagSwapRB) != 0);
+        const bool   opaque = ((flags & ConvertFlagOpaque) != 0);
+
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i texels[4];
+
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                __m128 value = _mm_loadu_ps(pSrc + ((x + i) * 4));
+
+                if (swapRB)
+                {
+                    value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+                }
+
+                if (opaque)
+                {
+                    value = _mm_blend_ps(value, one, 0x8);
+                }
+
+                texels[i] = _mm_cvtps_epi32(_mm_mul_ps(SaturateSse41(value), scale));
+            }
+
+            const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(texels[0], texels[1]),
+                                                    _mm_packus_epi32(texels[2], texels[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + (x * 4)), packed);
+        }
+    }
+
+    EncodeUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_SSE41 static void SwizzleUnorm8Sse41(
+    const uint8_t* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    const __m128i order = GetSwizzleMask128(flags);
+    const __m128i alpha = _mm_set1_epi32(((flags & ConvertFlagOpaque) != 0) ? int32_t(0xff000000) : 0);
+
+    uint32_t x = 0;
+
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + (x * 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + (x * 4)),
+                         _mm_or_si128(_mm_shuffle_epi8(texels, order), alpha));
+    }
+
+    SwizzleUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_SSE41 static void DecodeRgb32fSse41(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t flags)
+{
+    const float* pFloats = reinterpret_cast<const float*>(pSrc);
+    const __m128 one     = _mm_set1_ps(1.0f);
+
+    uint32_t x = 0;
+
+    // A 16-byte load per texel reads the red channel of the next one, so the last texel of the row stays scalar
+    for (; x + 1 < width; x++)
+    {
+        _mm_storeu_ps(pDst + (x * 4), _mm_blend_ps(_mm_loadu_ps(pFloats + (x * 3)), one, 0x8));
+    }
+
+    DecodeRgb32fScalar(pSrc + (x * 12), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_SSE41 static void EncodeR11G11B10fSse41(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    // Per-channel constants of FloatToPackedFloat: red and green have 6 mantissa bits, blue 5, alpha is dropped
+    const __m128  maxValue    = _mm_setr_ps(65024.0f, 65024.0f, 64512.0f, 0.0f);
+    const __m128  denormLimit = _mm_set1_ps(1.0f / 16384.0f);
+    const __m128  denormScale = _mm_setr_ps(1048576.0f, 1048576.0f, 524288.0f, 0.0f);
+    const __m128i roundBias   = _mm_setr_epi32(0xffff, 0xffff, 0x1ffff, 0);
+    const __m128i exponentBias = _mm_setr_epi32(112 << 6, 112 << 6, 112 << 5, 0);
+    const __m128i position    = _mm_setr_epi32(1, 1 << 11, 1 << 22, 0);
+    const __m128i one         = _mm_set1_epi32(1);
+
+    for (uint32_t x = 0; x < width; x++)
+    {
+        const __m128  value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSrc + (x * 4)), _mm_setzero_ps()), maxValue);
+        const __m128i bits  = _mm_castps_si128(value);
+
+        // Shift by 17 for 6 mantissa bits and by 18 for the blue channel (lane 2, 16-bit words 4 and 5)
+        const __m128i lsb     = _mm_and_si128(_mm_blend_epi16(_mm_srli_epi32(bits, 17), _mm_srli_epi32(bits, 18), 0x30),
+                                              one);
+        const __m128i rounded = _mm_add_epi32(_mm_add_epi32(bits, roundBias), lsb);
+        const __m128i normal  = _mm_sub_epi32(
+            _mm_blend_epi16(_mm_srli_epi32(rounded, 17), _mm_srli_epi32(rounded, 18), 0x30), exponentBias);
+        const __m128i denorm  = _mm_cvtps_epi32(_mm_mul_ps(value, denormScale));
+        const __m128i channel = _mm_blendv_epi8(normal, denorm, _mm_castps_si128(_mm_cmplt_ps(value, denormLimit)));
+
+        const uint32_t texel = OrLanesSse41(_mm_mullo_epi32(channel, position));
+        std::memcpy(pDst + (x * 4), &texel, sizeof(texel));
+    }
+}
+
+AR_TARGET_SSE41 static void EncodeR10G10B10A2Sse41(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    const __m128  scale    = _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+    const __m128i position = _mm_setr_epi32(1, 1 << 10, 1 << 20, 1 << 30);
+
+    for (uint32_t x = 0; x < width; x++)
+    {
+        const __m128i channel = _mm_cvtps_epi32(_mm_mul_ps(SaturateSse41(_mm_loadu_ps(pSrc + (x * 4))), scale));
+
+        const uint32_t texel = OrLanesSse41(_mm_mullo_epi32(channel, position));
+        std::memcpy(pDst + (x * 4), &texel, sizeof(texel));
+    }
+}
+
+//=====================================================================================================================
+// Returns the SSE4.1 kernels
+static ConvertKernels GetSse41Kernels()
+{
+    ConvertKernels kernels = GetScalarKernels();
+
+    kernels.Decode[TexelLayoutRgba8]       = DecodeUnorm8Sse41;
+    kernels.Decode[TexelLayoutBgra8]       = DecodeUnorm8Sse41;
+    kernels.Decode[TexelLayoutBgrx8]       = DecodeUnorm8Sse41;
+    kernels.Decode[TexelLayoutRgb32f]      = DecodeRgb32fSse41;
+    kernels.Encode[TexelLayoutRgba8]       = EncodeUnorm8Sse41;
+    kernels.Encode[TexelLayoutBgra8]       = EncodeUnorm8Sse41;
+    kernels.Encode[TexelLayoutBgrx8]       = EncodeUnorm8Sse41;
+    kernels.Encode[TexelLayoutR11G11B10f]  = EncodeR11G11B10fSse41;
+    kernels.Encode[TexelLayoutR10G10B10A2] = EncodeR10G10B10A2Sse41;
+    kernels.Swizzle                        = SwizzleUnorm8Sse41;
+
+    return kernels;
+}
+
+//=====================================================================================================================
+// AVX2 kernels. Two texels per 256-bit register; sRGB tables are read with gathers and halves use F16C.
+
+AR_TARGET_AVX2 static inline __m256 SaturateAvx2(
+    __m256 value)
+{
+    return _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+AR_TARGET_AVX2 static void DecodeUnorm8Avx2(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t flags)
+{
+    const float* pTable = GetSrgbTables().ToLinear;
+    const bool   swapRB = ((flags & ConvertFlagSwapRB) != 0);
+    const bool   opaque = ((flags & ConvertFlagOpaque) != 0);
+    const bool   isSrgb = ((flags & ConvertFlagSrgb) != 0);
+
+    // Table offsets per channel: sRGB color channels read the first half, alpha and UNORM channels the second
+    const __m256i tableOffset = isSrgb ? _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256) : _mm256_set1_epi32(256);
+    const __m256  scale       = _mm256_set1_ps(1.0f / 255.0f);
+    const __m256  one         = _mm256_set1_ps(1.0f);
+
+    uint32_t x = 0;
+
+    for (; x + 2 <= width; x += 2)
+    {
+        __m256i texels = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + (x * 4))));
+
+        if (swapRB)
+        {
+            texels = _mm256_shuffle_epi32(texels, _MM_SHUFFLE(3, 0, 1, 2));
+        }
+
+        __m256 value = isSrgb ? _mm256_i32gather_ps(pTable, _mm256_add_epi32(texels, tableOffset), 4) :
+                                _mm256_mul_ps(_mm256_cvtepi32_ps(texels), scale);
+
+        if (opaque)
+        {
+            value = _mm256_blend_ps(value, one, 0x88);
+        }
+
+        _mm256_storeu_ps(pDst + (x * 4), value);
+    }
+
+    DecodeUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_AVX2 static void EncodeUnorm8Avx2(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    const int*   pTable = reinterpret_cast<const int*>(GetSrgbTables().FromLinear);
+    const bool   swapRB = ((flags & ConvertFlagSwapRB) != 0);
+    const bool   opaque = ((flags & ConvertFlagOpaque) != 0);
+    const bool   isSrgb = ((flags & ConvertFlagSrgb) != 0);
+
+    const __m256  scale     = _mm256_set1_ps(255.0f);
+    const __m256  srgbScale = _mm256_set1_ps(float(SrgbEncodeSteps - 1));
+    const __m256  one       = _mm256_set1_ps(1.0f);
+    const __m256i byteMask  = _mm256_set1_epi32(0xff);
+    const __m256i order     = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    uint32_t x = 0;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256i texels[4];
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            __m256 value = _mm256_loadu_ps(pSrc + ((x + (i * 2)) * 4));
+
+            if (swapRB)
+            {
+                value = _mm256_permute_ps(value, _MM_SHUFFLE(3, 0, 1, 2));
+            }
+
+            if (opaque)
+            {
+                value = _mm256_blend_ps(value, one, 0x88);
+            }
+
+            value     = SaturateAvx2(value);
+            texels[i] = _mm256_cvtps_epi32(_mm256_mul_ps(value, scale));
+
+            if (isSrgb)
+            {
+                // 32-bit gathers at byte offsets; the table is padded so the last entry can be read this way
+                const __m256i index = _mm256_cvtps_epi32(_mm256_mul_ps(value, srgbScale));
+                const __m256i srgb  = _mm256_and_si256(_mm256_i32gather_epi32(pTable, index, 1), byteMask);
+
+                texels[i] = _mm256_blend_epi32(srgb, texels[i], 0x88);
+            }
+        }
+
+        // Packing works per 128-bit lane, leaving texels in 0 2 4 6 1 3 5 7 order
+        const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(texels[0], texels[1]),
+                                                   _mm256_packus_epi32(texels[2], texels[3]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + (x * 4)), _mm256_permutevar8x32_epi32(packed, order));
+    }
+
+    EncodeUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_AVX2 static void SwizzleUnorm8Avx2(
+    const uint8_t* pSrc, uint8_t* pDst, uint32_t width, uint32_t flags)
+{
+    const __m256i order = ((flags & ConvertFlagSwapRB) != 0) ?
+        _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                         2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) :
+        _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                         0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m256i alpha = _mm256_set1_epi32(((flags & ConvertFlagOpaque) != 0) ? int32_t(0xff000000) : 0);
+
+    uint32_t x = 0;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        const __m256i texels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + (x * 4)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + (x * 4)),
+                            _mm256_or_si256(_mm256_shuffle_epi8(texels, order), alpha));
+    }
+
+    SwizzleUnorm8Scalar(pSrc + (x * 4), pDst + (x * 4), width - x, flags);
+}
+
+AR_TARGET_AVX2 static void DecodeRgba16fAvx2(
+    const uint8_t* pSrc, float* pDst, uint32_t width, uint32_t)
+{
+    uint32_t x = 0;
+
+    for (; x + 2 <= width; x += 2)
+    {
+        _mm256_storeu_ps(pDst + (x * 4),
+                         _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + (x * 8)))));
+    }
+
+    if (x < width)
+    {
+        _mm_storeu_ps(pDst + (x * 4), _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + (x * 8)))));
+    }
+}
+
+AR_TARGET_AVX2 static void EncodeRgba16fAvx2(
+    const float* pSrc, uint8_t* pDst, uint32_t width, uint32_t)
+{
+    uint32_t x = 0;
+
+    for (; x + 2 <= width; x += 2)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + (x * 8)),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(pSrc + (x * 4)), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    if (x < width)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + (x * 8)),
+                         _mm_cvtps_ph(_mm_loadu_ps(pSrc + (x * 4)), _MM_FROUND_TO_NEAREST_INT));
+    }
+}
+
+//=====================================================================================================================
+// Returns the AVX2 kernels (SSE4.1 kernels fill the layouts without a wider version)
+static ConvertKernels GetAvx2Kernels()
+{
+    ConvertKernels kernels = GetSse41Kernels();
+
+    kernels.Decode[TexelLayoutRgba8]   = DecodeUnorm8Avx2;
+    kernels.Decode[TexelLayoutBgra8]   = DecodeUnorm8Avx2;
+    kernels.Decode[TexelLayoutBgrx8]   = DecodeUnorm8Avx2;
+    kernels.Decode[TexelLayoutRgba16f] = DecodeRgba16fAvx2;
+    kernels.Encode[TexelLayoutRgba8]   = EncodeUnorm8Avx2;
+    kernels.Encode[TexelLayoutBgra8]   = EncodeUnorm8Avx2;
+    kernels.Encode[TexelLayoutBgrx8]   = EncodeUnorm8Avx2;
+    kernels.Encode[TexelLayoutRgba16f] = EncodeRgba16fAvx2;
+    kernels.Swizzle                    = SwizzleUnorm8Avx2;
+
+    return kernels;
+}
+
+//=====================================================================================================================
+// Queries the CPU for the best supported instruction set
+static ConvertIsa DetectConvertIsa()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool avx   = ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 6) == 6);
+    const bool f16c  = (info[2] & (1 << 29)) != 0;
+
+    __cpuidex(info, 7, 0);
+
+    const bool avx2 = avx && f16c && ((info[1] & (1 << 5)) != 0);
+#else
+    __builtin_cpu_init();
+
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2  = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+#endif
+
+    return avx2 ? ConvertIsa::Avx2 : (sse41 ? ConvertIsa::Sse41 : ConvertIsa::Scalar);
+}
+#endif
+
+//=====================================================================================================================
+// Returns the best conversion instruction set supported by the CPU
+ConvertIsa GetSupportedConvertIsa()
+{
+#if AR_SIMD_X86
+    static const ConvertIsa isa = DetectConvertIsa();
+    return isa;
+#else
+    return ConvertIsa::Scalar;
+#endif
+}
+
+//=====================================================================================================================
+// Returns the kernels of an instruction set, clamped to the supported one
+static const ConvertKernels& GetKernels(
+    ConvertIsa isa)
+{
+    const ConvertIsa supported = GetSupportedConvertIsa();
+
+    if ((isa == ConvertIsa::Auto) || (isa > supported))
+    {
+        isa = supported;
+    }
+
+    static const ConvertKernels ScalarKernels = GetScalarKernels();
+
+#if AR_SIMD_X86
+    static const ConvertKernels Sse41Kernels = GetSse41Kernels();
+    static const ConvertKernels Avx2Kernels  = GetAvx2Kernels();
+
+    if (isa == ConvertIsa::Avx2)
+    {
+        return Avx2Kernels;
+    }
+
+    if (isa == ConvertIsa::Sse41)
+    {
+        return Sse41Kernels;
+    }
+#endif
+
+    return ScalarKernels;
+}
+
+//=====================================================================================================================
+// Returns whether texels of one format can be converted to another
+bool IsConversionSupported(
+    DXGI_FORMAT srcFormat, DXGI_FORMAT dstFormat)
+{
+    const TexelLayout src = GetTexelFormat(srcFormat).Layout;
+    const TexelLayout dst = GetTexelFormat(dstFormat).Layout;
+
+    return (src != TexelLayoutUnsupported) && (src != TexelLayoutR11G11B10f) && (src != TexelLayoutR10G10B10A2) &&
+           (dst != TexelLayoutUnsupported);
+}
+
+//=====================================================================================================================
+// Converts rows of texels on the calling thread
+bool ConvertRows(
+    DXGI_FORMAT srcFormat,
+    const void* pSrc,
+    uint64_t    srcRowPitch,
+    DXGI_FORMAT dstFormat,
+    void*       pDst,
+    uint64_t    dstRowPitch,
+    uint32_t    width,
+    uint32_t    rowCount,
+    ConvertIsa  isa)
+{
+    if (IsConversionSupported(srcFormat, dstFormat) == false)
+    {
+        return false;
+    }
+
+    const TexelFormat     src     = GetTexelFormat(srcFormat);
+    const TexelFormat     dst     = GetTexelFormat(dstFormat);
+    const ConvertKernels& kernels = GetKernels(isa);
+
+    const bool isSameLayout = (src.Layout == dst.Layout) && (src.Flags == dst.Flags);
+    const bool isSwizzle    = IsUnorm8Layout(src.Layout) && IsUnorm8Layout(dst.Layout) &&
+                              ((src.Flags & ConvertFlagSrgb) == (dst.Flags & ConvertFlagSrgb));
+
+    // Channels move between 8-bit layouts without a float round trip; sources without alpha write an opaque one
+    const uint32_t swizzleFlags = ((src.Flags ^ dst.Flags) & ConvertFlagSwapRB) |
+                                  ((src.Flags | dst.Flags) & ConvertFlagOpaque);
+
+    alignas(32) float scratch[ScratchTexels * 4];
+
+    for (uint32_t y = 0; y < rowCount; y++)
+    {
+        const uint8_t* pSrcRow = static_cast<const uint8_t*>(pSrc) + (srcRowPitch * y);
+        uint8_t*       pDstRow = static_cast<uint8_t*>(pDst) + (dstRowPitch * y);
+
+        if (isSameLayout)
+        {
+            std::memcpy(pDstRow, pSrcRow, size_t(width) * src.Size);
+        }
+        else if (isSwizzle)
+        {
+            kernels.Swizzle(pSrcRow, pDstRow, width, swizzleFlags);
+        }
+        else
+        {
+            for (uint32_t x = 0; x < width; x += ScratchTexels)
+            {
+                const uint32_t count = std::min(ScratchTexels, width - x);
+
+                kernels.Decode[src.Layout](pSrcRow + (size_t(x) * src.Size), scratch, count, src.Flags);
+                kernels.Encode[dst.Layout](scratch, pDstRow + (size_t(x) * dst.Size), count, dst.Flags);
+            }
+        }
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Rows of one subresource depth slice converted by one worker
+struct ConvertTile
+{
+    uint32_t Index;    ///< Subresource index relative to the first subresource
+    uint32_t Slice;    ///< Depth slice
+    uint32_t FirstRow; ///< First row
+    uint32_t RowCount; ///< Row count
+};
+
+//=====================================================================================================================
+// Converts source subresources to the builder format in upload footprint layout
+bool ConvertSubresources(
+    const ResourceBuilder& builder,
+    uint32_t               firstSubresource,
+    uint32_t               numSubresources,
+    uint64_t               baseOffset,
+    const ConvertSource*   pSources,
+    void*                  pDstData,
+    uint32_t               threadCount,
+    ConvertIsa             isa)
+{
+    if ((builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) || IsBlockCompressed(builder.Format) ||
+        (builder.GetPlaneCount() != 1))
+    {
+        return false;
+    }
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(numSubresources);
+    std::vector<uint32_t>                           numRows(numSubresources);
+    std::vector<ConvertTile>                        tiles;
+
+    builder.GetCopyableFootprints(
+        firstSubresource, numSubresources, baseOffset, layouts.data(), numRows.data(), nullptr, nullptr);
+
+    for (uint32_t i = 0; i < numSubresources; i++)
+    {
+        if ((numRows[i] == UINT32_MAX) || (IsConversionSupported(pSources[i].Format, builder.Format) == false))
+        {
+            return false;
+        }
+
+        for (uint32_t z = 0; z < layouts[i].Footprint.Depth; z++)
+        {
+            for (uint32_t y = 0; y < numRows[i]; y += RowsPerTile)
+            {
+                tiles.push_back({ i, z, y, std::min(RowsPerTile, numRows[i] - y) });
+            }
+        }
+    }
+
+    ParallelFor(static_cast<uint32_t>(tiles.size()), threadCount, MinTilesPerThread,
+                [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t t = begin; t < end; t++)
+        {
+            const ConvertTile&                        tile   = tiles[t];
+            const ConvertSource&                      source = pSources[tile.Index];
+            const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[tile.Index];
+            const uint64_t                            pitch  = layout.Footprint.RowPitch;
+
+            const uint8_t* pSrc = static_cast<const uint8_t*>(source.pData) + (source.SlicePitch * tile.Slice) +
+                                  (source.RowPitch * tile.FirstRow);
+            uint8_t*       pDst = static_cast<uint8_t*>(pDstData) + layout.Offset +
+                                  (pitch * ((uint64_t(numRows[tile.Index]) * tile.Slice) + tile.FirstRow));
+
+            ConvertRows(source.Format, pSrc, source.RowPitch, builder.Format, pDst, pitch,
+                        layout.Footprint.Width, tile.RowCount, isa);
+        }
+    });
+
+    return true;
+}
+} // AR
@@ -0,0 +1,110 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Instruction set used by the conversion kernels
+enum class ConvertIsa : uint32_t
+{
+    Auto   = 0, ///< Best instruction set supported by the CPU
+    Scalar = 1, ///< Portable reference kernels
+    Sse41  = 2, ///< SSE4.1 kernels
+    Avx2   = 3, ///< AVX2 and F16C kernels
+};
+
+//=====================================================================================================================
+// Source texel data of one subresource
+struct ConvertSource
+{
+    const void* pData;      ///< First texel of the subresource
+    DXGI_FORMAT Format;     ///< Source format
+    uint64_t    RowPitch;   ///< Row pitch in bytes
+    uint64_t    SlicePitch; ///< Depth slice pitch in bytes
+};
+
+/// Returns the best conversion instruction set supported by the CPU
+ConvertIsa GetSupportedConvertIsa();
+
+/// Returns whether texels of one format can be converted to another. Supported formats are the RGBA8 and BGRA8/BGRX8
+/// UNORM and sRGB formats, R16G16B16A16_FLOAT, R32G32B32_FLOAT and R32G32B32A32_FLOAT as sources and destinations,
+/// R11G11B10_FLOAT and R10G10B10A2_UNORM as destinations. Typeless formats convert as their default view format.
+///
+/// @param srcFormat [in] Source format
+/// @param dstFormat [in] Destination format
+///
+bool IsConversionSupported(DXGI_FORMAT srcFormat, DXGI_FORMAT dstFormat);
+
+/// Converts rows of texels on the calling thread. sRGB formats are decoded to linear values and linear values are
+/// encoded to sRGB destinations, so UNORM and sRGB formats convert into each other. Values are rounded to nearest
+/// even and saturated to the destination range (R11G11B10_FLOAT saturates NaN to zero and infinity to the largest
+/// finite value). Every instruction set produces the same bits as the scalar kernels.
+///
+/// @param srcFormat   [in]  Source format
+/// @param pSrc        [in]  First source row
+/// @param srcRowPitch [in]  Source row pitch in bytes
+/// @param dstFormat   [in]  Destination format
+/// @param pDst        [out] First destination row
+/// @param dstRowPitch [in]  Destination row pitch in bytes
+/// @param width       [in]  Texels per row
+/// @param rowCount    [in]  Row count
+/// @param isa         [optional] Kernel instruction set (clamped to the supported one)
+///
+/// Returns false when the conversion is not supported.
+bool ConvertRows(
+    DXGI_FORMAT srcFormat,
+    const void* pSrc,
+    uint64_t    srcRowPitch,
+    DXGI_FORMAT dstFormat,
+    void*       pDst,
+    uint64_t    dstRowPitch,
+    uint32_t    width,
+    uint32_t    rowCount,
+    ConvertIsa  isa = ConvertIsa::Auto);
+
+/// Converts source subresources to the builder format, writing them directly in the layout of
+/// ResourceBuilder::GetCopyableFootprints (e.g. into a mapped upload buffer or an UploadRingPlanner block). Rows of
+/// every subresource and depth slice are split into tiles converted across worker threads. Sources have the
+/// dimensions of their subresource.
+///
+/// @param builder          [in]  Destination resource description
+/// @param firstSubresource [in]  First subresource index
+/// @param numSubresources  [in]  Subresource count
+/// @param baseOffset       [in]  Offset of the first subresource in the destination buffer
+/// @param pSources         [in]  Source data of every subresource
+/// @param pDstData         [out] Destination buffer start (footprint offsets are relative to it)
+/// @param threadCount      [optional] Worker thread count (0 selects the hardware concurrency)
+/// @param isa              [optional] Kernel instruction set (clamped to the supported one)
+///
+/// Returns false when the builder is a buffer, a block compressed or multi-plane texture, or a source format cannot
+/// be converted to the builder format. Nothing is written in that case.
+bool ConvertSubresources(
+    const ResourceBuilder& builder,
+    uint32_t               firstSubresource,
+    uint32_t               numSubresources,
+    uint64_t               baseOffset,
+    const ConvertSource*   pSources,
+    void*                  pDstData,
+    uint32_t               threadCount = 0,
+    ConvertIsa             isa         = ConvertIsa::Auto);
+} // AR
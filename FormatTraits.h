@@ -0,0 +1,462 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <d3d12.h>
+#include <cstdint>
+
+namespace AR {
+
+//=====================================================================================================================
+// Format property flags
+enum FormatFlags : uint16_t
+{
+    FormatFlagTypeless        = 0x0001, ///< Typeless format (requires a typed view format)
+    FormatFlagDepth           = 0x0002, ///< Format carries depth data
+    FormatFlagStencil         = 0x0004, ///< Format carries stencil data
+    FormatFlagSrgb            = 0x0008, ///< sRGB encoded format
+    FormatFlagBlockCompressed = 0x0010, ///< BC1-BC7 block compressed format
+    FormatFlagPacked          = 0x0020, ///< Packed format sharing components between horizontal texel pairs
+    FormatFlagPlanar          = 0x0040, ///< Multi-plane video format
+    FormatFlagVideo           = 0x0080, ///< Video format
+    FormatFlagPalette         = 0x0100, ///< Palettized format
+};
+
+//=====================================================================================================================
+// Per-format traits. Formats are stored as uint8_t since every format in the table is below 256.
+struct FormatInfo
+{
+    uint8_t  Format;          ///< Format described by this entry
+    uint8_t  BlockWidth;      ///< Block width in texels (1 for uncompressed formats)
+    uint8_t  BlockHeight;     ///< Block height in texels (1 for uncompressed formats)
+    uint8_t  PlaneCount;      ///< Plane count
+    uint16_t BitsPerBlock;    ///< Bits per block (bits per texel for uncompressed formats, luma plane for planar)
+    uint16_t Flags;           ///< FormatFlags
+    uint8_t  TypelessFormat;  ///< Typeless family, or DXGI_FORMAT_UNKNOWN when the format cannot be cast
+    uint8_t  ViewFormat;      ///< Default typed shader resource / color target view format
+    uint8_t  DepthViewFormat; ///< Default depth-stencil view format
+    uint8_t  SrgbPairFormat;  ///< sRGB counterpart of a linear format and linear counterpart of an sRGB format
+};
+
+#define AR_FORMAT_INFO(format, bits, blockWidth, blockHeight, planes, flags, typeless, view, depthView, srgbPair) \
+    { uint8_t(DXGI_FORMAT_##format), blockWidth, blockHeight, planes, bits, uint16_t(flags),                    \
+      uint8_t(DXGI_FORMAT_##typeless), uint8_t(DXGI_FORMAT_##view), uint8_t(DXGI_FORMAT_##depthView),          \
+      uint8_t(DXGI_FORMAT_##srgbPair) }
+
+//=====================================================================================================================
+// Format traits table indexed by DXGI_FORMAT. Columns: format, bits per block, block width, block height, plane count,
+// flags, typeless family, default view format, default depth-stencil view format, sRGB/linear counterpart.
+constexpr FormatInfo FormatInfoTable[] =
+{
+    AR_FORMAT_INFO(UNKNOWN, 0, 1, 1, 0, 0,
+                   UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32A32_TYPELESS, 128, 1, 1, 1, FormatFlagTypeless,
+                   R32G32B32A32_TYPELESS, R32G32B32A32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32A32_FLOAT, 128, 1, 1, 1, 0,
+                   R32G32B32A32_TYPELESS, R32G32B32A32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32A32_UINT, 128, 1, 1, 1, 0,
+                   R32G32B32A32_TYPELESS, R32G32B32A32_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32A32_SINT, 128, 1, 1, 1, 0,
+                   R32G32B32A32_TYPELESS, R32G32B32A32_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32_TYPELESS, 96, 1, 1, 1, FormatFlagTypeless,
+                   R32G32B32_TYPELESS, R32G32B32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32_FLOAT, 96, 1, 1, 1, 0,
+                   R32G32B32_TYPELESS, R32G32B32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32_UINT, 96, 1, 1, 1, 0,
+                   R32G32B32_TYPELESS, R32G32B32_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32B32_SINT, 96, 1, 1, 1, 0,
+                   R32G32B32_TYPELESS, R32G32B32_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_TYPELESS, 64, 1, 1, 1, FormatFlagTypeless,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_FLOAT, 64, 1, 1, 1, 0,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_UNORM, 64, 1, 1, 1, 0,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_UINT, 64, 1, 1, 1, 0,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_SNORM, 64, 1, 1, 1, 0,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16B16A16_SINT, 64, 1, 1, 1, 0,
+                   R16G16B16A16_TYPELESS, R16G16B16A16_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32_TYPELESS, 64, 1, 1, 1, FormatFlagTypeless,
+                   R32G32_TYPELESS, R32G32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32_FLOAT, 64, 1, 1, 1, 0,
+                   R32G32_TYPELESS, R32G32_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32_UINT, 64, 1, 1, 1, 0,
+                   R32G32_TYPELESS, R32G32_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G32_SINT, 64, 1, 1, 1, 0,
+                   R32G32_TYPELESS, R32G32_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32G8X24_TYPELESS, 64, 1, 1, 2, FormatFlagTypeless | FormatFlagDepth | FormatFlagStencil,
+                   R32G8X24_TYPELESS, R32_FLOAT_X8X24_TYPELESS, D32_FLOAT_S8X24_UINT, UNKNOWN),
+    AR_FORMAT_INFO(D32_FLOAT_S8X24_UINT, 64, 1, 1, 2, FormatFlagDepth | FormatFlagStencil,
+                   R32G8X24_TYPELESS, R32_FLOAT_X8X24_TYPELESS, D32_FLOAT_S8X24_UINT, UNKNOWN),
+    AR_FORMAT_INFO(R32_FLOAT_X8X24_TYPELESS, 64, 1, 1, 2, FormatFlagTypeless | FormatFlagDepth,
+                   R32G8X24_TYPELESS, R32_FLOAT_X8X24_TYPELESS, D32_FLOAT_S8X24_UINT, UNKNOWN),
+    AR_FORMAT_INFO(X32_TYPELESS_G8X24_UINT, 64, 1, 1, 2, FormatFlagStencil,
+                   R32G8X24_TYPELESS, X32_TYPELESS_G8X24_UINT, D32_FLOAT_S8X24_UINT, UNKNOWN),
+    AR_FORMAT_INFO(R10G10B10A2_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   R10G10B10A2_TYPELESS, R10G10B10A2_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R10G10B10A2_UNORM, 32, 1, 1, 1, 0,
+                   R10G10B10A2_TYPELESS, R10G10B10A2_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R10G10B10A2_UINT, 32, 1, 1, 1, 0,
+                   R10G10B10A2_TYPELESS, R10G10B10A2_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R11G11B10_FLOAT, 32, 1, 1, 1, 0,
+                   UNKNOWN, R11G11B10_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8B8A8_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8B8A8_UNORM, 32, 1, 1, 1, 0,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_UNORM, UNKNOWN, R8G8B8A8_UNORM_SRGB),
+    AR_FORMAT_INFO(R8G8B8A8_UNORM_SRGB, 32, 1, 1, 1, FormatFlagSrgb,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_UNORM_SRGB, UNKNOWN, R8G8B8A8_UNORM),
+    AR_FORMAT_INFO(R8G8B8A8_UINT, 32, 1, 1, 1, 0,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8B8A8_SNORM, 32, 1, 1, 1, 0,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8B8A8_SINT, 32, 1, 1, 1, 0,
+                   R8G8B8A8_TYPELESS, R8G8B8A8_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   R16G16_TYPELESS, R16G16_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_FLOAT, 32, 1, 1, 1, 0,
+                   R16G16_TYPELESS, R16G16_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_UNORM, 32, 1, 1, 1, 0,
+                   R16G16_TYPELESS, R16G16_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_UINT, 32, 1, 1, 1, 0,
+                   R16G16_TYPELESS, R16G16_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_SNORM, 32, 1, 1, 1, 0,
+                   R16G16_TYPELESS, R16G16_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16G16_SINT, 32, 1, 1, 1, 0,
+                   R16G16_TYPELESS, R16G16_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   R32_TYPELESS, R32_FLOAT, D32_FLOAT, UNKNOWN),
+    AR_FORMAT_INFO(D32_FLOAT, 32, 1, 1, 1, FormatFlagDepth,
+                   R32_TYPELESS, R32_FLOAT, D32_FLOAT, UNKNOWN),
+    AR_FORMAT_INFO(R32_FLOAT, 32, 1, 1, 1, 0,
+                   R32_TYPELESS, R32_FLOAT, D32_FLOAT, UNKNOWN),
+    AR_FORMAT_INFO(R32_UINT, 32, 1, 1, 1, 0,
+                   R32_TYPELESS, R32_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R32_SINT, 32, 1, 1, 1, 0,
+                   R32_TYPELESS, R32_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R24G8_TYPELESS, 32, 1, 1, 2, FormatFlagTypeless | FormatFlagDepth | FormatFlagStencil,
+                   R24G8_TYPELESS, R24_UNORM_X8_TYPELESS, D24_UNORM_S8_UINT, UNKNOWN),
+    AR_FORMAT_INFO(D24_UNORM_S8_UINT, 32, 1, 1, 2, FormatFlagDepth | FormatFlagStencil,
+                   R24G8_TYPELESS, R24_UNORM_X8_TYPELESS, D24_UNORM_S8_UINT, UNKNOWN),
+    AR_FORMAT_INFO(R24_UNORM_X8_TYPELESS, 32, 1, 1, 2, FormatFlagTypeless | FormatFlagDepth,
+                   R24G8_TYPELESS, R24_UNORM_X8_TYPELESS, D24_UNORM_S8_UINT, UNKNOWN),
+    AR_FORMAT_INFO(X24_TYPELESS_G8_UINT, 32, 1, 1, 2, FormatFlagStencil,
+                   R24G8_TYPELESS, X24_TYPELESS_G8_UINT, D24_UNORM_S8_UINT, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_TYPELESS, 16, 1, 1, 1, FormatFlagTypeless,
+                   R8G8_TYPELESS, R8G8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_UNORM, 16, 1, 1, 1, 0,
+                   R8G8_TYPELESS, R8G8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_UINT, 16, 1, 1, 1, 0,
+                   R8G8_TYPELESS, R8G8_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_SNORM, 16, 1, 1, 1, 0,
+                   R8G8_TYPELESS, R8G8_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_SINT, 16, 1, 1, 1, 0,
+                   R8G8_TYPELESS, R8G8_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16_TYPELESS, 16, 1, 1, 1, FormatFlagTypeless,
+                   R16_TYPELESS, R16_UNORM, D16_UNORM, UNKNOWN),
+    AR_FORMAT_INFO(R16_FLOAT, 16, 1, 1, 1, 0,
+                   R16_TYPELESS, R16_FLOAT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(D16_UNORM, 16, 1, 1, 1, FormatFlagDepth,
+                   R16_TYPELESS, R16_UNORM, D16_UNORM, UNKNOWN),
+    AR_FORMAT_INFO(R16_UNORM, 16, 1, 1, 1, 0,
+                   R16_TYPELESS, R16_UNORM, D16_UNORM, UNKNOWN),
+    AR_FORMAT_INFO(R16_UINT, 16, 1, 1, 1, 0,
+                   R16_TYPELESS, R16_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16_SNORM, 16, 1, 1, 1, 0,
+                   R16_TYPELESS, R16_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R16_SINT, 16, 1, 1, 1, 0,
+                   R16_TYPELESS, R16_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8_TYPELESS, 8, 1, 1, 1, FormatFlagTypeless,
+                   R8_TYPELESS, R8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8_UNORM, 8, 1, 1, 1, 0,
+                   R8_TYPELESS, R8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8_UINT, 8, 1, 1, 1, 0,
+                   R8_TYPELESS, R8_UINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8_SNORM, 8, 1, 1, 1, 0,
+                   R8_TYPELESS, R8_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8_SINT, 8, 1, 1, 1, 0,
+                   R8_TYPELESS, R8_SINT, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(A8_UNORM, 8, 1, 1, 1, 0,
+                   UNKNOWN, A8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R1_UNORM, 8, 8, 1, 1, 0,
+                   UNKNOWN, R1_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R9G9B9E5_SHAREDEXP, 32, 1, 1, 1, 0,
+                   UNKNOWN, R9G9B9E5_SHAREDEXP, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(R8G8_B8G8_UNORM, 32, 2, 1, 1, FormatFlagPacked,
+                   UNKNOWN, R8G8_B8G8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(G8R8_G8B8_UNORM, 32, 2, 1, 1, FormatFlagPacked,
+                   UNKNOWN, G8R8_G8B8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC1_TYPELESS, 64, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC1_TYPELESS, BC1_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC1_UNORM, 64, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC1_TYPELESS, BC1_UNORM, UNKNOWN, BC1_UNORM_SRGB),
+    AR_FORMAT_INFO(BC1_UNORM_SRGB, 64, 4, 4, 1, FormatFlagBlockCompressed | FormatFlagSrgb,
+                   BC1_TYPELESS, BC1_UNORM_SRGB, UNKNOWN, BC1_UNORM),
+    AR_FORMAT_INFO(BC2_TYPELESS, 128, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC2_TYPELESS, BC2_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC2_UNORM, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC2_TYPELESS, BC2_UNORM, UNKNOWN, BC2_UNORM_SRGB),
+    AR_FORMAT_INFO(BC2_UNORM_SRGB, 128, 4, 4, 1, FormatFlagBlockCompressed | FormatFlagSrgb,
+                   BC2_TYPELESS, BC2_UNORM_SRGB, UNKNOWN, BC2_UNORM),
+    AR_FORMAT_INFO(BC3_TYPELESS, 128, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC3_TYPELESS, BC3_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC3_UNORM, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC3_TYPELESS, BC3_UNORM, UNKNOWN, BC3_UNORM_SRGB),
+    AR_FORMAT_INFO(BC3_UNORM_SRGB, 128, 4, 4, 1, FormatFlagBlockCompressed | FormatFlagSrgb,
+                   BC3_TYPELESS, BC3_UNORM_SRGB, UNKNOWN, BC3_UNORM),
+    AR_FORMAT_INFO(BC4_TYPELESS, 64, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC4_TYPELESS, BC4_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC4_UNORM, 64, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC4_TYPELESS, BC4_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC4_SNORM, 64, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC4_TYPELESS, BC4_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC5_TYPELESS, 128, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC5_TYPELESS, BC5_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC5_UNORM, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC5_TYPELESS, BC5_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC5_SNORM, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC5_TYPELESS, BC5_SNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B5G6R5_UNORM, 16, 1, 1, 1, 0,
+                   UNKNOWN, B5G6R5_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B5G5R5A1_UNORM, 16, 1, 1, 1, 0,
+                   UNKNOWN, B5G5R5A1_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B8G8R8A8_UNORM, 32, 1, 1, 1, 0,
+                   B8G8R8A8_TYPELESS, B8G8R8A8_UNORM, UNKNOWN, B8G8R8A8_UNORM_SRGB),
+    AR_FORMAT_INFO(B8G8R8X8_UNORM, 32, 1, 1, 1, 0,
+                   B8G8R8X8_TYPELESS, B8G8R8X8_UNORM, UNKNOWN, B8G8R8X8_UNORM_SRGB),
+    AR_FORMAT_INFO(R10G10B10_XR_BIAS_A2_UNORM, 32, 1, 1, 1, 0,
+                   R10G10B10A2_TYPELESS, R10G10B10_XR_BIAS_A2_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B8G8R8A8_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   B8G8R8A8_TYPELESS, B8G8R8A8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B8G8R8A8_UNORM_SRGB, 32, 1, 1, 1, FormatFlagSrgb,
+                   B8G8R8A8_TYPELESS, B8G8R8A8_UNORM_SRGB, UNKNOWN, B8G8R8A8_UNORM),
+    AR_FORMAT_INFO(B8G8R8X8_TYPELESS, 32, 1, 1, 1, FormatFlagTypeless,
+                   B8G8R8X8_TYPELESS, B8G8R8X8_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B8G8R8X8_UNORM_SRGB, 32, 1, 1, 1, FormatFlagSrgb,
+                   B8G8R8X8_TYPELESS, B8G8R8X8_UNORM_SRGB, UNKNOWN, B8G8R8X8_UNORM),
+    AR_FORMAT_INFO(BC6H_TYPELESS, 128, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC6H_TYPELESS, BC6H_UF16, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC6H_UF16, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC6H_TYPELESS, BC6H_UF16, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC6H_SF16, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC6H_TYPELESS, BC6H_SF16, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC7_TYPELESS, 128, 4, 4, 1, FormatFlagTypeless | FormatFlagBlockCompressed,
+                   BC7_TYPELESS, BC7_UNORM, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(BC7_UNORM, 128, 4, 4, 1, FormatFlagBlockCompressed,
+                   BC7_TYPELESS, BC7_UNORM, UNKNOWN, BC7_UNORM_SRGB),
+    AR_FORMAT_INFO(BC7_UNORM_SRGB, 128, 4, 4, 1, FormatFlagBlockCompressed | FormatFlagSrgb,
+                   BC7_TYPELESS, BC7_UNORM_SRGB, UNKNOWN, BC7_UNORM),
+    AR_FORMAT_INFO(AYUV, 32, 1, 1, 1, FormatFlagVideo,
+                   UNKNOWN, AYUV, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(Y410, 32, 1, 1, 1, FormatFlagVideo,
+                   UNKNOWN, Y410, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(Y416, 64, 1, 1, 1, FormatFlagVideo,
+                   UNKNOWN, Y416, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(NV12, 8, 1, 1, 2, FormatFlagPlanar | FormatFlagVideo,
+                   UNKNOWN, NV12, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(P010, 16, 1, 1, 2, FormatFlagPlanar | FormatFlagVideo,
+                   UNKNOWN, P010, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(P016, 16, 1, 1, 2, FormatFlagPlanar | FormatFlagVideo,
+                   UNKNOWN, P016, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(420_OPAQUE, 8, 1, 1, 2, FormatFlagPlanar | FormatFlagVideo,
+                   UNKNOWN, 420_OPAQUE, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(YUY2, 32, 2, 1, 1, FormatFlagPacked | FormatFlagVideo,
+                   UNKNOWN, YUY2, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(Y210, 64, 2, 1, 1, FormatFlagPacked | FormatFlagVideo,
+                   UNKNOWN, Y210, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(Y216, 64, 2, 1, 1, FormatFlagPacked | FormatFlagVideo,
+                   UNKNOWN, Y216, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(NV11, 8, 1, 1, 2, FormatFlagPlanar | FormatFlagVideo,
+                   UNKNOWN, NV11, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(AI44, 8, 1, 1, 1, FormatFlagVideo | FormatFlagPalette,
+                   UNKNOWN, AI44, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(IA44, 8, 1, 1, 1, FormatFlagVideo | FormatFlagPalette,
+                   UNKNOWN, IA44, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(P8, 8, 1, 1, 1, FormatFlagVideo | FormatFlagPalette,
+                   UNKNOWN, P8, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(A8P8, 16, 1, 1, 1, FormatFlagVideo | FormatFlagPalette,
+                   UNKNOWN, A8P8, UNKNOWN, UNKNOWN),
+    AR_FORMAT_INFO(B4G4R4A4_UNORM, 16, 1, 1, 1, 0,
+                   UNKNOWN, B4G4R4A4_UNORM, UNKNOWN, UNKNOWN),
+};
+
+#undef AR_FORMAT_INFO
+
+/// Table entry count (formats past DXGI_FORMAT_B4G4R4A4_UNORM resolve to the DXGI_FORMAT_UNKNOWN entry)
+constexpr uint32_t FormatInfoCount = sizeof(FormatInfoTable) / sizeof(FormatInfoTable[0]);
+
+//=====================================================================================================================
+// Returns the traits for a format. Out-of-range formats select the DXGI_FORMAT_UNKNOWN entry without branching.
+constexpr const FormatInfo& GetFormatInfo(DXGI_FORMAT format)
+{
+    return FormatInfoTable[(static_cast<uint32_t>(format) < FormatInfoCount) ? static_cast<uint32_t>(format) : 0];
+}
+
+//=====================================================================================================================
+// Returns whether the DXGI_FORMAT input is a typeless format
+constexpr bool IsTypeless(DXGI_FORMAT format)
+{
+    return (GetFormatInfo(format).Flags & FormatFlagTypeless) != 0;
+}
+
+//=====================================================================================================================
+// Returns whether the format carries depth data
+constexpr bool IsDepthFormat(DXGI_FORMAT format)
+{
+    return (GetFormatInfo(format).Flags & FormatFlagDepth) != 0;
+}
+
+//=====================================================================================================================
+// Returns whether the format carries stencil data
+constexpr bool IsStencilFormat(DXGI_FORMAT format)
+{
+    return (GetFormatInfo(format).Flags & FormatFlagStencil) != 0;
+}
+
+//=====================================================================================================================
+// Returns whether the format is sRGB encoded
+constexpr bool IsSrgb(DXGI_FORMAT format)
+{
+    return (GetFormatInfo(format).Flags & FormatFlagSrgb) != 0;
+}
+
+//=====================================================================================================================
+// Returns whether the format is a BC1-BC7 block compressed format
+constexpr bool IsBlockCompressed(DXGI_FORMAT format)
+{
+    return (GetFormatInfo(format).Flags & FormatFlagBlockCompressed) != 0;
+}
+
+//=====================================================================================================================
+// Returns the number of bits per texel (averaged over the block for block compressed and packed formats)
+constexpr uint32_t GetBitsPerPixel(DXGI_FORMAT format)
+{
+    const FormatInfo& info = GetFormatInfo(format);
+    return info.BitsPerBlock / (info.BlockWidth * info.BlockHeight);
+}
+
+//=====================================================================================================================
+// Returns the number of bytes per block (bytes per texel for uncompressed formats)
+constexpr uint32_t GetBytesPerBlock(DXGI_FORMAT format)
+{
+    return GetFormatInfo(format).BitsPerBlock / 8;
+}
+
+//=====================================================================================================================
+// Returns the plane count of the format
+constexpr uint32_t GetPlaneCount(DXGI_FORMAT format)
+{
+    return GetFormatInfo(format).PlaneCount;
+}
+
+//=====================================================================================================================
+// Returns the typeless family of a format (DXGI_FORMAT_UNKNOWN when the format cannot be cast)
+constexpr DXGI_FORMAT GetTypelessFormat(DXGI_FORMAT format)
+{
+    return static_cast<DXGI_FORMAT>(GetFormatInfo(format).TypelessFormat);
+}
+
+//=====================================================================================================================
+// Returns the default typed shader resource / color target view format
+constexpr DXGI_FORMAT GetDefaultViewFormat(DXGI_FORMAT format)
+{
+    return static_cast<DXGI_FORMAT>(GetFormatInfo(format).ViewFormat);
+}
+
+//=====================================================================================================================
+// Returns the default depth-stencil view format (DXGI_FORMAT_UNKNOWN when the format has no depth counterpart)
+constexpr DXGI_FORMAT GetDefaultDepthViewFormat(DXGI_FORMAT format)
+{
+    return static_cast<DXGI_FORMAT>(GetFormatInfo(format).DepthViewFormat);
+}
+
+//=====================================================================================================================
+// Returns the sRGB variant of a format (the format itself when already sRGB, DXGI_FORMAT_UNKNOWN if none exists)
+constexpr DXGI_FORMAT GetSrgbFormat(DXGI_FORMAT format)
+{
+    return IsSrgb(format) ? format : static_cast<DXGI_FORMAT>(GetFormatInfo(format).SrgbPairFormat);
+}
+
+//=====================================================================================================================
+// Returns the linear variant of an sRGB format (the format itself when not sRGB)
+constexpr DXGI_FORMAT GetLinearFormat(DXGI_FORMAT format)
+{
+    return IsSrgb(format) ? static_cast<DXGI_FORMAT>(GetFormatInfo(format).SrgbPairFormat) : format;
+}
+
+//=====================================================================================================================
+// Layout of one plane of a format as seen by copy operations
+struct PlaneLayout
+{
+    DXGI_FORMAT Format;      ///< Per-plane copy format
+    uint32_t    WidthShift;  ///< Horizontal subsampling of the plane (log2)
+    uint32_t    HeightShift; ///< Vertical subsampling of the plane (log2)
+};
+
+//=====================================================================================================================
+// Returns the copy layout of a plane. Depth-stencil formats split into a 32-bit depth plane and an 8-bit stencil plane,
+// planar video formats into a luma plane and a subsampled interleaved chroma plane. Single-plane formats return the
+// format itself for plane 0.
+constexpr PlaneLayout GetPlaneLayout(DXGI_FORMAT format, uint32_t plane)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G8X24_TYPELESS:
+    case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+    case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
+    case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
+    case DXGI_FORMAT_R24G8_TYPELESS:
+    case DXGI_FORMAT_D24_UNORM_S8_UINT:
+    case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
+    case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
+        return { (plane == 0) ? DXGI_FORMAT_R32_TYPELESS : DXGI_FORMAT_R8_TYPELESS, 0, 0 };
+    case DXGI_FORMAT_NV12:
+    case DXGI_FORMAT_420_OPAQUE:
+        return { (plane == 0) ? DXGI_FORMAT_R8_TYPELESS : DXGI_FORMAT_R8G8_TYPELESS, plane, plane };
+    case DXGI_FORMAT_P010:
+    case DXGI_FORMAT_P016:
+        return { (plane == 0) ? DXGI_FORMAT_R16_TYPELESS : DXGI_FORMAT_R16G16_TYPELESS, plane, plane };
+    case DXGI_FORMAT_NV11:
+        return { (plane == 0) ? DXGI_FORMAT_R8_TYPELESS : DXGI_FORMAT_R8G8_TYPELESS, plane * 2, 0 };
+    default:
+        return { format, 0, 0 };
+    }
+}
+
+//=====================================================================================================================
+// @internal Returns whether every table entry sits at the index of the format it describes
+constexpr bool ValidateFormatInfoTable()
+{
+    for (uint32_t i = 0; i < FormatInfoCount; i++)
+    {
+        if (FormatInfoTable[i].Format != i)
+        {
+            return false;
+        }
+    }
+
+    return (FormatInfoCount == (DXGI_FORMAT_B4G4R4A4_UNORM + 1));
+}
+
+static_assert(ValidateFormatInfoTable(), "FormatInfoTable is out of order");
+static_assert(sizeof(FormatInfo) == 12, "FormatInfo should stay compact");
+} // AR
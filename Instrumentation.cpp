@@ -0,0 +1,430 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "Instrumentation.h"
+
+#if AR_ENABLE_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#endif
+
+namespace AR {
+
+// Instrumented method names, in InstrumentedMethod order
+static const char* const InstrumentedMethodNames[] =
+{
+    "Buffer",
+    "Texture1D",
+    "Texture2D",
+    "Texture3D",
+    "FromExistingResource",
+    "AsColorTargetView",
+    "AsColorTargetViewArray",
+    "AsDepthStencilView",
+    "AsDepthStencilViewArray",
+    "AsShaderResourceView",
+    "AsShaderResourceViewArray",
+    "AsBufferResourceView",
+    "AsUnorderedAccessView",
+    "AsUnorderedAccessViewArray",
+    "BuildMipViews",
+};
+
+static_assert(sizeof(InstrumentedMethodNames) / sizeof(InstrumentedMethodNames[0]) ==
+              static_cast<size_t>(InstrumentedMethod::Count), "InstrumentedMethodNames is out of date");
+
+//=====================================================================================================================
+// Returns the name of an instrumented method
+const char* GetInstrumentedMethodName(
+    InstrumentedMethod method)
+{
+    return (method < InstrumentedMethod::Count) ? InstrumentedMethodNames[static_cast<uint32_t>(method)] : "Unknown";
+}
+
+#if AR_ENABLE_INSTRUMENTATION
+
+static constexpr uint32_t MethodCount = static_cast<uint32_t>(InstrumentedMethod::Count);
+
+//=====================================================================================================================
+// Per-thread recording state. Only the owning thread writes; counters are stored with relaxed loads and stores
+// rather than read-modify-write operations, and events are published through the write index.
+struct ThreadRing
+{
+    /// Event slot guarded by a sequence number (odd while the owner writes it, 2 * (event index + 1) once written).
+    /// Fields are atomics so readers may copy slots while the owner overwrites them.
+    struct Slot
+    {
+        std::atomic<uint64_t> Sequence;
+        std::atomic<uint64_t> StartNs;
+        std::atomic<uint64_t> DurationNs;
+        std::atomic<uint64_t> Info; ///< Method (bits 0-15), format (bits 16-23), dimension (bits 24-31)
+    };
+
+    uint32_t              Thread;                                      ///< Thread index
+    std::atomic<uint64_t> WriteIndex;                                  ///< Events recorded
+    std::atomic<uint64_t> Calls[MethodCount];                          ///< Per-method call counts
+    std::atomic<uint64_t> TimeNs[MethodCount];                         ///< Per-method time in nanoseconds
+    std::atomic<uint64_t> Formats[Instrumentation::FormatCount];       ///< Format histogram
+    std::atomic<uint64_t> Dimensions[Instrumentation::DimensionCount]; ///< Dimension histogram
+    Slot                  Events[Instrumentation::EventCapacity];      ///< Event ring
+};
+
+//=====================================================================================================================
+// Rings of every thread that recorded an event. Rings outlive their threads so their events can still be exported,
+// and the ring of an exited thread is handed to the next thread that starts recording, so short-lived threads (e.g. one
+// per task of a job system) never hold more rings than the most threads that recorded at the same time.
+struct RingRegistry
+{
+    std::mutex                               Lock;
+    std::vector<std::shared_ptr<ThreadRing>> Rings;
+    std::vector<ThreadRing*>                 FreeRings; ///< Rings whose thread exited
+};
+
+//=====================================================================================================================
+// Returns the ring registry
+static RingRegistry& GetRegistry()
+{
+    static RingRegistry registry;
+    return registry;
+}
+
+//=====================================================================================================================
+// Increments a counter owned by the calling thread
+static void Increment(
+    std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+//=====================================================================================================================
+// Sums a counter over every thread ring
+template <typename Func>
+static uint64_t SumRings(
+    const Func& func)
+{
+    RingRegistry&               registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    uint64_t sum = 0;
+
+    for (const std::shared_ptr<ThreadRing>& ring : registry.Rings)
+    {
+        sum += func(*ring).load(std::memory_order_relaxed);
+    }
+
+    return sum;
+}
+
+//=====================================================================================================================
+// Ring of the calling thread, returned to the registry's free list when the thread exits
+struct ThreadRingOwner
+{
+    ThreadRing* pRing = nullptr;
+
+    ~ThreadRingOwner()
+    {
+        if (pRing != nullptr)
+        {
+            RingRegistry&               registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Lock);
+
+            registry.FreeRings.push_back(pRing);
+        }
+    }
+};
+
+//=====================================================================================================================
+// Returns the ring of the calling thread, taking a free ring or registering a new one on first use
+static ThreadRing& GetThreadRing()
+{
+    thread_local ThreadRingOwner owner;
+
+    if (owner.pRing == nullptr)
+    {
+        RingRegistry&               registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Lock);
+
+        if (registry.FreeRings.empty() == false)
+        {
+            // The new thread continues the ring: counters keep accumulating and older events stay exportable
+            owner.pRing = registry.FreeRings.back();
+            registry.FreeRings.pop_back();
+        }
+        else
+        {
+            // Value-initialisation zeroes every atomic
+            std::shared_ptr<ThreadRing> ring(new ThreadRing());
+
+            ring->Thread = static_cast<uint32_t>(registry.Rings.size());
+            registry.Rings.push_back(ring);
+            owner.pRing = ring.get();
+        }
+    }
+
+    return *owner.pRing;
+}
+
+//=====================================================================================================================
+// Returns the current timestamp in nanoseconds
+uint64_t Instrumentation::GetTimestamp()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+//=====================================================================================================================
+// Records a call on the calling thread
+void Instrumentation::Record(
+    InstrumentedMethod method, uint32_t format, uint32_t dimension, uint64_t startNs)
+{
+    const uint64_t endNs    = GetTimestamp();
+    const uint64_t duration = (endNs > startNs) ? (endNs - startNs) : 0;
+    const uint32_t index    = static_cast<uint32_t>(method);
+    ThreadRing&    ring     = GetThreadRing();
+
+    Increment(ring.Calls[index], 1);
+    Increment(ring.TimeNs[index], duration);
+    Increment(ring.Formats[format % FormatCount], 1);
+    Increment(ring.Dimensions[dimension % DimensionCount], 1);
+
+    const uint64_t    writeIndex = ring.WriteIndex.load(std::memory_order_relaxed);
+    ThreadRing::Slot& slot       = ring.Events[writeIndex & (EventCapacity - 1)];
+
+    slot.Sequence.store((2 * writeIndex) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.StartNs.store(startNs, std::memory_order_relaxed);
+    slot.DurationNs.store(duration, std::memory_order_relaxed);
+    slot.Info.store(index | ((format & 0xff) << 16) | ((dimension & 0xff) << 24), std::memory_order_relaxed);
+
+    slot.Sequence.store((2 * writeIndex) + 2, std::memory_order_release);
+    ring.WriteIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+//=====================================================================================================================
+// Returns the number of calls of a method across all threads
+uint64_t Instrumentation::GetCallCount(
+    InstrumentedMethod method)
+{
+    return SumRings([method](ThreadRing& ring) -> std::atomic<uint64_t>&
+    {
+        return ring.Calls[static_cast<uint32_t>(method) % MethodCount];
+    });
+}
+
+//=====================================================================================================================
+// Returns the total time spent in a method across all threads
+uint64_t Instrumentation::GetCallTime(
+    InstrumentedMethod method)
+{
+    return SumRings([method](ThreadRing& ring) -> std::atomic<uint64_t>&
+    {
+        return ring.TimeNs[static_cast<uint32_t>(method) % MethodCount];
+    });
+}
+
+//=====================================================================================================================
+// Returns the number of calls that returned with a resource format
+uint64_t Instrumentation::GetFormatCount(
+    DXGI_FORMAT format)
+{
+    return SumRings([format](ThreadRing& ring) -> std::atomic<uint64_t>&
+    {
+        return ring.Formats[static_cast<uint32_t>(format) % FormatCount];
+    });
+}
+
+//=====================================================================================================================
+// Returns the number of calls that returned with a resource dimension
+uint64_t Instrumentation::GetDimensionCount(
+    D3D12_RESOURCE_DIMENSION dimension)
+{
+    return SumRings([dimension](ThreadRing& ring) -> std::atomic<uint64_t>&
+    {
+        return ring.Dimensions[static_cast<uint32_t>(dimension) % DimensionCount];
+    });
+}
+
+//=====================================================================================================================
+// Collects the events kept by every thread ring
+void Instrumentation::CollectEvents(
+    std::vector<InstrumentationEvent>* pEvents)
+{
+    pEvents->clear();
+
+    RingRegistry&               registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    for (const std::shared_ptr<ThreadRing>& ring : registry.Rings)
+    {
+        const uint64_t end   = ring->WriteIndex.load(std::memory_order_acquire);
+        const uint64_t begin = (end > EventCapacity) ? (end - EventCapacity) : 0;
+
+        for (uint64_t i = begin; i < end; i++)
+        {
+            const ThreadRing::Slot& slot     = ring->Events[i & (EventCapacity - 1)];
+            const uint64_t          sequence = slot.Sequence.load(std::memory_order_acquire);
+
+            InstrumentationEvent event = {};
+            event.StartNs    = slot.StartNs.load(std::memory_order_relaxed);
+            event.DurationNs = slot.DurationNs.load(std::memory_order_relaxed);
+
+            const uint64_t info = slot.Info.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Skip slots the owner overwrote while they were copied
+            if ((sequence != (2 * i) + 2) || (slot.Sequence.load(std::memory_order_relaxed) != sequence))
+            {
+                continue;
+            }
+
+            event.Method    = static_cast<InstrumentedMethod>(info & 0xffff);
+            event.Format    = static_cast<uint8_t>(info >> 16);
+            event.Dimension = static_cast<uint8_t>(info >> 24);
+            event.Thread    = ring->Thread;
+
+            pEvents->push_back(event);
+        }
+    }
+
+    std::sort(pEvents->begin(), pEvents->end(), [](const InstrumentationEvent& a, const InstrumentationEvent& b)
+    {
+        return a.StartNs < b.StartNs;
+    });
+}
+
+//=====================================================================================================================
+// Writes the kept events as Chrome trace JSON
+bool Instrumentation::WriteChromeTrace(
+    FILE* pFile)
+{
+    std::vector<InstrumentationEvent> events;
+    CollectEvents(&events);
+
+    fprintf(pFile, "{\n  \"displayTimeUnit\": \"ns\",\n  \"traceEvents\": [\n");
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const InstrumentationEvent& event = events[i];
+
+        // Chrome trace timestamps are microseconds
+        fprintf(pFile,
+                "    {\"name\": \"%s\", \"cat\": \"ResourceBuilder\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+                "\"pid\": 1, \"tid\": %u, \"args\": {\"format\": %u, \"dimension\": %u}}%s\n",
+                GetInstrumentedMethodName(event.Method), event.StartNs / 1000.0, event.DurationNs / 1000.0,
+                event.Thread, event.Format, event.Dimension, (i + 1 < events.size()) ? "," : "");
+    }
+
+    fprintf(pFile, "  ]\n}\n");
+
+    return ferror(pFile) == 0;
+}
+
+//=====================================================================================================================
+// Writes a table of per-method call counts and times followed by the format and dimension histograms
+void Instrumentation::WriteSummary(
+    FILE* pFile)
+{
+    fprintf(pFile, "%-28s %12s %14s %10s\n", "Method", "Calls", "Total (us)", "Mean (ns)");
+
+    for (uint32_t i = 0; i < MethodCount; i++)
+    {
+        const InstrumentedMethod method = static_cast<InstrumentedMethod>(i);
+        const uint64_t           calls  = GetCallCount(method);
+        const uint64_t           timeNs = GetCallTime(method);
+
+        if (calls != 0)
+        {
+            fprintf(pFile, "%-28s %12llu %14.3f %10.1f\n", GetInstrumentedMethodName(method),
+                    static_cast<unsigned long long>(calls), timeNs / 1000.0, double(timeNs) / double(calls));
+        }
+    }
+
+    fprintf(pFile, "\n%-28s %12s\n", "Format", "Calls");
+
+    for (uint32_t i = 0; i < FormatCount; i++)
+    {
+        const uint64_t calls = GetFormatCount(static_cast<DXGI_FORMAT>(i));
+
+        if (calls != 0)
+        {
+            fprintf(pFile, "%-28u %12llu\n", i, static_cast<unsigned long long>(calls));
+        }
+    }
+
+    static const char* const DimensionNames[DimensionCount] =
+    {
+        "Unknown", "Buffer", "Texture1D", "Texture2D", "Texture3D"
+    };
+
+    fprintf(pFile, "\n%-28s %12s\n", "Dimension", "Calls");
+
+    for (uint32_t i = 0; i < DimensionCount; i++)
+    {
+        const uint64_t calls = GetDimensionCount(static_cast<D3D12_RESOURCE_DIMENSION>(i));
+
+        if (calls != 0)
+        {
+            fprintf(pFile, "%-28s %12llu\n", DimensionNames[i], static_cast<unsigned long long>(calls));
+        }
+    }
+}
+
+//=====================================================================================================================
+// Clears counters, histograms and rings
+void Instrumentation::Reset()
+{
+    RingRegistry&               registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    for (const std::shared_ptr<ThreadRing>& ring : registry.Rings)
+    {
+        for (uint32_t i = 0; i < MethodCount; i++)
+        {
+            ring->Calls[i].store(0, std::memory_order_relaxed);
+            ring->TimeNs[i].store(0, std::memory_order_relaxed);
+        }
+
+        for (std::atomic<uint64_t>& count : ring->Formats)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        for (std::atomic<uint64_t>& count : ring->Dimensions)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        for (ThreadRing::Slot& slot : ring->Events)
+        {
+            slot.Sequence.store(0, std::memory_order_relaxed);
+        }
+
+        ring->WriteIndex.store(0, std::memory_order_relaxed);
+    }
+}
+
+#endif
+} // AR
@@ -0,0 +1,195 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <d3d12.h>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+// Builder instrumentation is compiled in only when the build defines AR_ENABLE_INSTRUMENTATION=1. Without it the
+// hooks expand to nothing and the builder is unchanged.
+#ifndef AR_ENABLE_INSTRUMENTATION
+#define AR_ENABLE_INSTRUMENTATION 0
+#endif
+
+namespace AR {
+
+//=====================================================================================================================
+// Builder methods carrying an instrumentation hook
+enum class InstrumentedMethod : uint16_t
+{
+    Buffer,
+    Texture1D,
+    Texture2D,
+    Texture3D,
+    FromExistingResource,
+    AsColorTargetView,
+    AsColorTargetViewArray,
+    AsDepthStencilView,
+    AsDepthStencilViewArray,
+    AsShaderResourceView,
+    AsShaderResourceViewArray,
+    AsBufferResourceView,
+    AsUnorderedAccessView,
+    AsUnorderedAccessViewArray,
+    BuildMipViews,
+    Count
+};
+
+/// Returns the name of an instrumented method
+///
+/// @param method [in] Method
+///
+const char* GetInstrumentedMethodName(InstrumentedMethod method);
+
+#if AR_ENABLE_INSTRUMENTATION
+
+//=====================================================================================================================
+// Timestamped call recorded by an instrumentation hook
+struct InstrumentationEvent
+{
+    uint64_t           StartNs;    ///< Start time in nanoseconds since the first recorded event
+    uint64_t           DurationNs; ///< Duration in nanoseconds
+    InstrumentedMethod Method;     ///< Called method
+    uint8_t            Format;     ///< Resource format when the call returned
+    uint8_t            Dimension;  ///< Resource dimension when the call returned
+    uint32_t           Thread;     ///< Recording ring index (in first-event order, reused after a thread exits)
+};
+
+//=====================================================================================================================
+// Builder instrumentation. Each recording thread owns a ring of the most recent events and its own call counters,
+// so recording never takes a lock or contends on a shared cache line; readers merge the per-thread state. Counters
+// and histograms cover every call, rings keep the last EventCapacity events of each thread. The ring of an exited
+// thread is reused by the next thread that starts recording, so memory is bounded by the peak recording thread count.
+class Instrumentation
+{
+public:
+    static constexpr uint32_t EventCapacity  = 8192; ///< Events kept per thread (power of two)
+    static constexpr uint32_t FormatCount    = 256;  ///< Format histogram size
+    static constexpr uint32_t DimensionCount = 5;    ///< Dimension histogram size
+
+    /// Returns the current timestamp in nanoseconds
+    static uint64_t GetTimestamp();
+
+    /// Records a call on the calling thread
+    ///
+    /// @param method    [in] Called method
+    /// @param format    [in] Resource format when the call returned
+    /// @param dimension [in] Resource dimension when the call returned
+    /// @param startNs   [in] Timestamp taken when the call started
+    ///
+    static void Record(InstrumentedMethod method, uint32_t format, uint32_t dimension, uint64_t startNs);
+
+    /// Returns the number of calls of a method across all threads
+    static uint64_t GetCallCount(InstrumentedMethod method);
+
+    /// Returns the total time spent in a method across all threads, in nanoseconds
+    static uint64_t GetCallTime(InstrumentedMethod method);
+
+    /// Returns the number of calls that returned with a resource format
+    static uint64_t GetFormatCount(DXGI_FORMAT format);
+
+    /// Returns the number of calls that returned with a resource dimension
+    static uint64_t GetDimensionCount(D3D12_RESOURCE_DIMENSION dimension);
+
+    /// Collects the events kept by every thread ring, sorted by start time. Events overwritten while collecting are
+    /// skipped.
+    ///
+    /// @param pEvents [out] Events
+    ///
+    static void CollectEvents(std::vector<InstrumentationEvent>* pEvents);
+
+    /// Writes the kept events as Chrome trace JSON (chrome://tracing, Perfetto)
+    ///
+    /// @param pFile [in] Output file
+    ///
+    static bool WriteChromeTrace(FILE* pFile);
+
+    /// Writes a table of per-method call counts and times followed by the format and dimension histograms
+    ///
+    /// @param pFile [in] Output file
+    ///
+    static void WriteSummary(FILE* pFile);
+
+    /// Clears counters, histograms and rings. Not thread-safe: call while no thread records.
+    static void Reset();
+};
+
+//=====================================================================================================================
+// Records one builder call from construction to destruction. Calls evaluated at compile time are not recorded.
+class ScopedInstrumentation
+{
+public:
+#if defined(__cpp_lib_is_constant_evaluated) && defined(__cpp_constexpr) && (__cpp_constexpr >= 201907L)
+    constexpr ScopedInstrumentation(InstrumentedMethod method, const D3D12_RESOURCE_DESC* pDesc)
+        :
+        m_pDesc(pDesc),
+        m_start(0),
+        m_method(method)
+    {
+        if (std::is_constant_evaluated() == false)
+        {
+            m_start = Instrumentation::GetTimestamp();
+        }
+    }
+
+    constexpr ~ScopedInstrumentation()
+    {
+        if (std::is_constant_evaluated() == false)
+        {
+            Instrumentation::Record(m_method, m_pDesc->Format, m_pDesc->Dimension, m_start);
+        }
+    }
+#else
+    ScopedInstrumentation(InstrumentedMethod method, const D3D12_RESOURCE_DESC* pDesc)
+        :
+        m_pDesc(pDesc),
+        m_start(Instrumentation::GetTimestamp()),
+        m_method(method)
+    {
+    }
+
+    ~ScopedInstrumentation()
+    {
+        Instrumentation::Record(m_method, m_pDesc->Format, m_pDesc->Dimension, m_start);
+    }
+#endif
+
+    ScopedInstrumentation(const ScopedInstrumentation&)            = delete;
+    ScopedInstrumentation& operator=(const ScopedInstrumentation&) = delete;
+
+private:
+    const D3D12_RESOURCE_DESC* m_pDesc;  ///< Builder description
+    uint64_t                   m_start;  ///< Start timestamp
+    InstrumentedMethod         m_method; ///< Called method
+};
+
+/// Records the enclosing builder method
+#define AR_INSTRUMENT(method) \
+    AR::ScopedInstrumentation arInstrumentation(AR::InstrumentedMethod::method, this)
+
+#else
+
+#define AR_INSTRUMENT(method)
+
+#endif
+} // AR
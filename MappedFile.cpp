@@ -0,0 +1,165 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AR {
+
+//=====================================================================================================================
+// Constructor
+MappedFile::MappedFile()
+    :
+    m_pData(nullptr),
+    m_size(0)
+#if defined(_WIN32)
+    ,
+    m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr)
+#endif
+{
+}
+
+//=====================================================================================================================
+// Destructor
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//=====================================================================================================================
+// Maps a file
+bool MappedFile::Open(
+    const char* pPath)
+{
+    Close();
+
+#if defined(_WIN32)
+    m_hFile = CreateFileA(
+        pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (m_hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size = {};
+
+    if ((GetFileSizeEx(m_hFile, &size) == FALSE) || (static_cast<uint64_t>(size.QuadPart) > SIZE_MAX))
+    {
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    if (m_size > 0)
+    {
+        m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_pData    = (m_hMapping != nullptr) ?
+                     static_cast<const uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+
+        if (m_pData == nullptr)
+        {
+            Close();
+            return false;
+        }
+    }
+#else
+    const int file = open(pPath, O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info = {};
+
+    if (fstat(file, &info) != 0)
+    {
+        close(file);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(info.st_size);
+
+    if (m_size > 0)
+    {
+        void* pData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (pData == MAP_FAILED)
+        {
+            close(file);
+            m_size = 0;
+            return false;
+        }
+
+        m_pData = static_cast<const uint8_t*>(pData);
+    }
+
+    // The mapping keeps its own reference to the file
+    close(file);
+#endif
+
+    return true;
+}
+
+//=====================================================================================================================
+// Unmaps the file
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (m_pData != nullptr)
+    {
+        UnmapViewOfFile(m_pData);
+    }
+
+    if (m_hMapping != nullptr)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+
+    if (m_hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_pData != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(m_pData), m_size);
+    }
+#endif
+
+    m_pData = nullptr;
+    m_size  = 0;
+}
+} // AR
@@ -0,0 +1,61 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace AR {
+
+//=====================================================================================================================
+// Read-only memory-mapped file (file mapping on Windows, mmap elsewhere)
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Maps a file
+    ///
+    /// @param pPath [in] File path
+    ///
+    bool Open(const char* pPath);
+
+    /// Unmaps the file
+    void Close();
+
+    /// Returns the mapped bytes (nullptr when no file is open or the file is empty)
+    const uint8_t* GetData() const { return m_pData; }
+
+    /// Returns the mapped size in bytes
+    size_t GetSize() const { return m_size; }
+
+private:
+    const uint8_t* m_pData;   ///< Mapped view
+    size_t         m_size;    ///< Mapped size
+#if defined(_WIN32)
+    void*          m_hFile;    ///< File handle
+    void*          m_hMapping; ///< File mapping handle
+#endif
+};
+} // AR
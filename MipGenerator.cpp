@@ -0,0 +1,491 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "MipGenerator.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <cmath>
+#include <cstring>
+
+namespace AR {
+
+// Destination rows per parallel filtering tile
+static constexpr uint32_t RowsPerTile = 32;
+
+// Smallest number of tiles worth handing to a worker thread
+static constexpr uint32_t MinTilesPerThread = 2;
+
+// Kaiser filter half-width in destination texels and window shape
+static constexpr double KaiserRadius = 3.0;
+static constexpr double KaiserAlpha  = 4.0;
+
+// Working format of the filters
+static constexpr DXGI_FORMAT FilterFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
+
+//=====================================================================================================================
+// Polyphase filter along one axis: the taps of destination texel i are [Offsets[i], Offsets[i + 1]). Taps past the
+// edges are clamped and merged into the edge texel.
+struct FilterTaps
+{
+    std::vector<uint32_t> Offsets; ///< First tap of every destination texel, plus the tap count
+    std::vector<uint32_t> Indices; ///< Source texel of every tap
+    std::vector<float>    Weights; ///< Normalized weight of every tap
+};
+
+//=====================================================================================================================
+// Returns the zeroth order modified Bessel function of the first kind
+static double BesselI0(
+    double x)
+{
+    const double halfSquared = x * x * 0.25;
+
+    double sum  = 1.0;
+    double term = 1.0;
+
+    for (uint32_t k = 1; term > (sum * 1.0e-12); k++)
+    {
+        term *= halfSquared / (double(k) * k);
+        sum  += term;
+    }
+
+    return sum;
+}
+
+//=====================================================================================================================
+// Returns the Kaiser-windowed sinc at a distance in destination texels
+static double KaiserSinc(
+    double x)
+{
+    if (std::fabs(x) >= KaiserRadius)
+    {
+        return 0.0;
+    }
+
+    const double pi     = 3.14159265358979323846;
+    const double sinc   = (x == 0.0) ? 1.0 : (std::sin(pi * x) / (pi * x));
+    const double ratio  = x / KaiserRadius;
+    const double window = BesselI0(KaiserAlpha * std::sqrt(1.0 - (ratio * ratio))) / BesselI0(KaiserAlpha);
+
+    return sinc * window;
+}
+
+//=====================================================================================================================
+// Builds the taps reducing srcSize texels to dstSize texels
+static void BuildTaps(
+    uint32_t srcSize, uint32_t dstSize, MipFilter filter, FilterTaps* pTaps)
+{
+    const double scale = double(srcSize) / double(dstSize);
+
+    std::vector<uint32_t> indices;
+    std::vector<double>   weights;
+
+    pTaps->Offsets.assign(1, 0);
+    pTaps->Indices.clear();
+    pTaps->Weights.clear();
+
+    const auto addTap = [&](int64_t index, double weight)
+    {
+        const uint32_t clamped = static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(index, 0), srcSize - 1));
+
+        if ((indices.empty() == false) && (indices.back() == clamped))
+        {
+            weights.back() += weight;
+        }
+        else
+        {
+            indices.push_back(clamped);
+            weights.push_back(weight);
+        }
+    };
+
+    for (uint32_t i = 0; i < dstSize; i++)
+    {
+        indices.clear();
+        weights.clear();
+
+        if (srcSize == dstSize)
+        {
+            addTap(i, 1.0);
+        }
+        else if (filter == MipFilter::Box)
+        {
+            // Weight every source texel by the part of it the destination texel covers
+            const double begin = i * scale;
+            const double end   = (i + 1) * scale;
+
+            for (int64_t s = int64_t(std::floor(begin)); s < int64_t(std::ceil(end)); s++)
+            {
+                const double coverage = std::min(end, double(s + 1)) - std::max(begin, double(s));
+
+                if (coverage > 1.0e-9)
+                {
+                    addTap(s, coverage);
+                }
+            }
+        }
+        else
+        {
+            // The kernel is stretched by the scale so it stays band-limited to the destination rate
+            const double center = ((i + 0.5) * scale) - 0.5;
+            const double radius = KaiserRadius * scale;
+
+            for (int64_t s = int64_t(std::ceil(center - radius)); s <= int64_t(std::floor(center + radius)); s++)
+            {
+                const double weight = KaiserSinc((double(s) - center) / scale);
+
+                if (weight != 0.0)
+                {
+                    addTap(s, weight);
+                }
+            }
+        }
+
+        double sum = 0.0;
+
+        for (double weight : weights)
+        {
+            sum += weight;
+        }
+
+        for (size_t k = 0; k < indices.size(); k++)
+        {
+            pTaps->Indices.push_back(indices[k]);
+            pTaps->Weights.push_back(static_cast<float>(weights[k] / sum));
+        }
+
+        pTaps->Offsets.push_back(static_cast<uint32_t>(pTaps->Indices.size()));
+    }
+}
+
+//=====================================================================================================================
+// Row kernels: filter a row of RGBA floats horizontally, or accumulate a weighted row into a destination row
+using FilterRowFunc     = void (*)(const float* pSrc, const FilterTaps& taps, uint32_t dstWidth, float* pDst);
+using AccumulateRowFunc = void (*)(const float* pSrc, float weight, uint32_t count, float* pDst);
+
+//=====================================================================================================================
+// Kernels of one instruction set
+struct MipKernels
+{
+    FilterRowFunc     FilterRow;
+    AccumulateRowFunc AccumulateRow;
+};
+
+//=====================================================================================================================
+// Scalar kernels (reference for every SIMD kernel)
+
+static void FilterRowScalar(
+    const float* pSrc, const FilterTaps& taps, uint32_t dstWidth, float* pDst)
+{
+    for (uint32_t x = 0; x < dstWidth; x++)
+    {
+        float sum[4] = {};
+
+        for (uint32_t k = taps.Offsets[x]; k < taps.Offsets[x + 1]; k++)
+        {
+            const float  weight = taps.Weights[k];
+            const float* pTexel = pSrc + (size_t(taps.Indices[k]) * 4);
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                sum[c] = sum[c] + (weight * pTexel[c]);
+            }
+        }
+
+        std::memcpy(pDst + (size_t(x) * 4), sum, sizeof(sum));
+    }
+}
+
+static void AccumulateRowScalar(
+    const float* pSrc, float weight, uint32_t count, float* pDst)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pDst[i] = pDst[i] + (weight * pSrc[i]);
+    }
+}
+
+#if AR_SIMD_X86
+//=====================================================================================================================
+// SSE4.1 kernels: one RGBA texel per register
+
+AR_TARGET_SSE41 static inline __m128 FilterTexelSse41(
+    const float* pSrc, const FilterTaps& taps, uint32_t x)
+{
+    __m128 sum = _mm_setzero_ps();
+
+    for (uint32_t k = taps.Offsets[x]; k < taps.Offsets[x + 1]; k++)
+    {
+        const __m128 texel = _mm_loadu_ps(pSrc + (size_t(taps.Indices[k]) * 4));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps.Weights[k]), texel));
+    }
+
+    return sum;
+}
+
+AR_TARGET_SSE41 static void FilterRowSse41(
+    const float* pSrc, const FilterTaps& taps, uint32_t dstWidth, float* pDst)
+{
+    for (uint32_t x = 0; x < dstWidth; x++)
+    {
+        _mm_storeu_ps(pDst + (size_t(x) * 4), FilterTexelSse41(pSrc, taps, x));
+    }
+}
+
+AR_TARGET_SSE41 static void AccumulateRowSse41(
+    const float* pSrc, float weight, uint32_t count, float* pDst)
+{
+    const __m128 scale = _mm_set1_ps(weight);
+    uint32_t     i     = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_mul_ps(scale, _mm_loadu_ps(pSrc + i))));
+    }
+
+    AccumulateRowScalar(pSrc + i, weight, count - i, pDst + i);
+}
+
+//=====================================================================================================================
+// AVX2 kernels: two RGBA texels per register
+
+AR_TARGET_AVX2 static void FilterRowAvx2(
+    const float* pSrc, const FilterTaps& taps, uint32_t dstWidth, float* pDst)
+{
+    uint32_t x = 0;
+
+    for (; x + 2 <= dstWidth; x += 2)
+    {
+        const uint32_t first0 = taps.Offsets[x];
+        const uint32_t first1 = taps.Offsets[x + 1];
+        const uint32_t count  = first1 - first0;
+
+        // Pairs are only filtered together when both texels have the same tap count (every pair of even sizes)
+        if ((taps.Offsets[x + 2] - first1) != count)
+        {
+            _mm_storeu_ps(pDst + (size_t(x) * 4), FilterTexelSse41(pSrc, taps, x));
+            _mm_storeu_ps(pDst + (size_t(x + 1) * 4), FilterTexelSse41(pSrc, taps, x + 1));
+            continue;
+        }
+
+        __m256 sum = _mm256_setzero_ps();
+
+        for (uint32_t k = 0; k < count; k++)
+        {
+            const __m256 texels = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_loadu_ps(pSrc + (size_t(taps.Indices[first0 + k]) * 4))),
+                _mm_loadu_ps(pSrc + (size_t(taps.Indices[first1 + k]) * 4)), 1);
+            const __m256 weights = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_set1_ps(taps.Weights[first0 + k])), _mm_set1_ps(taps.Weights[first1 + k]),
+                1);
+
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(weights, texels));
+        }
+
+        _mm256_storeu_ps(pDst + (size_t(x) * 4), sum);
+    }
+
+    for (; x < dstWidth; x++)
+    {
+        _mm_storeu_ps(pDst + (size_t(x) * 4), FilterTexelSse41(pSrc, taps, x));
+    }
+}
+
+AR_TARGET_AVX2 static void AccumulateRowAvx2(
+    const float* pSrc, float weight, uint32_t count, float* pDst)
+{
+    const __m256 scale = _mm256_set1_ps(weight);
+    uint32_t     i     = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(pDst + i,
+                         _mm256_add_ps(_mm256_loadu_ps(pDst + i), _mm256_mul_ps(scale, _mm256_loadu_ps(pSrc + i))));
+    }
+
+    AccumulateRowScalar(pSrc + i, weight, count - i, pDst + i);
+}
+#endif
+
+//=====================================================================================================================
+// Returns the kernels of an instruction set, clamped to the supported one
+static const MipKernels& GetMipKernels(
+    ConvertIsa isa)
+{
+    const ConvertIsa supported = GetSupportedConvertIsa();
+
+    if ((isa == ConvertIsa::Auto) || (isa > supported))
+    {
+        isa = supported;
+    }
+
+    static const MipKernels ScalarKernels = { FilterRowScalar, AccumulateRowScalar };
+
+#if AR_SIMD_X86
+    static const MipKernels Sse41Kernels = { FilterRowSse41, AccumulateRowSse41 };
+    static const MipKernels Avx2Kernels  = { FilterRowAvx2, AccumulateRowAvx2 };
+
+    if (isa == ConvertIsa::Avx2)
+    {
+        return Avx2Kernels;
+    }
+
+    if (isa == ConvertIsa::Sse41)
+    {
+        return Sse41Kernels;
+    }
+#endif
+
+    return ScalarKernels;
+}
+
+//=====================================================================================================================
+// Destination rows of one slice of a mip level filtered by one worker
+struct MipTile
+{
+    uint32_t Slice;    ///< Array slice
+    uint32_t Z;        ///< Destination depth slice
+    uint32_t FirstRow; ///< First destination row
+    uint32_t RowCount; ///< Destination row count
+};
+
+//=====================================================================================================================
+// Returns whether GenerateMips can filter a format
+bool IsMipGenerationSupported(
+    DXGI_FORMAT format)
+{
+    return IsConversionSupported(format, FilterFormat) && IsConversionSupported(FilterFormat, format);
+}
+
+//=====================================================================================================================
+// Generates the mip chain of every array slice from mip 0 in upload footprint layout
+bool GenerateMips(
+    const ResourceBuilder& builder,
+    uint64_t               baseOffset,
+    void*                  pData,
+    MipFilter              filter,
+    uint32_t               threadCount,
+    ConvertIsa             isa)
+{
+    if ((builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) || (builder.SampleDesc.Count > 1) ||
+        (builder.GetPlaneCount() != 1) || (IsMipGenerationSupported(builder.Format) == false))
+    {
+        return false;
+    }
+
+    const uint32_t mipCount   = builder.GetMipCount();
+    const uint32_t sliceCount = (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? 1 : builder.GetArraySize();
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(size_t(mipCount) * sliceCount);
+    std::vector<uint32_t>                           numRows(size_t(mipCount) * sliceCount);
+
+    builder.GetCopyableFootprints(
+        0, mipCount * sliceCount, baseOffset, layouts.data(), numRows.data(), nullptr, nullptr);
+
+    const MipKernels& kernels = GetMipKernels(isa);
+    uint8_t*          pBytes  = static_cast<uint8_t*>(pData);
+
+    for (uint32_t mip = 1; mip < mipCount; mip++)
+    {
+        // Every array slice of a level has the same footprint dimensions
+        const D3D12_SUBRESOURCE_FOOTPRINT& src = layouts[mip - 1].Footprint;
+        const D3D12_SUBRESOURCE_FOOTPRINT& dst = layouts[mip].Footprint;
+
+        FilterTaps columnTaps;
+        FilterTaps rowTaps;
+        FilterTaps depthTaps;
+
+        BuildTaps(src.Width, dst.Width, filter, &columnTaps);
+        BuildTaps(src.Height, dst.Height, filter, &rowTaps);
+        BuildTaps(src.Depth, dst.Depth, filter, &depthTaps);
+
+        std::vector<MipTile> tiles;
+
+        for (uint32_t slice = 0; slice < sliceCount; slice++)
+        {
+            for (uint32_t z = 0; z < dst.Depth; z++)
+            {
+                for (uint32_t y = 0; y < dst.Height; y += RowsPerTile)
+                {
+                    tiles.push_back({ slice, z, y, std::min(RowsPerTile, dst.Height - y) });
+                }
+            }
+        }
+
+        ParallelFor(static_cast<uint32_t>(tiles.size()), threadCount, MinTilesPerThread,
+                    [&](uint32_t begin, uint32_t end)
+        {
+            const uint32_t dstStride = dst.Width * 4;
+
+            std::vector<float> decoded(size_t(src.Width) * 4);
+            std::vector<float> filtered;
+            std::vector<float> accumulated;
+
+            for (uint32_t t = begin; t < end; t++)
+            {
+                const MipTile&                            tile      = tiles[t];
+                const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& srcLayout = layouts[(mip - 1) + (tile.Slice * mipCount)];
+                const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& dstLayout = layouts[mip + (tile.Slice * mipCount)];
+
+                // Source rows read by the tile, each filtered horizontally once per depth tap
+                const uint32_t firstTap = rowTaps.Offsets[tile.FirstRow];
+                const uint32_t lastTap  = rowTaps.Offsets[tile.FirstRow + tile.RowCount];
+                const uint32_t lowRow   = *std::min_element(&rowTaps.Indices[firstTap], &rowTaps.Indices[lastTap]);
+                const uint32_t highRow  = *std::max_element(&rowTaps.Indices[firstTap], &rowTaps.Indices[lastTap]);
+
+                filtered.resize(size_t(highRow - lowRow + 1) * dstStride);
+                accumulated.assign(size_t(tile.RowCount) * dstStride, 0.0f);
+
+                for (uint32_t zt = depthTaps.Offsets[tile.Z]; zt < depthTaps.Offsets[tile.Z + 1]; zt++)
+                {
+                    const uint8_t* pSlice = pBytes + srcLayout.Offset +
+                                            (uint64_t(src.RowPitch) * src.Height * depthTaps.Indices[zt]);
+
+                    for (uint32_t y = lowRow; y <= highRow; y++)
+                    {
+                        ConvertRows(builder.Format, pSlice + (uint64_t(src.RowPitch) * y), 0, FilterFormat,
+                                    decoded.data(), 0, src.Width, 1, isa);
+                        kernels.FilterRow(decoded.data(), columnTaps, dst.Width,
+                                          filtered.data() + (size_t(y - lowRow) * dstStride));
+                    }
+
+                    for (uint32_t r = 0; r < tile.RowCount; r++)
+                    {
+                        const uint32_t row = tile.FirstRow + r;
+
+                        for (uint32_t yt = rowTaps.Offsets[row]; yt < rowTaps.Offsets[row + 1]; yt++)
+                        {
+                            kernels.AccumulateRow(filtered.data() + (size_t(rowTaps.Indices[yt] - lowRow) * dstStride),
+                                                  depthTaps.Weights[zt] * rowTaps.Weights[yt], dstStride,
+                                                  accumulated.data() + (size_t(r) * dstStride));
+                        }
+                    }
+                }
+
+                uint8_t* pDst = pBytes + dstLayout.Offset +
+                                (uint64_t(dst.RowPitch) * ((uint64_t(dst.Height) * tile.Z) + tile.FirstRow));
+
+                ConvertRows(FilterFormat, accumulated.data(), uint64_t(dstStride) * sizeof(float), builder.Format,
+                            pDst, dst.RowPitch, dst.Width, tile.RowCount, isa);
+            }
+        });
+    }
+
+    return true;
+}
+} // AR
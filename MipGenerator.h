@@ -0,0 +1,66 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "FormatConvert.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Downsampling filter used by GenerateMips
+enum class MipFilter : uint32_t
+{
+    Box    = 0, ///< Area-weighted box (two taps per axis for even sizes, three for odd sizes)
+    Kaiser = 1, ///< Kaiser-windowed sinc over three destination texels each side (sharper, may ring)
+};
+
+/// Returns whether GenerateMips can filter a format: formats ConvertRows converts to and from R32G32B32A32_FLOAT
+/// (RGBA8 and BGRA8/BGRX8 UNORM and sRGB, RGBA16F, RGB32F and RGBA32F). Typeless formats filter as their default view
+/// format.
+///
+/// @param format [in] Texture format
+///
+bool IsMipGenerationSupported(DXGI_FORMAT format);
+
+/// Generates mip levels 1 to GetMipCount() - 1 of every array slice from mip 0, in place in the layout of
+/// ResourceBuilder::GetCopyableFootprints over all subresources. Each level is filtered from the previous one in
+/// linear float: sRGB texels are decoded before filtering and encoded afterwards, so averages are gamma correct.
+/// Filters are separable and polyphase, so odd and non-power-of-two sizes are weighted by texel coverage; 3D textures
+/// are filtered along depth as well. Rows of every slice are split into tiles filtered across worker threads, one
+/// level after another. Every instruction set produces the same bits as the scalar kernels for finite texels.
+///
+/// @param builder     [in]     Resource description
+/// @param baseOffset  [in]     Offset of subresource 0 in the buffer
+/// @param pData       [in,out] Buffer start (footprint offsets are relative to it); mip 0 of every slice is read and
+///                             the other levels are written
+/// @param filter      [optional] Downsampling filter
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+/// @param isa         [optional] Kernel instruction set (clamped to the supported one)
+///
+/// Returns false when the builder is a buffer, multisampled, multi-plane or has an unsupported format. Nothing is
+/// written in that case.
+bool GenerateMips(
+    const ResourceBuilder& builder,
+    uint64_t               baseOffset,
+    void*                  pData,
+    MipFilter              filter      = MipFilter::Box,
+    uint32_t               threadCount = 0,
+    ConvertIsa             isa         = ConvertIsa::Auto);
+} // AR
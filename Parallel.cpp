@@ -0,0 +1,135 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "Parallel.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Initialise pool
+WorkerPool::WorkerPool()
+    :
+    m_busy(false),
+    m_workerCount(0),
+    m_generation(0),
+    m_wanted(0),
+    m_joined(0),
+    m_active(0),
+    m_chunkCount(0),
+    m_nextChunk(0),
+    m_pFunc(nullptr),
+    m_pContext(nullptr)
+{
+}
+
+//=====================================================================================================================
+// Returns the shared pool. The pool is never destroyed: its workers wait until the process exits, so no worker can
+// outlive other function-local statics (e.g. the instrumentation ring registry) during static destruction.
+WorkerPool& WorkerPool::Get()
+{
+    static WorkerPool* pPool = new WorkerPool();
+    return *pPool;
+}
+
+//=====================================================================================================================
+// Runs every chunk of a job on the calling thread and the workers
+bool WorkerPool::Run(
+    uint32_t chunkCount, uint32_t workerCount, ChunkFunc pFunc, const void* pContext)
+{
+    if (m_busy.exchange(true, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    workerCount = std::min(std::min(workerCount, MaxWorkers), (chunkCount > 0) ? chunkCount - 1 : 0);
+
+    // Only the thread running a job starts workers, so the vector is never grown concurrently
+    while (m_workers.size() < workerCount)
+    {
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+        m_workerCount.store(static_cast<uint32_t>(m_workers.size()), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_generation++;
+        m_wanted     = workerCount;
+        m_joined     = 0;
+        m_chunkCount = chunkCount;
+        m_pFunc      = pFunc;
+        m_pContext   = pContext;
+        m_nextChunk.store(0, std::memory_order_relaxed);
+    }
+
+    if (workerCount > 0)
+    {
+        m_wake.notify_all();
+    }
+
+    RunChunks();
+
+    // Every chunk is claimed; wait for the workers still running theirs, and keep late workers out of the job
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_done.wait(lock, [this]() { return m_active == 0; });
+        m_wanted = 0;
+    }
+
+    m_busy.store(false, std::memory_order_release);
+
+    return true;
+}
+
+//=====================================================================================================================
+// Waits for jobs and runs their chunks
+void WorkerPool::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    uint64_t                     generation = 0;
+
+    while (true)
+    {
+        m_wake.wait(lock, [&]() { return (m_generation != generation) && (m_joined < m_wanted); });
+
+        generation = m_generation;
+        m_joined++;
+        m_active++;
+
+        lock.unlock();
+        RunChunks();
+        lock.lock();
+
+        if (--m_active == 0)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+//=====================================================================================================================
+// Claims and runs chunks of the current job until none are left
+void WorkerPool::RunChunks()
+{
+    for (uint32_t chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < m_chunkCount;
+         chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed))
+    {
+        m_pFunc(m_pContext, chunk);
+    }
+}
+} // AR
@@ -0,0 +1,135 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#undef min
+#undef max
+
+namespace AR {
+
+//=====================================================================================================================
+// Persistent worker threads shared by every ParallelFor call. Workers are started on demand, up to the largest worker
+// count requested, and then wait for jobs until the process exits, so a parallel loop costs a wake-up per worker
+// rather than a thread creation and join. One job runs at a time: a job started while another is running (from
+// another thread, or from inside a chunk of the running job) is refused and the caller runs it on its own thread.
+class WorkerPool
+{
+public:
+    /// Runs one chunk of a job
+    using ChunkFunc = void (*)(const void* pContext, uint32_t chunk);
+
+    /// Most worker threads the pool starts
+    static constexpr uint32_t MaxWorkers = 256;
+
+    /// Returns the shared pool
+    static WorkerPool& Get();
+
+    /// Returns the number of worker threads started so far
+    uint32_t GetWorkerCount() const { return m_workerCount.load(std::memory_order_relaxed); }
+
+    /// Runs pFunc(pContext, chunk) for every chunk in [0, chunkCount) on the calling thread and up to workerCount
+    /// workers, which claim chunks as they become free. Returns once every chunk finished, or false without running
+    /// anything when another job is running.
+    bool Run(uint32_t chunkCount, uint32_t workerCount, ChunkFunc pFunc, const void* pContext);
+
+private:
+    WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// @internal Waits for jobs and runs their chunks
+    void WorkerLoop();
+
+    /// @internal Claims and runs chunks of the current job until none are left
+    void RunChunks();
+
+    std::atomic<bool>        m_busy;        ///< A job is running
+    std::atomic<uint32_t>    m_workerCount; ///< Started worker threads
+    std::vector<std::thread> m_workers;     ///< Worker threads (only grown by the thread running a job)
+    std::mutex               m_lock;        ///< Guards the job fields below
+    std::condition_variable  m_wake;        ///< Signals workers that a job started
+    std::condition_variable  m_done;        ///< Signals the job owner that the last worker left the job
+    uint64_t                 m_generation;  ///< Incremented per job so workers join each job once
+    uint32_t                 m_wanted;      ///< Workers the current job may use
+    uint32_t                 m_joined;      ///< Workers that joined the current job
+    uint32_t                 m_active;      ///< Workers still running chunks of the current job
+    uint32_t                 m_chunkCount;  ///< Chunks of the current job
+    std::atomic<uint32_t>    m_nextChunk;   ///< Next unclaimed chunk of the current job
+    ChunkFunc                m_pFunc;       ///< Chunk function of the current job
+    const void*              m_pContext;    ///< Chunk function context of the current job
+};
+
+//=====================================================================================================================
+// Runs func(begin, end) over [0, count) split into contiguous chunks across the shared WorkerPool. The calling thread
+// processes chunks too. A thread count of zero selects the hardware concurrency; chunks are never smaller than
+// minItemsPerThread so small batches stay on the calling thread, as do calls made while the pool is busy.
+template <typename Func>
+void ParallelFor(
+    uint32_t count, uint32_t threadCount, uint32_t minItemsPerThread, const Func& func)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const uint32_t maxThreads = std::max(1u, count / std::max(1u, minItemsPerThread));
+    threadCount               = std::min(threadCount, maxThreads);
+
+    if (threadCount <= 1)
+    {
+        if (count > 0)
+        {
+            func(0u, count);
+        }
+        return;
+    }
+
+    struct Job
+    {
+        const Func* pFunc;
+        uint32_t    Count;
+        uint32_t    ChunkSize;
+    };
+
+    const uint32_t chunkSize = (count + threadCount - 1) / threadCount;
+    const Job      job       = { &func, count, chunkSize };
+
+    const WorkerPool::ChunkFunc runChunk = [](const void* pContext, uint32_t chunk)
+    {
+        const Job&     job   = *static_cast<const Job*>(pContext);
+        const uint32_t begin = chunk * job.ChunkSize;
+        (*job.pFunc)(begin, std::min(job.Count, begin + job.ChunkSize));
+    };
+
+    if (WorkerPool::Get().Run((count + chunkSize - 1) / chunkSize, threadCount - 1, runChunk, &job) == false)
+    {
+        func(0u, count);
+    }
+}
+} // AR
@@ -0,0 +1,373 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "RenderTargetPool.h"
+#include <cstring>
+
+namespace AR {
+
+// Index terminating the idle LRU list
+static constexpr uint32_t InvalidEntry = UINT32_MAX;
+
+//=====================================================================================================================
+// Builds the pool key of a resource description
+PoolKey MakePoolKey(
+    const ResourceBuilder& builder)
+{
+    const D3D12_HEAP_PROPERTIES HeapProperties = builder.GetHeapProperties();
+
+    PoolKey key = {};
+    key.Width            = builder.Width;
+    key.Alignment        = builder.GetAllocationInfo().Alignment;
+    key.Height           = builder.Height;
+    key.DepthOrArraySize = builder.DepthOrArraySize;
+    key.MipLevels        = builder.GetMipCount();
+    key.Format           = builder.Format;
+    key.SampleCount      = builder.SampleDesc.Count;
+    key.SampleQuality    = builder.SampleDesc.Quality;
+    key.Dimension        = static_cast<uint32_t>(builder.Dimension) | (static_cast<uint32_t>(builder.Layout) << 8);
+    key.Flags            = builder.Flags;
+    key.Heap             = static_cast<uint32_t>(HeapProperties.Type) |
+                           (static_cast<uint32_t>(HeapProperties.CPUPageProperty) << 8) |
+                           (static_cast<uint32_t>(HeapProperties.MemoryPoolPreference) << 16);
+    key.HeapFlags        = builder.GetHeapFlags();
+
+    return key;
+}
+
+//=====================================================================================================================
+// Returns the stable 64-bit hash of a pool key
+uint64_t HashPoolKey(
+    const PoolKey& key)
+{
+    static_assert(sizeof(PoolKey) == 56, "PoolKey must not contain padding");
+
+    uint8_t bytes[sizeof(PoolKey)] = {};
+    std::memcpy(bytes, &key, sizeof(key));
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (uint8_t byte : bytes)
+    {
+        hash = (hash ^ byte) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+//=====================================================================================================================
+// Initialise pool
+RenderTargetPool::RenderTargetPool(
+    ID3D12Device* pDevice, uint64_t budgetBytes)
+    :
+    m_pDevice(pDevice),
+    m_budget(budgetBytes),
+    m_completedFence(0),
+    m_lruHead(InvalidEntry),
+    m_lruTail(InvalidEntry),
+    m_stats()
+{
+}
+
+//=====================================================================================================================
+// Destroys every idle resource
+RenderTargetPool::~RenderTargetPool()
+{
+    for (uint32_t index = m_lruHead; index != InvalidEntry; index = m_entries[index].LruNext)
+    {
+        m_entries[index].pResource->Release();
+    }
+}
+
+//=====================================================================================================================
+// Returns an idle resource with a matching description, or creates a committed resource
+HRESULT RenderTargetPool::Acquire(
+    const ResourceBuilder&   builder,
+    D3D12_RESOURCE_STATES    initialState,
+    const D3D12_CLEAR_VALUE* pClearValue,
+    ID3D12Resource**         ppResource,
+    D3D12_RESOURCE_STATES*   pCurrentState)
+{
+    if (ppResource == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    const PoolKey  key  = MakePoolKey(builder);
+    const uint64_t hash = HashPoolKey(key);
+
+    m_stats.AcquireCount++;
+
+    // Prefer the most recently released match: least recently released entries are the eviction candidates
+    uint32_t found = InvalidEntry;
+    auto     range = m_idle.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const Entry& entry = m_entries[it->second];
+
+        if ((entry.FenceValue <= m_completedFence) &&
+            (std::memcmp(&entry.Key, &key, sizeof(key)) == 0) &&
+            ((found == InvalidEntry) || (entry.FenceValue >= m_entries[found].FenceValue)))
+        {
+            found = it->second;
+        }
+    }
+
+    if (found != InvalidEntry)
+    {
+        Entry& entry = m_entries[found];
+
+        Unlink(found);
+        m_inUse.emplace(entry.pResource, found);
+
+        m_stats.HitCount++;
+        m_stats.WastedBytes -= entry.SizeBytes;
+        m_stats.InUseBytes  += entry.SizeBytes;
+
+        *ppResource = entry.pResource;
+
+        if (pCurrentState != nullptr)
+        {
+            *pCurrentState = entry.State;
+        }
+
+        return S_OK;
+    }
+
+    m_stats.MissCount++;
+
+    // Make room for the new resource before creating it
+    const uint64_t sizeBytes = builder.GetAllocationInfo().SizeInBytes;
+    Evict((sizeBytes < m_budget) ? (m_budget - sizeBytes) : 0);
+
+    const D3D12_HEAP_PROPERTIES HeapProperties = builder.GetHeapProperties();
+    ID3D12Resource*             pResource      = nullptr;
+    HRESULT                     hr             = m_pDevice->CreateCommittedResource(
+        &HeapProperties, builder.GetHeapFlags(), &builder, initialState, pClearValue, IID_PPV_ARGS(&pResource));
+
+    if (hr == S_OK)
+    {
+        AddInUse(pResource, key, hash, sizeBytes);
+
+        *ppResource = pResource;
+
+        if (pCurrentState != nullptr)
+        {
+            *pCurrentState = initialState;
+        }
+    }
+    else
+    {
+        *ppResource = nullptr;
+    }
+
+    return hr;
+}
+
+//=====================================================================================================================
+// Hands a resource created by the caller to the pool as an acquired resource
+void RenderTargetPool::Adopt(
+    ID3D12Resource* pResource, const ResourceBuilder& builder)
+{
+    const PoolKey key = MakePoolKey(builder);
+
+    AddInUse(pResource, key, HashPoolKey(key), builder.GetAllocationInfo().SizeInBytes);
+    Evict(m_budget);
+}
+
+//=====================================================================================================================
+// Returns an acquired resource to the pool
+bool RenderTargetPool::Release(
+    ID3D12Resource* pResource, D3D12_RESOURCE_STATES currentState, uint64_t fenceValue)
+{
+    auto it = m_inUse.find(pResource);
+
+    if (it == m_inUse.end())
+    {
+        return false;
+    }
+
+    const uint32_t index = it->second;
+    Entry&         entry = m_entries[index];
+
+    m_inUse.erase(it);
+
+    entry.FenceValue = fenceValue;
+    entry.State      = currentState;
+    entry.LruPrev    = m_lruTail;
+    entry.LruNext    = InvalidEntry;
+
+    if (m_lruTail != InvalidEntry)
+    {
+        m_entries[m_lruTail].LruNext = index;
+    }
+    else
+    {
+        m_lruHead = index;
+    }
+
+    m_lruTail = index;
+    m_idle.emplace(entry.Hash, index);
+
+    m_stats.InUseBytes  -= entry.SizeBytes;
+    m_stats.WastedBytes += entry.SizeBytes;
+
+    Evict(m_budget);
+
+    return true;
+}
+
+//=====================================================================================================================
+// Makes completed resources reusable and evicts idle resources beyond the budget
+void RenderTargetPool::BeginFrame(
+    uint64_t completedFenceValue)
+{
+    m_completedFence = completedFenceValue;
+
+    Evict(m_budget);
+}
+
+//=====================================================================================================================
+// Sets the memory budget and evicts idle resources beyond it
+void RenderTargetPool::SetBudget(
+    uint64_t budgetBytes)
+{
+    m_budget = budgetBytes;
+
+    Evict(m_budget);
+}
+
+//=====================================================================================================================
+// Destroys every idle resource whose fence value completed
+void RenderTargetPool::Trim()
+{
+    Evict(0);
+}
+
+//=====================================================================================================================
+// Returns the fraction of acquires served by a pooled resource
+double RenderTargetPool::GetHitRate() const
+{
+    return (m_stats.AcquireCount != 0) ?
+           (static_cast<double>(m_stats.HitCount) / static_cast<double>(m_stats.AcquireCount)) : 0.0;
+}
+
+//=====================================================================================================================
+// Adds an acquired entry
+void RenderTargetPool::AddInUse(
+    ID3D12Resource* pResource, const PoolKey& key, uint64_t hash, uint64_t sizeBytes)
+{
+    uint32_t index = 0;
+
+    if (m_freeEntries.empty() == false)
+    {
+        index = m_freeEntries.back();
+        m_freeEntries.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[index];
+    entry.pResource  = pResource;
+    entry.Key        = key;
+    entry.Hash       = hash;
+    entry.SizeBytes  = sizeBytes;
+    entry.FenceValue = 0;
+    entry.State      = D3D12_RESOURCE_STATE_COMMON;
+    entry.LruPrev    = InvalidEntry;
+    entry.LruNext    = InvalidEntry;
+
+    m_inUse.emplace(pResource, index);
+
+    m_stats.InUseBytes += sizeBytes;
+    m_stats.PeakBytes   = (GetTotalBytes() > m_stats.PeakBytes) ? GetTotalBytes() : m_stats.PeakBytes;
+}
+
+//=====================================================================================================================
+// Unlinks an idle entry from the LRU list and its key bucket
+void RenderTargetPool::Unlink(
+    uint32_t index)
+{
+    Entry& entry = m_entries[index];
+
+    if (entry.LruPrev != InvalidEntry)
+    {
+        m_entries[entry.LruPrev].LruNext = entry.LruNext;
+    }
+    else
+    {
+        m_lruHead = entry.LruNext;
+    }
+
+    if (entry.LruNext != InvalidEntry)
+    {
+        m_entries[entry.LruNext].LruPrev = entry.LruPrev;
+    }
+    else
+    {
+        m_lruTail = entry.LruPrev;
+    }
+
+    entry.LruPrev = InvalidEntry;
+    entry.LruNext = InvalidEntry;
+
+    auto range = m_idle.equal_range(entry.Hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == index)
+        {
+            m_idle.erase(it);
+            break;
+        }
+    }
+}
+
+//=====================================================================================================================
+// Destroys completed idle entries, least recently released first, until at most targetBytes are held
+void RenderTargetPool::Evict(
+    uint64_t targetBytes)
+{
+    uint32_t index = m_lruHead;
+
+    while ((index != InvalidEntry) && (GetTotalBytes() > targetBytes))
+    {
+        Entry&         entry = m_entries[index];
+        const uint32_t next  = entry.LruNext;
+
+        // Resources the GPU may still use are skipped
+        if (entry.FenceValue <= m_completedFence)
+        {
+            Unlink(index);
+            entry.pResource->Release();
+            entry.pResource = nullptr;
+            m_freeEntries.push_back(index);
+
+            m_stats.EvictionCount++;
+            m_stats.WastedBytes -= entry.SizeBytes;
+        }
+
+        index = next;
+    }
+}
+} // AR
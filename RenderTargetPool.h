@@ -0,0 +1,184 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <unordered_map>
+#include <vector>
+
+namespace AR {
+
+//=====================================================================================================================
+// Canonical pool identity of a resource description. Keys are built field by field from the builder, with the mip
+// count and placement alignment resolved, so equivalent descriptions (e.g. MipLevels 0 and the full chain) share a
+// key. The optimized clear value is not part of the key.
+struct PoolKey
+{
+    uint64_t Width;            ///< Width (buffer size in bytes)
+    uint64_t Alignment;        ///< Resolved placement alignment
+    uint32_t Height;           ///< Height
+    uint32_t DepthOrArraySize; ///< Depth or array size
+    uint32_t MipLevels;        ///< Resolved mip count
+    uint32_t Format;           ///< Resource format
+    uint32_t SampleCount;      ///< Sample count
+    uint32_t SampleQuality;    ///< Sample quality
+    uint32_t Dimension;        ///< Resource dimension (bits 0-7), texture layout (bits 8-15)
+    uint32_t Flags;            ///< Resource flags
+    uint32_t Heap;             ///< Heap type (bits 0-7), CPU page property (bits 8-15), memory pool (bits 16-23)
+    uint32_t HeapFlags;        ///< Heap flags
+};
+
+/// Builds the pool key of a resource description
+///
+/// @param builder [in] Resource builder
+///
+PoolKey MakePoolKey(const ResourceBuilder& builder);
+
+/// Returns the stable 64-bit hash of a pool key (FNV-1a over the key fields)
+uint64_t HashPoolKey(const PoolKey& key);
+
+//=====================================================================================================================
+// Render target pool statistics
+struct RenderTargetPoolStats
+{
+    uint64_t AcquireCount;  ///< Acquire calls
+    uint64_t HitCount;      ///< Acquires served by a pooled resource
+    uint64_t MissCount;     ///< Acquires that created a resource
+    uint64_t EvictionCount; ///< Idle resources destroyed to stay within the budget
+    uint64_t InUseBytes;    ///< Bytes of acquired resources
+    uint64_t WastedBytes;   ///< Bytes held by idle resources (memory the pool keeps that nothing uses)
+    uint64_t PeakBytes;     ///< Largest total of in-use and idle bytes
+};
+
+//=====================================================================================================================
+// Pool of transient render targets (or any other resources) keyed by their ResourceBuilder description. Released
+// resources are kept idle until the fence value signalled after their last GPU use completes, then handed back to
+// the next Acquire with a matching key, so recreating targets with the same description (resolution changes,
+// post-process toggles) does not create resources. Idle resources are evicted least recently released first once
+// the pool holds more than its memory budget. Sizes are estimated with ResourceBuilder::GetAllocationInfo. The pool
+// is not thread-safe.
+class RenderTargetPool
+{
+public:
+    /// Initialise pool
+    ///
+    /// @param pDevice     [in] Device used to create committed resources (must outlive the pool)
+    /// @param budgetBytes [optional] Memory budget in bytes
+    ///
+    explicit RenderTargetPool(ID3D12Device* pDevice, uint64_t budgetBytes = 256ull << 20);
+
+    /// Destroys every idle resource (resources still acquired stay owned by the caller)
+    ~RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&)            = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    /// Returns an idle resource with a matching description, or creates a committed resource on a miss. The caller
+    /// owns the returned reference until Release.
+    ///
+    /// @param builder       [in]  Resource description (heap properties and flags select the heap)
+    /// @param initialState  [in]  State of a newly created resource
+    /// @param pClearValue   [in]  Optional optimized clear value of a newly created resource
+    /// @param ppResource    [out] Resource
+    /// @param pCurrentState [out] Optional state of the resource (the state it was released in on a hit)
+    ///
+    HRESULT Acquire(
+        const ResourceBuilder&   builder,
+        D3D12_RESOURCE_STATES    initialState,
+        const D3D12_CLEAR_VALUE* pClearValue,
+        ID3D12Resource**         ppResource,
+        D3D12_RESOURCE_STATES*   pCurrentState = nullptr);
+
+    /// Hands a resource created by the caller (e.g. a placed resource) to the pool as an acquired resource. The pool
+    /// takes over the caller's reference.
+    ///
+    /// @param pResource [in] Resource
+    /// @param builder   [in] Resource description
+    ///
+    void Adopt(ID3D12Resource* pResource, const ResourceBuilder& builder);
+
+    /// Returns an acquired resource to the pool. Returns false when the resource was not acquired from the pool.
+    ///
+    /// @param pResource    [in] Resource
+    /// @param currentState [in] State the resource is left in
+    /// @param fenceValue   [in] Fence value signalled after the last GPU use of the resource
+    ///
+    bool Release(ID3D12Resource* pResource, D3D12_RESOURCE_STATES currentState, uint64_t fenceValue);
+
+    /// Makes resources released with fence values up to the completed value reusable and evicts idle resources
+    /// beyond the budget
+    ///
+    /// @param completedFenceValue [in] Last completed fence value
+    ///
+    void BeginFrame(uint64_t completedFenceValue);
+
+    /// Sets the memory budget and evicts idle resources beyond it
+    ///
+    /// @param budgetBytes [in] Memory budget in bytes
+    ///
+    void SetBudget(uint64_t budgetBytes);
+
+    /// Destroys every idle resource whose fence value completed
+    void Trim();
+
+    /// Returns pool statistics
+    const RenderTargetPoolStats& GetStats() const { return m_stats; }
+
+    /// Returns the fraction of acquires served by a pooled resource
+    double GetHitRate() const;
+
+private:
+    /// @internal Pooled resource
+    struct Entry
+    {
+        ID3D12Resource*       pResource;  ///< Resource (nullptr when the entry is free)
+        PoolKey               Key;        ///< Description key
+        uint64_t              Hash;       ///< Key hash
+        uint64_t              SizeBytes;  ///< Estimated size
+        uint64_t              FenceValue; ///< Fence value of the last release
+        D3D12_RESOURCE_STATES State;      ///< State the resource was released in
+        uint32_t              LruPrev;    ///< Previous (less recently released) idle entry
+        uint32_t              LruNext;    ///< Next (more recently released) idle entry
+    };
+
+    /// @internal Adds an acquired entry
+    void AddInUse(ID3D12Resource* pResource, const PoolKey& key, uint64_t hash, uint64_t sizeBytes);
+
+    /// @internal Unlinks an idle entry from the LRU list and its key bucket
+    void Unlink(uint32_t index);
+
+    /// @internal Destroys completed idle entries, least recently released first, until at most targetBytes are held
+    void Evict(uint64_t targetBytes);
+
+    /// @internal Returns the total of in-use and idle bytes
+    uint64_t GetTotalBytes() const { return m_stats.InUseBytes + m_stats.WastedBytes; }
+
+    ID3D12Device*                                   m_pDevice;        ///< Device
+    uint64_t                                        m_budget;         ///< Memory budget in bytes
+    uint64_t                                        m_completedFence; ///< Last completed fence value
+    std::vector<Entry>                              m_entries;        ///< Entry storage
+    std::vector<uint32_t>                           m_freeEntries;    ///< Unused entry indices
+    std::unordered_multimap<uint64_t, uint32_t>     m_idle;           ///< Idle entries by key hash
+    std::unordered_map<ID3D12Resource*, uint32_t>   m_inUse;          ///< Acquired entries by resource
+    uint32_t                                        m_lruHead;        ///< Least recently released idle entry
+    uint32_t                                        m_lruTail;        ///< Most recently released idle entry
+    RenderTargetPoolStats                           m_stats;          ///< Statistics
+};
+} // AR
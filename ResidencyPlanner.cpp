@@ -0,0 +1,224 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "ResidencyPlanner.h"
+#include <algorithm>
+
+namespace AR {
+
+//=====================================================================================================================
+// Initialise planner
+ResidencyPlanner::ResidencyPlanner(
+    const ResourceBuilder& builder)
+    :
+    m_width(builder.Width),
+    m_height(builder.Height),
+    m_depth((builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? builder.DepthOrArraySize : 1u),
+    m_mipCount(builder.GetMipCount()),
+    m_arraySize(builder.GetArraySize()),
+    m_tileCount(0),
+    m_sliceTiles(0),
+    m_tileShape(),
+    m_packedMips(),
+    m_tilings(m_mipCount * m_arraySize)
+{
+    uint32_t tilingCount = static_cast<uint32_t>(m_tilings.size());
+
+    builder.GetResourceTiling(&m_tileCount, &m_packedMips, &m_tileShape, &tilingCount, 0, m_tilings.data());
+
+    m_tilings.resize(tilingCount);
+    m_sliceTiles = (m_tileCount != 0) ? (m_tileCount / m_arraySize) : 0;
+}
+
+//=====================================================================================================================
+// Appends the tiles covering a set of requests to a list
+uint32_t ResidencyPlanner::GetTiles(
+    const TileRequest*         pRequests,
+    uint32_t                   count,
+    bool                       includeCoarserMips,
+    std::vector<ResidentTile>* pTiles
+    ) const
+{
+    const size_t first = pTiles->size();
+
+    for (uint32_t i = 0; (i < count) && (m_tileCount != 0); i++)
+    {
+        const TileRequest& request = pRequests[i];
+
+        if ((request.Mip >= m_mipCount) || (request.ArraySlice >= m_arraySize))
+        {
+            continue;
+        }
+
+        // Coarser mips stop at the first packed mip, which maps every packed tile of the slice
+        const uint32_t lastMip = includeCoarserMips ?
+            std::max(request.Mip, std::min<uint32_t>(m_mipCount - 1, m_packedMips.NumStandardMips)) : request.Mip;
+
+        for (uint32_t mip = request.Mip; mip <= lastMip; mip++)
+        {
+            const uint32_t shift = mip - request.Mip;
+            const uint32_t round = (1u << shift) - 1;
+
+            // Round the region outwards so every texel footprint of the finer mip stays covered. Ends are rounded in
+            // 64 bits so regions reaching UINT32_MAX do not wrap.
+            const auto roundUp = [=](uint32_t end) { return static_cast<uint32_t>((uint64_t(end) + round) >> shift); };
+
+            D3D12_BOX region = request.Region;
+            region.left   = region.left >> shift;
+            region.top    = region.top >> shift;
+            region.front  = (m_depth > 1) ? (region.front >> shift) : region.front;
+            region.right  = roundUp(region.right);
+            region.bottom = roundUp(region.bottom);
+            region.back   = (m_depth > 1) ? roundUp(region.back) : region.back;
+
+            AddRegion(mip, request.ArraySlice, region, pTiles);
+        }
+    }
+
+    const auto begin = pTiles->begin() + first;
+
+    std::sort(begin, pTiles->end(), [](const ResidentTile& lhs, const ResidentTile& rhs)
+    {
+        return lhs.TileIndex < rhs.TileIndex;
+    });
+
+    pTiles->erase(std::unique(begin, pTiles->end(), [](const ResidentTile& lhs, const ResidentTile& rhs)
+    {
+        return lhs.TileIndex == rhs.TileIndex;
+    }), pTiles->end());
+
+    return static_cast<uint32_t>(pTiles->size() - first);
+}
+
+//=====================================================================================================================
+// Merges tiles with consecutive indices in the same subresource into tile regions
+uint32_t ResidencyPlanner::BuildTileRegions(
+    const ResidentTile*                           pTiles,
+    uint32_t                                      count,
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE>* pCoordinates,
+    std::vector<D3D12_TILE_REGION_SIZE>*          pRegionSizes)
+{
+    uint32_t regionCount = 0;
+
+    for (uint32_t i = 0; i < count;)
+    {
+        uint32_t runEnd = i + 1;
+
+        // Linear tile order within a subresource matches the UseBox = FALSE traversal of UpdateTileMappings
+        while ((runEnd < count) &&
+               (pTiles[runEnd].TileIndex == pTiles[runEnd - 1].TileIndex + 1) &&
+               (pTiles[runEnd].Coordinate.Subresource == pTiles[i].Coordinate.Subresource))
+        {
+            runEnd++;
+        }
+
+        D3D12_TILE_REGION_SIZE Size = {};
+        Size.NumTiles = runEnd - i;
+        Size.UseBox   = FALSE;
+
+        pCoordinates->push_back(pTiles[i].Coordinate);
+        pRegionSizes->push_back(Size);
+
+        regionCount++;
+        i = runEnd;
+    }
+
+    return regionCount;
+}
+
+//=====================================================================================================================
+// Appends the tiles of one mip region
+void ResidencyPlanner::AddRegion(
+    uint32_t                   mip,
+    uint32_t                   slice,
+    const D3D12_BOX&           region,
+    std::vector<ResidentTile>* pTiles
+    ) const
+{
+    if (mip >= m_packedMips.NumStandardMips)
+    {
+        AddPackedTiles(slice, pTiles);
+        return;
+    }
+
+    const uint32_t                  subresource = slice * m_mipCount + mip;
+    const D3D12_SUBRESOURCE_TILING& tiling      = m_tilings[subresource];
+
+    const uint64_t width  = std::max<uint64_t>(1, m_width >> mip);
+    const uint32_t height = std::max(1u, m_height >> mip);
+    const uint32_t depth  = std::max(1u, m_depth >> mip);
+
+    // Axes with an empty range select the whole mip extent
+    const uint64_t left   = (region.right > region.left) ? region.left : 0;
+    const uint64_t right  = (region.right > region.left) ? std::min<uint64_t>(region.right, width) : width;
+    const uint32_t top    = (region.bottom > region.top) ? region.top : 0;
+    const uint32_t bottom = (region.bottom > region.top) ? std::min(region.bottom, height) : height;
+    const uint32_t front  = (region.back > region.front) ? region.front : 0;
+    const uint32_t back   = (region.back > region.front) ? std::min(region.back, depth) : depth;
+
+    if ((left >= right) || (top >= bottom) || (front >= back))
+    {
+        return;
+    }
+
+    const uint32_t beginX = static_cast<uint32_t>(left / m_tileShape.WidthInTexels);
+    const uint32_t endX   = static_cast<uint32_t>((right - 1) / m_tileShape.WidthInTexels);
+    const uint32_t beginY = top / m_tileShape.HeightInTexels;
+    const uint32_t endY   = (bottom - 1) / m_tileShape.HeightInTexels;
+    const uint32_t beginZ = front / m_tileShape.DepthInTexels;
+    const uint32_t endZ   = (back - 1) / m_tileShape.DepthInTexels;
+
+    for (uint32_t z = beginZ; z <= endZ; z++)
+    {
+        for (uint32_t y = beginY; y <= endY; y++)
+        {
+            for (uint32_t x = beginX; x <= endX; x++)
+            {
+                ResidentTile Tile = {};
+                Tile.Coordinate.X           = x;
+                Tile.Coordinate.Y           = y;
+                Tile.Coordinate.Z           = z;
+                Tile.Coordinate.Subresource = subresource;
+                Tile.TileIndex = tiling.StartTileIndexInOverallResource +
+                                 (z * tiling.HeightInTiles + y) * tiling.WidthInTiles + x;
+
+                pTiles->push_back(Tile);
+            }
+        }
+    }
+}
+
+//=====================================================================================================================
+// Appends every packed tile of an array slice
+void ResidencyPlanner::AddPackedTiles(
+    uint32_t                   slice,
+    std::vector<ResidentTile>* pTiles
+    ) const
+{
+    for (uint32_t i = 0; i < m_packedMips.NumTilesForPackedMips; i++)
+    {
+        ResidentTile Tile = {};
+        Tile.Coordinate.X           = i;
+        Tile.Coordinate.Subresource = slice * m_mipCount + m_packedMips.NumStandardMips;
+        Tile.TileIndex              = slice * m_sliceTiles + m_packedMips.StartTileIndexInOverallResource + i;
+
+        pTiles->push_back(Tile);
+    }
+}
+} // AR
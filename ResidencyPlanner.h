@@ -0,0 +1,121 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <vector>
+
+namespace AR {
+
+//=====================================================================================================================
+// Region of a mip requested resident
+struct TileRequest
+{
+    uint32_t  Mip;        ///< Mip level
+    uint32_t  ArraySlice; ///< Array slice (0 for 3D textures and buffers)
+    D3D12_BOX Region;     ///< Texel region of the mip (bytes for buffers); an empty box selects the whole mip
+};
+
+//=====================================================================================================================
+// Tile that must be mapped to satisfy a set of tile requests
+struct ResidentTile
+{
+    D3D12_TILED_RESOURCE_COORDINATE Coordinate; ///< Tile coordinate (packed tiles use the first packed subresource)
+    uint32_t                        TileIndex;  ///< Tile index in the overall resource
+};
+
+//=====================================================================================================================
+// Residency planner for reserved resources. Maps mip regions requested by a texture streamer to the tiles that have to
+// be resident and merges them into regions for ID3D12CommandQueue::UpdateTileMappings. The tiling is computed once on
+// the CPU with ResourceBuilder::GetResourceTiling.
+class ResidencyPlanner
+{
+public:
+    /// Initialise planner
+    ///
+    /// @param builder [in] Reserved resource description
+    ///
+    explicit ResidencyPlanner(const ResourceBuilder& builder);
+
+    /// Returns the tile count of the resource
+    uint32_t GetTileCount() const { return m_tileCount; }
+
+    /// Returns the standard tile shape (zero when the resource cannot be tiled)
+    const D3D12_TILE_SHAPE& GetTileShape() const { return m_tileShape; }
+
+    /// Returns the packed mip description
+    const D3D12_PACKED_MIP_INFO& GetPackedMipInfo() const { return m_packedMips; }
+
+    /// Returns the tiling of a subresource (packed mips report D3D12_PACKED_TILE)
+    ///
+    /// @param subresource [in] Subresource index
+    ///
+    const D3D12_SUBRESOURCE_TILING& GetSubresourceTiling(uint32_t subresource) const { return m_tilings[subresource]; }
+
+    /// Appends the tiles covering a set of requests to a list. The appended tiles are sorted by tile index and
+    /// de-duplicated. Requests for a packed mip select every packed tile of the array slice.
+    ///
+    /// @param pRequests          [in]  Request array
+    /// @param count              [in]  Request count
+    /// @param includeCoarserMips [in]  Also select the tiles covering the region in every coarser mip
+    /// @param pTiles             [out] Tile list to append to
+    ///
+    /// @returns Number of tiles appended
+    ///
+    uint32_t GetTiles(
+        const TileRequest*         pRequests,
+        uint32_t                   count,
+        bool                       includeCoarserMips,
+        std::vector<ResidentTile>* pTiles) const;
+
+    /// Merges tiles with consecutive indices in the same subresource into tile regions for UpdateTileMappings
+    ///
+    /// @param pTiles        [in]  Tile array sorted by tile index
+    /// @param count         [in]  Tile count
+    /// @param pCoordinates  [out] Region start coordinates to append to
+    /// @param pRegionSizes  [out] Region sizes to append to (UseBox is FALSE)
+    ///
+    /// @returns Number of regions appended
+    ///
+    static uint32_t BuildTileRegions(
+        const ResidentTile*                           pTiles,
+        uint32_t                                      count,
+        std::vector<D3D12_TILED_RESOURCE_COORDINATE>* pCoordinates,
+        std::vector<D3D12_TILE_REGION_SIZE>*          pRegionSizes);
+
+private:
+    /// @internal Appends the tiles of one mip region
+    void AddRegion(uint32_t mip, uint32_t slice, const D3D12_BOX& region, std::vector<ResidentTile>* pTiles) const;
+
+    /// @internal Appends every packed tile of an array slice
+    void AddPackedTiles(uint32_t slice, std::vector<ResidentTile>* pTiles) const;
+
+    uint64_t                              m_width;      ///< Mip 0 width (bytes for buffers)
+    uint32_t                              m_height;     ///< Mip 0 height
+    uint32_t                              m_depth;      ///< Mip 0 depth
+    uint32_t                              m_mipCount;   ///< Mip count
+    uint32_t                              m_arraySize;  ///< Array size
+    uint32_t                              m_tileCount;  ///< Tiles in the overall resource
+    uint32_t                              m_sliceTiles; ///< Tiles per array slice (standard and packed)
+    D3D12_TILE_SHAPE                      m_tileShape;  ///< Standard tile shape
+    D3D12_PACKED_MIP_INFO                 m_packedMips; ///< Packed mip description
+    std::vector<D3D12_SUBRESOURCE_TILING> m_tilings;    ///< Per-subresource tiling
+};
+} // AR
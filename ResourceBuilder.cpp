@@ -26,344 +26,208 @@ namespace AR {
 
 //=====================================================================================================================
 // Initialise builder from existing resource
-D3D12_RESOURCE_DESC& ResourceBuilder::FromExistingResource(
+ResourceBuilder& ResourceBuilder::FromExistingResource(
     ID3D12Resource* pResource)
 {
+    AR_INSTRUMENT(FromExistingResource);
+
     if (pResource != nullptr)
     {
+        *this = ResourceBuilder{};
         *(D3D12_RESOURCE_DESC*)this = pResource->GetDesc();
-        HRESULT hr = pResource->GetHeapProperties(&this->HeapProperties, &this->HeapFlags);
 
-        if (hr == S_OK)
+        D3D12_HEAP_PROPERTIES HeapProperties = {};
+        D3D12_HEAP_FLAGS      HeapFlags      = D3D12_HEAP_FLAG_NONE;
+
+        // Reserved resources have no heap: leave the heap properties cleared
+        if (pResource->GetHeapProperties(&HeapProperties, &HeapFlags) == S_OK)
         {
-            BuildViewDimensions();
+            SetHeapProperties(HeapProperties).SetHeapFlags(HeapFlags);
         }
     }
 
     return *this;
 }
 
+#if AR_HAS_CONSTEXPR_BUILDER
 //=====================================================================================================================
-// Initialise builder as a buffer
-D3D12_RESOURCE_DESC& ResourceBuilder::Buffer(
-    uint64_t byteWidth)
-{
-    ZeroMemory(this, sizeof(this));
-    
-    this->Width     = byteWidth;
-    this->Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-
-    BuildViewDimensions();
-
-    return *this;
-}
-
-//=====================================================================================================================
-// Initialise builder as texture1D
-D3D12_RESOURCE_DESC& ResourceBuilder::Texture1D(
-    uint64_t width, DXGI_FORMAT format, uint16_t arraySize, uint16_t mipLevels)
-{
-    ZeroMemory(this, sizeof(this));
+// Compile-time checks: fixed render target descriptions fold to constants
+namespace {
 
-    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
+constexpr ResourceBuilder ShadowAtlas = []() {
+    ResourceBuilder builder = {};
+    builder.Texture2D(4096, 4096, DXGI_FORMAT_R32_TYPELESS);
+    return builder;
+}();
 
-    this->Width            = width;
-    this->Height           = 1;
-    this->DepthOrArraySize = arraySize;
-    this->MipLevels        = mipLevels;
-    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
-    this->Alignment        = 0;
-    this->Format           = format;
-    this->SampleDesc       = { 1, 0 };
+static_assert(ShadowAtlas.AsDepthTarget().Flags == D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL, "");
+static_assert(ShadowAtlas.AsDepthStencilView(DXGI_FORMAT_D32_FLOAT).ViewDimension == D3D12_DSV_DIMENSION_TEXTURE2D, "");
+static_assert(ShadowAtlas.AsDepthStencilView(DXGI_FORMAT_D32_FLOAT).Format == DXGI_FORMAT_D32_FLOAT, "");
+static_assert(ShadowAtlas.AsShaderResourceView(DXGI_FORMAT_R32_FLOAT).Texture2D.MipLevels == 1, "");
+static_assert(ShadowAtlas.AsDepthStencilView().Format == DXGI_FORMAT_D32_FLOAT, "");
+static_assert(ShadowAtlas.AsShaderResourceView().Format == DXGI_FORMAT_R32_FLOAT, "");
 
-    BuildViewDimensions();
+constexpr ResourceBuilder GBufferArray = []() {
+    ResourceBuilder builder = {};
+    builder.Texture2D(1920, 1080, DXGI_FORMAT_R16G16B16A16_FLOAT, 4);
+    return builder;
+}();
 
-    return *this;
-}
+static_assert(GBufferArray.AsColorTargetViewArray().ViewDimension == D3D12_RTV_DIMENSION_TEXTURE2DARRAY, "");
+static_assert(GBufferArray.AsColorTargetViewArray(DXGI_FORMAT_UNKNOWN, 0, 1).Texture2DArray.ArraySize == 3, "");
+static_assert(GBufferArray.AsShaderResourceViewArray().Format == DXGI_FORMAT_R16G16B16A16_FLOAT, "");
 
- //=====================================================================================================================
- // Initialise builder as texture2D
-D3D12_RESOURCE_DESC& ResourceBuilder::Texture2D(
-    uint64_t width, uint32_t height, DXGI_FORMAT format, uint16_t arraySize, uint16_t mipLevels)
+constexpr uint64_t CopyableBytes(const ResourceBuilder& builder, uint32_t firstSubresource, uint32_t numSubresources)
 {
-    ZeroMemory(this, sizeof(this));
-
-    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
-
-    this->Width            = width;
-    this->Height           = height;
-    this->DepthOrArraySize = arraySize;
-    this->MipLevels        = mipLevels;
-    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-    this->Alignment        = 0;
-    this->Format           = format;
-    this->SampleDesc       = { 1, 0 };
-
-    BuildViewDimensions();
-
-    return *this;
+    uint64_t totalBytes = 0;
+    builder.GetCopyableFootprints(firstSubresource, numSubresources, 0, nullptr, nullptr, nullptr, &totalBytes);
+    return totalBytes;
 }
 
-//=====================================================================================================================
-// Initialise builder as texture3D
-D3D12_RESOURCE_DESC& ResourceBuilder::Texture3D(
-    uint64_t width, uint32_t height, uint16_t depth, DXGI_FORMAT format, uint16_t mipLevels)
+constexpr uint64_t TotalCopyableBytes(const ResourceBuilder& builder)
 {
-    ZeroMemory(this, sizeof(this));
-
-    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
-
-    this->Width            = width;
-    this->Height           = height;
-    this->DepthOrArraySize = depth;
-    this->MipLevels        = mipLevels;
-    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
-    this->Alignment        = 0;
-    this->Format           = format;
-    this->SampleDesc       = { 1, 0 };
+    return CopyableBytes(builder, 0, builder.GetSubresourceCount());
+}
 
-    BuildViewDimensions();
+constexpr ResourceBuilder CompressedChain = []() {
+    ResourceBuilder builder = {};
+    builder.Texture2D(100, 60, DXGI_FORMAT_BC1_UNORM, 1, 0);
+    return builder;
+}();
 
-    return *this;
-}
+static_assert(CompressedChain.GetMipCount() == 7, "");
+static_assert(CompressedChain.GetSubresourceFootprint(0).Footprint.Width == 100, "");
+static_assert(CompressedChain.GetSubresourceFootprint(0).Footprint.RowPitch == 256, "");
+static_assert(CompressedChain.GetSubresourceFootprint(6).Footprint.Height == 4, "");
+static_assert(ShadowAtlas.GetPlaneCount() == 1, "");
+static_assert(TotalCopyableBytes(ShadowAtlas) == 4096ull * 4096 * 4, "");
+static_assert(CopyableBytes(CompressedChain, 6, 1) != UINT64_MAX, "");
+static_assert(CopyableBytes(CompressedChain, 6, 2) == UINT64_MAX, "");
+static_assert(CopyableBytes(CompressedChain, UINT32_MAX - 1, 4) == UINT64_MAX, "");
 
 //=====================================================================================================================
-// Set builder resource format
-D3D12_RESOURCE_DESC& ResourceBuilder::SetFormat(
-    DXGI_FORMAT format)
+// Builders shared by the checks below (allocation estimates are table-tested in bench/TestMain.cpp)
+constexpr ResourceBuilder MakeBuffer(uint64_t byteWidth)
 {
-    this->Format = format;
-    return *this;
+    ResourceBuilder builder = {};
+    builder.Buffer(byteWidth);
+    return builder;
 }
 
-//=====================================================================================================================
-// Returns builder resource description as a color target
-D3D12_RESOURCE_DESC ResourceBuilder::AsColorTarget(
-    bool allowUAV
-    ) const
+constexpr ResourceBuilder MakeTexture(
+    D3D12_RESOURCE_DIMENSION dimension,
+    uint64_t                 width,
+    uint32_t                 height,
+    uint16_t                 depthOrArraySize,
+    DXGI_FORMAT              format,
+    uint16_t                 mipLevels = 1,
+    uint32_t                 samples   = 1,
+    D3D12_RESOURCE_FLAGS     flags     = D3D12_RESOURCE_FLAG_NONE)
 {
-    D3D12_RESOURCE_DESC Value = *this;
-    Value.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+    ResourceBuilder builder = {};
 
-    if (allowUAV)
+    if (dimension == D3D12_RESOURCE_DIMENSION_TEXTURE1D)
+    {
+        builder.Texture1D(width, format, depthOrArraySize, mipLevels);
+    }
+    else if (dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
     {
-        Value.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+        builder.Texture3D(width, height, depthOrArraySize, format, mipLevels);
+    }
+    else
+    {
+        builder.Texture2D(width, height, format, depthOrArraySize, mipLevels);
     }
 
-    return Value;
+    return builder.SetSampleCount(samples).SetFlags(flags);
 }
 
-//=====================================================================================================================
-// Returns builder resource description as a depth target
-D3D12_RESOURCE_DESC ResourceBuilder::AsDepthTarget(
-    bool allowSRV
-    ) const
-{
-    D3D12_RESOURCE_DESC Value = *this;
-    Value.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+constexpr ResourceBuilder RawBuffer = MakeBuffer(1000);
 
-    if (allowSRV == false)
-    {
-        Value.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
-    }
+constexpr ResourceBuilder MsaaTarget = MakeTexture(
+    D3D12_RESOURCE_DIMENSION_TEXTURE2D, 1920, 1080, 1, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 4,
+    D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
 
-    return Value;
-}
+static_assert(GetAllocationInfo(&RawBuffer, 1).SizeInBytes == 65536, "");
 
 //=====================================================================================================================
-// Returns color target view
-D3D12_RENDER_TARGET_VIEW_DESC ResourceBuilder::AsColorTargetView(
-    DXGI_FORMAT viewFormat, uint32_t baseMip
-    ) const
+// Standard tile shapes and tiling of a streamed texture
+constexpr uint32_t TotalTileCount(const ResourceBuilder& builder)
 {
-    D3D12_RENDER_TARGET_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format             = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension      = RTVDimension;
-    ViewDesc.Texture2D.MipSlice = baseMip;
-
-    return ViewDesc;
+    uint32_t tileCount = 0;
+    builder.GetResourceTiling(&tileCount, nullptr, nullptr, nullptr, 0, nullptr);
+    return tileCount;
 }
 
-//=====================================================================================================================
-// Returns color target view for an array
-D3D12_RENDER_TARGET_VIEW_DESC ResourceBuilder::AsColorTargetViewArray(
-    DXGI_FORMAT viewFormat,
-    uint16_t    baseMip,
-    uint16_t    baseArray,
-    uint16_t    arraySize
-    ) const
+constexpr D3D12_PACKED_MIP_INFO PackedMipInfo(const ResourceBuilder& builder)
 {
-    D3D12_RENDER_TARGET_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format                         = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension                  = RTVDimensionArray;
-    ViewDesc.Texture2DArray.MipSlice        = baseMip;
-    ViewDesc.Texture2DArray.FirstArraySlice = baseArray;
-    ViewDesc.Texture2DArray.ArraySize       = std::min(DepthOrArraySize, arraySize) - baseArray;
-
-    return ViewDesc;
+    D3D12_PACKED_MIP_INFO Info = {};
+    builder.GetResourceTiling(nullptr, &Info, nullptr, nullptr, 0, nullptr);
+    return Info;
 }
 
-//=====================================================================================================================
-// Returns depth stencil view
-D3D12_DEPTH_STENCIL_VIEW_DESC ResourceBuilder::AsDepthStencilView(
-    DXGI_FORMAT viewFormat, uint16_t baseMip
-    ) const
-{
-    D3D12_DEPTH_STENCIL_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format             = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension      = DSVDimension;
-    ViewDesc.Texture2D.MipSlice = baseMip;
+constexpr ResourceBuilder StreamedTexture =
+    MakeTexture(D3D12_RESOURCE_DIMENSION_TEXTURE2D, 1024, 1024, 1, DXGI_FORMAT_R8G8B8A8_UNORM, 0);
 
-    return ViewDesc;
-}
+static_assert(StreamedTexture.GetStandardTileShape().WidthInTexels == 128, "");
+static_assert(StreamedTexture.GetStandardTileShape().HeightInTexels == 128, "");
+static_assert(PackedMipInfo(StreamedTexture).NumStandardMips == 4, "");
+static_assert(PackedMipInfo(StreamedTexture).NumPackedMips == 7, "");
+static_assert(PackedMipInfo(StreamedTexture).StartTileIndexInOverallResource == 64 + 16 + 4 + 1, "");
+static_assert(TotalTileCount(StreamedTexture) == 64 + 16 + 4 + 1 + 1, "");
 
 //=====================================================================================================================
-// Returns depth stencil view for an array
-D3D12_DEPTH_STENCIL_VIEW_DESC ResourceBuilder::AsDepthStencilViewArray(
-    DXGI_FORMAT viewFormat,
-    uint16_t    baseMip,
-    uint16_t    baseArray,
-    uint16_t    arraySize
-    ) const
-{
-    D3D12_DEPTH_STENCIL_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format                         = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension                  = DSVDimensionArray;
-    ViewDesc.Texture2DArray.MipSlice        = baseMip;
-    ViewDesc.Texture2DArray.FirstArraySlice = baseArray;
-    ViewDesc.Texture2DArray.ArraySize       = std::min(DepthOrArraySize, arraySize) - baseArray;
-
-    return ViewDesc;
-}
+// Unordered access views and per-mip view sets
+constexpr ResourceBuilder HiZChain =
+    MakeTexture(D3D12_RESOURCE_DIMENSION_TEXTURE2D, 1920, 1080, 2, DXGI_FORMAT_R32_TYPELESS, 0);
 
-//=====================================================================================================================
-// Returns shader resource view
-D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsShaderResourceView(
-    DXGI_FORMAT viewFormat,
-    uint16_t    baseMip,
-    uint16_t    mipLevels,
-    float       minLod
-    ) const
-{
-    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format                        = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension                 = SRVDimension;
-    ViewDesc.Texture2D.MostDetailedMip     = baseMip;
-    ViewDesc.Texture2D.MipLevels           = std::min(mipLevels, MipLevels) - baseMip;
-    ViewDesc.Texture2D.ResourceMinLODClamp = minLod;
-    ViewDesc.Shader4ComponentMapping       = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-
-    return ViewDesc;
-}
+constexpr ResourceBuilder VolumeChain =
+    MakeTexture(D3D12_RESOURCE_DIMENSION_TEXTURE3D, 64, 64, 32, DXGI_FORMAT_R16_FLOAT, 0);
 
-//=====================================================================================================================
-// Returns shader resource view
-D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsBufferResourceView(
-    uint32_t    firstElement,
-    uint32_t    numElements,
-    uint32_t    byteStride,
-    DXGI_FORMAT viewFormat
-    ) const
+constexpr bool ValidateMipViews()
 {
-    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format                        = viewFormat;
-    ViewDesc.ViewDimension                 = D3D12_SRV_DIMENSION_BUFFER;
-    ViewDesc.Buffer.FirstElement           = firstElement;
-    ViewDesc.Buffer.NumElements            = numElements;
-    ViewDesc.Buffer.StructureByteStride    = byteStride;
-
-    if ((byteStride == 0) && (viewFormat == DXGI_FORMAT_UNKNOWN))
-    {
-        ViewDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
-    }
+    MipViewRange range = {};
+    range.PerSlice     = true;
 
-    ViewDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    D3D12_SHADER_RESOURCE_VIEW_DESC  srvs[22] = {};
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavs[22] = {};
 
-    ///TODO: Clamp NumElements to resource Width / byteStride (assume 4-byte for raw buffers)
-    return ViewDesc;
-}
+    const uint32_t count = HiZChain.BuildMipViews(range, 22, srvs, uavs);
 
-//=====================================================================================================================
-ResourceBuilder& ResourceBuilder::SetHeapType(D3D12_HEAP_TYPE type)
-{
-    HeapProperties.Type = type;
-    return *this;
+    return (count == 22) &&
+           (srvs[12].Texture2DArray.MostDetailedMip == 1) && (srvs[12].Texture2DArray.MipLevels == 1) &&
+           (srvs[12].Texture2DArray.FirstArraySlice == 1) && (srvs[12].Texture2DArray.ArraySize == 1) &&
+           (uavs[21].Texture2DArray.MipSlice == 10) && (uavs[21].Format == DXGI_FORMAT_R32_FLOAT) &&
+           (HiZChain.BuildMipViews(range, 21, srvs, uavs) == 0);
 }
 
-//=====================================================================================================================
-// Returns shader resource view for an array
-D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsShaderResourceViewArray(
-    DXGI_FORMAT viewFormat,
-    uint16_t    baseMip,
-    uint16_t    baseArray,
-    uint16_t    mipLevels,
-    uint16_t    arraySize,
-    float       minLod
-    ) const
-{
-    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
-    ViewDesc.Format                             = (IsTypeless(Format) ? viewFormat : Format);
-    ViewDesc.ViewDimension                      = SRVDimensionArray;
-    ViewDesc.Texture2DArray.MostDetailedMip     = baseMip;
-    ViewDesc.Texture2DArray.MipLevels           = std::min(mipLevels, MipLevels) - baseMip;
-    ViewDesc.Texture2DArray.FirstArraySlice     = baseArray;
-    ViewDesc.Texture2DArray.ArraySize           = std::min(DepthOrArraySize, arraySize) - baseArray;
-    ViewDesc.Texture2DArray.ResourceMinLODClamp = minLod;
-    ViewDesc.Shader4ComponentMapping            = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-
-    return ViewDesc;
-}
+static_assert(ValidateMipViews(), "");
+static_assert(HiZChain.GetMipViewCount(MipViewRange{}) == 11, "");
+static_assert(HiZChain.AsUnorderedAccessView().ViewDimension == D3D12_UAV_DIMENSION_TEXTURE2D, "");
+static_assert(HiZChain.AsUnorderedAccessViewArray().ViewDimension == D3D12_UAV_DIMENSION_TEXTURE2DARRAY, "");
+static_assert(HiZChain.AsShaderResourceViewArray(DXGI_FORMAT_UNKNOWN, 1, 1, 1, 1).Texture2DArray.ArraySize == 1, "");
+static_assert(HiZChain.AsShaderResourceView().Texture2D.MipLevels == 11, "");
+static_assert(VolumeChain.AsUnorderedAccessView(DXGI_FORMAT_UNKNOWN, 2).Texture3D.WSize == 8, "");
+static_assert(VolumeChain.AsShaderResourceView().Texture3D.MipLevels == 7, "");
+static_assert(VolumeChain.AsColorTargetViewArray(DXGI_FORMAT_UNKNOWN, 1, 4).Texture3D.WSize == 12, "");
+static_assert(RawBuffer.AsUnorderedAccessView().Buffer.Flags == D3D12_BUFFER_UAV_FLAG_RAW, "");
+static_assert(RawBuffer.AsUnorderedAccessView().Buffer.NumElements == 250, "");
+static_assert(RawBuffer.AsUnorderedAccessView(DXGI_FORMAT_R32_UINT).Format == DXGI_FORMAT_R32_UINT, "");
+static_assert(RawBuffer.AsUnorderedAccessView(DXGI_FORMAT_R32_UINT).Buffer.Flags == 0, "");
+static_assert(RawBuffer.AsUnorderedAccessView(DXGI_FORMAT_R16_UINT).Buffer.NumElements == 500, "");
+static_assert(RawBuffer.AsColorTargetView(DXGI_FORMAT_R8_UNORM).Format == DXGI_FORMAT_R8_UNORM, "");
+static_assert(RawBuffer.AsColorTargetView(DXGI_FORMAT_R8_UNORM).Buffer.NumElements == 1000, "");
+static_assert(RawBuffer.AsColorTargetView().Buffer.NumElements == 0, "");
+static_assert(CopyableBytes(RawBuffer, 0, 1) == 1000, "");
+static_assert(CopyableBytes(RawBuffer, 0, 2) == UINT64_MAX, "");
+static_assert(CopyableBytes(RawBuffer, 1, 1) == UINT64_MAX, "");
 
-//=====================================================================================================================
-// Internal helper function
-void ResourceBuilder::BuildViewDimensions()
-{
-    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
-    {
-        RTVDimension = D3D12_RTV_DIMENSION_BUFFER;
-        DSVDimension = D3D12_DSV_DIMENSION_UNKNOWN; // Not supported
-        SRVDimension = D3D12_SRV_DIMENSION_BUFFER;
-    }
-    else if (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE1D)
-    {
-        RTVDimension = D3D12_RTV_DIMENSION_TEXTURE1D;
-        DSVDimension = D3D12_DSV_DIMENSION_UNKNOWN; // Not supported
-        SRVDimension = D3D12_SRV_DIMENSION_TEXTURE1D;
-    }
-    else if (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
-    {
-        RTVDimension = D3D12_RTV_DIMENSION_TEXTURE3D;
-        DSVDimension = D3D12_DSV_DIMENSION_UNKNOWN; // Not supported
-        SRVDimension = D3D12_SRV_DIMENSION_TEXTURE3D;
-    }
-    else // D3D12_RESOURCE_DIMENSION_TEXTURE2D
-    {
-        if (SampleDesc.Count > 1)
-        {
-            RTVDimension = D3D12_RTV_DIMENSION_TEXTURE2DMS;
-            DSVDimension = D3D12_DSV_DIMENSION_TEXTURE2DMS;
-            SRVDimension = D3D12_SRV_DIMENSION_TEXTURE2DMS;
-
-            RTVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_RTV_DIMENSION_TEXTURE2DMS : D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
-            DSVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_DSV_DIMENSION_TEXTURE2DMS : D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY;
-            SRVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_SRV_DIMENSION_TEXTURE2DMS : D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY;
-        }
-        else
-        {
-            RTVDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-            DSVDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
-            SRVDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-
-            RTVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_RTV_DIMENSION_TEXTURE2D : D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
-            DSVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_DSV_DIMENSION_TEXTURE2D : D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
-            SRVDimensionArray =
-                (DepthOrArraySize == 1) ? D3D12_SRV_DIMENSION_TEXTURE2D : D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-        }
-    }
-}
+// View dimensions are derived from the description, so they follow sample counts set after the factory
+static_assert(MsaaTarget.GetDSVDimension() == D3D12_DSV_DIMENSION_TEXTURE2DMS, "");
+static_assert(MsaaTarget.GetUAVDimension() == D3D12_UAV_DIMENSION_UNKNOWN, "");
+static_assert(GBufferArray.GetSRVDimension() == D3D12_SRV_DIMENSION_TEXTURE2D, "");
+static_assert(GBufferArray.AsColorTarget().GetHeapProperties().Type == D3D12_HEAP_TYPE_DEFAULT, "");
+
+} // anonymous namespace
+#endif
 } // AR
\ No newline at end of file
@@ -20,66 +20,68 @@ SOFTWARE.
 
 #pragma once
 #include <d3d12.h>
+#include <cassert>
 #include <cstdint>
 #include <algorithm>
+#include <type_traits>
+#include "FormatTraits.h"
+#include "Instrumentation.h"
 
 #undef min
 #undef max
 
+// Builder methods are constexpr when the compiler can switch the active view description union member inside a
+// constant expression (C++20). Older compilers get the same methods as plain inline functions.
+#if defined(__cpp_constexpr) && (__cpp_constexpr >= 202002L)
+#define AR_CONSTEXPR constexpr
+#define AR_HAS_CONSTEXPR_BUILDER 1
+#else
+#define AR_CONSTEXPR inline
+#define AR_HAS_CONSTEXPR_BUILDER 0
+#endif
+
 namespace AR {
 
 //=====================================================================================================================
-// Returns whether the DXGI_FORMAT input is a typeless format
-constexpr bool IsTypeless(DXGI_FORMAT format)
-{
-    switch (format)
-    {
-    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
-    case DXGI_FORMAT_R32G32B32_TYPELESS:
-    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
-    case DXGI_FORMAT_R32G32_TYPELESS:
-    case DXGI_FORMAT_R32G8X24_TYPELESS:
-    case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
-    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
-    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
-    case DXGI_FORMAT_R16G16_TYPELESS:
-    case DXGI_FORMAT_R32_TYPELESS:
-    case DXGI_FORMAT_R24G8_TYPELESS:
-    case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
-    case DXGI_FORMAT_R8G8_TYPELESS:
-    case DXGI_FORMAT_R16_TYPELESS:
-    case DXGI_FORMAT_R8_TYPELESS:
-    case DXGI_FORMAT_BC1_TYPELESS:
-    case DXGI_FORMAT_BC2_TYPELESS:
-    case DXGI_FORMAT_BC3_TYPELESS:
-    case DXGI_FORMAT_BC4_TYPELESS:
-    case DXGI_FORMAT_BC5_TYPELESS:
-    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
-    case DXGI_FORMAT_B8G8R8X8_TYPELESS:
-    case DXGI_FORMAT_BC6H_TYPELESS:
-    case DXGI_FORMAT_BC7_TYPELESS:
-        return true;
-        break;
-    default:
-        return false;
-    }
+// Rounds value up to a power-of-two alignment
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
 }
 
 //=====================================================================================================================
-// D3D12 resource builder helper
+// Mip and array range of a per-mip view set (see ResourceBuilder::BuildMipViews)
+struct MipViewRange
+{
+    DXGI_FORMAT SrvFormat = DXGI_FORMAT_UNKNOWN;                     ///< Shader resource view format override
+    DXGI_FORMAT UavFormat = DXGI_FORMAT_UNKNOWN;                     ///< Unordered access view format override
+    uint16_t    BaseMip   = 0;                                       ///< First mip level
+    uint16_t    MipLevels = D3D12_REQ_MIP_LEVELS;                    ///< Mip count (clamped to the resource)
+    uint16_t    BaseArray = 0;                                       ///< First array slice (0 for 3D textures)
+    uint16_t    ArraySize = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION; ///< Array count (clamped to the resource)
+    bool        PerSlice  = false;                                   ///< One view per mip and array slice (not 3D)
+};
+
+//=====================================================================================================================
+// D3D12 resource builder helper. The builder is a trivially copyable value that fits in one cache line: the resource
+// description plus packed heap properties. View dimensions are derived from the description when a view is built.
 struct ResourceBuilder : D3D12_RESOURCE_DESC
 {
-    /// Initialise builder from an existing resource
+    /// Initialise an empty builder (every field zero, no heap type)
+    constexpr ResourceBuilder() : D3D12_RESOURCE_DESC{} {}
+
+    /// Initialise builder from an existing resource. Resources without a heap (reserved resources) get cleared heap
+    /// properties. See ResourceCache for repeated queries of the same resource.
     ///
     /// @param pResource    [in] Existing D3D12 resource pointer
     ///
-    D3D12_RESOURCE_DESC& FromExistingResource(ID3D12Resource* pResource);
+    ResourceBuilder& FromExistingResource(ID3D12Resource* pResource);
 
     /// Initialise builder as a buffer
     ///
     /// @param byteWidth    [in] Buffer size in bytes
     ///
-    D3D12_RESOURCE_DESC& Buffer(uint64_t byteWidth);
+    AR_CONSTEXPR ResourceBuilder& Buffer(uint64_t byteWidth);
 
     /// Initialise builder as a one-dimensional texture from input
     ///
@@ -88,7 +90,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param arraySize [in] Array slice count
     /// @param mipLevels [in] Mip level count
     ///
-    D3D12_RESOURCE_DESC& Texture1D(
+    AR_CONSTEXPR ResourceBuilder& Texture1D(
         uint64_t width, DXGI_FORMAT format, uint16_t arraySize = 1, uint16_t mipLevels = 1);
 
     /// Initialise builder as a two-dimensional texture from input
@@ -99,7 +101,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param arraySize [in] Array slice count
     /// @param mipLevels [in] Mip level count
     ///
-    D3D12_RESOURCE_DESC& Texture2D(
+    AR_CONSTEXPR ResourceBuilder& Texture2D(
         uint64_t width, uint32_t height, DXGI_FORMAT format, uint16_t arraySize = 1, uint16_t mipLevels = 1);
 
     /// Initialise builder as a three-dimensional texture from input
@@ -110,33 +112,95 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param format    [in] Texture format @see DXGI_FORMAT
     /// @param mipLevels [in] Mip level count
     ///
-    D3D12_RESOURCE_DESC& Texture3D(
+    AR_CONSTEXPR ResourceBuilder& Texture3D(
         uint64_t width, uint32_t height, uint16_t depth, DXGI_FORMAT format, uint16_t mipLevels = 1);
 
     /// Set builder resource format
     ///
     /// @param format [in] Resource format
     ///
-    D3D12_RESOURCE_DESC& SetFormat(DXGI_FORMAT format);
+    AR_CONSTEXPR ResourceBuilder& SetFormat(DXGI_FORMAT format);
+
+    /// Set builder sample count and quality
+    ///
+    /// @param count   [in]       Samples per pixel
+    /// @param quality [optional] Sample quality level
+    ///
+    AR_CONSTEXPR ResourceBuilder& SetSampleCount(uint32_t count, uint32_t quality = 0);
+
+    /// Set builder resource flags
+    ///
+    /// @param flags [in] Resource flags
+    ///
+    AR_CONSTEXPR ResourceBuilder& SetFlags(D3D12_RESOURCE_FLAGS flags);
+
+    /// Set heap type property
+    ///
+    /// @param type [in] Heap type
+    ///
+    AR_CONSTEXPR ResourceBuilder& SetHeapType(D3D12_HEAP_TYPE type);
+
+    /// Set heap properties (custom heaps). Node masks are stored for the first eight nodes only and must not name a
+    /// higher node (asserted).
+    ///
+    /// @param properties [in] Heap properties
+    ///
+    AR_CONSTEXPR ResourceBuilder& SetHeapProperties(const D3D12_HEAP_PROPERTIES& properties);
+
+    /// Set heap flags
+    ///
+    /// @param flags [in] Heap flags
+    ///
+    AR_CONSTEXPR ResourceBuilder& SetHeapFlags(D3D12_HEAP_FLAGS flags);
+
+    /// Returns the heap properties to create the resource with
+    AR_CONSTEXPR D3D12_HEAP_PROPERTIES GetHeapProperties() const;
+
+    /// Returns the heap flags to create the resource with
+    AR_CONSTEXPR D3D12_HEAP_FLAGS GetHeapFlags() const;
+
+    /// Returns the render target view dimension of the resource
+    ///
+    /// @param array [optional] Dimension of array views (single slice resources return their single view dimension)
+    ///
+    AR_CONSTEXPR D3D12_RTV_DIMENSION GetRTVDimension(bool array = false) const;
+
+    /// Returns the depth-stencil view dimension of the resource (unknown for buffers, 1D and 3D textures)
+    ///
+    /// @param array [optional] Dimension of array views (single slice resources return their single view dimension)
+    ///
+    AR_CONSTEXPR D3D12_DSV_DIMENSION GetDSVDimension(bool array = false) const;
+
+    /// Returns the shader resource view dimension of the resource
+    ///
+    /// @param array [optional] Dimension of array views (single slice resources return their single view dimension)
+    ///
+    AR_CONSTEXPR D3D12_SRV_DIMENSION GetSRVDimension(bool array = false) const;
+
+    /// Returns the unordered access view dimension of the resource (unknown for MSAA textures)
+    ///
+    /// @param array [optional] Dimension of array views (single slice resources return their single view dimension)
+    ///
+    AR_CONSTEXPR D3D12_UAV_DIMENSION GetUAVDimension(bool array = false) const;
 
     /// Returns builder resource description as a color target
     ///
     /// @param allowUAV [optional] Allow unordered access
     ///
-    D3D12_RESOURCE_DESC AsColorTarget(bool allowUAV = false) const;
+    AR_CONSTEXPR ResourceBuilder AsColorTarget(bool allowUAV = false) const;
 
     /// Returns builder resource description as a depth target
     ///
     /// @param allowSRV [optional] Allow shader read access
     ///
-    D3D12_RESOURCE_DESC AsDepthTarget(bool allowSRV = true) const;
+    AR_CONSTEXPR ResourceBuilder AsDepthTarget(bool allowSRV = true) const;
 
     /// Returns color target view
     ///
     /// @param viewFormat [optional] Color target view format
     /// @param baseMip    [optional] Base mip level
     ///
-    D3D12_RENDER_TARGET_VIEW_DESC AsColorTargetView(
+    AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC AsColorTargetView(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN, uint32_t baseMip = 0) const;
 
     /// Returns color target view for an array
@@ -146,7 +210,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param baseArray  [optional] Base array slice
     /// @param arraySize  [optional] Array count
     ///
-    D3D12_RENDER_TARGET_VIEW_DESC AsColorTargetViewArray(
+    AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC AsColorTargetViewArray(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN,
         uint16_t    baseMip    = 0,
         uint16_t    baseArray  = 0,
@@ -157,7 +221,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param viewFormat [optional] Depth-stencil view format
     /// @param baseMip    [optional] Base mip level
     ///
-    D3D12_DEPTH_STENCIL_VIEW_DESC AsDepthStencilView(
+    AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC AsDepthStencilView(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN, uint16_t baseMip = 0) const;
 
     /// Returns depth-stencil view for an array
@@ -167,7 +231,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param baseArray  [optional] Base array slice
     /// @param arraySize  [optional] Array count
     ///
-    D3D12_DEPTH_STENCIL_VIEW_DESC AsDepthStencilViewArray(
+    AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC AsDepthStencilViewArray(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN,
         uint16_t    baseMip    = 0,
         uint16_t    baseArray  = 0,
@@ -180,7 +244,7 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
      /// @param byteStride   [optional] Structured buffer byte stride
      /// @param viewFormat   [optional] Override view format (typed buffers only)
      ///
-    D3D12_SHADER_RESOURCE_VIEW_DESC AsBufferResourceView(
+    AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC AsBufferResourceView(
         uint32_t    firstElement = 0,
         uint32_t    numElements  = 0xffffffff,
         uint32_t    byteStride   = 0,
@@ -193,20 +257,14 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
     /// @param mipLevels    [optional] Mip count
     /// @param minLod       [optional] Minimum level of detail
     ///
-    D3D12_SHADER_RESOURCE_VIEW_DESC AsShaderResourceView(
+    AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC AsShaderResourceView(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN,
         uint16_t    baseMip    = 0,
         uint16_t    mipLevels  = D3D12_REQ_MIP_LEVELS,
         float       minLod     = 0.0f) const;
 
-    /// Set heap type property
-    ///
-    /// @param type [in] Heap type
-    ///
-    ResourceBuilder& SetHeapType(D3D12_HEAP_TYPE type);
-
     // Returns shader resource view for an array
-    D3D12_SHADER_RESOURCE_VIEW_DESC AsShaderResourceViewArray(
+    AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC AsShaderResourceViewArray(
         DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN,
         uint16_t    baseMip    = 0,
         uint16_t    baseArray  = 0,
@@ -214,18 +272,1473 @@ struct ResourceBuilder : D3D12_RESOURCE_DESC
         uint16_t    arraySize  = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION,
         float       minLod     = 0.0f) const;
 
-    D3D12_RTV_DIMENSION   RTVDimension;      ///< RTV dimension
-    D3D12_RTV_DIMENSION   RTVDimensionArray; ///< RTV dimension (valid only for array texture)
-    D3D12_DSV_DIMENSION   DSVDimension;      ///< DSV dimension
-    D3D12_DSV_DIMENSION   DSVDimensionArray; ///< DSV dimension (valid only for array texture)
-    D3D12_SRV_DIMENSION   SRVDimension;      ///< SRV dimension
-    D3D12_SRV_DIMENSION   SRVDimensionArray; ///< SRV dimension (valid only for array texture)
-    D3D12_HEAP_PROPERTIES HeapProperties;    ///< Heap properties
-    D3D12_HEAP_FLAGS      HeapFlags;         ///< Heap flags
+    /// Returns unordered access view
+    ///
+    /// @param viewFormat [optional] Override view format (sRGB formats are replaced by their linear counterpart)
+    /// @param mipSlice   [optional] Mip level
+    ///
+    AR_CONSTEXPR D3D12_UNORDERED_ACCESS_VIEW_DESC AsUnorderedAccessView(
+        DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN, uint16_t mipSlice = 0) const;
+
+    /// Returns unordered access view for an array (a W slice range for 3D textures)
+    ///
+    /// @param viewFormat [optional] Override view format (sRGB formats are replaced by their linear counterpart)
+    /// @param mipSlice   [optional] Mip level
+    /// @param baseArray  [optional] Base array slice
+    /// @param arraySize  [optional] Array count
+    ///
+    AR_CONSTEXPR D3D12_UNORDERED_ACCESS_VIEW_DESC AsUnorderedAccessViewArray(
+        DXGI_FORMAT viewFormat = DXGI_FORMAT_UNKNOWN,
+        uint16_t    mipSlice   = 0,
+        uint16_t    baseArray  = 0,
+        uint16_t    arraySize  = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION) const;
+
+    /// Returns the number of views of each type BuildMipViews writes for a range, or zero when the range starts
+    /// outside the resource mips or array slices, or selects array slices of a 3D texture
+    ///
+    /// @param range [in] Mip and array range
+    ///
+    AR_CONSTEXPR uint32_t GetMipViewCount(const MipViewRange& range) const;
+
+    /// Builds single-mip shader resource and unordered access views for every mip in a range, as used by compute
+    /// downsampling and Hi-Z passes. View i covers mip (BaseMip + i) and every requested array slice; with PerSlice
+    /// the views are ordered like subresources (slice-major) and cover one array slice each. Views of 3D textures
+    /// cover every depth slice of their mip, so ranges with PerSlice or a non-zero BaseArray are rejected for them.
+    /// Nothing is written when the range is invalid, the storage is too small or unordered access views are requested
+    /// for a resource that cannot have them (buffers and MSAA textures).
+    ///
+    /// @param range    [in]  Mip and array range
+    /// @param capacity [in]  Entries available in each output array
+    /// @param pSrvs    [out] Optional shader resource view array
+    /// @param pUavs    [out] Optional unordered access view array
+    ///
+    /// @returns Number of views of each type written
+    ///
+    AR_CONSTEXPR uint32_t BuildMipViews(
+        const MipViewRange&               range,
+        uint32_t                          capacity,
+        D3D12_SHADER_RESOURCE_VIEW_DESC*  pSrvs,
+        D3D12_UNORDERED_ACCESS_VIEW_DESC* pUavs) const;
+
+    /// Returns the mip level count (a MipLevels value of zero resolves to the full mip chain)
+    AR_CONSTEXPR uint32_t GetMipCount() const;
+
+    /// Returns the array slice count (1 for buffers and 3D textures)
+    AR_CONSTEXPR uint32_t GetArraySize() const;
+
+    /// Returns the plane count of the resource format (1 for buffers)
+    AR_CONSTEXPR uint32_t GetPlaneCount() const;
+
+    /// Returns the subresource count over every mip, array slice and plane
+    AR_CONSTEXPR uint32_t GetSubresourceCount() const;
+
+    /// Returns the subresource index for a mip, array slice and plane
+    ///
+    /// @param mipSlice   [in] Mip level
+    /// @param arraySlice [in] Array slice
+    /// @param planeSlice [in] Plane slice
+    ///
+    AR_CONSTEXPR uint32_t CalcSubresource(uint32_t mipSlice, uint32_t arraySlice, uint32_t planeSlice) const;
+
+    /// Returns the copyable footprint of one subresource
+    ///
+    /// @param subresource  [in]  Subresource index
+    /// @param offset       [in]  Placement offset written to the footprint
+    /// @param pNumRows     [out] Optional row count (block rows for block compressed formats)
+    /// @param pRowSize     [out] Optional unpadded row size in bytes
+    ///
+    AR_CONSTEXPR D3D12_PLACED_SUBRESOURCE_FOOTPRINT GetSubresourceFootprint(
+        uint32_t  subresource,
+        uint64_t  offset   = 0,
+        uint32_t* pNumRows = nullptr,
+        uint64_t* pRowSize = nullptr) const;
+
+    /// Computes placed subresource footprints without a device, following the rules of
+    /// ID3D12Device::GetCopyableFootprints (256-byte row pitch and 512-byte placement alignment). Subresources that
+    /// cannot be described (e.g. a texture without a format, or a range past the last subresource; buffers only have
+    /// subresource 0) report UINT64_MAX / UINT32_MAX values like the device.
+    ///
+    /// @param firstSubresource [in]  First subresource index
+    /// @param numSubresources  [in]  Subresource count
+    /// @param baseOffset       [in]  Offset of the first subresource
+    /// @param pLayouts         [out] Optional placed footprint array with room for numSubresources items
+    /// @param pNumRows         [out] Optional row count array
+    /// @param pRowSizeInBytes  [out] Optional unpadded row size array
+    /// @param pTotalBytes      [out] Optional total size of the placed subresources (excluding baseOffset)
+    ///
+    AR_CONSTEXPR void GetCopyableFootprints(
+        uint32_t                            firstSubresource,
+        uint32_t                            numSubresources,
+        uint64_t                            baseOffset,
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts,
+        uint32_t*                           pNumRows,
+        uint64_t*                           pRowSizeInBytes,
+        uint64_t*                           pTotalBytes) const;
+
+    /// Estimates the placement size and alignment of the resource without a device, applying the D3D12 small
+    /// (4KB), default (64KB), small MSAA (64KB) and MSAA (4MB) placement alignment rules. When Alignment is zero the
+    /// smallest legal alignment is selected; write the returned alignment into the description before creating a
+    /// placed resource so the device accepts it. Sizes are estimated from the linear subresource layout.
+    AR_CONSTEXPR D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo() const;
+
+    /// Returns the standard (64KB) tile shape of a reserved resource with this description. 1D textures and formats
+    /// without a standard shape (planar, packed or non power-of-two element sizes) return a zero shape.
+    AR_CONSTEXPR D3D12_TILE_SHAPE GetStandardTileShape() const;
+
+    /// Computes reserved resource tiling without a device, mirroring ID3D12Device::GetResourceTiling. Mips smaller
+    /// than a tile in any dimension are packed; each array slice stores its standard mips followed by its packed
+    /// mips. The packed tile count is estimated from the packed mip sizes (drivers may pack more tightly).
+    ///
+    /// @param pNumTilesForEntireResource [out]    Optional total tile count
+    /// @param pPackedMipDesc             [out]    Optional packed mip description
+    /// @param pStandardTileShape         [out]    Optional tile shape of the standard mips
+    /// @param pNumSubresourceTilings     [in/out] Optional subresource tiling capacity in, tilings written out
+    /// @param firstSubresourceTiling     [in]     First subresource to describe
+    /// @param pSubresourceTilings        [out]    Optional subresource tiling array (packed mips report
+    ///                                            D3D12_PACKED_TILE)
+    ///
+    AR_CONSTEXPR void GetResourceTiling(
+        uint32_t*                 pNumTilesForEntireResource,
+        D3D12_PACKED_MIP_INFO*    pPackedMipDesc,
+        D3D12_TILE_SHAPE*         pStandardTileShape,
+        uint32_t*                 pNumSubresourceTilings,
+        uint32_t                  firstSubresourceTiling,
+        D3D12_SUBRESOURCE_TILING* pSubresourceTilings) const;
 
 private:
 
-    /// @internal Internal helper functions for building view dimension structures
-    void BuildViewDimensions();
+    /// @internal Returns the color/shader view format: the resource format when typed, otherwise the requested
+    /// format or the typeless family default when none is given. Buffers always take the requested format.
+    AR_CONSTEXPR DXGI_FORMAT ResolveViewFormat(DXGI_FORMAT viewFormat) const;
+
+    /// @internal Returns the depth-stencil view format (see ResolveViewFormat)
+    AR_CONSTEXPR DXGI_FORMAT ResolveDepthViewFormat(DXGI_FORMAT viewFormat) const;
+
+    /// @internal Returns the number of elements of [base, base + count) that lie inside [0, total)
+    static AR_CONSTEXPR uint32_t ClampCount(uint32_t base, uint32_t count, uint32_t total);
+
+    /// @internal Returns the W slice count of a 3D texture mip
+    AR_CONSTEXPR uint32_t GetMipDepth(uint32_t mip) const;
+
+    // Heap properties packed into the tail of the cache line (every D3D12 heap flag fits in 16 bits)
+    uint8_t  m_heapType             = 0; ///< D3D12_HEAP_TYPE
+    uint8_t  m_cpuPageProperty      = 0; ///< D3D12_CPU_PAGE_PROPERTY
+    uint8_t  m_memoryPoolPreference = 0; ///< D3D12_MEMORY_POOL
+    uint8_t  m_creationNodeMask     = 0; ///< Creation node mask
+    uint8_t  m_visibleNodeMask      = 0; ///< Visible node mask
+    uint16_t m_heapFlags            = 0; ///< D3D12_HEAP_FLAGS
 };
+
+static_assert(sizeof(ResourceBuilder) <= 64, "ResourceBuilder must fit in a cache line");
+static_assert(std::is_trivially_copyable<ResourceBuilder>::value, "ResourceBuilder must be trivially copyable");
+static_assert((D3D12_HEAP_FLAG_SHARED | D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_ALLOW_DISPLAY |
+               D3D12_HEAP_FLAG_SHARED_CROSS_ADAPTER | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES |
+               D3D12_HEAP_FLAG_DENY_NON_RT_DS_TEXTURES | D3D12_HEAP_FLAG_HARDWARE_PROTECTED |
+               D3D12_HEAP_FLAG_ALLOW_WRITE_WATCH | D3D12_HEAP_FLAG_ALLOW_SHADER_ATOMICS |
+               D3D12_HEAP_FLAG_CREATE_NOT_RESIDENT | D3D12_HEAP_FLAG_CREATE_NOT_ZEROED) <= UINT16_MAX,
+              "Every D3D12_HEAP_FLAGS value must fit in the packed heap flags");
+
+/// Estimates allocation info for a set of resources placed back to back in one heap (mirrors
+/// ID3D12Device::GetResourceAllocationInfo1)
+///
+/// @param pBuilders [in]  Builder array
+/// @param count     [in]  Builder count
+/// @param pInfos    [out] Optional per-resource offset, size and alignment array with room for count items
+///
+AR_CONSTEXPR D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo(
+    const ResourceBuilder*           pBuilders,
+    uint32_t                         count,
+    D3D12_RESOURCE_ALLOCATION_INFO1* pInfos = nullptr);
+
+//=====================================================================================================================
+// Initialise builder as a buffer
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::Buffer(
+    uint64_t byteWidth)
+{
+    AR_INSTRUMENT(Buffer);
+
+    *this = ResourceBuilder{};
+
+    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
+
+    this->Width            = byteWidth;
+    this->Height           = 1;
+    this->DepthOrArraySize = 1;
+    this->MipLevels        = 1;
+    this->Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+    this->Alignment        = 0;
+    this->Format           = DXGI_FORMAT_UNKNOWN;
+    this->SampleDesc       = { 1, 0 };
+    this->Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    return *this;
+}
+
+//=====================================================================================================================
+// Initialise builder as texture1D
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::Texture1D(
+    uint64_t width, DXGI_FORMAT format, uint16_t arraySize, uint16_t mipLevels)
+{
+    AR_INSTRUMENT(Texture1D);
+
+    *this = ResourceBuilder{};
+
+    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
+
+    this->Width            = width;
+    this->Height           = 1;
+    this->DepthOrArraySize = arraySize;
+    this->MipLevels        = mipLevels;
+    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
+    this->Alignment        = 0;
+    this->Format           = format;
+    this->SampleDesc       = { 1, 0 };
+
+    return *this;
+}
+
+//=====================================================================================================================
+// Initialise builder as texture2D
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::Texture2D(
+    uint64_t width, uint32_t height, DXGI_FORMAT format, uint16_t arraySize, uint16_t mipLevels)
+{
+    AR_INSTRUMENT(Texture2D);
+
+    *this = ResourceBuilder{};
+
+    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
+
+    this->Width            = width;
+    this->Height           = height;
+    this->DepthOrArraySize = arraySize;
+    this->MipLevels        = mipLevels;
+    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    this->Alignment        = 0;
+    this->Format           = format;
+    this->SampleDesc       = { 1, 0 };
+
+    return *this;
+}
+
+//=====================================================================================================================
+// Initialise builder as texture3D
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::Texture3D(
+    uint64_t width, uint32_t height, uint16_t depth, DXGI_FORMAT format, uint16_t mipLevels)
+{
+    AR_INSTRUMENT(Texture3D);
+
+    *this = ResourceBuilder{};
+
+    this->SetHeapType(D3D12_HEAP_TYPE_DEFAULT);
+
+    this->Width            = width;
+    this->Height           = height;
+    this->DepthOrArraySize = depth;
+    this->MipLevels        = mipLevels;
+    this->Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
+    this->Alignment        = 0;
+    this->Format           = format;
+    this->SampleDesc       = { 1, 0 };
+
+    return *this;
+}
+
+//=====================================================================================================================
+// Set builder resource format
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetFormat(
+    DXGI_FORMAT format)
+{
+    this->Format = format;
+    return *this;
+}
+
+//=====================================================================================================================
+// Set builder sample count and quality
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetSampleCount(
+    uint32_t count, uint32_t quality)
+{
+    this->SampleDesc = { count, quality };
+    return *this;
+}
+
+//=====================================================================================================================
+// Set builder resource flags
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetFlags(
+    D3D12_RESOURCE_FLAGS flags)
+{
+    this->Flags = flags;
+    return *this;
+}
+
+//=====================================================================================================================
+// Set heap type property
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetHeapType(
+    D3D12_HEAP_TYPE type)
+{
+    m_heapType = static_cast<uint8_t>(type);
+    return *this;
+}
+
+//=====================================================================================================================
+// Set heap properties
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetHeapProperties(
+    const D3D12_HEAP_PROPERTIES& properties)
+{
+    m_heapType             = static_cast<uint8_t>(properties.Type);
+    m_cpuPageProperty      = static_cast<uint8_t>(properties.CPUPageProperty);
+    m_memoryPoolPreference = static_cast<uint8_t>(properties.MemoryPoolPreference);
+
+    // Node masks are packed into 8 bits: truncating a ninth node would silently retarget the heap
+    assert((properties.CreationNodeMask <= UINT8_MAX) && (properties.VisibleNodeMask <= UINT8_MAX));
+    m_creationNodeMask     = static_cast<uint8_t>(properties.CreationNodeMask);
+    m_visibleNodeMask      = static_cast<uint8_t>(properties.VisibleNodeMask);
+    return *this;
+}
+
+//=====================================================================================================================
+// Set heap flags
+AR_CONSTEXPR ResourceBuilder& ResourceBuilder::SetHeapFlags(
+    D3D12_HEAP_FLAGS flags)
+{
+    m_heapFlags = static_cast<uint16_t>(flags);
+    return *this;
+}
+
+//=====================================================================================================================
+// Returns the heap properties
+AR_CONSTEXPR D3D12_HEAP_PROPERTIES ResourceBuilder::GetHeapProperties() const
+{
+    D3D12_HEAP_PROPERTIES Properties = {};
+    Properties.Type                  = static_cast<D3D12_HEAP_TYPE>(m_heapType);
+    Properties.CPUPageProperty       = static_cast<D3D12_CPU_PAGE_PROPERTY>(m_cpuPageProperty);
+    Properties.MemoryPoolPreference  = static_cast<D3D12_MEMORY_POOL>(m_memoryPoolPreference);
+    Properties.CreationNodeMask      = m_creationNodeMask;
+    Properties.VisibleNodeMask       = m_visibleNodeMask;
+    return Properties;
+}
+
+//=====================================================================================================================
+// Returns the heap flags
+AR_CONSTEXPR D3D12_HEAP_FLAGS ResourceBuilder::GetHeapFlags() const
+{
+    return static_cast<D3D12_HEAP_FLAGS>(m_heapFlags);
+}
+
+//=====================================================================================================================
+// Returns builder resource description as a color target
+AR_CONSTEXPR ResourceBuilder ResourceBuilder::AsColorTarget(
+    bool allowUAV
+    ) const
+{
+    ResourceBuilder Value = *this;
+    Value.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+    if (allowUAV)
+    {
+        Value.Flags = Value.Flags | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    }
+
+    return Value;
+}
+
+//=====================================================================================================================
+// Returns builder resource description as a depth target
+AR_CONSTEXPR ResourceBuilder ResourceBuilder::AsDepthTarget(
+    bool allowSRV
+    ) const
+{
+    ResourceBuilder Value = *this;
+    Value.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+    if (allowSRV == false)
+    {
+        Value.Flags = Value.Flags | D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+    }
+
+    return Value;
+}
+
+//=====================================================================================================================
+// Returns color target view
+AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC ResourceBuilder::AsColorTargetView(
+    DXGI_FORMAT viewFormat, uint32_t baseMip
+    ) const
+{
+    AR_INSTRUMENT(AsColorTargetView);
+
+    D3D12_RENDER_TARGET_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = ResolveViewFormat(viewFormat);
+    ViewDesc.ViewDimension = GetRTVDimension();
+
+    // Write the union member of the view dimension so 1D and 3D views do not alias the 2D layout
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_RTV_DIMENSION_BUFFER:
+        ViewDesc.Buffer             = {};
+        ViewDesc.Buffer.NumElements = (GetBytesPerBlock(ViewDesc.Format) != 0) ?
+            static_cast<uint32_t>(Width / GetBytesPerBlock(ViewDesc.Format)) : 0;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE1D:
+        ViewDesc.Texture1D          = {};
+        ViewDesc.Texture1D.MipSlice = baseMip;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE3D:
+        ViewDesc.Texture3D          = {};
+        ViewDesc.Texture3D.MipSlice = baseMip;
+        ViewDesc.Texture3D.WSize    = GetMipDepth(baseMip);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DMS:
+        ViewDesc.Texture2DMS = {};
+        break;
+    default:
+        ViewDesc.Texture2D          = {};
+        ViewDesc.Texture2D.MipSlice = baseMip;
+        break;
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns color target view for an array
+AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC ResourceBuilder::AsColorTargetViewArray(
+    DXGI_FORMAT viewFormat,
+    uint16_t    baseMip,
+    uint16_t    baseArray,
+    uint16_t    arraySize
+    ) const
+{
+    AR_INSTRUMENT(AsColorTargetViewArray);
+
+    D3D12_RENDER_TARGET_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = ResolveViewFormat(viewFormat);
+    ViewDesc.ViewDimension = GetRTVDimension(true);
+
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_RTV_DIMENSION_TEXTURE1DARRAY:
+        ViewDesc.Texture1DArray                 = {};
+        ViewDesc.Texture1DArray.MipSlice        = baseMip;
+        ViewDesc.Texture1DArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture1DArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DARRAY:
+        ViewDesc.Texture2DArray                 = {};
+        ViewDesc.Texture2DArray.MipSlice        = baseMip;
+        ViewDesc.Texture2DArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY:
+        ViewDesc.Texture2DMSArray                 = {};
+        ViewDesc.Texture2DMSArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DMSArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE3D:
+        ViewDesc.Texture3D             = {};
+        ViewDesc.Texture3D.MipSlice    = baseMip;
+        ViewDesc.Texture3D.FirstWSlice = baseArray;
+        ViewDesc.Texture3D.WSize       = ClampCount(baseArray, arraySize, GetMipDepth(baseMip));
+        break;
+    default: // Single slice resources
+        return AsColorTargetView(viewFormat, baseMip);
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns depth stencil view
+AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC ResourceBuilder::AsDepthStencilView(
+    DXGI_FORMAT viewFormat, uint16_t baseMip
+    ) const
+{
+    AR_INSTRUMENT(AsDepthStencilView);
+
+    D3D12_DEPTH_STENCIL_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = ResolveDepthViewFormat(viewFormat);
+    ViewDesc.ViewDimension = GetDSVDimension();
+
+    if (ViewDesc.ViewDimension == D3D12_DSV_DIMENSION_TEXTURE2DMS)
+    {
+        ViewDesc.Texture2DMS = {};
+    }
+    else
+    {
+        ViewDesc.Texture2D          = {};
+        ViewDesc.Texture2D.MipSlice = baseMip;
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns depth stencil view for an array
+AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC ResourceBuilder::AsDepthStencilViewArray(
+    DXGI_FORMAT viewFormat,
+    uint16_t    baseMip,
+    uint16_t    baseArray,
+    uint16_t    arraySize
+    ) const
+{
+    AR_INSTRUMENT(AsDepthStencilViewArray);
+
+    D3D12_DEPTH_STENCIL_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = ResolveDepthViewFormat(viewFormat);
+    ViewDesc.ViewDimension = GetDSVDimension(true);
+
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_DSV_DIMENSION_TEXTURE2DARRAY:
+        ViewDesc.Texture2DArray                 = {};
+        ViewDesc.Texture2DArray.MipSlice        = baseMip;
+        ViewDesc.Texture2DArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY:
+        ViewDesc.Texture2DMSArray                 = {};
+        ViewDesc.Texture2DMSArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DMSArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    default: // Single slice resources
+        return AsDepthStencilView(viewFormat, baseMip);
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns shader resource view
+AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsShaderResourceView(
+    DXGI_FORMAT viewFormat,
+    uint16_t    baseMip,
+    uint16_t    mipLevels,
+    float       minLod
+    ) const
+{
+    AR_INSTRUMENT(AsShaderResourceView);
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return AsBufferResourceView(0, 0xffffffff, 0, viewFormat);
+    }
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format                  = ResolveViewFormat(viewFormat);
+    ViewDesc.ViewDimension           = GetSRVDimension();
+    ViewDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+
+    // Write the union member of the view dimension so 1D and 3D views do not alias the 2D layout
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_SRV_DIMENSION_TEXTURE1D:
+        ViewDesc.Texture1D                     = {};
+        ViewDesc.Texture1D.MostDetailedMip     = baseMip;
+        ViewDesc.Texture1D.MipLevels           = ClampCount(baseMip, mipLevels, GetMipCount());
+        ViewDesc.Texture1D.ResourceMinLODClamp = minLod;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE3D:
+        ViewDesc.Texture3D                     = {};
+        ViewDesc.Texture3D.MostDetailedMip     = baseMip;
+        ViewDesc.Texture3D.MipLevels           = ClampCount(baseMip, mipLevels, GetMipCount());
+        ViewDesc.Texture3D.ResourceMinLODClamp = minLod;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DMS:
+        ViewDesc.Texture2DMS = {};
+        break;
+    default:
+        ViewDesc.Texture2D                     = {};
+        ViewDesc.Texture2D.MostDetailedMip     = baseMip;
+        ViewDesc.Texture2D.MipLevels           = ClampCount(baseMip, mipLevels, GetMipCount());
+        ViewDesc.Texture2D.ResourceMinLODClamp = minLod;
+        break;
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns shader resource view
+AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsBufferResourceView(
+    uint32_t    firstElement,
+    uint32_t    numElements,
+    uint32_t    byteStride,
+    DXGI_FORMAT viewFormat
+    ) const
+{
+    AR_INSTRUMENT(AsBufferResourceView);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format                        = viewFormat;
+    ViewDesc.ViewDimension                 = D3D12_SRV_DIMENSION_BUFFER;
+    ViewDesc.Buffer.FirstElement           = firstElement;
+    ViewDesc.Buffer.NumElements            = numElements;
+    ViewDesc.Buffer.StructureByteStride    = byteStride;
+
+    if ((byteStride == 0) && (viewFormat == DXGI_FORMAT_UNKNOWN))
+    {
+        ViewDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
+    }
+
+    ViewDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+
+    ///TODO: Clamp NumElements to resource Width / byteStride (assume 4-byte for raw buffers)
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns shader resource view for an array
+AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC ResourceBuilder::AsShaderResourceViewArray(
+    DXGI_FORMAT viewFormat,
+    uint16_t    baseMip,
+    uint16_t    baseArray,
+    uint16_t    mipLevels,
+    uint16_t    arraySize,
+    float       minLod
+    ) const
+{
+    AR_INSTRUMENT(AsShaderResourceViewArray);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format                  = ResolveViewFormat(viewFormat);
+    ViewDesc.ViewDimension           = GetSRVDimension(true);
+    ViewDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_SRV_DIMENSION_TEXTURE1DARRAY:
+        ViewDesc.Texture1DArray                     = {};
+        ViewDesc.Texture1DArray.MostDetailedMip     = baseMip;
+        ViewDesc.Texture1DArray.MipLevels           = ClampCount(baseMip, mipLevels, GetMipCount());
+        ViewDesc.Texture1DArray.FirstArraySlice     = baseArray;
+        ViewDesc.Texture1DArray.ArraySize           = ClampCount(baseArray, arraySize, GetArraySize());
+        ViewDesc.Texture1DArray.ResourceMinLODClamp = minLod;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:
+        ViewDesc.Texture2DArray                     = {};
+        ViewDesc.Texture2DArray.MostDetailedMip     = baseMip;
+        ViewDesc.Texture2DArray.MipLevels           = ClampCount(baseMip, mipLevels, GetMipCount());
+        ViewDesc.Texture2DArray.FirstArraySlice     = baseArray;
+        ViewDesc.Texture2DArray.ArraySize           = ClampCount(baseArray, arraySize, GetArraySize());
+        ViewDesc.Texture2DArray.ResourceMinLODClamp = minLod;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY:
+        ViewDesc.Texture2DMSArray                 = {};
+        ViewDesc.Texture2DMSArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DMSArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    default: // Single slice resources (3D textures have no array views)
+        return AsShaderResourceView(viewFormat, baseMip, mipLevels, minLod);
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns unordered access view
+AR_CONSTEXPR D3D12_UNORDERED_ACCESS_VIEW_DESC ResourceBuilder::AsUnorderedAccessView(
+    DXGI_FORMAT viewFormat, uint16_t mipSlice
+    ) const
+{
+    AR_INSTRUMENT(AsUnorderedAccessView);
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = GetLinearFormat(ResolveViewFormat(viewFormat));
+    ViewDesc.ViewDimension = GetUAVDimension();
+
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_UAV_DIMENSION_BUFFER:
+        // Buffers get a typed view of the requested format, or a raw view when none is given
+        ViewDesc.Buffer = {};
+
+        if (ViewDesc.Format == DXGI_FORMAT_UNKNOWN)
+        {
+            ViewDesc.Format       = DXGI_FORMAT_R32_TYPELESS;
+            ViewDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+        }
+
+        ViewDesc.Buffer.NumElements = (GetBytesPerBlock(ViewDesc.Format) != 0) ?
+            static_cast<uint32_t>(Width / GetBytesPerBlock(ViewDesc.Format)) : 0;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE1D:
+        ViewDesc.Texture1D          = {};
+        ViewDesc.Texture1D.MipSlice = mipSlice;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE3D:
+        ViewDesc.Texture3D          = {};
+        ViewDesc.Texture3D.MipSlice = mipSlice;
+        ViewDesc.Texture3D.WSize    = GetMipDepth(mipSlice);
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE2D:
+        ViewDesc.Texture2D          = {};
+        ViewDesc.Texture2D.MipSlice = mipSlice;
+        break;
+    default: // MSAA textures have no unordered access views
+        break;
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns unordered access view for an array
+AR_CONSTEXPR D3D12_UNORDERED_ACCESS_VIEW_DESC ResourceBuilder::AsUnorderedAccessViewArray(
+    DXGI_FORMAT viewFormat,
+    uint16_t    mipSlice,
+    uint16_t    baseArray,
+    uint16_t    arraySize
+    ) const
+{
+    AR_INSTRUMENT(AsUnorderedAccessViewArray);
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC ViewDesc = {};
+    ViewDesc.Format        = GetLinearFormat(ResolveViewFormat(viewFormat));
+    ViewDesc.ViewDimension = GetUAVDimension(true);
+
+    switch (ViewDesc.ViewDimension)
+    {
+    case D3D12_UAV_DIMENSION_TEXTURE1DARRAY:
+        ViewDesc.Texture1DArray                 = {};
+        ViewDesc.Texture1DArray.MipSlice        = mipSlice;
+        ViewDesc.Texture1DArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture1DArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE2DARRAY:
+        ViewDesc.Texture2DArray                 = {};
+        ViewDesc.Texture2DArray.MipSlice        = mipSlice;
+        ViewDesc.Texture2DArray.FirstArraySlice = baseArray;
+        ViewDesc.Texture2DArray.ArraySize       = ClampCount(baseArray, arraySize, GetArraySize());
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE3D:
+        ViewDesc.Texture3D             = {};
+        ViewDesc.Texture3D.MipSlice    = mipSlice;
+        ViewDesc.Texture3D.FirstWSlice = baseArray;
+        ViewDesc.Texture3D.WSize       = ClampCount(baseArray, arraySize, GetMipDepth(mipSlice));
+        break;
+    default: // Single slice resources
+        return AsUnorderedAccessView(viewFormat, mipSlice);
+    }
+
+    return ViewDesc;
+}
+
+//=====================================================================================================================
+// Returns the number of views of each type BuildMipViews writes for a range
+AR_CONSTEXPR uint32_t ResourceBuilder::GetMipViewCount(
+    const MipViewRange& range
+    ) const
+{
+    const uint32_t mipCount   = ClampCount(range.BaseMip, range.MipLevels, GetMipCount());
+    const uint32_t sliceCount = ClampCount(range.BaseArray, range.ArraySize, GetArraySize());
+
+    // Depth slices shrink with every mip, so 3D textures have no per-slice views and no array range to start
+    const bool isSliced3D = (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) &&
+                            (range.PerSlice || (range.BaseArray != 0));
+
+    if ((Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) || (mipCount == 0) || (sliceCount == 0) || isSliced3D)
+    {
+        return 0;
+    }
+
+    return range.PerSlice ? (mipCount * sliceCount) : mipCount;
+}
+
+//=====================================================================================================================
+// Builds single-mip shader resource and unordered access views for every mip in a range
+AR_CONSTEXPR uint32_t ResourceBuilder::BuildMipViews(
+    const MipViewRange&               range,
+    uint32_t                          capacity,
+    D3D12_SHADER_RESOURCE_VIEW_DESC*  pSrvs,
+    D3D12_UNORDERED_ACCESS_VIEW_DESC* pUavs
+    ) const
+{
+    AR_INSTRUMENT(BuildMipViews);
+
+    const uint32_t viewCount = GetMipViewCount(range);
+
+    if ((viewCount == 0) || (viewCount > capacity) ||
+        ((pUavs != nullptr) && (GetUAVDimension() == D3D12_UAV_DIMENSION_UNKNOWN)))
+    {
+        return 0;
+    }
+
+    const uint32_t mipCount   = ClampCount(range.BaseMip, range.MipLevels, GetMipCount());
+    const uint32_t sliceCount = range.PerSlice ? ClampCount(range.BaseArray, range.ArraySize, GetArraySize()) : 1;
+    const uint16_t viewSlices = range.PerSlice ? 1 :
+                                (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+                                static_cast<uint16_t>(D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION) : range.ArraySize;
+
+    // The array variants fall back to single slice views on resources without array views
+    for (uint32_t slice = 0; slice < sliceCount; slice++)
+    {
+        const uint16_t baseArray = static_cast<uint16_t>(range.BaseArray + slice);
+
+        for (uint32_t mip = 0; mip < mipCount; mip++)
+        {
+            const uint32_t index    = slice * mipCount + mip;
+            const uint16_t mipSlice = static_cast<uint16_t>(range.BaseMip + mip);
+
+            if (pSrvs != nullptr)
+            {
+                pSrvs[index] = AsShaderResourceViewArray(range.SrvFormat, mipSlice, baseArray, 1, viewSlices);
+            }
+
+            if (pUavs != nullptr)
+            {
+                pUavs[index] = AsUnorderedAccessViewArray(range.UavFormat, mipSlice, baseArray, viewSlices);
+            }
+        }
+    }
+
+    return viewCount;
+}
+
+//=====================================================================================================================
+// Returns the render target view dimension
+AR_CONSTEXPR D3D12_RTV_DIMENSION ResourceBuilder::GetRTVDimension(
+    bool array
+    ) const
+{
+    const bool isArray = array && (DepthOrArraySize != 1);
+
+    switch (Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        return D3D12_RTV_DIMENSION_BUFFER;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+        return isArray ? D3D12_RTV_DIMENSION_TEXTURE1DARRAY : D3D12_RTV_DIMENSION_TEXTURE1D;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+        // Array views of 3D textures select a W slice range
+        return D3D12_RTV_DIMENSION_TEXTURE3D;
+    default:
+        if (SampleDesc.Count > 1)
+        {
+            return isArray ? D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY : D3D12_RTV_DIMENSION_TEXTURE2DMS;
+        }
+
+        return isArray ? D3D12_RTV_DIMENSION_TEXTURE2DARRAY : D3D12_RTV_DIMENSION_TEXTURE2D;
+    }
+}
+
+//=====================================================================================================================
+// Returns the depth-stencil view dimension
+AR_CONSTEXPR D3D12_DSV_DIMENSION ResourceBuilder::GetDSVDimension(
+    bool array
+    ) const
+{
+    if (Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D)
+    {
+        return D3D12_DSV_DIMENSION_UNKNOWN; // Not supported
+    }
+
+    const bool isArray = array && (DepthOrArraySize != 1);
+
+    if (SampleDesc.Count > 1)
+    {
+        return isArray ? D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY : D3D12_DSV_DIMENSION_TEXTURE2DMS;
+    }
+
+    return isArray ? D3D12_DSV_DIMENSION_TEXTURE2DARRAY : D3D12_DSV_DIMENSION_TEXTURE2D;
+}
+
+//=====================================================================================================================
+// Returns the shader resource view dimension
+AR_CONSTEXPR D3D12_SRV_DIMENSION ResourceBuilder::GetSRVDimension(
+    bool array
+    ) const
+{
+    const bool isArray = array && (DepthOrArraySize != 1);
+
+    switch (Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        return D3D12_SRV_DIMENSION_BUFFER;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+        return isArray ? D3D12_SRV_DIMENSION_TEXTURE1DARRAY : D3D12_SRV_DIMENSION_TEXTURE1D;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+        return D3D12_SRV_DIMENSION_TEXTURE3D;
+    default:
+        if (SampleDesc.Count > 1)
+        {
+            return isArray ? D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY : D3D12_SRV_DIMENSION_TEXTURE2DMS;
+        }
+
+        return isArray ? D3D12_SRV_DIMENSION_TEXTURE2DARRAY : D3D12_SRV_DIMENSION_TEXTURE2D;
+    }
+}
+
+//=====================================================================================================================
+// Returns the unordered access view dimension
+AR_CONSTEXPR D3D12_UAV_DIMENSION ResourceBuilder::GetUAVDimension(
+    bool array
+    ) const
+{
+    const bool isArray = array && (DepthOrArraySize != 1);
+
+    switch (Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        return D3D12_UAV_DIMENSION_BUFFER;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+        return isArray ? D3D12_UAV_DIMENSION_TEXTURE1DARRAY : D3D12_UAV_DIMENSION_TEXTURE1D;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+        return D3D12_UAV_DIMENSION_TEXTURE3D;
+    default:
+        if (SampleDesc.Count > 1)
+        {
+            return D3D12_UAV_DIMENSION_UNKNOWN; // Not supported
+        }
+
+        return isArray ? D3D12_UAV_DIMENSION_TEXTURE2DARRAY : D3D12_UAV_DIMENSION_TEXTURE2D;
+    }
+}
+
+//=====================================================================================================================
+// Returns the color/shader view format for the resource
+AR_CONSTEXPR DXGI_FORMAT ResourceBuilder::ResolveViewFormat(
+    DXGI_FORMAT viewFormat
+    ) const
+{
+    // Buffers have no format of their own: typed buffer views take the requested format
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return viewFormat;
+    }
+
+    if (IsTypeless(Format) == false)
+    {
+        return Format;
+    }
+
+    return (viewFormat != DXGI_FORMAT_UNKNOWN) ? viewFormat : GetDefaultViewFormat(Format);
+}
+
+//=====================================================================================================================
+// Returns the depth-stencil view format for the resource
+AR_CONSTEXPR DXGI_FORMAT ResourceBuilder::ResolveDepthViewFormat(
+    DXGI_FORMAT viewFormat
+    ) const
+{
+    if (IsTypeless(Format) == false)
+    {
+        return Format;
+    }
+
+    return (viewFormat != DXGI_FORMAT_UNKNOWN) ? viewFormat : GetDefaultDepthViewFormat(Format);
+}
+
+//=====================================================================================================================
+// Returns the number of elements of [base, base + count) that lie inside [0, total)
+AR_CONSTEXPR uint32_t ResourceBuilder::ClampCount(
+    uint32_t base, uint32_t count, uint32_t total)
+{
+    return (base < total) ? std::min(count, total - base) : 0;
+}
+
+//=====================================================================================================================
+// Returns the W slice count of a 3D texture mip
+AR_CONSTEXPR uint32_t ResourceBuilder::GetMipDepth(
+    uint32_t mip
+    ) const
+{
+    return std::max(1u, static_cast<uint32_t>(DepthOrArraySize) >> std::min(mip, 31u));
+}
+
+//=====================================================================================================================
+// Returns the mip level count
+AR_CONSTEXPR uint32_t ResourceBuilder::GetMipCount() const
+{
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return 1;
+    }
+
+    if (MipLevels != 0)
+    {
+        return MipLevels;
+    }
+
+    uint64_t largest = std::max<uint64_t>(Width, Height);
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+        largest = std::max<uint64_t>(largest, DepthOrArraySize);
+    }
+
+    uint32_t mipCount = 1;
+
+    while (largest > 1)
+    {
+        largest >>= 1;
+        mipCount++;
+    }
+
+    return mipCount;
+}
+
+//=====================================================================================================================
+// Returns the array slice count
+AR_CONSTEXPR uint32_t ResourceBuilder::GetArraySize() const
+{
+    return ((Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) || (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)) ?
+        1 : DepthOrArraySize;
+}
+
+//=====================================================================================================================
+// Returns the plane count of the resource format
+AR_CONSTEXPR uint32_t ResourceBuilder::GetPlaneCount() const
+{
+    return (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) ? 1 : std::max(1u, AR::GetPlaneCount(Format));
+}
+
+//=====================================================================================================================
+// Returns the subresource count
+AR_CONSTEXPR uint32_t ResourceBuilder::GetSubresourceCount() const
+{
+    return GetMipCount() * GetArraySize() * GetPlaneCount();
+}
+
+//=====================================================================================================================
+// Returns the subresource index for a mip, array slice and plane
+AR_CONSTEXPR uint32_t ResourceBuilder::CalcSubresource(
+    uint32_t mipSlice, uint32_t arraySlice, uint32_t planeSlice
+    ) const
+{
+    return mipSlice + (arraySlice * GetMipCount()) + (planeSlice * GetMipCount() * GetArraySize());
+}
+
+//=====================================================================================================================
+// Returns the copyable footprint of one subresource
+AR_CONSTEXPR D3D12_PLACED_SUBRESOURCE_FOOTPRINT ResourceBuilder::GetSubresourceFootprint(
+    uint32_t  subresource,
+    uint64_t  offset,
+    uint32_t* pNumRows,
+    uint64_t* pRowSize
+    ) const
+{
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT Layout = {};
+    Layout.Offset = offset;
+
+    uint32_t numRows = 1;
+    uint64_t rowSize = Width;
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        Layout.Footprint.Format   = DXGI_FORMAT_UNKNOWN;
+        Layout.Footprint.Width    = static_cast<uint32_t>(Width);
+        Layout.Footprint.Height   = 1;
+        Layout.Footprint.Depth    = 1;
+        Layout.Footprint.RowPitch = static_cast<uint32_t>(AlignUp(Width, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+    }
+    else
+    {
+        const uint32_t    mipCount   = GetMipCount();
+        const uint32_t    mipSlice   = subresource % mipCount;
+        const uint32_t    planeSlice = subresource / (mipCount * GetArraySize());
+        const PlaneLayout plane      = GetPlaneLayout(Format, planeSlice);
+        const FormatInfo& info       = GetFormatInfo(plane.Format);
+
+        const uint64_t width  = std::max<uint64_t>(1, Width >> mipSlice);
+        const uint32_t height = std::max(1u, Height >> mipSlice);
+        const uint32_t depth  = (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+            std::max(1u, static_cast<uint32_t>(DepthOrArraySize) >> mipSlice) : 1u;
+
+        const uint64_t planeWidth  = (width + (1ull << plane.WidthShift) - 1) >> plane.WidthShift;
+        const uint32_t planeHeight = (height + (1u << plane.HeightShift) - 1) >> plane.HeightShift;
+
+        const uint64_t alignedWidth  = AlignUp(planeWidth, info.BlockWidth);
+        const uint32_t alignedHeight = static_cast<uint32_t>(AlignUp(planeHeight, info.BlockHeight));
+
+        numRows = alignedHeight / info.BlockHeight;
+        rowSize = (alignedWidth / info.BlockWidth) * (info.BitsPerBlock / 8);
+
+        Layout.Footprint.Format   = plane.Format;
+        Layout.Footprint.Width    = static_cast<uint32_t>(alignedWidth);
+        Layout.Footprint.Height   = alignedHeight;
+        Layout.Footprint.Depth    = depth;
+        Layout.Footprint.RowPitch = static_cast<uint32_t>(AlignUp(rowSize, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+    }
+
+    if (pNumRows != nullptr)
+    {
+        *pNumRows = numRows;
+    }
+
+    if (pRowSize != nullptr)
+    {
+        *pRowSize = rowSize;
+    }
+
+    return Layout;
+}
+
+//=====================================================================================================================
+// Computes placed subresource footprints without a device
+AR_CONSTEXPR void ResourceBuilder::GetCopyableFootprints(
+    uint32_t                            firstSubresource,
+    uint32_t                            numSubresources,
+    uint64_t                            baseOffset,
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts,
+    uint32_t*                           pNumRows,
+    uint64_t*                           pRowSizeInBytes,
+    uint64_t*                           pTotalBytes
+    ) const
+{
+    // Buffers have the single subresource 0. The texture range check cannot wrap for large subresource indices.
+    const uint32_t subresourceCount = GetSubresourceCount();
+
+    const bool isValid = (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) ?
+                         ((firstSubresource == 0) && (numSubresources <= 1)) :
+                         ((GetFormatInfo(Format).BitsPerBlock != 0) && (firstSubresource <= subresourceCount) &&
+                          (numSubresources <= subresourceCount - firstSubresource));
+
+    // Placement alignment applies to the offset relative to baseOffset
+    uint64_t offset = 0;
+    uint64_t end    = 0;
+
+    for (uint32_t i = 0; i < numSubresources; i++)
+    {
+        uint32_t numRows = UINT32_MAX;
+        uint64_t rowSize = UINT64_MAX;
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT Layout = {};
+
+        if (isValid)
+        {
+            if (Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                offset = AlignUp(offset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+            }
+
+            Layout = GetSubresourceFootprint(firstSubresource + i, baseOffset + offset, &numRows, &rowSize);
+
+            const uint32_t totalRows = numRows * Layout.Footprint.Depth;
+
+            end    = offset + (uint64_t(Layout.Footprint.RowPitch) * (totalRows - 1)) + rowSize;
+            offset = offset + (uint64_t(Layout.Footprint.RowPitch) * totalRows);
+        }
+        else
+        {
+            Layout.Offset = UINT64_MAX;
+        }
+
+        if (pLayouts != nullptr)
+        {
+            pLayouts[i] = Layout;
+        }
+
+        if (pNumRows != nullptr)
+        {
+            pNumRows[i] = numRows;
+        }
+
+        if (pRowSizeInBytes != nullptr)
+        {
+            pRowSizeInBytes[i] = rowSize;
+        }
+    }
+
+    if (pTotalBytes != nullptr)
+    {
+        *pTotalBytes = isValid ? end : UINT64_MAX;
+    }
+}
+
+//=====================================================================================================================
+// Estimates the placement size and alignment of the resource
+AR_CONSTEXPR D3D12_RESOURCE_ALLOCATION_INFO ResourceBuilder::GetAllocationInfo() const
+{
+    D3D12_RESOURCE_ALLOCATION_INFO Info = {};
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        Info.Alignment   = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        Info.SizeInBytes = AlignUp(Width, Info.Alignment);
+        return Info;
+    }
+
+    uint64_t totalBytes = 0;
+    GetCopyableFootprints(0, GetSubresourceCount(), 0, nullptr, nullptr, nullptr, &totalBytes);
+
+    if (totalBytes == UINT64_MAX)
+    {
+        Info.SizeInBytes = UINT64_MAX;
+        Info.Alignment   = UINT64_MAX;
+        return Info;
+    }
+
+    uint32_t numRows = 0;
+    const D3D12_PLACED_SUBRESOURCE_FOOTPRINT TopMip = GetSubresourceFootprint(0, 0, &numRows);
+
+    const uint64_t samples     = std::max(1u, SampleDesc.Count);
+    const uint64_t topMipBytes = uint64_t(TopMip.Footprint.RowPitch) * numRows * TopMip.Footprint.Depth * samples;
+    const bool     isMsaa      = (samples > 1);
+    const bool     isUndefined = (Layout == D3D12_TEXTURE_LAYOUT_UNKNOWN);
+    const bool     isTarget    =
+        (Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+
+    // Small placement requires an undefined layout and a most detailed mip that fits the next alignment class
+    uint64_t smallAlignment   = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+    uint64_t defaultAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    bool     allowSmall       = isUndefined && (isTarget == false) && (topMipBytes <= defaultAlignment);
+
+    if (isMsaa)
+    {
+        smallAlignment   = D3D12_SMALL_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+        defaultAlignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+        allowSmall       = isUndefined && (topMipBytes <= defaultAlignment);
+    }
+
+    if (Alignment == 0)
+    {
+        Info.Alignment = allowSmall ? smallAlignment : defaultAlignment;
+    }
+    else if ((Alignment == defaultAlignment) || ((Alignment == smallAlignment) && allowSmall))
+    {
+        Info.Alignment = Alignment;
+    }
+    else
+    {
+        // The device rejects illegal alignment requests
+        Info.SizeInBytes = UINT64_MAX;
+        Info.Alignment   = UINT64_MAX;
+        return Info;
+    }
+
+    Info.SizeInBytes = AlignUp(totalBytes * samples, Info.Alignment);
+
+    return Info;
+}
+
+//=====================================================================================================================
+// Returns the standard tile shape of a reserved resource
+AR_CONSTEXPR D3D12_TILE_SHAPE ResourceBuilder::GetStandardTileShape() const
+{
+    D3D12_TILE_SHAPE Shape = {};
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        Shape.WidthInTexels  = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        Shape.HeightInTexels = 1;
+        Shape.DepthInTexels  = 1;
+        return Shape;
+    }
+
+    const FormatInfo& info = GetFormatInfo(Format);
+    const uint32_t    bits = info.BitsPerBlock;
+
+    const bool hasStandardShape = (Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE1D) &&
+                                  (info.PlaneCount == 1) &&
+                                  (info.BlockWidth == info.BlockHeight) &&
+                                  ((info.BlockWidth == 1) || (info.BlockWidth == 4)) &&
+                                  (bits >= 8) && (bits <= 128) && ((bits & (bits - 1)) == 0);
+
+    if (hasStandardShape == false)
+    {
+        return Shape;
+    }
+
+    // A 64KB tile holds 2^log2Elements texels (blocks for block compressed formats)
+    uint32_t log2Bytes = 0;
+
+    for (uint32_t bytes = bits / 8; bytes > 1; bytes >>= 1)
+    {
+        log2Bytes++;
+    }
+
+    const uint32_t log2Elements = 16 - log2Bytes;
+
+    if (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+        const uint32_t log2Depth  = log2Elements / 3;
+        const uint32_t log2Height = (log2Elements + 1) / 3;
+        const uint32_t log2Width  = log2Elements - log2Depth - log2Height;
+
+        Shape.WidthInTexels  = info.BlockWidth << log2Width;
+        Shape.HeightInTexels = info.BlockHeight << log2Height;
+        Shape.DepthInTexels  = 1u << log2Depth;
+    }
+    else
+    {
+        uint32_t log2Samples = 0;
+
+        for (uint32_t samples = SampleDesc.Count; samples > 1; samples >>= 1)
+        {
+            log2Samples++;
+        }
+
+        // Each doubling of the sample count halves the width and height alternately, width first
+        const uint32_t log2Width  = (log2Elements - log2Elements / 2) - (log2Samples + 1) / 2;
+        const uint32_t log2Height = (log2Elements / 2) - log2Samples / 2;
+
+        Shape.WidthInTexels  = info.BlockWidth << log2Width;
+        Shape.HeightInTexels = info.BlockHeight << log2Height;
+        Shape.DepthInTexels  = 1;
+    }
+
+    return Shape;
+}
+
+//=====================================================================================================================
+// Computes reserved resource tiling without a device
+AR_CONSTEXPR void ResourceBuilder::GetResourceTiling(
+    uint32_t*                 pNumTilesForEntireResource,
+    D3D12_PACKED_MIP_INFO*    pPackedMipDesc,
+    D3D12_TILE_SHAPE*         pStandardTileShape,
+    uint32_t*                 pNumSubresourceTilings,
+    uint32_t                  firstSubresourceTiling,
+    D3D12_SUBRESOURCE_TILING* pSubresourceTilings
+    ) const
+{
+    const D3D12_TILE_SHAPE Shape     = GetStandardTileShape();
+    const bool             isValid   = (Shape.WidthInTexels != 0);
+    const bool             isBuffer  = (Dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+    const uint32_t         mipCount  = GetMipCount();
+    const uint32_t         arraySize = GetArraySize();
+    const FormatInfo&      info      = GetFormatInfo(Format);
+
+    // Returns the tile grid of a mip (zero when the mip is packed)
+    const auto getMipTiling = [&](uint32_t mip)
+    {
+        D3D12_SUBRESOURCE_TILING Tiling = {};
+
+        const uint64_t width  = isBuffer ? Width : std::max<uint64_t>(1, Width >> mip);
+        const uint32_t height = std::max(1u, Height >> mip);
+        const uint32_t depth  = (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+            std::max(1u, static_cast<uint32_t>(DepthOrArraySize) >> mip) : 1u;
+
+        if (isBuffer ||
+            ((width >= Shape.WidthInTexels) && (height >= Shape.HeightInTexels) && (depth >= Shape.DepthInTexels)))
+        {
+            Tiling.WidthInTiles  = static_cast<uint32_t>((width + Shape.WidthInTexels - 1) / Shape.WidthInTexels);
+            Tiling.HeightInTiles = static_cast<uint16_t>((height + Shape.HeightInTexels - 1) / Shape.HeightInTexels);
+            Tiling.DepthInTiles  = static_cast<uint16_t>((depth + Shape.DepthInTexels - 1) / Shape.DepthInTexels);
+        }
+
+        return Tiling;
+    };
+
+    uint32_t standardMips  = 0;
+    uint32_t standardTiles = 0;
+    uint64_t packedBytes   = 0;
+
+    for (uint32_t mip = 0; isValid && (mip < mipCount); mip++)
+    {
+        const D3D12_SUBRESOURCE_TILING Tiling = getMipTiling(mip);
+
+        if ((Tiling.WidthInTiles != 0) && (standardMips == mip))
+        {
+            standardMips++;
+            standardTiles += Tiling.WidthInTiles * Tiling.HeightInTiles * Tiling.DepthInTiles;
+        }
+        else
+        {
+            const uint64_t width  = std::max<uint64_t>(1, Width >> mip);
+            const uint64_t height = std::max(1u, Height >> mip);
+            const uint64_t depth  = (Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+                std::max(1u, static_cast<uint32_t>(DepthOrArraySize) >> mip) : 1u;
+
+            packedBytes += ((width + info.BlockWidth - 1) / info.BlockWidth) *
+                           ((height + info.BlockHeight - 1) / info.BlockHeight) * depth * (info.BitsPerBlock / 8);
+        }
+    }
+
+    const uint32_t packedMips  = isValid ? (mipCount - standardMips) : 0;
+    const uint32_t packedTiles = (packedMips > 0) ?
+        static_cast<uint32_t>(std::max<uint64_t>(1, AlignUp(packedBytes, D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES) /
+                                                    D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES)) : 0;
+    const uint32_t sliceTiles  = standardTiles + packedTiles;
+
+    if (pNumTilesForEntireResource != nullptr)
+    {
+        *pNumTilesForEntireResource = sliceTiles * arraySize;
+    }
+
+    if (pPackedMipDesc != nullptr)
+    {
+        *pPackedMipDesc = {};
+        pPackedMipDesc->NumStandardMips                 = static_cast<uint8_t>(standardMips);
+        pPackedMipDesc->NumPackedMips                   = static_cast<uint8_t>(packedMips);
+        pPackedMipDesc->NumTilesForPackedMips           = packedTiles;
+        pPackedMipDesc->StartTileIndexInOverallResource = (packedMips > 0) ? standardTiles : 0;
+    }
+
+    if (pStandardTileShape != nullptr)
+    {
+        *pStandardTileShape = Shape;
+    }
+
+    if (pNumSubresourceTilings != nullptr)
+    {
+        const uint32_t subresourceCount = isValid ? (mipCount * arraySize) : 0;
+        const uint32_t first            = std::min(firstSubresourceTiling, subresourceCount);
+        const uint32_t count            = std::min(*pNumSubresourceTilings, subresourceCount - first);
+
+        for (uint32_t i = 0; (i < count) && (pSubresourceTilings != nullptr); i++)
+        {
+            const uint32_t mip   = (first + i) % mipCount;
+            const uint32_t slice = (first + i) / mipCount;
+
+            D3D12_SUBRESOURCE_TILING Tiling = {};
+            Tiling.StartTileIndexInOverallResource = D3D12_PACKED_TILE;
+
+            if (mip < standardMips)
+            {
+                Tiling = getMipTiling(mip);
+                Tiling.StartTileIndexInOverallResource = slice * sliceTiles;
+
+                for (uint32_t coarser = 0; coarser < mip; coarser++)
+                {
+                    const D3D12_SUBRESOURCE_TILING Previous = getMipTiling(coarser);
+                    Tiling.StartTileIndexInOverallResource +=
+                        Previous.WidthInTiles * Previous.HeightInTiles * Previous.DepthInTiles;
+                }
+            }
+
+            pSubresourceTilings[i] = Tiling;
+        }
+
+        *pNumSubresourceTilings = count;
+    }
+}
+
+//=====================================================================================================================
+// Estimates allocation info for a set of resources placed back to back in one heap
+AR_CONSTEXPR D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo(
+    const ResourceBuilder*           pBuilders,
+    uint32_t                         count,
+    D3D12_RESOURCE_ALLOCATION_INFO1* pInfos)
+{
+    D3D12_RESOURCE_ALLOCATION_INFO Total = {};
+    Total.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const D3D12_RESOURCE_ALLOCATION_INFO Info = pBuilders[i].GetAllocationInfo();
+
+        if (Info.SizeInBytes == UINT64_MAX)
+        {
+            Total.SizeInBytes = UINT64_MAX;
+            Total.Alignment   = UINT64_MAX;
+        }
+
+        const uint64_t offset = (Total.SizeInBytes == UINT64_MAX) ?
+            UINT64_MAX : AlignUp(Total.SizeInBytes, Info.Alignment);
+
+        if (pInfos != nullptr)
+        {
+            pInfos[i].Offset      = offset;
+            pInfos[i].Alignment   = Info.Alignment;
+            pInfos[i].SizeInBytes = Info.SizeInBytes;
+        }
+
+        if (Total.SizeInBytes != UINT64_MAX)
+        {
+            Total.SizeInBytes = offset + Info.SizeInBytes;
+            Total.Alignment   = std::max(Total.Alignment, Info.Alignment);
+        }
+    }
+
+    return Total;
+}
 } // AR
\ No newline at end of file
@@ -0,0 +1,335 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "ResourceCache.h"
+#include <cstring>
+#include <thread>
+
+namespace AR {
+
+//=====================================================================================================================
+// Private data interface attached to every cached resource. The resource releases it on destruction, which
+// invalidates the cache entry while the resource address is still reserved.
+class ResourceCache::ReleaseToken final : public IUnknown
+{
+public:
+    ReleaseToken(const std::shared_ptr<TokenOwner>& owner, ID3D12Resource* pResource) :
+        m_refCount(1),
+        m_owner(owner),
+        m_pResource(pResource)
+    {
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+    {
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+
+        if (refCount == 0)
+        {
+            delete this;
+        }
+
+        return refCount;
+    }
+
+private:
+    ~ReleaseToken()
+    {
+        std::lock_guard<std::mutex> lock(m_owner->Lock);
+
+        if (m_owner->pCache != nullptr)
+        {
+            m_owner->pCache->InvalidateEntry(m_pResource);
+        }
+    }
+
+    std::atomic<ULONG>          m_refCount;  ///< Reference count
+    std::shared_ptr<TokenOwner> m_owner;     ///< Owning cache (cleared when the cache is destroyed first)
+    ID3D12Resource*             m_pResource; ///< Resource the token is attached to
+};
+
+//=====================================================================================================================
+// Initialise cache
+ResourceCache::ResourceCache(
+    uint32_t capacity)
+    :
+    m_mask(0),
+    m_size(0),
+    m_used(0),
+    m_hits(0),
+    m_misses(0),
+    m_tokenGuid(),
+    m_tokenOwner(std::make_shared<TokenOwner>())
+{
+    uint32_t tableSize = 16;
+
+    while (tableSize < capacity)
+    {
+        tableSize <<= 1;
+    }
+
+    m_slots.reset(new Slot[tableSize]);
+    m_mask = tableSize - 1;
+
+    for (uint32_t i = 0; i < tableSize; i++)
+    {
+        m_slots[i].State.store(SlotEmpty, std::memory_order_relaxed);
+    }
+
+    m_tokenOwner->pCache = this;
+
+    // Every cache uses its own private data GUID so several caches can track the same resource
+    const ResourceCache* pThis = this;
+
+    m_tokenGuid.Data1 = 0x5a3c71e2;
+    m_tokenGuid.Data2 = 0x9b04;
+    m_tokenGuid.Data3 = 0x4f6d;
+    std::memcpy(m_tokenGuid.Data4, &pThis, std::min(sizeof(pThis), sizeof(m_tokenGuid.Data4)));
+}
+
+//=====================================================================================================================
+// Disconnects the release tokens still attached to live resources
+ResourceCache::~ResourceCache()
+{
+    std::lock_guard<std::mutex> lock(m_tokenOwner->Lock);
+    m_tokenOwner->pCache = nullptr;
+}
+
+//=====================================================================================================================
+// Returns the builder of a resource, querying the resource on a miss
+ResourceBuilder ResourceCache::Get(
+    ID3D12Resource* pResource)
+{
+    ResourceBuilder builder = {};
+
+    if ((pResource == nullptr) || Find(pResource, &builder))
+    {
+        return builder;
+    }
+
+    builder.FromExistingResource(pResource);
+
+    Slot* pSlot = Reserve(pResource);
+
+    if (pSlot != nullptr)
+    {
+        pSlot->pResource = pResource;
+        pSlot->Builder   = builder;
+
+        // The token must be attached before the entry is published, otherwise a release could miss the entry
+        ReleaseToken* pToken = new ReleaseToken(m_tokenOwner, pResource);
+        const HRESULT hr     = pResource->SetPrivateDataInterface(m_tokenGuid, pToken);
+        pToken->Release();
+
+        if (hr == S_OK)
+        {
+            pSlot->State.store(SlotReady, std::memory_order_release);
+            m_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            pSlot->State.store(SlotTombstone, std::memory_order_release);
+        }
+    }
+
+    return builder;
+}
+
+//=====================================================================================================================
+// Looks up a cached builder without querying the resource
+bool ResourceCache::Find(
+    ID3D12Resource* pResource, ResourceBuilder* pBuilder
+    ) const
+{
+    const uint32_t home = GetHome(pResource);
+
+    for (uint32_t probe = 0; probe <= m_mask; probe++)
+    {
+        const Slot&    slot  = m_slots[(home + probe) & m_mask];
+        const uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        if (state == SlotEmpty)
+        {
+            break;
+        }
+
+        if ((state == SlotReady) && (slot.pResource == pResource))
+        {
+            *pBuilder = slot.Builder;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+//=====================================================================================================================
+// Invalidates the entry of a live resource and detaches its release token
+void ResourceCache::Invalidate(
+    ID3D12Resource* pResource)
+{
+    if (pResource != nullptr)
+    {
+        // Releasing the token invalidates the entry; invalidate directly too in case the token was never attached
+        pResource->SetPrivateDataInterface(m_tokenGuid, nullptr);
+        InvalidateEntry(pResource);
+    }
+}
+
+//=====================================================================================================================
+// Tombstones the entry of a resource
+void ResourceCache::InvalidateEntry(
+    ID3D12Resource* pResource)
+{
+    const uint32_t home = GetHome(pResource);
+
+    for (uint32_t probe = 0; probe <= m_mask; probe++)
+    {
+        Slot&    slot  = m_slots[(home + probe) & m_mask];
+        uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        if (state == SlotEmpty)
+        {
+            break;
+        }
+
+        if ((state == SlotReady) &&
+            (slot.pResource == pResource) &&
+            slot.State.compare_exchange_strong(state, SlotTombstone, std::memory_order_acq_rel))
+        {
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+//=====================================================================================================================
+// Returns the entry to publish the resource into
+ResourceCache::Slot* ResourceCache::Reserve(
+    ID3D12Resource* pResource)
+{
+    // Keep a quarter of the table empty so probe sequences stay short and always terminate
+    const uint32_t maxUsed = (m_mask + 1) - ((m_mask + 1) / 4);
+    const uint32_t home    = GetHome(pResource);
+
+    for (uint32_t probe = 0; probe <= m_mask; probe++)
+    {
+        Slot&    slot  = m_slots[(home + probe) & m_mask];
+        uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            if (state == SlotEmpty)
+            {
+                if (m_used.load(std::memory_order_relaxed) >= maxUsed)
+                {
+                    return nullptr;
+                }
+
+                if (slot.State.compare_exchange_weak(state, SlotWriting, std::memory_order_acquire))
+                {
+                    m_used.fetch_add(1, std::memory_order_relaxed);
+                    return &slot;
+                }
+
+                // Lost the race for this slot; re-examine it with the state the winner published
+                continue;
+            }
+
+            if (state == SlotWriting)
+            {
+                // Another thread is publishing this slot, possibly for the same resource
+                std::this_thread::yield();
+                state = slot.State.load(std::memory_order_acquire);
+                continue;
+            }
+
+            break;
+        }
+
+        if ((state == SlotReady) && (slot.pResource == pResource))
+        {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+//=====================================================================================================================
+// Reclaims invalidated entries
+void ResourceCache::Compact()
+{
+    const uint32_t tableSize = m_mask + 1;
+    std::unique_ptr<Slot[]> slots(new Slot[tableSize]);
+
+    for (uint32_t i = 0; i < tableSize; i++)
+    {
+        slots[i].State.store(SlotEmpty, std::memory_order_relaxed);
+    }
+
+    uint32_t used = 0;
+
+    for (uint32_t i = 0; i < tableSize; i++)
+    {
+        const Slot& source = m_slots[i];
+
+        if (source.State.load(std::memory_order_relaxed) != SlotReady)
+        {
+            continue;
+        }
+
+        uint32_t index = GetHome(source.pResource);
+
+        while (slots[index].State.load(std::memory_order_relaxed) != SlotEmpty)
+        {
+            index = (index + 1) & m_mask;
+        }
+
+        slots[index].pResource = source.pResource;
+        slots[index].Builder   = source.Builder;
+        slots[index].State.store(SlotReady, std::memory_order_relaxed);
+        used++;
+    }
+
+    m_slots = std::move(slots);
+    m_used.store(used, std::memory_order_release);
+}
+
+//=====================================================================================================================
+// Returns the probe start of a resource
+uint32_t ResourceCache::GetHome(
+    const ID3D12Resource* pResource
+    ) const
+{
+    // Fibonacci hashing spreads the aligned allocation addresses over the table
+    const uint64_t address = reinterpret_cast<uintptr_t>(pResource);
+    return static_cast<uint32_t>((address * 0x9e3779b97f4a7c15ull) >> 32) & m_mask;
+}
+} // AR
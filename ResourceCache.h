@@ -0,0 +1,130 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace AR {
+
+//=====================================================================================================================
+// Concurrent cache of ResourceBuilder::FromExistingResource results keyed by resource address. Lookups are lock-free
+// and may run on any number of threads alongside inserts and invalidations. On insert the cache attaches a release
+// token to the resource with SetPrivateDataInterface; when the resource is destroyed the token invalidates the entry
+// before the address can be reused. Invalidated entries leave tombstones that Compact reclaims at a point where no
+// other thread uses the cache (see ViewCache).
+class ResourceCache
+{
+public:
+    /// Initialise cache
+    ///
+    /// @param capacity [optional] Entry capacity (rounded up to a power of two)
+    ///
+    explicit ResourceCache(uint32_t capacity = 1024);
+
+    /// Disconnects the release tokens still attached to live resources
+    ~ResourceCache();
+
+    ResourceCache(const ResourceCache&)            = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    /// Returns the builder of a resource, querying the resource on a miss. When the cache is full the builder is
+    /// returned uncached.
+    ///
+    /// @param pResource [in] Existing D3D12 resource pointer
+    ///
+    ResourceBuilder Get(ID3D12Resource* pResource);
+
+    /// Looks up a cached builder without querying the resource
+    ///
+    /// @param pResource [in]  Resource pointer
+    /// @param pBuilder  [out] Cached builder
+    ///
+    bool Find(ID3D12Resource* pResource, ResourceBuilder* pBuilder) const;
+
+    /// Invalidates the entry of a live resource (e.g. after the resource was renamed or its description changed) and
+    /// detaches its release token
+    ///
+    /// @param pResource [in] Resource pointer
+    ///
+    void Invalidate(ID3D12Resource* pResource);
+
+    /// Reclaims invalidated entries. Not thread-safe: call while no other thread uses the cache.
+    void Compact();
+
+    /// Returns the number of live entries
+    uint32_t GetSize() const { return m_size.load(std::memory_order_relaxed); }
+
+    /// Returns the number of lookup hits
+    uint64_t GetHitCount() const { return m_hits.load(std::memory_order_relaxed); }
+
+    /// Returns the number of lookup misses
+    uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    /// @internal Slot states (see ViewCache)
+    enum SlotState : uint32_t
+    {
+        SlotEmpty     = 0, ///< Never used (terminates probing)
+        SlotWriting   = 1, ///< Being published by an inserting thread
+        SlotReady     = 2, ///< Holds a live entry
+        SlotTombstone = 3, ///< Held an invalidated entry
+    };
+
+    /// @internal Table slot. Resource and builder are written before the state is released as SlotReady and are not
+    /// modified again until Compact.
+    struct Slot
+    {
+        std::atomic<uint32_t> State;
+        ID3D12Resource*       pResource;
+        ResourceBuilder       Builder;
+    };
+
+    /// @internal State shared with release tokens, which may outlive the cache
+    struct TokenOwner
+    {
+        std::mutex     Lock;
+        ResourceCache* pCache;
+    };
+
+    class ReleaseToken;
+
+    /// @internal Tombstones the entry of a resource
+    void InvalidateEntry(ID3D12Resource* pResource);
+
+    /// @internal Returns the entry to publish the resource into, or nullptr when the resource is cached or the cache
+    /// is full
+    Slot* Reserve(ID3D12Resource* pResource);
+
+    /// @internal Returns the probe start of a resource
+    uint32_t GetHome(const ID3D12Resource* pResource) const;
+
+    std::unique_ptr<Slot[]>       m_slots;      ///< Slot table
+    uint32_t                      m_mask;       ///< Capacity - 1
+    std::atomic<uint32_t>         m_size;       ///< Live entries
+    std::atomic<uint32_t>         m_used;       ///< Non-empty slots (live + tombstones)
+    mutable std::atomic<uint64_t> m_hits;       ///< Lookup hits
+    mutable std::atomic<uint64_t> m_misses;     ///< Lookup misses
+    GUID                          m_tokenGuid;  ///< Private data GUID of this cache's release tokens
+    std::shared_ptr<TokenOwner>   m_tokenOwner; ///< Cache pointer shared with release tokens
+};
+} // AR
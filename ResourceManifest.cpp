@@ -0,0 +1,296 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "ResourceManifest.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace AR {
+
+//=====================================================================================================================
+// Returns the 64-bit FNV-1a hash of a byte range
+static uint64_t HashBytes(
+    const uint8_t* pData, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ pData[i]) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+//=====================================================================================================================
+// Returns the 64-bit FNV-1a hash of a resource name
+uint64_t HashManifestName(
+    const char* pName, size_t length)
+{
+    return HashBytes(reinterpret_cast<const uint8_t*>(pName), length);
+}
+
+//=====================================================================================================================
+// Adds a resource
+void ManifestWriter::Add(
+    const char*                     pName,
+    const ResourceBuilder&          builder,
+    const ShaderResourceViewParams* pSrvParams,
+    const ColorTargetViewParams*    pRtvParams,
+    const DepthStencilViewParams*   pDsvParams)
+{
+    const size_t length   = std::strlen(pName);
+    const bool   isBuffer = (builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+
+    ManifestEntry entry = {};
+
+    entry.Builder    = builder;
+    entry.NameHash   = HashManifestName(pName, length);
+    entry.NameOffset = static_cast<uint32_t>(m_strings.size());
+    entry.NameLength = static_cast<uint32_t>(length);
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE) == 0)
+    {
+        ShaderResourceViewParams params = {};
+
+        if (pSrvParams != nullptr)
+        {
+            params = *pSrvParams;
+        }
+        else if (isBuffer)
+        {
+            // Default buffer view: raw view of the whole buffer
+            params.NumElements = static_cast<uint32_t>(builder.Width / 4);
+        }
+
+        entry.ShaderResourceView = BuildShaderResourceView(builder, params);
+        entry.Views             |= ManifestViewShaderResource;
+    }
+
+    if ((isBuffer == false) && ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0))
+    {
+        const ColorTargetViewParams params = (pRtvParams != nullptr) ? *pRtvParams : ColorTargetViewParams{};
+
+        entry.ColorTargetView = BuildColorTargetView(builder, params);
+        entry.Views          |= ManifestViewColorTarget;
+    }
+
+    if ((isBuffer == false) && ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0))
+    {
+        const DepthStencilViewParams params = (pDsvParams != nullptr) ? *pDsvParams : DepthStencilViewParams{};
+
+        entry.DepthStencilView = BuildDepthStencilView(builder, params);
+        entry.Views           |= ManifestViewDepthStencil;
+    }
+
+    m_strings.append(pName, length + 1);
+    m_entries.push_back(entry);
+}
+
+//=====================================================================================================================
+// Serialises the manifest into memory
+void ManifestWriter::Write(
+    std::vector<uint8_t>* pData) const
+{
+    std::vector<ManifestEntry> entries = m_entries;
+
+    std::sort(entries.begin(), entries.end(), [this](const ManifestEntry& a, const ManifestEntry& b)
+    {
+        return (a.NameHash != b.NameHash) ?
+            (a.NameHash < b.NameHash) :
+            (std::strcmp(m_strings.c_str() + a.NameOffset, m_strings.c_str() + b.NameOffset) < 0);
+    });
+
+    ManifestHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    header.Magic        = ManifestMagic;
+    header.Version      = ManifestVersion;
+    header.HeaderSize   = sizeof(ManifestHeader);
+    header.EntrySize    = sizeof(ManifestEntry);
+    header.EntryCount   = static_cast<uint32_t>(entries.size());
+    header.StringSize   = static_cast<uint32_t>(m_strings.size());
+    header.EntryOffset  = sizeof(ManifestHeader);
+    header.StringOffset = header.EntryOffset + entries.size() * sizeof(ManifestEntry);
+
+    pData->resize(static_cast<size_t>(header.StringOffset) + m_strings.size());
+
+    if (entries.empty() == false)
+    {
+        std::memcpy(pData->data() + header.EntryOffset, entries.data(), entries.size() * sizeof(ManifestEntry));
+    }
+
+    std::memcpy(pData->data() + header.StringOffset, m_strings.data(), m_strings.size());
+
+    header.Checksum = HashBytes(pData->data() + sizeof(ManifestHeader), pData->size() - sizeof(ManifestHeader));
+
+    std::memcpy(pData->data(), &header, sizeof(header));
+}
+
+//=====================================================================================================================
+// Serialises the manifest into a file
+bool ManifestWriter::Write(
+    const char* pPath) const
+{
+    std::vector<uint8_t> data;
+    Write(&data);
+
+    FILE* pFile = std::fopen(pPath, "wb");
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    const bool written = (std::fwrite(data.data(), 1, data.size(), pFile) == data.size());
+
+    return (std::fclose(pFile) == 0) && written;
+}
+
+//=====================================================================================================================
+// Constructor
+ResourceManifest::ResourceManifest()
+    :
+    m_pEntries(nullptr),
+    m_pStrings(nullptr),
+    m_entryCount(0)
+{
+}
+
+//=====================================================================================================================
+// Maps and validates a manifest file
+bool ResourceManifest::Open(
+    const char* pPath, bool validateChecksum)
+{
+    Close();
+
+    if (m_file.Open(pPath) && OpenMemory(m_file.GetData(), m_file.GetSize(), validateChecksum))
+    {
+        return true;
+    }
+
+    Close();
+    return false;
+}
+
+//=====================================================================================================================
+// Validates a manifest already in memory
+bool ResourceManifest::OpenMemory(
+    const void* pData, size_t size, bool validateChecksum)
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+
+    if ((pBytes == nullptr) || (size < sizeof(ManifestHeader)) || ((reinterpret_cast<uintptr_t>(pBytes) % 8) != 0))
+    {
+        return false;
+    }
+
+    ManifestHeader header;
+    std::memcpy(&header, pBytes, sizeof(header));
+
+    const uint64_t entryBytes = static_cast<uint64_t>(header.EntryCount) * sizeof(ManifestEntry);
+
+    const bool validLayout = (header.Magic == ManifestMagic) &&
+                             (header.Version == ManifestVersion) &&
+                             (header.HeaderSize == sizeof(ManifestHeader)) &&
+                             (header.EntrySize == sizeof(ManifestEntry)) &&
+                             ((header.EntryOffset % 8) == 0) &&
+                             (header.EntryOffset >= sizeof(ManifestHeader)) &&
+                             (header.EntryOffset <= size) &&
+                             (entryBytes <= size - header.EntryOffset) &&
+                             (header.StringOffset <= size) &&
+                             (header.StringSize <= size - header.StringOffset) &&
+                             ((header.StringSize == 0) || (pBytes[header.StringOffset + header.StringSize - 1] == 0));
+
+    if (validLayout == false)
+    {
+        return false;
+    }
+
+    const ManifestEntry* pEntries = reinterpret_cast<const ManifestEntry*>(pBytes + header.EntryOffset);
+
+    if (validateChecksum &&
+        (HashBytes(pBytes + sizeof(ManifestHeader), size - sizeof(ManifestHeader)) != header.Checksum))
+    {
+        return false;
+    }
+
+    // Name ranges are checked even for trusted files: GetName and Find read them without further checks
+    for (uint32_t i = 0; i < header.EntryCount; i++)
+    {
+        if ((pEntries[i].NameOffset >= header.StringSize) ||
+            (pEntries[i].NameLength >= header.StringSize - pEntries[i].NameOffset))
+        {
+            return false;
+        }
+    }
+
+    m_pEntries   = pEntries;
+    m_pStrings   = reinterpret_cast<const char*>(pBytes + header.StringOffset);
+    m_entryCount = header.EntryCount;
+
+    return true;
+}
+
+//=====================================================================================================================
+// Releases the manifest
+void ResourceManifest::Close()
+{
+    m_file.Close();
+
+    m_pEntries   = nullptr;
+    m_pStrings   = nullptr;
+    m_entryCount = 0;
+}
+
+//=====================================================================================================================
+// Returns the first entry with a name hash
+const ManifestEntry* ResourceManifest::FindHash(
+    uint64_t nameHash) const
+{
+    const ManifestEntry* pEnd   = m_pEntries + m_entryCount;
+    const ManifestEntry* pEntry = std::lower_bound(m_pEntries, pEnd, nameHash,
+        [](const ManifestEntry& entry, uint64_t hash) { return entry.NameHash < hash; });
+
+    return ((pEntry != pEnd) && (pEntry->NameHash == nameHash)) ? pEntry : nullptr;
+}
+
+//=====================================================================================================================
+// Returns an entry by name
+const ManifestEntry* ResourceManifest::Find(
+    const char* pName) const
+{
+    const size_t         length = std::strlen(pName);
+    const uint64_t       hash   = HashManifestName(pName, length);
+    const ManifestEntry* pEnd   = m_pEntries + m_entryCount;
+
+    for (const ManifestEntry* pEntry = FindHash(hash);
+         (pEntry != nullptr) && (pEntry != pEnd) && (pEntry->NameHash == hash);
+         pEntry++)
+    {
+        if ((pEntry->NameLength == length) && (std::memcmp(GetName(*pEntry), pName, length) == 0))
+        {
+            return pEntry;
+        }
+    }
+
+    return nullptr;
+}
+} // AR
@@ -0,0 +1,180 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ViewBatch.h"
+#include "MappedFile.h"
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace AR {
+
+/// Manifest file identifier ('ARMF')
+constexpr uint32_t ManifestMagic = 0x464d5241;
+
+/// Manifest layout version (bump whenever ManifestEntry or ResourceBuilder changes layout)
+constexpr uint32_t ManifestVersion = 3;
+
+//=====================================================================================================================
+// Views stored in a manifest entry
+enum ManifestViewFlags : uint32_t
+{
+    ManifestViewShaderResource = 0x1, ///< ShaderResourceView is valid
+    ManifestViewColorTarget    = 0x2, ///< ColorTargetView is valid
+    ManifestViewDepthStencil   = 0x4, ///< DepthStencilView is valid
+};
+
+//=====================================================================================================================
+// Manifest file header. Entries follow the header sorted by name hash, then the null-terminated name strings.
+struct ManifestHeader
+{
+    uint32_t Magic;        ///< ManifestMagic
+    uint32_t Version;      ///< ManifestVersion
+    uint32_t HeaderSize;   ///< sizeof(ManifestHeader)
+    uint32_t EntrySize;    ///< sizeof(ManifestEntry)
+    uint32_t EntryCount;   ///< Entry count
+    uint32_t StringSize;   ///< Name string block size in bytes
+    uint64_t EntryOffset;  ///< File offset of the entry array
+    uint64_t StringOffset; ///< File offset of the name string block
+    uint64_t Checksum;     ///< FNV-1a hash of every byte following the header
+    uint64_t Reserved[2];  ///< Zero
+};
+
+//=====================================================================================================================
+// Manifest entry: a ready-to-use builder (heap properties included) and its default views, stored exactly as in
+// memory so the reader hands out entries straight from the mapped file.
+struct ManifestEntry
+{
+    ResourceBuilder                 Builder;            ///< Resource description
+    D3D12_SHADER_RESOURCE_VIEW_DESC ShaderResourceView; ///< Default shader resource view
+    D3D12_RENDER_TARGET_VIEW_DESC   ColorTargetView;    ///< Default color target view
+    D3D12_DEPTH_STENCIL_VIEW_DESC   DepthStencilView;   ///< Default depth-stencil view
+    uint64_t                        NameHash;           ///< HashManifestName of the name
+    uint32_t                        NameOffset;         ///< Name offset in the string block
+    uint32_t                        NameLength;         ///< Name length in bytes (excluding the terminator)
+    uint32_t                        Views;              ///< ManifestViewFlags
+    uint32_t                        Reserved;           ///< Zero
+};
+
+static_assert(sizeof(ManifestHeader) == 64, "ManifestHeader layout is part of the file format");
+static_assert(std::is_trivially_copyable<ManifestEntry>::value, "ManifestEntry is read straight from the file");
+static_assert((sizeof(ManifestEntry) % 8) == 0, "ManifestEntry must keep the entry array 8-byte aligned");
+
+/// Returns the 64-bit FNV-1a hash of a resource name
+///
+/// @param pName  [in] Name
+/// @param length [in] Name length in bytes
+///
+uint64_t HashManifestName(const char* pName, size_t length);
+
+//=====================================================================================================================
+// Manifest writer used by offline tools. Entries can be added in any order; Write sorts them by name hash.
+class ManifestWriter
+{
+public:
+    /// Adds a resource. Views are built for the usages the builder allows (shader resource unless denied, color
+    /// target and depth-stencil when allowed) from the given parameters, or from defaults.
+    ///
+    /// @param pName       [in] Unique resource name
+    /// @param builder     [in] Resource builder
+    /// @param pSrvParams  [optional] Shader resource view parameters
+    /// @param pRtvParams  [optional] Color target view parameters
+    /// @param pDsvParams  [optional] Depth-stencil view parameters
+    ///
+    void Add(
+        const char*                     pName,
+        const ResourceBuilder&          builder,
+        const ShaderResourceViewParams* pSrvParams = nullptr,
+        const ColorTargetViewParams*    pRtvParams = nullptr,
+        const DepthStencilViewParams*   pDsvParams = nullptr);
+
+    /// Serialises the manifest into memory
+    ///
+    /// @param pData [out] File contents
+    ///
+    void Write(std::vector<uint8_t>* pData) const;
+
+    /// Serialises the manifest into a file
+    ///
+    /// @param pPath [in] File path
+    ///
+    bool Write(const char* pPath) const;
+
+private:
+    std::vector<ManifestEntry> m_entries; ///< Entries in insertion order
+    std::string                m_strings; ///< Name string block
+};
+
+//=====================================================================================================================
+// Manifest reader. The file is memory mapped and validated once; entries are then returned as pointers into the
+// mapping with no parsing and no allocation. Entry pointers stay valid until Close.
+class ResourceManifest
+{
+public:
+    ResourceManifest();
+
+    /// Maps and validates a manifest file
+    ///
+    /// @param pPath            [in] File path
+    /// @param validateChecksum [optional] Verify the checksum (skippable for trusted files; the layout and the entry
+    ///                                    name ranges are always checked)
+    ///
+    bool Open(const char* pPath, bool validateChecksum = true);
+
+    /// Validates a manifest already in memory (the memory must outlive the reader)
+    ///
+    /// @param pData            [in] Manifest bytes (8-byte aligned)
+    /// @param size             [in] Size in bytes
+    /// @param validateChecksum [optional] Verify the checksum
+    ///
+    bool OpenMemory(const void* pData, size_t size, bool validateChecksum = true);
+
+    /// Releases the manifest
+    void Close();
+
+    /// Returns the entry count
+    uint32_t GetEntryCount() const { return m_entryCount; }
+
+    /// Returns an entry by index (entries are sorted by name hash)
+    const ManifestEntry& GetEntry(uint32_t index) const { return m_pEntries[index]; }
+
+    /// Returns an entry by name, or nullptr when the manifest has no such entry
+    ///
+    /// @param pName [in] Resource name
+    ///
+    const ManifestEntry* Find(const char* pName) const;
+
+    /// Returns the first entry with a name hash, or nullptr (names are not compared)
+    ///
+    /// @param nameHash [in] HashManifestName of the resource name
+    ///
+    const ManifestEntry* FindHash(uint64_t nameHash) const;
+
+    /// Returns the null-terminated name of an entry
+    const char* GetName(const ManifestEntry& entry) const { return m_pStrings + entry.NameOffset; }
+
+private:
+    MappedFile           m_file;       ///< Mapped manifest file
+    const ManifestEntry* m_pEntries;   ///< Entry array
+    const char*          m_pStrings;   ///< Name string block
+    uint32_t             m_entryCount; ///< Entry count
+};
+} // AR
@@ -0,0 +1,458 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "StateTracker.h"
+#include <algorithm>
+
+namespace AR {
+
+//=====================================================================================================================
+// Returns true when a state is a non-empty combination of read-only states
+static bool IsReadOnlyState(
+    D3D12_RESOURCE_STATES state)
+{
+    return (state != D3D12_RESOURCE_STATE_COMMON) && ((state & ~ReadOnlyResourceStates) == 0);
+}
+
+//=====================================================================================================================
+// Returns true when moving from the current state to the requested state needs a barrier
+static bool NeedsTransition(
+    D3D12_RESOURCE_STATES current, D3D12_RESOURCE_STATES requested)
+{
+    if (current == requested)
+    {
+        return false;
+    }
+
+    // A read-only state already including every requested read bit satisfies the request
+    return (IsReadOnlyState(current) && IsReadOnlyState(requested) && ((current & requested) == requested)) == false;
+}
+
+//=====================================================================================================================
+// Returns true when two state runs can be merged
+static bool IsSameState(
+    const StateRange& a, const StateRange& b)
+{
+    // Subresources only share a split run when they are covered by the same BEGIN_ONLY barrier
+    return (a.State == b.State) && (a.Split == b.Split) &&
+           ((a.Split == false) ||
+            ((a.SplitBefore == b.SplitBefore) && (a.SplitBegin == b.SplitBegin) && (a.SplitEnd == b.SplitEnd)));
+}
+
+//=====================================================================================================================
+// Returns a transition barrier
+static D3D12_RESOURCE_BARRIER MakeTransition(
+    ID3D12Resource*              pResource,
+    uint32_t                     subresource,
+    D3D12_RESOURCE_STATES        before,
+    D3D12_RESOURCE_STATES        after,
+    D3D12_RESOURCE_BARRIER_FLAGS flags)
+{
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags                  = flags;
+    barrier.Transition.pResource   = pResource;
+    barrier.Transition.Subresource = subresource;
+    barrier.Transition.StateBefore = before;
+    barrier.Transition.StateAfter  = after;
+
+    return barrier;
+}
+
+//=====================================================================================================================
+// Constructor
+StateTracker::StateTracker()
+{
+}
+
+//=====================================================================================================================
+// Starts tracking a resource
+uint32_t StateTracker::Register(
+    ID3D12Resource* pResource, const ResourceBuilder& builder, D3D12_RESOURCE_STATES initialState)
+{
+    TrackedResource resource = {};
+    resource.pResource        = pResource;
+    resource.MipCount         = builder.GetMipCount();
+    resource.ArraySize        = builder.GetArraySize();
+    resource.SubresourceCount = builder.GetSubresourceCount();
+    resource.Whole            = { 0, resource.SubresourceCount, initialState, initialState, 0, 0, false };
+
+    m_resources.push_back(std::move(resource));
+
+    return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+//=====================================================================================================================
+// Stops tracking every resource and drops pending requests
+void StateTracker::Reset()
+{
+    m_resources.clear();
+    m_requests.clear();
+}
+
+//=====================================================================================================================
+// Records a request
+void StateTracker::AddRequest(
+    uint32_t handle, D3D12_RESOURCE_STATES state, uint32_t firstSubresource, uint32_t count, bool split)
+{
+    const uint32_t subresourceCount = m_resources[handle].SubresourceCount;
+
+    Request request = { handle, 0, subresourceCount, state, split };
+
+    if (firstSubresource != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+    {
+        request.Begin = std::min(firstSubresource, subresourceCount);
+        request.End   = request.Begin + std::min(count, subresourceCount - request.Begin);
+    }
+
+    if (request.Begin < request.End)
+    {
+        m_requests.push_back(request);
+    }
+}
+
+//=====================================================================================================================
+// Requests a state for a range of subresources in the pending pass
+void StateTracker::Transition(
+    uint32_t handle, D3D12_RESOURCE_STATES state, uint32_t firstSubresource, uint32_t count)
+{
+    AddRequest(handle, state, firstSubresource, count, false);
+}
+
+//=====================================================================================================================
+// Requests the first half of a split transition
+void StateTracker::BeginSplitTransition(
+    uint32_t handle, D3D12_RESOURCE_STATES state, uint32_t firstSubresource, uint32_t count)
+{
+    AddRequest(handle, state, firstSubresource, count, true);
+}
+
+//=====================================================================================================================
+// Requests a state for a mip and array slice range (every plane)
+void StateTracker::TransitionSlices(
+    uint32_t              handle,
+    D3D12_RESOURCE_STATES state,
+    uint32_t              baseMip,
+    uint32_t              mipCount,
+    uint32_t              baseArray,
+    uint32_t              arrayCount)
+{
+    const TrackedResource& resource   = m_resources[handle];
+    const uint32_t         planeCount = resource.SubresourceCount / (resource.MipCount * resource.ArraySize);
+
+    if ((baseMip >= resource.MipCount) || (baseArray >= resource.ArraySize))
+    {
+        return;
+    }
+
+    mipCount   = std::min(mipCount, resource.MipCount - baseMip);
+    arrayCount = std::min(arrayCount, resource.ArraySize - baseArray);
+
+    // Whole mip chains of consecutive slices are contiguous, so they collapse into one request per plane
+    const bool fullChains = (mipCount == resource.MipCount);
+
+    for (uint32_t plane = 0; plane < planeCount; plane++)
+    {
+        const uint32_t planeBase = plane * resource.MipCount * resource.ArraySize;
+
+        if (fullChains)
+        {
+            AddRequest(handle, state, planeBase + baseArray * resource.MipCount, arrayCount * mipCount, false);
+        }
+        else
+        {
+            for (uint32_t slice = baseArray; slice < baseArray + arrayCount; slice++)
+            {
+                AddRequest(handle, state, planeBase + slice * resource.MipCount + baseMip, mipCount, false);
+            }
+        }
+    }
+}
+
+//=====================================================================================================================
+// Applies one request to one subresource state
+void StateTracker::ResolveSubresource(
+    StateRange* pState, D3D12_RESOURCE_STATES state, bool split, BarrierSlot* pTransition)
+{
+    if (NeedsTransition(pState->State, state))
+    {
+        const D3D12_RESOURCE_BARRIER_FLAGS flags =
+            split ? D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY : D3D12_RESOURCE_BARRIER_FLAG_NONE;
+
+        *pTransition = { pState->State, state, flags, true };
+
+        pState->SplitBefore = pState->State;
+        pState->State       = state;
+        pState->Split       = split;
+    }
+}
+
+//=====================================================================================================================
+// Appends the barriers of one merge phase, promoting to ALL_SUBRESOURCES when possible
+bool StateTracker::EmitPhase(
+    ID3D12Resource*                      pResource,
+    const BarrierSlot*                   pSlots,
+    uint32_t                             count,
+    std::vector<D3D12_RESOURCE_BARRIER>* pBarriers)
+{
+    bool promote = true;
+
+    for (uint32_t i = 0; (i < count) && promote; i++)
+    {
+        promote = pSlots[i].Valid &&
+                  (pSlots[i].Before == pSlots[0].Before) &&
+                  (pSlots[i].After == pSlots[0].After) &&
+                  (pSlots[i].Flags == pSlots[0].Flags);
+    }
+
+    if (promote)
+    {
+        pBarriers->push_back(MakeTransition(
+            pResource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, pSlots[0].Before, pSlots[0].After, pSlots[0].Flags));
+        return true;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pSlots[i].Valid)
+        {
+            pBarriers->push_back(MakeTransition(pResource, i, pSlots[i].Before, pSlots[i].After, pSlots[i].Flags));
+        }
+    }
+
+    return false;
+}
+
+//=====================================================================================================================
+// Resolves the requests of one resource
+void StateTracker::FlushResource(
+    const Request* pRequests, uint32_t requestCount, std::vector<D3D12_RESOURCE_BARRIER>* pBarriers)
+{
+    TrackedResource& resource = m_resources[pRequests[0].Resource];
+    const uint32_t   count    = resource.SubresourceCount;
+
+    // Fast path: whole-resource state and whole-resource requests never expand to subresources
+    bool wholeRequests = resource.Ranges.empty();
+
+    for (uint32_t i = 0; (i < requestCount) && wholeRequests; i++)
+    {
+        wholeRequests = (pRequests[i].Begin == 0) && (pRequests[i].End == count);
+    }
+
+    // Requests for the same subresource within a pass combine read-only states; otherwise the last one wins
+    const auto mergeState = [](D3D12_RESOURCE_STATES merged, D3D12_RESOURCE_STATES state)
+    {
+        return (IsReadOnlyState(merged) && IsReadOnlyState(state)) ? (merged | state) : state;
+    };
+
+    if (wholeRequests)
+    {
+        D3D12_RESOURCE_STATES state = pRequests[0].State;
+
+        for (uint32_t i = 1; i < requestCount; i++)
+        {
+            state = mergeState(state, pRequests[i].State);
+        }
+
+        // A uniform split state always comes from an ALL_SUBRESOURCES BEGIN_ONLY barrier
+        if (resource.Whole.Split)
+        {
+            pBarriers->push_back(MakeTransition(resource.pResource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                                                resource.Whole.SplitBefore, resource.Whole.State,
+                                                D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+            resource.Whole.Split = false;
+        }
+
+        BarrierSlot transitionSlot = {};
+
+        ResolveSubresource(&resource.Whole, state, pRequests[requestCount - 1].Split, &transitionSlot);
+
+        if (transitionSlot.Valid)
+        {
+            EmitPhase(resource.pResource, &transitionSlot, 1, pBarriers);
+        }
+
+        resource.Whole.SplitBegin = 0;
+        resource.Whole.SplitEnd   = count;
+
+        return;
+    }
+
+    m_scratch.resize(count);
+    m_requested.resize(count);
+    m_requestKind.assign(count, 0);
+    m_slots.assign(count, BarrierSlot{});
+
+    if (resource.Ranges.empty())
+    {
+        std::fill(m_scratch.begin(), m_scratch.end(), resource.Whole);
+    }
+    else
+    {
+        for (const StateRange& range : resource.Ranges)
+        {
+            std::fill(m_scratch.begin() + range.Begin, m_scratch.begin() + range.End, range);
+        }
+    }
+
+    for (uint32_t i = 0; i < requestCount; i++)
+    {
+        const Request& request = pRequests[i];
+
+        for (uint32_t sub = request.Begin; sub < request.End; sub++)
+        {
+            m_requested[sub]   = (m_requestKind[sub] != 0) ?
+                                 mergeState(m_requested[sub], request.State) : request.State;
+            m_requestKind[sub] = request.Split ? 2 : 1;
+        }
+    }
+
+    // Touching any subresource of an outstanding split barrier ends every subresource its BEGIN_ONLY covered, with
+    // END_ONLY barriers repeating the BEGIN_ONLY: one ALL_SUBRESOURCES barrier or one barrier per subresource
+    for (uint32_t sub = 0; sub < count; sub++)
+    {
+        if ((m_requestKind[sub] == 0) || (m_scratch[sub].Split == false))
+        {
+            continue;
+        }
+
+        const uint32_t splitBegin = m_scratch[sub].SplitBegin;
+        const uint32_t splitEnd   = m_scratch[sub].SplitEnd;
+        const bool     wholeSplit = (splitBegin == 0) && (splitEnd == count);
+
+        for (uint32_t split = splitBegin; split < splitEnd; split++)
+        {
+            StateRange& state = m_scratch[split];
+
+            if (state.Split && ((wholeSplit == false) || (split == splitBegin)))
+            {
+                pBarriers->push_back(MakeTransition(resource.pResource,
+                                                    wholeSplit ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES : split,
+                                                    state.SplitBefore, state.State,
+                                                    D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+            }
+
+            state.Split = false;
+        }
+    }
+
+    for (uint32_t sub = 0; sub < count; sub++)
+    {
+        if (m_requestKind[sub] != 0)
+        {
+            ResolveSubresource(&m_scratch[sub], m_requested[sub], m_requestKind[sub] == 2, &m_slots[sub]);
+        }
+    }
+
+    // New split barriers remember the span of their BEGIN_ONLY so they are ended the same way
+    const bool wholeBarrier = EmitPhase(resource.pResource, m_slots.data(), count, pBarriers);
+
+    for (uint32_t sub = 0; sub < count; sub++)
+    {
+        if (m_slots[sub].Valid && (m_slots[sub].Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY))
+        {
+            m_scratch[sub].SplitBegin = wholeBarrier ? 0 : sub;
+            m_scratch[sub].SplitEnd   = wholeBarrier ? count : (sub + 1);
+        }
+    }
+
+    // Store the new states as runs, collapsing to whole-resource tracking when a single run remains
+    resource.Ranges.clear();
+
+    StateRange run = m_scratch[0];
+    run.Begin      = 0;
+
+    for (uint32_t sub = 1; sub <= count; sub++)
+    {
+        if ((sub == count) || (IsSameState(run, m_scratch[sub]) == false))
+        {
+            run.End = sub;
+            resource.Ranges.push_back(run);
+
+            if (sub < count)
+            {
+                run       = m_scratch[sub];
+                run.Begin = sub;
+            }
+        }
+    }
+
+    if (resource.Ranges.size() == 1)
+    {
+        resource.Whole = resource.Ranges[0];
+        resource.Ranges.clear();
+    }
+}
+
+//=====================================================================================================================
+// Resolves the pending requests into barriers and updates the tracked states
+uint32_t StateTracker::Flush(
+    std::vector<D3D12_RESOURCE_BARRIER>* pBarriers)
+{
+    const size_t firstBarrier = pBarriers->size();
+
+    std::stable_sort(m_requests.begin(), m_requests.end(), [](const Request& a, const Request& b)
+    {
+        return a.Resource < b.Resource;
+    });
+
+    for (size_t begin = 0; begin < m_requests.size();)
+    {
+        size_t end = begin + 1;
+
+        while ((end < m_requests.size()) && (m_requests[end].Resource == m_requests[begin].Resource))
+        {
+            end++;
+        }
+
+        FlushResource(&m_requests[begin], static_cast<uint32_t>(end - begin), pBarriers);
+        begin = end;
+    }
+
+    m_requests.clear();
+
+    return static_cast<uint32_t>(pBarriers->size() - firstBarrier);
+}
+
+//=====================================================================================================================
+// Returns the tracked state of a subresource
+D3D12_RESOURCE_STATES StateTracker::GetState(
+    uint32_t handle, uint32_t subresource) const
+{
+    const TrackedResource& resource = m_resources[handle];
+
+    if (resource.Ranges.empty())
+    {
+        return resource.Whole.State;
+    }
+
+    const auto range = std::upper_bound(resource.Ranges.begin(), resource.Ranges.end(), subresource,
+        [](uint32_t value, const StateRange& range) { return value < range.Begin; });
+
+    return (range - 1)->State;
+}
+
+//=====================================================================================================================
+// Returns the number of state runs stored for a resource
+uint32_t StateTracker::GetRangeCount(
+    uint32_t handle) const
+{
+    return m_resources[handle].Ranges.empty() ? 1 : static_cast<uint32_t>(m_resources[handle].Ranges.size());
+}
+} // AR
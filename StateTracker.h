@@ -0,0 +1,187 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <vector>
+
+namespace AR {
+
+/// Read-only resource states that may be combined and are kept when a subset of them is requested
+constexpr D3D12_RESOURCE_STATES ReadOnlyResourceStates = D3D12_RESOURCE_STATE_GENERIC_READ |
+                                                         D3D12_RESOURCE_STATE_DEPTH_READ |
+                                                         D3D12_RESOURCE_STATE_RESOLVE_SOURCE;
+
+//=====================================================================================================================
+// Run of consecutive subresources sharing a state
+struct StateRange
+{
+    uint32_t              Begin;       ///< First subresource
+    uint32_t              End;         ///< One past the last subresource
+    D3D12_RESOURCE_STATES State;       ///< Current state (target state while a split barrier is in flight)
+    D3D12_RESOURCE_STATES SplitBefore; ///< State before the in-flight split barrier
+    uint32_t              SplitBegin;  ///< First subresource covered by the in-flight BEGIN_ONLY barrier
+    uint32_t              SplitEnd;    ///< One past the last subresource covered by the in-flight BEGIN_ONLY barrier
+    bool                  Split;       ///< A BEGIN_ONLY barrier was issued and its END_ONLY half is outstanding
+};
+
+//=====================================================================================================================
+// Per-subresource resource state tracker. States are stored as runs of subresources and collapse to a single
+// whole-resource entry whenever every subresource shares a state. Transitions requested for a pass are collected and
+// turned into a merged barrier list by Flush: one ALL_SUBRESOURCES barrier when the whole resource moves between the
+// same pair of states, per-subresource barriers otherwise, and none where the current read-only state already
+// covers the request. Split transitions issue BEGIN_ONLY barriers that a later request completes with END_ONLY
+// barriers repeating them exactly: touching any subresource of an ALL_SUBRESOURCES BEGIN_ONLY ends all of them.
+class StateTracker
+{
+public:
+    StateTracker();
+
+    /// Starts tracking a resource
+    ///
+    /// @param pResource    [in] Resource
+    /// @param builder      [in] Resource description (subresource layout)
+    /// @param initialState [in] State of every subresource
+    ///
+    /// Returns the handle used by the other methods.
+    uint32_t Register(
+        ID3D12Resource* pResource, const ResourceBuilder& builder, D3D12_RESOURCE_STATES initialState);
+
+    /// Stops tracking every resource and drops pending requests
+    void Reset();
+
+    /// Requests a state for a range of subresources in the pending pass
+    ///
+    /// @param handle           [in] Resource handle
+    /// @param state            [in] Requested state
+    /// @param firstSubresource [optional] First subresource, or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+    /// @param count            [optional] Subresource count (ignored for D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+    ///
+    void Transition(
+        uint32_t              handle,
+        D3D12_RESOURCE_STATES state,
+        uint32_t              firstSubresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+        uint32_t              count            = 1);
+
+    /// Requests a state for a mip and array slice range (every plane)
+    ///
+    /// @param handle     [in] Resource handle
+    /// @param state      [in] Requested state
+    /// @param baseMip    [in] First mip
+    /// @param mipCount   [in] Mip count
+    /// @param baseArray  [in] First array slice
+    /// @param arrayCount [in] Array slice count
+    ///
+    void TransitionSlices(
+        uint32_t              handle,
+        D3D12_RESOURCE_STATES state,
+        uint32_t              baseMip,
+        uint32_t              mipCount,
+        uint32_t              baseArray,
+        uint32_t              arrayCount);
+
+    /// Requests the first half of a split transition. The BEGIN_ONLY barrier is issued by the next Flush; the first
+    /// later request touching any subresource it covers issues the matching END_ONLY barrier.
+    ///
+    /// @param handle           [in] Resource handle
+    /// @param state            [in] Target state
+    /// @param firstSubresource [optional] First subresource, or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+    /// @param count            [optional] Subresource count (ignored for D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+    ///
+    void BeginSplitTransition(
+        uint32_t              handle,
+        D3D12_RESOURCE_STATES state,
+        uint32_t              firstSubresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+        uint32_t              count            = 1);
+
+    /// Resolves the pending requests into barriers and updates the tracked states
+    ///
+    /// @param pBarriers [out] Barrier list the merged barriers are appended to
+    ///
+    /// Returns the number of barriers appended.
+    uint32_t Flush(std::vector<D3D12_RESOURCE_BARRIER>* pBarriers);
+
+    /// Returns the tracked state of a subresource
+    D3D12_RESOURCE_STATES GetState(uint32_t handle, uint32_t subresource) const;
+
+    /// Returns true when every subresource of a resource shares one state (whole-resource tracking)
+    bool IsUniform(uint32_t handle) const { return m_resources[handle].Ranges.empty(); }
+
+    /// Returns the number of state runs stored for a resource
+    uint32_t GetRangeCount(uint32_t handle) const;
+
+private:
+    /// @internal Tracked resource
+    struct TrackedResource
+    {
+        ID3D12Resource*         pResource;        ///< Resource
+        uint32_t                MipCount;         ///< Mips per array slice
+        uint32_t                ArraySize;        ///< Array slices per plane
+        uint32_t                SubresourceCount; ///< Total subresources
+        StateRange              Whole;            ///< State of every subresource while Ranges is empty
+        std::vector<StateRange> Ranges;           ///< Sorted runs covering every subresource (empty when uniform)
+    };
+
+    /// @internal Pending request
+    struct Request
+    {
+        uint32_t              Resource;
+        uint32_t              Begin;
+        uint32_t              End;
+        D3D12_RESOURCE_STATES State;
+        bool                  Split;
+    };
+
+    /// @internal Per-subresource barrier slot used while merging
+    struct BarrierSlot
+    {
+        D3D12_RESOURCE_STATES        Before;
+        D3D12_RESOURCE_STATES        After;
+        D3D12_RESOURCE_BARRIER_FLAGS Flags;
+        bool                         Valid;
+    };
+
+    /// @internal Records a request
+    void AddRequest(
+        uint32_t handle, D3D12_RESOURCE_STATES state, uint32_t firstSubresource, uint32_t count, bool split);
+
+    /// @internal Resolves the requests of one resource
+    void FlushResource(const Request* pRequests, uint32_t requestCount, std::vector<D3D12_RESOURCE_BARRIER>* pBarriers);
+
+    /// @internal Applies one request to one subresource state
+    static void ResolveSubresource(
+        StateRange* pState, D3D12_RESOURCE_STATES state, bool split, BarrierSlot* pTransition);
+
+    /// @internal Appends the barriers of one merge phase, promoting to ALL_SUBRESOURCES when possible. Returns true
+    /// when the phase was promoted.
+    static bool EmitPhase(
+        ID3D12Resource*                      pResource,
+        const BarrierSlot*                   pSlots,
+        uint32_t                             count,
+        std::vector<D3D12_RESOURCE_BARRIER>* pBarriers);
+
+    std::vector<TrackedResource>       m_resources;    ///< Tracked resources indexed by handle
+    std::vector<Request>               m_requests;     ///< Requests of the pending pass
+    std::vector<StateRange>            m_scratch;      ///< Per-subresource states while merging
+    std::vector<D3D12_RESOURCE_STATES> m_requested;    ///< Per-subresource merged requests
+    std::vector<uint8_t>               m_requestKind;  ///< Per-subresource request kind (none, normal, split)
+    std::vector<BarrierSlot>           m_slots;        ///< Per-subresource transition barriers
+};
+} // AR
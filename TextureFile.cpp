@@ -0,0 +1,731 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "TextureFile.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include <cstring>
+#include <filesystem>
+
+namespace AR {
+
+// DDS file identifier ('DDS ')
+static constexpr uint32_t DdsMagic = 0x20534444;
+
+// DDS header and pixel format flags
+static constexpr uint32_t DdsHeaderSize       = 124;
+static constexpr uint32_t DdsDx10HeaderSize   = 20;
+static constexpr uint32_t DdsCaps2Cubemap     = 0x00000200;
+static constexpr uint32_t DdsCaps2AllFaces    = 0x0000fc00;
+static constexpr uint32_t DdsCaps2Volume      = 0x00200000;
+static constexpr uint32_t DdsPixelAlphaPixels = 0x00000001;
+static constexpr uint32_t DdsPixelAlpha       = 0x00000002;
+static constexpr uint32_t DdsPixelFourCC      = 0x00000004;
+static constexpr uint32_t DdsPixelRgb         = 0x00000040;
+static constexpr uint32_t DdsPixelLuminance   = 0x00020000;
+static constexpr uint32_t DdsPixelBumpDuDv    = 0x00080000;
+static constexpr uint32_t DdsMiscTextureCube  = 0x00000004;
+
+// KTX2 file identifier and header sizes
+static constexpr uint8_t  Ktx2Identifier[12] = { 0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n' };
+static constexpr uint32_t Ktx2HeaderSize     = 80;
+static constexpr uint32_t Ktx2LevelIndexSize = 24;
+
+// Smallest number of files worth handing to a worker of the shared pool
+static constexpr uint32_t MinFilesPerThread = 16;
+
+//=====================================================================================================================
+// Legacy DDS pixel format described by channel masks
+struct DdsMaskFormat
+{
+    uint32_t    Flags;    ///< Pixel format flag that must be set (DdsPixelRgb, DdsPixelLuminance, ...)
+    uint32_t    BitCount; ///< Bits per pixel
+    uint32_t    Masks[4]; ///< Red, green, blue and alpha masks
+    DXGI_FORMAT Format;   ///< Matching format
+};
+
+// Legacy pixel formats with a DXGI equivalent (as written by D3DX and texconv)
+static constexpr DdsMaskFormat DdsMaskFormats[] =
+{
+    { DdsPixelRgb,       32, { 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 }, DXGI_FORMAT_R8G8B8A8_UNORM     },
+    { DdsPixelRgb,       32, { 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 }, DXGI_FORMAT_B8G8R8A8_UNORM     },
+    { DdsPixelRgb,       32, { 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000 }, DXGI_FORMAT_B8G8R8X8_UNORM     },
+    { DdsPixelRgb,       32, { 0x000003ff, 0x000ffc00, 0x3ff00000, 0xc0000000 }, DXGI_FORMAT_R10G10B10A2_UNORM  },
+    { DdsPixelRgb,       32, { 0x0000ffff, 0xffff0000, 0x00000000, 0x00000000 }, DXGI_FORMAT_R16G16_UNORM       },
+    { DdsPixelRgb,       32, { 0xffffffff, 0x00000000, 0x00000000, 0x00000000 }, DXGI_FORMAT_R32_FLOAT          },
+    { DdsPixelRgb,       16, { 0x00007c00, 0x000003e0, 0x0000001f, 0x00008000 }, DXGI_FORMAT_B5G5R5A1_UNORM     },
+    { DdsPixelRgb,       16, { 0x0000f800, 0x000007e0, 0x0000001f, 0x00000000 }, DXGI_FORMAT_B5G6R5_UNORM       },
+    { DdsPixelRgb,       16, { 0x00000f00, 0x000000f0, 0x0000000f, 0x0000f000 }, DXGI_FORMAT_B4G4R4A4_UNORM     },
+    { DdsPixelLuminance,  8, { 0x000000ff, 0x00000000, 0x00000000, 0x00000000 }, DXGI_FORMAT_R8_UNORM           },
+    { DdsPixelLuminance, 16, { 0x0000ffff, 0x00000000, 0x00000000, 0x00000000 }, DXGI_FORMAT_R16_UNORM          },
+    { DdsPixelLuminance, 16, { 0x000000ff, 0x00000000, 0x00000000, 0x0000ff00 }, DXGI_FORMAT_R8G8_UNORM         },
+    { DdsPixelAlpha,      8, { 0x00000000, 0x00000000, 0x00000000, 0x000000ff }, DXGI_FORMAT_A8_UNORM           },
+    { DdsPixelBumpDuDv,  16, { 0x000000ff, 0x0000ff00, 0x00000000, 0x00000000 }, DXGI_FORMAT_R8G8_SNORM         },
+    { DdsPixelBumpDuDv,  32, { 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 }, DXGI_FORMAT_R8G8B8A8_SNORM     },
+    { DdsPixelBumpDuDv,  32, { 0x0000ffff, 0xffff0000, 0x00000000, 0x00000000 }, DXGI_FORMAT_R16G16_SNORM       },
+};
+
+//=====================================================================================================================
+// FourCC code with a DXGI equivalent
+struct DdsFourCCFormat
+{
+    uint32_t    FourCC; ///< FourCC code, or D3DFORMAT value for floating-point formats
+    DXGI_FORMAT Format; ///< Matching format
+};
+
+// Builds a FourCC code
+constexpr uint32_t MakeFourCC(
+    char a, char b, char c, char d)
+{
+    return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) |
+           (uint32_t(uint8_t(d)) << 24);
+}
+
+// Legacy FourCC formats
+static constexpr DdsFourCCFormat DdsFourCCFormats[] =
+{
+    { MakeFourCC('D', 'X', 'T', '1'), DXGI_FORMAT_BC1_UNORM          },
+    { MakeFourCC('D', 'X', 'T', '2'), DXGI_FORMAT_BC2_UNORM          },
+    { MakeFourCC('D', 'X', 'T', '3'), DXGI_FORMAT_BC2_UNORM          },
+    { MakeFourCC('D', 'X', 'T', '4'), DXGI_FORMAT_BC3_UNORM          },
+    { MakeFourCC('D', 'X', 'T', '5'), DXGI_FORMAT_BC3_UNORM          },
+    { MakeFourCC('A', 'T', 'I', '1'), DXGI_FORMAT_BC4_UNORM          },
+    { MakeFourCC('B', 'C', '4', 'U'), DXGI_FORMAT_BC4_UNORM          },
+    { MakeFourCC('B', 'C', '4', 'S'), DXGI_FORMAT_BC4_SNORM          },
+    { MakeFourCC('A', 'T', 'I', '2'), DXGI_FORMAT_BC5_UNORM          },
+    { MakeFourCC('B', 'C', '5', 'U'), DXGI_FORMAT_BC5_UNORM          },
+    { MakeFourCC('B', 'C', '5', 'S'), DXGI_FORMAT_BC5_SNORM          },
+    { MakeFourCC('R', 'G', 'B', 'G'), DXGI_FORMAT_R8G8_B8G8_UNORM    },
+    { MakeFourCC('G', 'R', 'G', 'B'), DXGI_FORMAT_G8R8_G8B8_UNORM    },
+    { MakeFourCC('Y', 'U', 'Y', '2'), DXGI_FORMAT_YUY2               },
+    { 36,                             DXGI_FORMAT_R16G16B16A16_UNORM },
+    { 110,                            DXGI_FORMAT_R16G16B16A16_SNORM },
+    { 111,                            DXGI_FORMAT_R16_FLOAT          },
+    { 112,                            DXGI_FORMAT_R16G16_FLOAT       },
+    { 113,                            DXGI_FORMAT_R16G16B16A16_FLOAT },
+    { 114,                            DXGI_FORMAT_R32_FLOAT          },
+    { 115,                            DXGI_FORMAT_R32G32_FLOAT       },
+    { 116,                            DXGI_FORMAT_R32G32B32A32_FLOAT },
+};
+
+//=====================================================================================================================
+// VkFormat value with a DXGI equivalent (values are spelled out so the parser does not need the Vulkan headers)
+struct Ktx2Format
+{
+    uint32_t    VkFormat; ///< VkFormat value
+    DXGI_FORMAT Format;   ///< Matching format
+};
+
+// KTX2 formats (see VkFormatTable for the opposite direction)
+static constexpr Ktx2Format Ktx2Formats[] =
+{
+    {   4, DXGI_FORMAT_B5G6R5_UNORM          }, // VK_FORMAT_R5G6B5_UNORM_PACK16
+    {   8, DXGI_FORMAT_B5G5R5A1_UNORM        }, // VK_FORMAT_A1R5G5B5_UNORM_PACK16
+    {   9, DXGI_FORMAT_R8_UNORM              },
+    {  10, DXGI_FORMAT_R8_SNORM              },
+    {  13, DXGI_FORMAT_R8_UINT               },
+    {  14, DXGI_FORMAT_R8_SINT               },
+    {  16, DXGI_FORMAT_R8G8_UNORM            },
+    {  17, DXGI_FORMAT_R8G8_SNORM            },
+    {  20, DXGI_FORMAT_R8G8_UINT             },
+    {  21, DXGI_FORMAT_R8G8_SINT             },
+    {  37, DXGI_FORMAT_R8G8B8A8_UNORM        },
+    {  38, DXGI_FORMAT_R8G8B8A8_SNORM        },
+    {  41, DXGI_FORMAT_R8G8B8A8_UINT         },
+    {  42, DXGI_FORMAT_R8G8B8A8_SINT         },
+    {  43, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB   },
+    {  44, DXGI_FORMAT_B8G8R8A8_UNORM        },
+    {  50, DXGI_FORMAT_B8G8R8A8_UNORM_SRGB   },
+    {  64, DXGI_FORMAT_R10G10B10A2_UNORM     }, // VK_FORMAT_A2B10G10R10_UNORM_PACK32
+    {  68, DXGI_FORMAT_R10G10B10A2_UINT      }, // VK_FORMAT_A2B10G10R10_UINT_PACK32
+    {  70, DXGI_FORMAT_R16_UNORM             },
+    {  71, DXGI_FORMAT_R16_SNORM             },
+    {  74, DXGI_FORMAT_R16_UINT              },
+    {  75, DXGI_FORMAT_R16_SINT              },
+    {  76, DXGI_FORMAT_R16_FLOAT             },
+    {  77, DXGI_FORMAT_R16G16_UNORM          },
+    {  78, DXGI_FORMAT_R16G16_SNORM          },
+    {  81, DXGI_FORMAT_R16G16_UINT           },
+    {  82, DXGI_FORMAT_R16G16_SINT           },
+    {  83, DXGI_FORMAT_R16G16_FLOAT          },
+    {  91, DXGI_FORMAT_R16G16B16A16_UNORM    },
+    {  92, DXGI_FORMAT_R16G16B16A16_SNORM    },
+    {  95, DXGI_FORMAT_R16G16B16A16_UINT     },
+    {  96, DXGI_FORMAT_R16G16B16A16_SINT     },
+    {  97, DXGI_FORMAT_R16G16B16A16_FLOAT    },
+    {  98, DXGI_FORMAT_R32_UINT              },
+    {  99, DXGI_FORMAT_R32_SINT              },
+    { 100, DXGI_FORMAT_R32_FLOAT             },
+    { 101, DXGI_FORMAT_R32G32_UINT           },
+    { 102, DXGI_FORMAT_R32G32_SINT           },
+    { 103, DXGI_FORMAT_R32G32_FLOAT          },
+    { 104, DXGI_FORMAT_R32G32B32_UINT        },
+    { 105, DXGI_FORMAT_R32G32B32_SINT        },
+    { 106, DXGI_FORMAT_R32G32B32_FLOAT       },
+    { 107, DXGI_FORMAT_R32G32B32A32_UINT     },
+    { 108, DXGI_FORMAT_R32G32B32A32_SINT     },
+    { 109, DXGI_FORMAT_R32G32B32A32_FLOAT    },
+    { 122, DXGI_FORMAT_R11G11B10_FLOAT       }, // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+    { 123, DXGI_FORMAT_R9G9B9E5_SHAREDEXP    }, // VK_FORMAT_E5B9G9R9_UFLOAT_PACK32
+    { 124, DXGI_FORMAT_D16_UNORM             },
+    { 126, DXGI_FORMAT_D32_FLOAT             },
+    { 129, DXGI_FORMAT_D24_UNORM_S8_UINT     },
+    { 130, DXGI_FORMAT_D32_FLOAT_S8X24_UINT  },
+    { 131, DXGI_FORMAT_BC1_UNORM             }, // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    { 132, DXGI_FORMAT_BC1_UNORM_SRGB        }, // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    { 133, DXGI_FORMAT_BC1_UNORM             },
+    { 134, DXGI_FORMAT_BC1_UNORM_SRGB        },
+    { 135, DXGI_FORMAT_BC2_UNORM             },
+    { 136, DXGI_FORMAT_BC2_UNORM_SRGB        },
+    { 137, DXGI_FORMAT_BC3_UNORM             },
+    { 138, DXGI_FORMAT_BC3_UNORM_SRGB        },
+    { 139, DXGI_FORMAT_BC4_UNORM             },
+    { 140, DXGI_FORMAT_BC4_SNORM             },
+    { 141, DXGI_FORMAT_BC5_UNORM             },
+    { 142, DXGI_FORMAT_BC5_SNORM             },
+    { 143, DXGI_FORMAT_BC6H_UF16             },
+    { 144, DXGI_FORMAT_BC6H_SF16             },
+    { 145, DXGI_FORMAT_BC7_UNORM             },
+    { 146, DXGI_FORMAT_BC7_UNORM_SRGB        },
+};
+
+//=====================================================================================================================
+// Reads a little-endian 32-bit value
+static uint32_t ReadU32(
+    const uint8_t* pData)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+//=====================================================================================================================
+// Reads a little-endian 64-bit value
+static uint64_t ReadU64(
+    const uint8_t* pData)
+{
+    uint64_t value = 0;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+//=====================================================================================================================
+// Returns the packed layout of one mip level of a single array slice
+static TextureSubresourceData GetPackedMip(
+    const ResourceBuilder& builder, uint32_t mip)
+{
+    const FormatInfo& info   = GetFormatInfo(builder.Format);
+    const uint64_t    width  = std::max<uint64_t>(1, builder.Width >> mip);
+    const uint32_t    height = std::max(1u, builder.Height >> mip);
+
+    TextureSubresourceData Data = {};
+    Data.RowPitch   = ((width + info.BlockWidth - 1) / info.BlockWidth) * (info.BitsPerBlock / 8);
+    Data.NumRows    = (height + info.BlockHeight - 1) / info.BlockHeight;
+    Data.SlicePitch = Data.RowPitch * Data.NumRows;
+    Data.Depth      = (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+                      std::max(1u, uint32_t(builder.DepthOrArraySize) >> mip) : 1;
+
+    return Data;
+}
+
+//=====================================================================================================================
+// Returns the packed size of every mip of one array slice
+static uint64_t GetPackedSliceSize(
+    const ResourceBuilder& builder)
+{
+    uint64_t size = 0;
+
+    for (uint32_t mip = 0; mip < builder.MipLevels; mip++)
+    {
+        const TextureSubresourceData Data = GetPackedMip(builder, mip);
+        size += Data.SlicePitch * Data.Depth;
+    }
+
+    return size;
+}
+
+//=====================================================================================================================
+// Returns the number of mips of a full chain
+static uint32_t GetFullMipCount(
+    uint64_t width, uint32_t height, uint32_t depth)
+{
+    uint64_t extent = std::max<uint64_t>(width, std::max(height, depth));
+    uint32_t count  = 1;
+
+    while (extent > 1)
+    {
+        extent >>= 1;
+        count++;
+    }
+
+    return count;
+}
+
+//=====================================================================================================================
+// Initialises the builder of a parsed header, rejecting descriptions the parser cannot lay out
+static bool BuildTexture(
+    ResourceBuilder*         pBuilder,
+    D3D12_RESOURCE_DIMENSION dimension,
+    uint64_t                 width,
+    uint32_t                 height,
+    uint32_t                 depthOrArraySize,
+    uint32_t                 mipLevels,
+    DXGI_FORMAT              format)
+{
+    const FormatInfo& info  = GetFormatInfo(format);
+    const uint32_t    depth = (dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? depthOrArraySize : 1;
+
+    // 3D textures are limited on all three axes, 1D and 2D textures on their extent and array size
+    uint32_t maxExtent    = D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+    uint32_t maxArraySize = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION;
+
+    if (dimension == D3D12_RESOURCE_DIMENSION_TEXTURE1D)
+    {
+        maxExtent    = D3D12_REQ_TEXTURE1D_U_DIMENSION;
+        maxArraySize = D3D12_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
+    }
+    else if (dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+        maxExtent    = D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION;
+        maxArraySize = D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION;
+    }
+
+    if ((format == DXGI_FORMAT_UNKNOWN) || (info.Format != format) || (info.BitsPerBlock == 0) ||
+        (info.PlaneCount != 1) || (width == 0) || (height == 0) || (depthOrArraySize == 0) ||
+        (width > maxExtent) || (height > maxExtent) || (depthOrArraySize > maxArraySize) ||
+        (mipLevels > GetFullMipCount(width, height, depth)))
+    {
+        return false;
+    }
+
+    const uint16_t mips = static_cast<uint16_t>(std::max(1u, mipLevels));
+
+    *pBuilder = ResourceBuilder{};
+
+    switch (dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+        pBuilder->Texture1D(width, format, static_cast<uint16_t>(depthOrArraySize), mips);
+        break;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+        pBuilder->Texture3D(width, height, static_cast<uint16_t>(depthOrArraySize), format, mips);
+        break;
+    default:
+        pBuilder->Texture2D(width, height, format, static_cast<uint16_t>(depthOrArraySize), mips);
+        break;
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Returns the format of a legacy DDS pixel format
+static DXGI_FORMAT GetDdsLegacyFormat(
+    const uint8_t* pPixelFormat)
+{
+    const uint32_t flags    = ReadU32(pPixelFormat + 4);
+    const uint32_t fourCC   = ReadU32(pPixelFormat + 8);
+    const uint32_t bitCount = ReadU32(pPixelFormat + 12);
+
+    if ((flags & DdsPixelFourCC) != 0)
+    {
+        for (const DdsFourCCFormat& entry : DdsFourCCFormats)
+        {
+            if (entry.FourCC == fourCC)
+            {
+                return entry.Format;
+            }
+        }
+
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    uint32_t masks[4] = {};
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        masks[i] = ReadU32(pPixelFormat + 16 + (i * 4));
+    }
+
+    // Alpha masks only count when the file says the alpha channel is present
+    if ((flags & (DdsPixelAlphaPixels | DdsPixelAlpha)) == 0)
+    {
+        masks[3] = 0;
+    }
+
+    for (const DdsMaskFormat& entry : DdsMaskFormats)
+    {
+        if (((flags & entry.Flags) != 0) && (entry.BitCount == bitCount) &&
+            (std::memcmp(entry.Masks, masks, sizeof(masks)) == 0))
+        {
+            return entry.Format;
+        }
+    }
+
+    return DXGI_FORMAT_UNKNOWN;
+}
+
+//=====================================================================================================================
+// Initialises a builder from a DDS file
+bool FromDDS(
+    const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout)
+{
+    if ((pData == nullptr) || (size < 4 + DdsHeaderSize) || (ReadU32(pData) != DdsMagic) ||
+        (ReadU32(pData + 4) != DdsHeaderSize))
+    {
+        return false;
+    }
+
+    // A non-zero mip count is honoured even without DDSD_MIPMAPCOUNT, as D3DX and DirectXTex read it: some writers
+    // fill the count but leave the flag clear, and a stray count cannot pass the full-chain and data size checks
+    const uint8_t* pHeader     = pData + 4;
+    const uint32_t height      = ReadU32(pHeader + 8);
+    const uint32_t width       = ReadU32(pHeader + 12);
+    const uint32_t depth       = ReadU32(pHeader + 20);
+    const uint32_t mipCount    = std::max(1u, ReadU32(pHeader + 24));
+    const uint8_t* pPixel      = pHeader + 72;
+    const uint32_t caps2       = ReadU32(pHeader + 108);
+    const bool     isDx10      = ((ReadU32(pPixel + 4) & DdsPixelFourCC) != 0) &&
+                                 (ReadU32(pPixel + 8) == MakeFourCC('D', 'X', '1', '0'));
+    const uint64_t dataOffset  = 4 + DdsHeaderSize + (isDx10 ? DdsDx10HeaderSize : 0);
+
+    if (size < dataOffset)
+    {
+        return false;
+    }
+
+    ResourceBuilder builder   = {};
+    uint32_t        faceCount = 1;
+    bool            isValid   = false;
+
+    if (isDx10)
+    {
+        const uint8_t*    pDx10     = pHeader + DdsHeaderSize;
+        const DXGI_FORMAT format    = static_cast<DXGI_FORMAT>(ReadU32(pDx10));
+        const uint32_t    dimension = ReadU32(pDx10 + 4);
+        const uint32_t    arraySize = ReadU32(pDx10 + 12);
+
+        switch (dimension)
+        {
+        case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+            isValid = (height <= 1) &&
+                      BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE1D, width, 1, arraySize, mipCount, format);
+            break;
+        case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
+            faceCount = ((ReadU32(pDx10 + 8) & DdsMiscTextureCube) != 0) ? 6 : 1;
+            isValid   = (arraySize <= D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION / faceCount) &&
+                        BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+                                     width, height, arraySize * faceCount, mipCount, format);
+            break;
+        case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+            isValid = (arraySize == 1) &&
+                      BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE3D,
+                                   width, height, depth, mipCount, format);
+            break;
+        default:
+            break;
+        }
+    }
+    else
+    {
+        const DXGI_FORMAT format = GetDdsLegacyFormat(pPixel);
+
+        if ((caps2 & DdsCaps2Volume) != 0)
+        {
+            isValid = BuildTexture(
+                &builder, D3D12_RESOURCE_DIMENSION_TEXTURE3D, width, height, depth, mipCount, format);
+        }
+        else if ((caps2 & DdsCaps2Cubemap) != 0)
+        {
+            // Partial cube maps have no D3D12 equivalent
+            faceCount = 6;
+            isValid   = ((caps2 & DdsCaps2AllFaces) == DdsCaps2AllFaces) &&
+                        BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE2D, width, height, 6, mipCount, format);
+        }
+        else
+        {
+            isValid = BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE2D, width, height, 1, mipCount, format);
+        }
+    }
+
+    if (isValid == false)
+    {
+        return false;
+    }
+
+    const uint32_t arraySize = builder.GetArraySize();
+    const uint64_t dataSize  = GetPackedSliceSize(builder) * arraySize;
+
+    if (dataSize > size - dataOffset)
+    {
+        return false;
+    }
+
+    *pBuilder = builder;
+
+    if (pLayout != nullptr)
+    {
+        *pLayout = {};
+        pLayout->Type       = TextureFileType::DDS;
+        pLayout->FaceCount  = faceCount;
+        pLayout->DataOffset = dataOffset;
+        pLayout->DataSize   = dataSize;
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Initialises a builder from a KTX2 file
+bool FromKTX2(
+    const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout)
+{
+    if ((pData == nullptr) || (size < Ktx2HeaderSize) ||
+        (std::memcmp(pData, Ktx2Identifier, sizeof(Ktx2Identifier)) != 0))
+    {
+        return false;
+    }
+
+    const uint32_t vkFormat         = ReadU32(pData + 12);
+    const uint32_t width            = ReadU32(pData + 20);
+    const uint32_t height           = ReadU32(pData + 24);
+    const uint32_t depth            = ReadU32(pData + 28);
+    const uint32_t layerCount       = std::max(1u, ReadU32(pData + 32));
+    const uint32_t faceCount        = ReadU32(pData + 36);
+    const uint32_t levelCount       = std::max(1u, ReadU32(pData + 40));
+    const uint32_t supercompression = ReadU32(pData + 44);
+
+    // Supercompressed data cannot be uploaded in place
+    if ((supercompression != 0) || ((faceCount != 1) && (faceCount != 6)) || (levelCount > D3D12_REQ_MIP_LEVELS) ||
+        (size - Ktx2HeaderSize < uint64_t(levelCount) * Ktx2LevelIndexSize))
+    {
+        return false;
+    }
+
+    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+
+    for (const Ktx2Format& entry : Ktx2Formats)
+    {
+        if (entry.VkFormat == vkFormat)
+        {
+            format = entry.Format;
+            break;
+        }
+    }
+
+    ResourceBuilder builder = {};
+    bool            isValid = false;
+
+    if (depth != 0)
+    {
+        isValid = (layerCount == 1) && (faceCount == 1) &&
+                  BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE3D, width, height, depth, levelCount, format);
+    }
+    else if (height == 0)
+    {
+        isValid = (faceCount == 1) &&
+                  BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE1D, width, 1, layerCount, levelCount, format);
+    }
+    else
+    {
+        isValid = (layerCount <= D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION / faceCount) &&
+                  BuildTexture(&builder, D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+                               width, height, layerCount * faceCount, levelCount, format);
+    }
+
+    if (isValid == false)
+    {
+        return false;
+    }
+
+    // Levels are stored smallest first, so the data spans from the last level to the end of the first
+    TextureFileLayout layout = {};
+    layout.Type       = TextureFileType::KTX2;
+    layout.FaceCount  = faceCount;
+    layout.DataOffset = UINT64_MAX;
+
+    uint64_t dataEnd = 0;
+
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        const uint8_t*               pLevel   = pData + Ktx2HeaderSize + (level * Ktx2LevelIndexSize);
+        const uint64_t               offset   = ReadU64(pLevel);
+        const uint64_t               length   = ReadU64(pLevel + 8);
+        const TextureSubresourceData mipData  = GetPackedMip(builder, level);
+        const uint64_t               expected = mipData.SlicePitch * mipData.Depth * builder.GetArraySize();
+
+        if ((length < expected) || (offset > size) || (length > size - offset))
+        {
+            return false;
+        }
+
+        layout.LevelOffsets[level] = offset;
+        layout.DataOffset          = std::min(layout.DataOffset, offset);
+        dataEnd                    = std::max(dataEnd, offset + length);
+    }
+
+    layout.DataSize = dataEnd - layout.DataOffset;
+
+    *pBuilder = builder;
+
+    if (pLayout != nullptr)
+    {
+        *pLayout = layout;
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Initialises a builder from a DDS or KTX2 file
+bool FromTextureFile(
+    const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout)
+{
+    if ((pData != nullptr) && (size >= 4) && (ReadU32(pData) == DdsMagic))
+    {
+        return FromDDS(pData, size, pBuilder, pLayout);
+    }
+
+    return FromKTX2(pData, size, pBuilder, pLayout);
+}
+
+//=====================================================================================================================
+// Returns the file location of a subresource's texel data
+bool GetTextureSubresourceData(
+    const ResourceBuilder&   builder,
+    const TextureFileLayout& layout,
+    uint32_t                 subresource,
+    TextureSubresourceData*  pData)
+{
+    const uint32_t mipCount = builder.MipLevels;
+
+    if ((mipCount == 0) || (subresource >= mipCount * builder.GetArraySize()))
+    {
+        return false;
+    }
+
+    const uint32_t mip   = subresource % mipCount;
+    const uint32_t slice = subresource / mipCount;
+
+    *pData = GetPackedMip(builder, mip);
+
+    if (layout.Type == TextureFileType::DDS)
+    {
+        // Every array slice (cube face) stores its full mip chain
+        uint64_t offset = layout.DataOffset + (GetPackedSliceSize(builder) * slice);
+
+        for (uint32_t i = 0; i < mip; i++)
+        {
+            const TextureSubresourceData Data = GetPackedMip(builder, i);
+            offset += Data.SlicePitch * Data.Depth;
+        }
+
+        pData->Offset = offset;
+    }
+    else
+    {
+        // Every mip level stores all layers and faces, in D3D12 array slice order
+        pData->Offset = layout.LevelOffsets[mip] + (pData->SlicePitch * pData->Depth * slice);
+    }
+
+    return true;
+}
+
+//=====================================================================================================================
+// Parses the headers of every .dds and .ktx2 file in a directory across worker threads
+bool ScanTextureDirectory(
+    const char* pPath, bool recursive, std::vector<TextureFileEntry>* pEntries, uint32_t threadCount)
+{
+    namespace fs = std::filesystem;
+
+    pEntries->clear();
+
+    std::error_code error;
+    const fs::path  root(pPath);
+
+    if (fs::is_directory(root, error) == false)
+    {
+        return false;
+    }
+
+    auto addFile = [pEntries](const fs::directory_entry& entry)
+    {
+        std::error_code fileError;
+
+        if (entry.is_regular_file(fileError))
+        {
+            std::string extension = entry.path().extension().string();
+
+            for (char& c : extension)
+            {
+                c = ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c;
+            }
+
+            if ((extension == ".dds") || (extension == ".ktx2"))
+            {
+                pEntries->push_back({ entry.path().string(), ResourceBuilder{}, TextureFileLayout{}, false });
+            }
+        }
+    };
+
+    if (recursive)
+    {
+        for (fs::recursive_directory_iterator it(root, error), end; (error.value() == 0) && (it != end);
+             it.increment(error))
+        {
+            addFile(*it);
+        }
+    }
+    else
+    {
+        for (fs::directory_iterator it(root, error), end; (error.value() == 0) && (it != end); it.increment(error))
+        {
+            addFile(*it);
+        }
+    }
+
+    if (error.value() != 0)
+    {
+        pEntries->clear();
+        return false;
+    }
+
+    std::sort(pEntries->begin(), pEntries->end(),
+              [](const TextureFileEntry& a, const TextureFileEntry& b) { return a.Path < b.Path; });
+
+    TextureFileEntry* pItems = pEntries->data();
+
+    ParallelFor(static_cast<uint32_t>(pEntries->size()), threadCount, MinFilesPerThread,
+                [pItems](uint32_t begin, uint32_t end)
+    {
+        MappedFile file;
+
+        for (uint32_t i = begin; i < end; i++)
+        {
+            TextureFileEntry& entry = pItems[i];
+
+            entry.IsValid = file.Open(entry.Path.c_str()) &&
+                            FromTextureFile(file.GetData(), file.GetSize(), &entry.Builder, &entry.Layout);
+            file.Close();
+        }
+    });
+
+    return true;
+}
+} // AR
@@ -0,0 +1,124 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <string>
+#include <vector>
+
+namespace AR {
+
+//=====================================================================================================================
+// Texture file container
+enum class TextureFileType : uint32_t
+{
+    DDS  = 0, ///< DirectDraw Surface (legacy or DX10 extended header)
+    KTX2 = 1, ///< Khronos texture 2.0 (without supercompression)
+};
+
+//=====================================================================================================================
+// Location of the texel data of a parsed texture file
+struct TextureFileLayout
+{
+    TextureFileType Type;                               ///< Container
+    uint32_t        FaceCount;                          ///< 6 for cube maps (counted in the array size), else 1
+    uint64_t        DataOffset;                         ///< File offset of the first texel byte
+    uint64_t        DataSize;                           ///< Texel data size in bytes
+    uint64_t        LevelOffsets[D3D12_REQ_MIP_LEVELS]; ///< File offset of every mip level (KTX2 only)
+};
+
+//=====================================================================================================================
+// Packed texel data of one subresource inside a texture file
+struct TextureSubresourceData
+{
+    uint64_t Offset;     ///< File offset
+    uint64_t RowPitch;   ///< Row pitch in bytes (rows of blocks for block compressed formats)
+    uint64_t SlicePitch; ///< Depth slice pitch in bytes
+    uint32_t NumRows;    ///< Rows per depth slice
+    uint32_t Depth;      ///< Depth slice count
+};
+
+//=====================================================================================================================
+// Texture file found by ScanTextureDirectory
+struct TextureFileEntry
+{
+    std::string       Path;    ///< File path
+    ResourceBuilder   Builder; ///< Resource description
+    TextureFileLayout Layout;  ///< Texel data location
+    bool              IsValid; ///< The header was parsed (Builder and Layout are undefined otherwise)
+};
+
+/// Initialises a builder from a DDS file. Covers the DX10 extended header (1D, 2D and 3D textures, arrays and cube
+/// maps), legacy cube maps and volumes, FourCC block compressed and floating-point formats, and the common legacy
+/// RGB, luminance, alpha and bump-map pixel formats. Returns false for unsupported or truncated files.
+///
+/// @param pData    [in]  File bytes (e.g. a MappedFile view)
+/// @param size     [in]  File size in bytes
+/// @param pBuilder [out] Resource description
+/// @param pLayout  [out] Optional texel data location
+///
+bool FromDDS(const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout = nullptr);
+
+/// Initialises a builder from a KTX2 file. Formats are translated from VkFormat; supercompressed files and formats
+/// without a DXGI equivalent return false.
+///
+/// @param pData    [in]  File bytes (e.g. a MappedFile view)
+/// @param size     [in]  File size in bytes
+/// @param pBuilder [out] Resource description
+/// @param pLayout  [out] Optional texel data location
+///
+bool FromKTX2(const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout = nullptr);
+
+/// Initialises a builder from a DDS or KTX2 file, selected by the file identifier
+///
+/// @param pData    [in]  File bytes
+/// @param size     [in]  File size in bytes
+/// @param pBuilder [out] Resource description
+/// @param pLayout  [out] Optional texel data location
+///
+bool FromTextureFile(
+    const uint8_t* pData, size_t size, ResourceBuilder* pBuilder, TextureFileLayout* pLayout = nullptr);
+
+/// Returns the file location of a subresource's texel data, ready for UploadRingPlanner::WriteSubresource
+///
+/// @param builder     [in]  Resource description returned by the parser
+/// @param layout      [in]  Texel data location returned by the parser
+/// @param subresource [in]  Subresource index
+/// @param pData       [out] Subresource data location
+///
+bool GetTextureSubresourceData(
+    const ResourceBuilder&   builder,
+    const TextureFileLayout& layout,
+    uint32_t                 subresource,
+    TextureSubresourceData*  pData);
+
+/// Parses the headers of every .dds and .ktx2 file in a directory on the shared worker pool (see ParallelFor), so
+/// repeated scans start no threads. Files are memory-mapped so only the header pages are read. Entries are sorted by
+/// path.
+///
+/// @param pPath       [in]  Directory path
+/// @param recursive   [in]  Include subdirectories
+/// @param pEntries    [out] Found files
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+/// Returns false when the directory cannot be read.
+bool ScanTextureDirectory(
+    const char* pPath, bool recursive, std::vector<TextureFileEntry>* pEntries, uint32_t threadCount = 0);
+} // AR
@@ -0,0 +1,227 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "UploadRing.h"
+#include <cstring>
+
+namespace AR {
+
+//=====================================================================================================================
+// Initialise planner
+UploadRingPlanner::UploadRingPlanner(
+    uint64_t ringSize)
+    :
+    m_size(ringSize),
+    m_head(0),
+    m_tail(0),
+    m_used(0),
+    m_plan()
+{
+}
+
+//=====================================================================================================================
+// Plans requests in order until the ring is full
+const UploadPlan& UploadRingPlanner::Plan(
+    const UploadRequest* pRequests, uint32_t count, uint64_t fenceValue)
+{
+    m_plan.Copies.clear();
+    m_plan.Groups.clear();
+    m_plan.RequestCount   = 0;
+    m_plan.AllocatedBytes = 0;
+
+    m_copies.clear();
+    m_groupOf.clear();
+    m_groups.clear();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const UploadRequest& request  = pRequests[i];
+        const uint64_t       required = GetRequiredBytes(request);
+
+        uint64_t consumed = 0;
+        uint64_t offset   = (required != UINT64_MAX) ? Allocate(required, &consumed) : UINT64_MAX;
+
+        if (offset == UINT64_MAX)
+        {
+            break;
+        }
+
+        m_layouts.resize(request.NumSubresources);
+        m_numRows.resize(request.NumSubresources);
+        m_rowSize.resize(request.NumSubresources);
+
+        request.Builder.GetCopyableFootprints(request.FirstSubresource, request.NumSubresources, offset,
+            m_layouts.data(), m_numRows.data(), m_rowSize.data(), nullptr);
+
+        auto group = m_groups.emplace(request.Destination, static_cast<uint32_t>(m_plan.Groups.size()));
+
+        if (group.second)
+        {
+            m_plan.Groups.push_back({ request.Destination, 0, 0 });
+        }
+
+        for (uint32_t j = 0; j < request.NumSubresources; j++)
+        {
+            UploadCopy copy = {};
+            copy.Footprint      = m_layouts[j];
+            copy.RowSizeInBytes = m_rowSize[j];
+            copy.NumRows        = m_numRows[j];
+            copy.Request        = i;
+            copy.Subresource    = request.FirstSubresource + j;
+
+            m_copies.push_back(copy);
+            m_groupOf.push_back(group.first->second);
+        }
+
+        m_plan.Groups[group.first->second].CopyCount += request.NumSubresources;
+        m_plan.AllocatedBytes                        += consumed;
+        m_plan.RequestCount++;
+    }
+
+    // Group copies by destination, keeping request order inside each group
+    uint32_t firstCopy = 0;
+
+    for (UploadGroup& group : m_plan.Groups)
+    {
+        group.FirstCopy = firstCopy;
+        firstCopy      += group.CopyCount;
+        group.CopyCount = 0;
+    }
+
+    m_plan.Copies.resize(m_copies.size());
+
+    for (size_t i = 0; i < m_copies.size(); i++)
+    {
+        UploadGroup& group = m_plan.Groups[m_groupOf[i]];
+        m_plan.Copies[group.FirstCopy + group.CopyCount++] = m_copies[i];
+    }
+
+    if (m_plan.AllocatedBytes != 0)
+    {
+        if ((m_submissions.empty() == false) && (m_submissions.back().FenceValue == fenceValue))
+        {
+            m_submissions.back().End    = m_head;
+            m_submissions.back().Bytes += m_plan.AllocatedBytes;
+        }
+        else
+        {
+            m_submissions.push_back({ fenceValue, m_head, m_plan.AllocatedBytes });
+        }
+    }
+
+    return m_plan;
+}
+
+//=====================================================================================================================
+// Reclaims the ring space of plans whose fence value completed
+void UploadRingPlanner::Retire(
+    uint64_t completedFenceValue)
+{
+    while ((m_submissions.empty() == false) && (m_submissions.front().FenceValue <= completedFenceValue))
+    {
+        m_tail  = m_submissions.front().End;
+        m_used -= m_submissions.front().Bytes;
+        m_submissions.pop_front();
+    }
+}
+
+//=====================================================================================================================
+// Returns the contiguous ring bytes a request needs
+uint64_t UploadRingPlanner::GetRequiredBytes(
+    const UploadRequest& request)
+{
+    uint64_t totalBytes = UINT64_MAX;
+
+    if (request.NumSubresources != 0)
+    {
+        request.Builder.GetCopyableFootprints(
+            request.FirstSubresource, request.NumSubresources, 0, nullptr, nullptr, nullptr, &totalBytes);
+    }
+
+    return totalBytes;
+}
+
+//=====================================================================================================================
+// Writes tightly packed source data of one copy into the mapped ring buffer
+void UploadRingPlanner::WriteSubresource(
+    void* pRingData, const UploadCopy& copy, const void* pSrcData, uint64_t rowPitch, uint64_t slicePitch)
+{
+    const D3D12_SUBRESOURCE_FOOTPRINT& footprint = copy.Footprint.Footprint;
+
+    uint8_t*       pDst = static_cast<uint8_t*>(pRingData) + copy.Footprint.Offset;
+    const uint8_t* pSrc = static_cast<const uint8_t*>(pSrcData);
+
+    for (uint32_t z = 0; z < footprint.Depth; z++)
+    {
+        uint8_t*       pDstSlice = pDst + (uint64_t(footprint.RowPitch) * copy.NumRows * z);
+        const uint8_t* pSrcSlice = pSrc + (slicePitch * z);
+
+        for (uint32_t y = 0; y < copy.NumRows; y++)
+        {
+            std::memcpy(pDstSlice + (uint64_t(footprint.RowPitch) * y), pSrcSlice + (rowPitch * y),
+                static_cast<size_t>(copy.RowSizeInBytes));
+        }
+    }
+}
+
+//=====================================================================================================================
+// Allocates a 512-byte aligned block
+uint64_t UploadRingPlanner::Allocate(
+    uint64_t size, uint64_t* pConsumed)
+{
+    // An empty ring restarts at offset zero so the largest block fits
+    if (m_used == 0)
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    const uint64_t start  = AlignUp(m_head, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    uint64_t       offset = UINT64_MAX;
+
+    if ((m_head > m_tail) || (m_used == 0))
+    {
+        // Free space is [head, size) followed by [0, tail): wrap when the block does not fit before the end
+        if (start + size <= m_size)
+        {
+            offset     = start;
+            *pConsumed = (start - m_head) + size;
+        }
+        else if (size <= m_tail)
+        {
+            offset     = 0;
+            *pConsumed = (m_size - m_head) + size;
+        }
+    }
+    else if ((m_head < m_tail) && (start + size <= m_tail))
+    {
+        // Free space is [head, tail)
+        offset     = start;
+        *pConsumed = (start - m_head) + size;
+    }
+
+    if (offset != UINT64_MAX)
+    {
+        m_head  = offset + size;
+        m_used += *pConsumed;
+    }
+
+    return offset;
+}
+} // AR
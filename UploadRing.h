@@ -0,0 +1,151 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace AR {
+
+//=====================================================================================================================
+// Subresource range of one destination resource to upload
+struct UploadRequest
+{
+    ResourceBuilder Builder;          ///< Destination resource description
+    uint32_t        Destination;      ///< Caller destination identity (copies are grouped by it)
+    uint32_t        FirstSubresource; ///< First destination subresource
+    uint32_t        NumSubresources;  ///< Subresource count
+};
+
+//=====================================================================================================================
+// Copy from the ring buffer into one destination subresource (CopyTextureRegion, or CopyBufferRegion for buffers)
+struct UploadCopy
+{
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT Footprint;      ///< Source footprint (offset relative to the ring buffer start)
+    uint64_t                           RowSizeInBytes; ///< Unpadded row size (bytes to write per row)
+    uint32_t                           NumRows;        ///< Rows per depth slice
+    uint32_t                           Request;        ///< Index into the request array
+    uint32_t                           Subresource;    ///< Destination subresource index
+};
+
+//=====================================================================================================================
+// Consecutive copies into one destination
+struct UploadGroup
+{
+    uint32_t Destination; ///< Caller destination identity
+    uint32_t FirstCopy;   ///< Index into UploadPlan::Copies
+    uint32_t CopyCount;   ///< Copy count
+};
+
+//=====================================================================================================================
+// Upload plan output
+struct UploadPlan
+{
+    std::vector<UploadCopy>  Copies;         ///< Copies grouped by destination (in first request order)
+    std::vector<UploadGroup> Groups;         ///< Destination groups (one transition barrier each)
+    uint32_t                 RequestCount;   ///< Requests planned (a prefix of the input; the rest did not fit)
+    uint64_t                 AllocatedBytes; ///< Ring bytes consumed, including alignment and wrap padding
+};
+
+//=====================================================================================================================
+// Plans texture and buffer uploads into a persistent ring-buffer upload heap without a device. Each request gets one
+// contiguous block laid out by ResourceBuilder::GetCopyableFootprints at a 512-byte aligned ring offset, blocks wrap
+// to the start of the ring when the end is reached, and the space of a plan is reclaimed once the fence value it
+// was tagged with completes. Copies come out grouped per destination so one command list can issue one barrier and
+// a run of copies per resource.
+class UploadRingPlanner
+{
+public:
+    /// Initialise planner
+    ///
+    /// @param ringSize [in] Ring buffer size in bytes
+    ///
+    explicit UploadRingPlanner(uint64_t ringSize);
+
+    /// Plans requests in order until the ring is full. Requests that were not planned can be submitted again after
+    /// Retire frees space. A request larger than the ring must be split into smaller subresource ranges, and a
+    /// request whose footprints cannot be described is never planned (see GetRequiredBytes).
+    ///
+    /// @param pRequests  [in] Request array
+    /// @param count      [in] Request count
+    /// @param fenceValue [in] Fence value signalled after the copies of the plan execute
+    ///
+    const UploadPlan& Plan(const UploadRequest* pRequests, uint32_t count, uint64_t fenceValue);
+
+    /// Reclaims the ring space of plans whose fence value completed
+    ///
+    /// @param completedFenceValue [in] Last completed fence value
+    ///
+    void Retire(uint64_t completedFenceValue);
+
+    /// Returns the most recent plan
+    const UploadPlan& GetPlan() const { return m_plan; }
+
+    /// Returns the ring buffer size in bytes
+    uint64_t GetSize() const { return m_size; }
+
+    /// Returns the ring bytes in use by plans that did not retire
+    uint64_t GetUsedBytes() const { return m_used; }
+
+    /// Returns the contiguous ring bytes a request needs (UINT64_MAX when its footprints cannot be described)
+    ///
+    /// @param request [in] Upload request
+    ///
+    static uint64_t GetRequiredBytes(const UploadRequest& request);
+
+    /// Writes tightly packed source data of one copy into the mapped ring buffer
+    ///
+    /// @param pRingData  [in] Mapped ring buffer start
+    /// @param copy       [in] Planned copy
+    /// @param pSrcData   [in] Source data of the subresource
+    /// @param rowPitch   [in] Source row pitch in bytes
+    /// @param slicePitch [in] Source depth slice pitch in bytes
+    ///
+    static void WriteSubresource(
+        void* pRingData, const UploadCopy& copy, const void* pSrcData, uint64_t rowPitch, uint64_t slicePitch);
+
+private:
+    /// @internal Ring space of one plan
+    struct Submission
+    {
+        uint64_t FenceValue; ///< Fence value of the plan
+        uint64_t End;        ///< Ring offset after the last block of the plan
+        uint64_t Bytes;      ///< Ring bytes consumed by the plan
+    };
+
+    /// @internal Allocates a 512-byte aligned block, returning UINT64_MAX when the ring is full
+    uint64_t Allocate(uint64_t size, uint64_t* pConsumed);
+
+    uint64_t                                        m_size;        ///< Ring size in bytes
+    uint64_t                                        m_head;        ///< Next free ring offset
+    uint64_t                                        m_tail;        ///< Oldest ring offset still in use
+    uint64_t                                        m_used;        ///< Bytes in use (including padding)
+    std::deque<Submission>                          m_submissions; ///< Plans waiting for their fence, oldest first
+    UploadPlan                                      m_plan;        ///< Plan output
+    std::vector<UploadCopy>                         m_copies;      ///< Copies in request order (scratch)
+    std::vector<uint32_t>                           m_groupOf;     ///< Group index per copy (scratch)
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> m_layouts;     ///< Request footprints (scratch)
+    std::vector<uint32_t>                           m_numRows;     ///< Request row counts (scratch)
+    std::vector<uint64_t>                           m_rowSize;     ///< Request row sizes (scratch)
+    std::unordered_map<uint32_t, uint32_t>          m_groups;      ///< Group index per destination (scratch)
+};
+} // AR
@@ -0,0 +1,87 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "ViewBatch.h"
+#include "Parallel.h"
+
+namespace AR {
+
+// Smallest number of views worth handing to a worker thread
+static constexpr uint32_t MinViewsPerThread = 1024;
+
+//=====================================================================================================================
+// Builds shader resource views for an array of builders
+void BuildShaderResourceViews(
+    const ResourceBuilder*          pBuilders,
+    const ShaderResourceViewParams* pParams,
+    uint32_t                        count,
+    D3D12_SHADER_RESOURCE_VIEW_DESC* pViews,
+    uint32_t                        threadCount)
+{
+    const ShaderResourceViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinViewsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            pViews[i] = BuildShaderResourceView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Builds color target views for an array of builders
+void BuildColorTargetViews(
+    const ResourceBuilder*         pBuilders,
+    const ColorTargetViewParams*   pParams,
+    uint32_t                       count,
+    D3D12_RENDER_TARGET_VIEW_DESC* pViews,
+    uint32_t                       threadCount)
+{
+    const ColorTargetViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinViewsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            pViews[i] = BuildColorTargetView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Builds depth-stencil views for an array of builders
+void BuildDepthStencilViews(
+    const ResourceBuilder*         pBuilders,
+    const DepthStencilViewParams*  pParams,
+    uint32_t                       count,
+    D3D12_DEPTH_STENCIL_VIEW_DESC* pViews,
+    uint32_t                       threadCount)
+{
+    const DepthStencilViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinViewsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            pViews[i] = BuildDepthStencilView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+        }
+    });
+}
+} // AR
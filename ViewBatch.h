@@ -0,0 +1,177 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ResourceBuilder.h"
+
+namespace AR {
+
+//=====================================================================================================================
+// Per-item shader resource view parameters (mirrors AsShaderResourceView, AsShaderResourceViewArray and
+// AsBufferResourceView arguments)
+struct ShaderResourceViewParams
+{
+    DXGI_FORMAT ViewFormat   = DXGI_FORMAT_UNKNOWN;                     ///< Override view format
+    uint16_t    BaseMip      = 0;                                       ///< Base mip level
+    uint16_t    MipLevels    = D3D12_REQ_MIP_LEVELS;                    ///< Mip count
+    uint16_t    BaseArray    = 0;                                       ///< Base array slice (array views only)
+    uint16_t    ArraySize    = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION; ///< Array count (array views only)
+    float       MinLod       = 0.0f;                                    ///< Minimum level of detail
+    bool        IsArray      = false;                                   ///< Build an array view
+    uint32_t    FirstElement = 0;                                       ///< First buffer element (buffers only)
+    uint32_t    NumElements  = 0xffffffff;                              ///< Buffer element count (buffers only)
+    uint32_t    ByteStride   = 0;                                       ///< Structured buffer stride (buffers only)
+};
+
+//=====================================================================================================================
+// Per-item color target view parameters (mirrors AsColorTargetView and AsColorTargetViewArray arguments)
+struct ColorTargetViewParams
+{
+    DXGI_FORMAT ViewFormat = DXGI_FORMAT_UNKNOWN;                     ///< Color target view format
+    uint16_t    BaseMip    = 0;                                       ///< Base mip level
+    uint16_t    BaseArray  = 0;                                       ///< Base array slice (array views only)
+    uint16_t    ArraySize  = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION; ///< Array count (array views only)
+    bool        IsArray    = false;                                   ///< Build an array view
+};
+
+//=====================================================================================================================
+// Per-item depth-stencil view parameters (mirrors AsDepthStencilView and AsDepthStencilViewArray arguments)
+struct DepthStencilViewParams
+{
+    DXGI_FORMAT ViewFormat = DXGI_FORMAT_UNKNOWN;                     ///< Depth-stencil view format
+    uint16_t    BaseMip    = 0;                                       ///< Base mip level
+    uint16_t    BaseArray  = 0;                                       ///< Base array slice (array views only)
+    uint16_t    ArraySize  = D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION; ///< Array count (array views only)
+    bool        IsArray    = false;                                   ///< Build an array view
+};
+
+/// Returns the shader resource view selected by per-item parameters (AsShaderResourceView,
+/// AsShaderResourceViewArray, or AsBufferResourceView for buffer builders)
+///
+/// @param builder [in] Resource builder
+/// @param params  [in] View parameters
+///
+AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC BuildShaderResourceView(
+    const ResourceBuilder& builder, const ShaderResourceViewParams& params);
+
+/// Returns the color target view selected by per-item parameters
+///
+/// @param builder [in] Resource builder
+/// @param params  [in] View parameters
+///
+AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC BuildColorTargetView(
+    const ResourceBuilder& builder, const ColorTargetViewParams& params);
+
+/// Returns the depth-stencil view selected by per-item parameters
+///
+/// @param builder [in] Resource builder
+/// @param params  [in] View parameters
+///
+AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC BuildDepthStencilView(
+    const ResourceBuilder& builder, const DepthStencilViewParams& params);
+
+/// Builds shader resource views for an array of builders. Output is identical to calling AsShaderResourceView,
+/// AsShaderResourceViewArray or AsBufferResourceView (buffer builders) on each item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pViews      [out] View description array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildShaderResourceViews(
+    const ResourceBuilder*          pBuilders,
+    const ShaderResourceViewParams* pParams,
+    uint32_t                        count,
+    D3D12_SHADER_RESOURCE_VIEW_DESC* pViews,
+    uint32_t                        threadCount = 1);
+
+/// Builds color target views for an array of builders. Output is identical to calling AsColorTargetView or
+/// AsColorTargetViewArray on each item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pViews      [out] View description array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildColorTargetViews(
+    const ResourceBuilder*         pBuilders,
+    const ColorTargetViewParams*   pParams,
+    uint32_t                       count,
+    D3D12_RENDER_TARGET_VIEW_DESC* pViews,
+    uint32_t                       threadCount = 1);
+
+/// Builds depth-stencil views for an array of builders. Output is identical to calling AsDepthStencilView or
+/// AsDepthStencilViewArray on each item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pViews      [out] View description array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildDepthStencilViews(
+    const ResourceBuilder*         pBuilders,
+    const DepthStencilViewParams*  pParams,
+    uint32_t                       count,
+    D3D12_DEPTH_STENCIL_VIEW_DESC* pViews,
+    uint32_t                       threadCount = 1);
+
+//=====================================================================================================================
+// Returns the shader resource view selected by per-item parameters
+AR_CONSTEXPR D3D12_SHADER_RESOURCE_VIEW_DESC BuildShaderResourceView(
+    const ResourceBuilder& builder, const ShaderResourceViewParams& params)
+{
+    if (builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return builder.AsBufferResourceView(
+            params.FirstElement, params.NumElements, params.ByteStride, params.ViewFormat);
+    }
+
+    if (params.IsArray)
+    {
+        return builder.AsShaderResourceViewArray(
+            params.ViewFormat, params.BaseMip, params.BaseArray, params.MipLevels, params.ArraySize, params.MinLod);
+    }
+
+    return builder.AsShaderResourceView(params.ViewFormat, params.BaseMip, params.MipLevels, params.MinLod);
+}
+
+//=====================================================================================================================
+// Returns the color target view selected by per-item parameters
+AR_CONSTEXPR D3D12_RENDER_TARGET_VIEW_DESC BuildColorTargetView(
+    const ResourceBuilder& builder, const ColorTargetViewParams& params)
+{
+    return params.IsArray ?
+        builder.AsColorTargetViewArray(params.ViewFormat, params.BaseMip, params.BaseArray, params.ArraySize) :
+        builder.AsColorTargetView(params.ViewFormat, params.BaseMip);
+}
+
+//=====================================================================================================================
+// Returns the depth-stencil view selected by per-item parameters
+AR_CONSTEXPR D3D12_DEPTH_STENCIL_VIEW_DESC BuildDepthStencilView(
+    const ResourceBuilder& builder, const DepthStencilViewParams& params)
+{
+    return params.IsArray ?
+        builder.AsDepthStencilViewArray(params.ViewFormat, params.BaseMip, params.BaseArray, params.ArraySize) :
+        builder.AsDepthStencilView(params.ViewFormat, params.BaseMip);
+}
+} // AR
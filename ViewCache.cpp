@@ -0,0 +1,476 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "ViewCache.h"
+#include <cstring>
+#include <thread>
+
+namespace AR {
+
+//=====================================================================================================================
+// Returns the bit pattern of a float
+static uint32_t FloatBits(
+    float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//=====================================================================================================================
+// Packs view type, dimension and flags into the key type field
+static uint32_t PackViewType(
+    ViewType type, uint32_t dimension, uint32_t flags)
+{
+    return static_cast<uint32_t>(type) | (dimension << 8) | (flags << 16);
+}
+
+//=====================================================================================================================
+// Builds the key of a shader resource view
+ViewKey MakeViewKey(
+    uint64_t resourceId, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc)
+{
+    ViewKey key = {};
+    key.ResourceId = resourceId;
+    key.Format     = viewDesc.Format;
+    key.Mapping    = viewDesc.Shader4ComponentMapping;
+
+    uint32_t flags = 0;
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_SRV_DIMENSION_BUFFER:
+        key.FirstElement  = viewDesc.Buffer.FirstElement;
+        key.Count         = viewDesc.Buffer.NumElements;
+        key.PlaneOrStride = viewDesc.Buffer.StructureByteStride;
+        flags             = viewDesc.Buffer.Flags;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE1D:
+        key.FirstElement = viewDesc.Texture1D.MostDetailedMip;
+        key.Count        = viewDesc.Texture1D.MipLevels;
+        key.MinLodBits   = FloatBits(viewDesc.Texture1D.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE1DARRAY:
+        key.FirstElement = viewDesc.Texture1DArray.MostDetailedMip;
+        key.Count        = viewDesc.Texture1DArray.MipLevels;
+        key.FirstSlice   = viewDesc.Texture1DArray.FirstArraySlice;
+        key.SliceCount   = viewDesc.Texture1DArray.ArraySize;
+        key.MinLodBits   = FloatBits(viewDesc.Texture1DArray.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2D:
+        key.FirstElement  = viewDesc.Texture2D.MostDetailedMip;
+        key.Count         = viewDesc.Texture2D.MipLevels;
+        key.PlaneOrStride = viewDesc.Texture2D.PlaneSlice;
+        key.MinLodBits    = FloatBits(viewDesc.Texture2D.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:
+        key.FirstElement  = viewDesc.Texture2DArray.MostDetailedMip;
+        key.Count         = viewDesc.Texture2DArray.MipLevels;
+        key.FirstSlice    = viewDesc.Texture2DArray.FirstArraySlice;
+        key.SliceCount    = viewDesc.Texture2DArray.ArraySize;
+        key.PlaneOrStride = viewDesc.Texture2DArray.PlaneSlice;
+        key.MinLodBits    = FloatBits(viewDesc.Texture2DArray.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY:
+        key.FirstSlice = viewDesc.Texture2DMSArray.FirstArraySlice;
+        key.SliceCount = viewDesc.Texture2DMSArray.ArraySize;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE3D:
+        key.FirstElement = viewDesc.Texture3D.MostDetailedMip;
+        key.Count        = viewDesc.Texture3D.MipLevels;
+        key.MinLodBits   = FloatBits(viewDesc.Texture3D.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBE:
+        key.FirstElement = viewDesc.TextureCube.MostDetailedMip;
+        key.Count        = viewDesc.TextureCube.MipLevels;
+        key.MinLodBits   = FloatBits(viewDesc.TextureCube.ResourceMinLODClamp);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY:
+        key.FirstElement = viewDesc.TextureCubeArray.MostDetailedMip;
+        key.Count        = viewDesc.TextureCubeArray.MipLevels;
+        key.FirstSlice   = viewDesc.TextureCubeArray.First2DArrayFace;
+        key.SliceCount   = viewDesc.TextureCubeArray.NumCubes;
+        key.MinLodBits   = FloatBits(viewDesc.TextureCubeArray.ResourceMinLODClamp);
+        break;
+    default: // D3D12_SRV_DIMENSION_TEXTURE2DMS carries no parameters
+        break;
+    }
+
+    key.Type = PackViewType(ViewType::ShaderResource, viewDesc.ViewDimension, flags);
+
+    return key;
+}
+
+//=====================================================================================================================
+// Builds the key of a render target view
+ViewKey MakeViewKey(
+    uint64_t resourceId, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc)
+{
+    ViewKey key = {};
+    key.ResourceId = resourceId;
+    key.Format     = viewDesc.Format;
+    key.Type       = PackViewType(ViewType::RenderTarget, viewDesc.ViewDimension, 0);
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_RTV_DIMENSION_BUFFER:
+        key.FirstElement = viewDesc.Buffer.FirstElement;
+        key.Count        = viewDesc.Buffer.NumElements;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE1D:
+        key.FirstElement = viewDesc.Texture1D.MipSlice;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE1DARRAY:
+        key.FirstElement = viewDesc.Texture1DArray.MipSlice;
+        key.FirstSlice   = viewDesc.Texture1DArray.FirstArraySlice;
+        key.SliceCount   = viewDesc.Texture1DArray.ArraySize;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2D:
+        key.FirstElement  = viewDesc.Texture2D.MipSlice;
+        key.PlaneOrStride = viewDesc.Texture2D.PlaneSlice;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DARRAY:
+        key.FirstElement  = viewDesc.Texture2DArray.MipSlice;
+        key.FirstSlice    = viewDesc.Texture2DArray.FirstArraySlice;
+        key.SliceCount    = viewDesc.Texture2DArray.ArraySize;
+        key.PlaneOrStride = viewDesc.Texture2DArray.PlaneSlice;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY:
+        key.FirstSlice = viewDesc.Texture2DMSArray.FirstArraySlice;
+        key.SliceCount = viewDesc.Texture2DMSArray.ArraySize;
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE3D:
+        key.FirstElement = viewDesc.Texture3D.MipSlice;
+        key.FirstSlice   = viewDesc.Texture3D.FirstWSlice;
+        key.SliceCount   = viewDesc.Texture3D.WSize;
+        break;
+    default: // D3D12_RTV_DIMENSION_TEXTURE2DMS carries no parameters
+        break;
+    }
+
+    return key;
+}
+
+//=====================================================================================================================
+// Builds the key of a depth-stencil view
+ViewKey MakeViewKey(
+    uint64_t resourceId, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc)
+{
+    ViewKey key = {};
+    key.ResourceId = resourceId;
+    key.Format     = viewDesc.Format;
+    key.Type       = PackViewType(ViewType::DepthStencil, viewDesc.ViewDimension, viewDesc.Flags);
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_DSV_DIMENSION_TEXTURE1D:
+        key.FirstElement = viewDesc.Texture1D.MipSlice;
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE1DARRAY:
+        key.FirstElement = viewDesc.Texture1DArray.MipSlice;
+        key.FirstSlice   = viewDesc.Texture1DArray.FirstArraySlice;
+        key.SliceCount   = viewDesc.Texture1DArray.ArraySize;
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2D:
+        key.FirstElement = viewDesc.Texture2D.MipSlice;
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DARRAY:
+        key.FirstElement = viewDesc.Texture2DArray.MipSlice;
+        key.FirstSlice   = viewDesc.Texture2DArray.FirstArraySlice;
+        key.SliceCount   = viewDesc.Texture2DArray.ArraySize;
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY:
+        key.FirstSlice = viewDesc.Texture2DMSArray.FirstArraySlice;
+        key.SliceCount = viewDesc.Texture2DMSArray.ArraySize;
+        break;
+    default: // D3D12_DSV_DIMENSION_TEXTURE2DMS carries no parameters
+        break;
+    }
+
+    return key;
+}
+
+//=====================================================================================================================
+// Builds the key of an unordered access view
+ViewKey MakeViewKey(
+    uint64_t resourceId, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc)
+{
+    ViewKey key = {};
+    key.ResourceId = resourceId;
+    key.Format     = viewDesc.Format;
+
+    uint32_t flags = 0;
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_UAV_DIMENSION_BUFFER:
+        key.FirstElement  = viewDesc.Buffer.FirstElement;
+        key.Count         = viewDesc.Buffer.NumElements;
+        key.PlaneOrStride = viewDesc.Buffer.StructureByteStride;
+        // Buffer views keep the counter offset in the otherwise unused MinLodBits field
+        key.MinLodBits    = static_cast<uint32_t>(viewDesc.Buffer.CounterOffsetInBytes);
+        flags             = viewDesc.Buffer.Flags;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE1D:
+        key.FirstElement = viewDesc.Texture1D.MipSlice;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE1DARRAY:
+        key.FirstElement = viewDesc.Texture1DArray.MipSlice;
+        key.FirstSlice   = viewDesc.Texture1DArray.FirstArraySlice;
+        key.SliceCount   = viewDesc.Texture1DArray.ArraySize;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE2D:
+        key.FirstElement  = viewDesc.Texture2D.MipSlice;
+        key.PlaneOrStride = viewDesc.Texture2D.PlaneSlice;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE2DARRAY:
+        key.FirstElement  = viewDesc.Texture2DArray.MipSlice;
+        key.FirstSlice    = viewDesc.Texture2DArray.FirstArraySlice;
+        key.SliceCount    = viewDesc.Texture2DArray.ArraySize;
+        key.PlaneOrStride = viewDesc.Texture2DArray.PlaneSlice;
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE3D:
+        key.FirstElement = viewDesc.Texture3D.MipSlice;
+        key.FirstSlice   = viewDesc.Texture3D.FirstWSlice;
+        key.SliceCount   = viewDesc.Texture3D.WSize;
+        break;
+    default:
+        break;
+    }
+
+    key.Type = PackViewType(ViewType::UnorderedAccess, viewDesc.ViewDimension, flags);
+
+    return key;
+}
+
+//=====================================================================================================================
+// Returns the stable 64-bit hash of a view key
+uint64_t HashViewKey(
+    const ViewKey& key)
+{
+    static_assert(sizeof(ViewKey) == 48, "ViewKey must not contain padding");
+
+    uint8_t bytes[sizeof(ViewKey)] = {};
+    std::memcpy(bytes, &key, sizeof(key));
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (uint8_t byte : bytes)
+    {
+        hash = (hash ^ byte) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+//=====================================================================================================================
+// Initialise cache
+ViewCache::ViewCache(
+    uint32_t capacity)
+    :
+    m_mask(0),
+    m_size(0),
+    m_used(0),
+    m_hits(0),
+    m_misses(0)
+{
+    uint32_t tableSize = 16;
+
+    while (tableSize < capacity)
+    {
+        tableSize <<= 1;
+    }
+
+    m_slots.reset(new Slot[tableSize]);
+    m_mask = tableSize - 1;
+
+    for (uint32_t i = 0; i < tableSize; i++)
+    {
+        m_slots[i].State.store(SlotEmpty, std::memory_order_relaxed);
+    }
+}
+
+//=====================================================================================================================
+// Looks up a descriptor
+bool ViewCache::Find(
+    const ViewKey& key, uint64_t* pDescriptor
+    ) const
+{
+    const uint64_t hash = HashViewKey(key);
+
+    for (uint32_t probe = 0; probe <= m_mask; probe++)
+    {
+        const Slot&    slot  = m_slots[(hash + probe) & m_mask];
+        const uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        if (state == SlotEmpty)
+        {
+            break;
+        }
+
+        if ((state == SlotReady) && (slot.Hash == hash) && (std::memcmp(&slot.Key, &key, sizeof(key)) == 0))
+        {
+            *pDescriptor = slot.Descriptor;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+//=====================================================================================================================
+// Returns the cached descriptor for a key, inserting the given descriptor when the key is not cached yet
+uint64_t ViewCache::FindOrInsert(
+    const ViewKey& key, uint64_t descriptor, bool* pInserted)
+{
+    // Keep a quarter of the table empty so probe sequences stay short and always terminate
+    const uint32_t maxUsed = (m_mask + 1) - ((m_mask + 1) / 4);
+    const uint64_t hash    = HashViewKey(key);
+
+    if (pInserted != nullptr)
+    {
+        *pInserted = false;
+    }
+
+    for (uint32_t probe = 0; probe <= m_mask; probe++)
+    {
+        Slot&    slot  = m_slots[(hash + probe) & m_mask];
+        uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            if (state == SlotEmpty)
+            {
+                if (m_used.load(std::memory_order_relaxed) >= maxUsed)
+                {
+                    return UINT64_MAX;
+                }
+
+                if (slot.State.compare_exchange_weak(state, SlotWriting, std::memory_order_acquire))
+                {
+                    slot.Hash       = hash;
+                    slot.Key        = key;
+                    slot.Descriptor = descriptor;
+                    slot.State.store(SlotReady, std::memory_order_release);
+
+                    m_used.fetch_add(1, std::memory_order_relaxed);
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+
+                    if (pInserted != nullptr)
+                    {
+                        *pInserted = true;
+                    }
+
+                    return descriptor;
+                }
+
+                // Lost the race for this slot; re-examine it with the state the winner published
+                continue;
+            }
+
+            if (state == SlotWriting)
+            {
+                // Another thread is publishing this slot, possibly for the same key
+                std::this_thread::yield();
+                state = slot.State.load(std::memory_order_acquire);
+                continue;
+            }
+
+            break;
+        }
+
+        if ((state == SlotReady) && (slot.Hash == hash) && (std::memcmp(&slot.Key, &key, sizeof(key)) == 0))
+        {
+            return slot.Descriptor;
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+//=====================================================================================================================
+// Invalidates every view of a released resource
+uint32_t ViewCache::Invalidate(
+    uint64_t resourceId, std::vector<uint64_t>* pReleased)
+{
+    uint32_t invalidated = 0;
+
+    for (uint32_t i = 0; i <= m_mask; i++)
+    {
+        Slot&    slot  = m_slots[i];
+        uint32_t state = slot.State.load(std::memory_order_acquire);
+
+        if ((state == SlotReady) &&
+            (slot.Key.ResourceId == resourceId) &&
+            slot.State.compare_exchange_strong(state, SlotTombstone, std::memory_order_acq_rel))
+        {
+            if (pReleased != nullptr)
+            {
+                pReleased->push_back(slot.Descriptor);
+            }
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            invalidated++;
+        }
+    }
+
+    return invalidated;
+}
+
+//=====================================================================================================================
+// Reclaims invalidated entries
+void ViewCache::Compact()
+{
+    std::vector<Slot*> live;
+    live.reserve(m_size.load(std::memory_order_relaxed));
+
+    const uint32_t tableSize = m_mask + 1;
+    std::unique_ptr<Slot[]> slots(new Slot[tableSize]);
+
+    for (uint32_t i = 0; i < tableSize; i++)
+    {
+        slots[i].State.store(SlotEmpty, std::memory_order_relaxed);
+
+        if (m_slots[i].State.load(std::memory_order_relaxed) == SlotReady)
+        {
+            live.push_back(&m_slots[i]);
+        }
+    }
+
+    for (Slot* pSource : live)
+    {
+        uint32_t index = static_cast<uint32_t>(pSource->Hash) & m_mask;
+
+        while (slots[index].State.load(std::memory_order_relaxed) != SlotEmpty)
+        {
+            index = (index + 1) & m_mask;
+        }
+
+        slots[index].Hash       = pSource->Hash;
+        slots[index].Key        = pSource->Key;
+        slots[index].Descriptor = pSource->Descriptor;
+        slots[index].State.store(SlotReady, std::memory_order_relaxed);
+    }
+
+    m_slots = std::move(slots);
+    m_used.store(static_cast<uint32_t>(live.size()), std::memory_order_release);
+}
+} // AR
@@ -0,0 +1,164 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <d3d12.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AR {
+
+//=====================================================================================================================
+// View type stored in a view key
+enum class ViewType : uint32_t
+{
+    ShaderResource  = 0, ///< Shader resource view
+    RenderTarget    = 1, ///< Render target view
+    DepthStencil    = 2, ///< Depth-stencil view
+    UnorderedAccess = 3, ///< Unordered access view
+};
+
+//=====================================================================================================================
+// Canonical view identity: a resource identity plus the view parameters that select its descriptor. Keys are built
+// field by field from the view description so union padding never reaches the hash.
+struct ViewKey
+{
+    uint64_t ResourceId;    ///< Resource identity (e.g. the ID3D12Resource address)
+    uint64_t FirstElement;  ///< Most detailed or target mip, or first buffer element
+    uint32_t Count;         ///< Mip count, or buffer element count
+    uint32_t FirstSlice;    ///< First array slice, first W slice or first cube face
+    uint32_t SliceCount;    ///< Array slice count, W slice count or cube count
+    uint32_t PlaneOrStride; ///< Plane slice, or structured buffer stride
+    uint32_t Format;        ///< View format
+    uint32_t Type;          ///< ViewType (bits 0-7), view dimension (bits 8-15), view flags (bits 16-31)
+    uint32_t Mapping;       ///< Shader component mapping (shader resource views only)
+    uint32_t MinLodBits;    ///< Minimum LOD clamp bit pattern
+};
+
+/// Builds the key of a shader resource view
+///
+/// @param resourceId [in] Resource identity
+/// @param viewDesc   [in] View description
+///
+ViewKey MakeViewKey(uint64_t resourceId, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc);
+
+/// Builds the key of a render target view
+///
+/// @param resourceId [in] Resource identity
+/// @param viewDesc   [in] View description
+///
+ViewKey MakeViewKey(uint64_t resourceId, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc);
+
+/// Builds the key of a depth-stencil view
+///
+/// @param resourceId [in] Resource identity
+/// @param viewDesc   [in] View description
+///
+ViewKey MakeViewKey(uint64_t resourceId, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc);
+
+/// Builds the key of an unordered access view (the counter resource is not part of the key)
+///
+/// @param resourceId [in] Resource identity
+/// @param viewDesc   [in] View description
+///
+ViewKey MakeViewKey(uint64_t resourceId, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc);
+
+/// Returns the stable 64-bit hash of a view key (FNV-1a over the key fields)
+uint64_t HashViewKey(const ViewKey& key);
+
+//=====================================================================================================================
+// Concurrent cache mapping view keys to previously created descriptors. Lookups are lock-free and may run on any
+// number of recording threads alongside inserts and invalidations. The table has a fixed power-of-two capacity;
+// invalidated entries leave tombstones that Compact reclaims at a point where no other thread uses the cache.
+class ViewCache
+{
+public:
+    /// Initialise cache
+    ///
+    /// @param capacity [optional] Entry capacity (rounded up to a power of two)
+    ///
+    explicit ViewCache(uint32_t capacity = 4096);
+
+    /// Looks up a descriptor
+    ///
+    /// @param key         [in]  View key
+    /// @param pDescriptor [out] Cached descriptor (CPU handle or heap index, as inserted)
+    ///
+    bool Find(const ViewKey& key, uint64_t* pDescriptor) const;
+
+    /// Returns the cached descriptor for a key, inserting the given descriptor when the key is not cached yet. When
+    /// another thread inserted the key first its descriptor is returned and the caller should release its own.
+    ///
+    /// @param key        [in]  View key
+    /// @param descriptor [in]  Descriptor created for the key
+    /// @param pInserted  [out] Optional flag set when the given descriptor was inserted
+    ///
+    /// Returns UINT64_MAX (and does not insert) when the cache is full.
+    uint64_t FindOrInsert(const ViewKey& key, uint64_t descriptor, bool* pInserted = nullptr);
+
+    /// Invalidates every view of a released resource
+    ///
+    /// @param resourceId [in]  Resource identity
+    /// @param pReleased  [out] Optional list receiving the descriptors of the invalidated views
+    ///
+    uint32_t Invalidate(uint64_t resourceId, std::vector<uint64_t>* pReleased = nullptr);
+
+    /// Reclaims invalidated entries. Not thread-safe: call while no other thread uses the cache.
+    void Compact();
+
+    /// Returns the number of live entries
+    uint32_t GetSize() const { return m_size.load(std::memory_order_relaxed); }
+
+    /// Returns the number of lookup hits
+    uint64_t GetHitCount() const { return m_hits.load(std::memory_order_relaxed); }
+
+    /// Returns the number of lookup misses
+    uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    /// @internal Slot states
+    enum SlotState : uint32_t
+    {
+        SlotEmpty     = 0, ///< Never used (terminates probing)
+        SlotWriting   = 1, ///< Being published by an inserting thread
+        SlotReady     = 2, ///< Holds a live entry
+        SlotTombstone = 3, ///< Held an invalidated entry
+    };
+
+    /// @internal Table slot. Key, hash and descriptor are written before the state is released as SlotReady and are
+    /// not modified again until Compact.
+    struct Slot
+    {
+        std::atomic<uint32_t> State;
+        uint64_t              Hash;
+        ViewKey               Key;
+        uint64_t              Descriptor;
+    };
+
+    std::unique_ptr<Slot[]>       m_slots;    ///< Slot table
+    uint32_t                      m_mask;     ///< Capacity - 1
+    std::atomic<uint32_t>         m_size;     ///< Live entries
+    std::atomic<uint32_t>         m_used;     ///< Non-empty slots (live + tombstones)
+    mutable std::atomic<uint64_t> m_hits;     ///< Lookup hits
+    mutable std::atomic<uint64_t> m_misses;   ///< Lookup misses
+};
+} // AR
@@ -0,0 +1,564 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "VulkanBuilder.h"
+#include "Parallel.h"
+
+namespace AR {
+
+// Smallest number of items worth handing to a worker thread
+static constexpr uint32_t MinItemsPerThread = 1024;
+
+//=====================================================================================================================
+// Returns the typed DXGI format an image for the builder is created with
+static DXGI_FORMAT ResolveImageFormat(
+    const ResourceBuilder& builder)
+{
+    DXGI_FORMAT format = builder.Format;
+
+    if (IsDepthFormat(format) || ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0))
+    {
+        const DXGI_FORMAT depthFormat = GetDefaultDepthViewFormat(format);
+
+        if (depthFormat != DXGI_FORMAT_UNKNOWN)
+        {
+            format = depthFormat;
+        }
+    }
+
+    return IsTypeless(format) ? GetDefaultViewFormat(format) : format;
+}
+
+//=====================================================================================================================
+// Returns a Vulkan count for a D3D12 count where UINT32_MAX selects all remaining mips or slices
+static uint32_t ToVkCount(
+    uint32_t count)
+{
+    return (count == UINT32_MAX) ? VK_REMAINING_MIP_LEVELS : count;
+}
+
+//=====================================================================================================================
+// Returns the Vulkan swizzle of one D3D12 shader component mapping selector
+static VkComponentSwizzle ToVkSwizzle(
+    uint32_t mapping, uint32_t component)
+{
+    constexpr VkComponentSwizzle Swizzles[8] =
+    {
+        VK_COMPONENT_SWIZZLE_R,
+        VK_COMPONENT_SWIZZLE_G,
+        VK_COMPONENT_SWIZZLE_B,
+        VK_COMPONENT_SWIZZLE_A,
+        VK_COMPONENT_SWIZZLE_ZERO,
+        VK_COMPONENT_SWIZZLE_ONE,
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+    };
+
+    const VkComponentSwizzle swizzle = Swizzles[(mapping >> (component * 3)) & 7];
+
+    // Express pass-through selectors as identity so default views compare equal to hand-written ones
+    return (swizzle == static_cast<VkComponentSwizzle>(VK_COMPONENT_SWIZZLE_R + component)) ?
+        VK_COMPONENT_SWIZZLE_IDENTITY : swizzle;
+}
+
+//=====================================================================================================================
+// Initialises an image view creation info with the view format and aspect of a view on the builder's image. A zero
+// depth aspect marks views that cannot select a depth-stencil plane (color targets and storage images).
+static VkImageViewCreateInfo InitImageView(
+    const ResourceBuilder& builder, VkImage image, DXGI_FORMAT viewFormat, VkImageAspectFlags depthAspect)
+{
+    const DXGI_FORMAT imageFormat = ResolveImageFormat(builder);
+
+    VkImageViewCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    info.image = image;
+
+    if (IsDepthFormat(imageFormat))
+    {
+        // Depth-stencil images are viewed with their own format; the aspect selects the plane. Views that cannot
+        // select a plane are rejected with VK_FORMAT_UNDEFINED and an empty aspect mask.
+        info.format                      = (depthAspect != 0) ? ToVkFormat(imageFormat) : VK_FORMAT_UNDEFINED;
+        info.subresourceRange.aspectMask = depthAspect;
+    }
+    else
+    {
+        info.format                      = ToVkFormat((viewFormat != DXGI_FORMAT_UNKNOWN) ? viewFormat : imageFormat);
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+        if ((viewFormat == DXGI_FORMAT_B8G8R8X8_UNORM) || (viewFormat == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB))
+        {
+            info.components.a = VK_COMPONENT_SWIZZLE_ONE;
+        }
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Sets the subresource range of an image view
+static void SetRange(
+    VkImageViewCreateInfo* pInfo,
+    VkImageViewType        viewType,
+    uint32_t               baseMip,
+    uint32_t               mipCount,
+    uint32_t               baseLayer,
+    uint32_t               layerCount)
+{
+    pInfo->viewType                        = viewType;
+    pInfo->subresourceRange.baseMipLevel   = baseMip;
+    pInfo->subresourceRange.levelCount     = ToVkCount(mipCount);
+    pInfo->subresourceRange.baseArrayLayer = baseLayer;
+    pInfo->subresourceRange.layerCount     = ToVkCount(layerCount);
+}
+
+//=====================================================================================================================
+// Returns the Vulkan format an image for the builder is created with
+VkFormat GetVkImageFormat(
+    const ResourceBuilder& builder)
+{
+    return ToVkFormat(ResolveImageFormat(builder));
+}
+
+//=====================================================================================================================
+// Returns the image creation info for a texture builder
+VkImageCreateInfo ToVkImageCreateInfo(
+    const ResourceBuilder& builder)
+{
+    const DXGI_FORMAT imageFormat = ResolveImageFormat(builder);
+    const bool        isDepth     = IsDepthFormat(imageFormat);
+
+    VkImageCreateInfo info = {};
+    info.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    info.format        = ToVkFormat(imageFormat);
+    info.extent.width  = static_cast<uint32_t>(builder.Width);
+    info.extent.height = 1;
+    info.extent.depth  = 1;
+    info.mipLevels     = builder.GetMipCount();
+    info.arrayLayers   = builder.GetArraySize();
+    info.samples       = static_cast<VkSampleCountFlagBits>(std::max(1u, builder.SampleDesc.Count));
+    info.tiling        = (builder.Layout == D3D12_TEXTURE_LAYOUT_ROW_MAJOR) ?
+                         VK_IMAGE_TILING_LINEAR : VK_IMAGE_TILING_OPTIMAL;
+    info.usage         = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    switch (builder.Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_TEXTURE1D:
+        info.imageType = VK_IMAGE_TYPE_1D;
+        break;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE3D:
+        info.imageType     = VK_IMAGE_TYPE_3D;
+        info.extent.height = builder.Height;
+        info.extent.depth  = builder.DepthOrArraySize;
+        break;
+    default:
+        info.imageType     = VK_IMAGE_TYPE_2D;
+        info.extent.height = builder.Height;
+        break;
+    }
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE) == 0)
+    {
+        info.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    }
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0)
+    {
+        info.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        if (info.imageType == VK_IMAGE_TYPE_3D)
+        {
+            info.flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+        }
+    }
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0)
+    {
+        info.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    }
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) != 0)
+    {
+        info.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
+    // Depth-stencil planes are selected through aspects, so only color typeless families need format casts
+    if (IsTypeless(builder.Format) && (isDepth == false))
+    {
+        info.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
+    }
+
+    // D3D12 decides cube usage per view; allow it whenever the image could back a cube view
+    if ((info.imageType == VK_IMAGE_TYPE_2D) &&
+        (info.samples == VK_SAMPLE_COUNT_1_BIT) &&
+        (info.extent.width == info.extent.height) &&
+        (info.arrayLayers >= 6) &&
+        ((info.arrayLayers % 6) == 0))
+    {
+        info.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the buffer creation info for a buffer builder
+VkBufferCreateInfo ToVkBufferCreateInfo(
+    const ResourceBuilder& builder)
+{
+    VkBufferCreateInfo info = {};
+    info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size        = builder.Width;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                       VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT |
+                       VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    if ((builder.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) != 0)
+    {
+        info.usage |= VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the image view creation info matching a shader resource view
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc)
+{
+    const bool isStencil = (viewDesc.Format == DXGI_FORMAT_X24_TYPELESS_G8_UINT) ||
+                           (viewDesc.Format == DXGI_FORMAT_X32_TYPELESS_G8X24_UINT);
+
+    VkImageViewCreateInfo info = InitImageView(
+        builder, image, viewDesc.Format, isStencil ? VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    const uint32_t mapping = viewDesc.Shader4ComponentMapping;
+
+    if (mapping != D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING)
+    {
+        info.components.r = ToVkSwizzle(mapping, 0);
+        info.components.g = ToVkSwizzle(mapping, 1);
+        info.components.b = ToVkSwizzle(mapping, 2);
+        info.components.a = ToVkSwizzle(mapping, 3);
+    }
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_SRV_DIMENSION_TEXTURE1D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D,
+                 viewDesc.Texture1D.MostDetailedMip, viewDesc.Texture1D.MipLevels, 0, 1);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE1DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D_ARRAY,
+                 viewDesc.Texture1DArray.MostDetailedMip, viewDesc.Texture1DArray.MipLevels,
+                 viewDesc.Texture1DArray.FirstArraySlice, viewDesc.Texture1DArray.ArraySize);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+                 viewDesc.Texture2DArray.MostDetailedMip, viewDesc.Texture2DArray.MipLevels,
+                 viewDesc.Texture2DArray.FirstArraySlice, viewDesc.Texture2DArray.ArraySize);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DMS:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, 0, 1, 0, 1);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, 1,
+                 viewDesc.Texture2DMSArray.FirstArraySlice, viewDesc.Texture2DMSArray.ArraySize);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE3D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_3D,
+                 viewDesc.Texture3D.MostDetailedMip, viewDesc.Texture3D.MipLevels, 0, 1);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBE:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_CUBE,
+                 viewDesc.TextureCube.MostDetailedMip, viewDesc.TextureCube.MipLevels, 0, 6);
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_CUBE_ARRAY,
+                 viewDesc.TextureCubeArray.MostDetailedMip, viewDesc.TextureCubeArray.MipLevels,
+                 viewDesc.TextureCubeArray.First2DArrayFace, viewDesc.TextureCubeArray.NumCubes * 6);
+        break;
+    default: // D3D12_SRV_DIMENSION_TEXTURE2D (buffers use ToVkBufferViewCreateInfo)
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D,
+                 viewDesc.Texture2D.MostDetailedMip, viewDesc.Texture2D.MipLevels, 0, 1);
+        break;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the image view creation info matching a color target view
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc)
+{
+    VkImageViewCreateInfo info = InitImageView(builder, image, viewDesc.Format, 0);
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_RTV_DIMENSION_TEXTURE1D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D, viewDesc.Texture1D.MipSlice, 1, 0, 1);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE1DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D_ARRAY, viewDesc.Texture1DArray.MipSlice, 1,
+                 viewDesc.Texture1DArray.FirstArraySlice, viewDesc.Texture1DArray.ArraySize);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, viewDesc.Texture2DArray.MipSlice, 1,
+                 viewDesc.Texture2DArray.FirstArraySlice, viewDesc.Texture2DArray.ArraySize);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DMS:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, 0, 1, 0, 1);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, 1,
+                 viewDesc.Texture2DMSArray.FirstArraySlice, viewDesc.Texture2DMSArray.ArraySize);
+        break;
+    case D3D12_RTV_DIMENSION_TEXTURE3D:
+        // Depth slices are attached as layers of a 2D array view (VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT)
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, viewDesc.Texture3D.MipSlice, 1,
+                 viewDesc.Texture3D.FirstWSlice, viewDesc.Texture3D.WSize);
+        break;
+    default: // D3D12_RTV_DIMENSION_TEXTURE2D
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, viewDesc.Texture2D.MipSlice, 1, 0, 1);
+        break;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the image view creation info matching a depth-stencil view
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc)
+{
+    const VkImageAspectFlags aspect = VK_IMAGE_ASPECT_DEPTH_BIT |
+        (IsStencilFormat(ResolveImageFormat(builder)) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+
+    VkImageViewCreateInfo info = InitImageView(builder, image, viewDesc.Format, aspect);
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_DSV_DIMENSION_TEXTURE1D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D, viewDesc.Texture1D.MipSlice, 1, 0, 1);
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE1DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D_ARRAY, viewDesc.Texture1DArray.MipSlice, 1,
+                 viewDesc.Texture1DArray.FirstArraySlice, viewDesc.Texture1DArray.ArraySize);
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, viewDesc.Texture2DArray.MipSlice, 1,
+                 viewDesc.Texture2DArray.FirstArraySlice, viewDesc.Texture2DArray.ArraySize);
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DMS:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, 0, 1, 0, 1);
+        break;
+    case D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, 1,
+                 viewDesc.Texture2DMSArray.FirstArraySlice, viewDesc.Texture2DMSArray.ArraySize);
+        break;
+    default: // D3D12_DSV_DIMENSION_TEXTURE2D
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, viewDesc.Texture2D.MipSlice, 1, 0, 1);
+        break;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the image view creation info matching an unordered access view
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc)
+{
+    VkImageViewCreateInfo info = InitImageView(builder, image, viewDesc.Format, 0);
+
+    switch (viewDesc.ViewDimension)
+    {
+    case D3D12_UAV_DIMENSION_TEXTURE1D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D, viewDesc.Texture1D.MipSlice, 1, 0, 1);
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE1DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_1D_ARRAY, viewDesc.Texture1DArray.MipSlice, 1,
+                 viewDesc.Texture1DArray.FirstArraySlice, viewDesc.Texture1DArray.ArraySize);
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE2DARRAY:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D_ARRAY, viewDesc.Texture2DArray.MipSlice, 1,
+                 viewDesc.Texture2DArray.FirstArraySlice, viewDesc.Texture2DArray.ArraySize);
+        break;
+    case D3D12_UAV_DIMENSION_TEXTURE3D:
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_3D, viewDesc.Texture3D.MipSlice, 1, 0, 1);
+        break;
+    default: // D3D12_UAV_DIMENSION_TEXTURE2D
+        SetRange(&info, VK_IMAGE_VIEW_TYPE_2D, viewDesc.Texture2D.MipSlice, 1, 0, 1);
+        break;
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Returns the buffer view creation info matching a buffer shader resource view
+VkBufferViewCreateInfo ToVkBufferViewCreateInfo(
+    const ResourceBuilder& builder, VkBuffer buffer, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc)
+{
+    uint64_t elementSize = 4; // Raw views address 32-bit words
+
+    if (viewDesc.Format != DXGI_FORMAT_UNKNOWN)
+    {
+        elementSize = GetBitsPerPixel(viewDesc.Format) / 8;
+    }
+    else if (viewDesc.Buffer.StructureByteStride != 0)
+    {
+        elementSize = viewDesc.Buffer.StructureByteStride;
+    }
+
+    VkBufferViewCreateInfo info = {};
+    info.sType  = VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO;
+    info.buffer = buffer;
+    info.format = ToVkFormat(viewDesc.Format);
+    info.offset = viewDesc.Buffer.FirstElement * elementSize;
+    info.range  = VK_WHOLE_SIZE;
+
+    // Clamp the element count to the buffer; UINT32_MAX (or any overrun) selects the rest of the buffer
+    if ((viewDesc.Buffer.NumElements != UINT32_MAX) && (info.offset < builder.Width))
+    {
+        const uint64_t range = viewDesc.Buffer.NumElements * elementSize;
+
+        if (range <= builder.Width - info.offset)
+        {
+            info.range = range;
+        }
+    }
+
+    return info;
+}
+
+//=====================================================================================================================
+// Fills image creation infos for an array of texture builders
+void BuildVkImageCreateInfos(
+    const ResourceBuilder* pBuilders,
+    uint32_t               count,
+    VkImageCreateInfo*     pInfos,
+    uint32_t               threadCount)
+{
+    ParallelFor(count, threadCount, MinItemsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            pInfos[i] = ToVkImageCreateInfo(pBuilders[i]);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Fills buffer creation infos for an array of buffer builders
+void BuildVkBufferCreateInfos(
+    const ResourceBuilder* pBuilders,
+    uint32_t               count,
+    VkBufferCreateInfo*    pInfos,
+    uint32_t               threadCount)
+{
+    ParallelFor(count, threadCount, MinItemsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            pInfos[i] = ToVkBufferCreateInfo(pBuilders[i]);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Fills shader resource image view creation infos for an array of texture builders
+void BuildVkShaderResourceViews(
+    const ResourceBuilder*          pBuilders,
+    const VkImage*                  pImages,
+    const ShaderResourceViewParams* pParams,
+    uint32_t                        count,
+    VkImageViewCreateInfo*          pInfos,
+    uint32_t                        threadCount)
+{
+    const ShaderResourceViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinItemsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const D3D12_SHADER_RESOURCE_VIEW_DESC viewDesc =
+                BuildShaderResourceView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+
+            pInfos[i] = ToVkImageViewCreateInfo(pBuilders[i], pImages[i], viewDesc);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Fills color target image view creation infos for an array of texture builders
+void BuildVkColorTargetViews(
+    const ResourceBuilder*       pBuilders,
+    const VkImage*               pImages,
+    const ColorTargetViewParams* pParams,
+    uint32_t                     count,
+    VkImageViewCreateInfo*       pInfos,
+    uint32_t                     threadCount)
+{
+    const ColorTargetViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinItemsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const D3D12_RENDER_TARGET_VIEW_DESC viewDesc =
+                BuildColorTargetView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+
+            pInfos[i] = ToVkImageViewCreateInfo(pBuilders[i], pImages[i], viewDesc);
+        }
+    });
+}
+
+//=====================================================================================================================
+// Fills depth-stencil image view creation infos for an array of texture builders
+void BuildVkDepthStencilViews(
+    const ResourceBuilder*        pBuilders,
+    const VkImage*                pImages,
+    const DepthStencilViewParams* pParams,
+    uint32_t                      count,
+    VkImageViewCreateInfo*        pInfos,
+    uint32_t                      threadCount)
+{
+    const DepthStencilViewParams defaultParams = {};
+
+    ParallelFor(count, threadCount, MinItemsPerThread, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const D3D12_DEPTH_STENCIL_VIEW_DESC viewDesc =
+                BuildDepthStencilView(pBuilders[i], (pParams != nullptr) ? pParams[i] : defaultParams);
+
+            pInfos[i] = ToVkImageViewCreateInfo(pBuilders[i], pImages[i], viewDesc);
+        }
+    });
+}
+} // AR
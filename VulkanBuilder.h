@@ -0,0 +1,343 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "ViewBatch.h"
+#include <vulkan/vulkan.h>
+
+namespace AR {
+
+//=====================================================================================================================
+// DXGI to Vulkan format mapping entry
+struct VkFormatMapping
+{
+    uint8_t  Format; ///< DXGI format described by this entry
+    VkFormat Vulkan; ///< Matching Vulkan format, or VK_FORMAT_UNDEFINED when Vulkan has no equivalent
+};
+
+#define AR_VK_FORMAT(format, vkFormat) { uint8_t(DXGI_FORMAT_##format), VK_FORMAT_##vkFormat }
+
+//=====================================================================================================================
+// Vulkan format table indexed by DXGI_FORMAT. Typeless formats have no Vulkan equivalent (images are created with a
+// typed format and VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT instead). Depth-stencil view formats map to the combined
+// depth-stencil format because Vulkan selects the plane through the view's aspect mask.
+constexpr VkFormatMapping VkFormatTable[] =
+{
+    AR_VK_FORMAT(UNKNOWN,                    UNDEFINED),
+    AR_VK_FORMAT(R32G32B32A32_TYPELESS,      UNDEFINED),
+    AR_VK_FORMAT(R32G32B32A32_FLOAT,         R32G32B32A32_SFLOAT),
+    AR_VK_FORMAT(R32G32B32A32_UINT,          R32G32B32A32_UINT),
+    AR_VK_FORMAT(R32G32B32A32_SINT,          R32G32B32A32_SINT),
+    AR_VK_FORMAT(R32G32B32_TYPELESS,         UNDEFINED),
+    AR_VK_FORMAT(R32G32B32_FLOAT,            R32G32B32_SFLOAT),
+    AR_VK_FORMAT(R32G32B32_UINT,             R32G32B32_UINT),
+    AR_VK_FORMAT(R32G32B32_SINT,             R32G32B32_SINT),
+    AR_VK_FORMAT(R16G16B16A16_TYPELESS,      UNDEFINED),
+    AR_VK_FORMAT(R16G16B16A16_FLOAT,         R16G16B16A16_SFLOAT),
+    AR_VK_FORMAT(R16G16B16A16_UNORM,         R16G16B16A16_UNORM),
+    AR_VK_FORMAT(R16G16B16A16_UINT,          R16G16B16A16_UINT),
+    AR_VK_FORMAT(R16G16B16A16_SNORM,         R16G16B16A16_SNORM),
+    AR_VK_FORMAT(R16G16B16A16_SINT,          R16G16B16A16_SINT),
+    AR_VK_FORMAT(R32G32_TYPELESS,            UNDEFINED),
+    AR_VK_FORMAT(R32G32_FLOAT,               R32G32_SFLOAT),
+    AR_VK_FORMAT(R32G32_UINT,                R32G32_UINT),
+    AR_VK_FORMAT(R32G32_SINT,                R32G32_SINT),
+    AR_VK_FORMAT(R32G8X24_TYPELESS,          UNDEFINED),
+    AR_VK_FORMAT(D32_FLOAT_S8X24_UINT,       D32_SFLOAT_S8_UINT),
+    AR_VK_FORMAT(R32_FLOAT_X8X24_TYPELESS,   D32_SFLOAT_S8_UINT),
+    AR_VK_FORMAT(X32_TYPELESS_G8X24_UINT,    D32_SFLOAT_S8_UINT),
+    AR_VK_FORMAT(R10G10B10A2_TYPELESS,       UNDEFINED),
+    AR_VK_FORMAT(R10G10B10A2_UNORM,          A2B10G10R10_UNORM_PACK32),
+    AR_VK_FORMAT(R10G10B10A2_UINT,           A2B10G10R10_UINT_PACK32),
+    AR_VK_FORMAT(R11G11B10_FLOAT,            B10G11R11_UFLOAT_PACK32),
+    AR_VK_FORMAT(R8G8B8A8_TYPELESS,          UNDEFINED),
+    AR_VK_FORMAT(R8G8B8A8_UNORM,             R8G8B8A8_UNORM),
+    AR_VK_FORMAT(R8G8B8A8_UNORM_SRGB,        R8G8B8A8_SRGB),
+    AR_VK_FORMAT(R8G8B8A8_UINT,              R8G8B8A8_UINT),
+    AR_VK_FORMAT(R8G8B8A8_SNORM,             R8G8B8A8_SNORM),
+    AR_VK_FORMAT(R8G8B8A8_SINT,              R8G8B8A8_SINT),
+    AR_VK_FORMAT(R16G16_TYPELESS,            UNDEFINED),
+    AR_VK_FORMAT(R16G16_FLOAT,               R16G16_SFLOAT),
+    AR_VK_FORMAT(R16G16_UNORM,               R16G16_UNORM),
+    AR_VK_FORMAT(R16G16_UINT,                R16G16_UINT),
+    AR_VK_FORMAT(R16G16_SNORM,               R16G16_SNORM),
+    AR_VK_FORMAT(R16G16_SINT,                R16G16_SINT),
+    AR_VK_FORMAT(R32_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(D32_FLOAT,                  D32_SFLOAT),
+    AR_VK_FORMAT(R32_FLOAT,                  R32_SFLOAT),
+    AR_VK_FORMAT(R32_UINT,                   R32_UINT),
+    AR_VK_FORMAT(R32_SINT,                   R32_SINT),
+    AR_VK_FORMAT(R24G8_TYPELESS,             UNDEFINED),
+    AR_VK_FORMAT(D24_UNORM_S8_UINT,          D24_UNORM_S8_UINT),
+    AR_VK_FORMAT(R24_UNORM_X8_TYPELESS,      D24_UNORM_S8_UINT),
+    AR_VK_FORMAT(X24_TYPELESS_G8_UINT,       D24_UNORM_S8_UINT),
+    AR_VK_FORMAT(R8G8_TYPELESS,              UNDEFINED),
+    AR_VK_FORMAT(R8G8_UNORM,                 R8G8_UNORM),
+    AR_VK_FORMAT(R8G8_UINT,                  R8G8_UINT),
+    AR_VK_FORMAT(R8G8_SNORM,                 R8G8_SNORM),
+    AR_VK_FORMAT(R8G8_SINT,                  R8G8_SINT),
+    AR_VK_FORMAT(R16_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(R16_FLOAT,                  R16_SFLOAT),
+    AR_VK_FORMAT(D16_UNORM,                  D16_UNORM),
+    AR_VK_FORMAT(R16_UNORM,                  R16_UNORM),
+    AR_VK_FORMAT(R16_UINT,                   R16_UINT),
+    AR_VK_FORMAT(R16_SNORM,                  R16_SNORM),
+    AR_VK_FORMAT(R16_SINT,                   R16_SINT),
+    AR_VK_FORMAT(R8_TYPELESS,                UNDEFINED),
+    AR_VK_FORMAT(R8_UNORM,                   R8_UNORM),
+    AR_VK_FORMAT(R8_UINT,                    R8_UINT),
+    AR_VK_FORMAT(R8_SNORM,                   R8_SNORM),
+    AR_VK_FORMAT(R8_SINT,                    R8_SINT),
+    AR_VK_FORMAT(A8_UNORM,                   UNDEFINED),
+    AR_VK_FORMAT(R1_UNORM,                   UNDEFINED),
+    AR_VK_FORMAT(R9G9B9E5_SHAREDEXP,         E5B9G9R9_UFLOAT_PACK32),
+    AR_VK_FORMAT(R8G8_B8G8_UNORM,            B8G8R8G8_422_UNORM),
+    AR_VK_FORMAT(G8R8_G8B8_UNORM,            G8B8G8R8_422_UNORM),
+    AR_VK_FORMAT(BC1_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC1_UNORM,                  BC1_RGBA_UNORM_BLOCK),
+    AR_VK_FORMAT(BC1_UNORM_SRGB,             BC1_RGBA_SRGB_BLOCK),
+    AR_VK_FORMAT(BC2_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC2_UNORM,                  BC2_UNORM_BLOCK),
+    AR_VK_FORMAT(BC2_UNORM_SRGB,             BC2_SRGB_BLOCK),
+    AR_VK_FORMAT(BC3_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC3_UNORM,                  BC3_UNORM_BLOCK),
+    AR_VK_FORMAT(BC3_UNORM_SRGB,             BC3_SRGB_BLOCK),
+    AR_VK_FORMAT(BC4_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC4_UNORM,                  BC4_UNORM_BLOCK),
+    AR_VK_FORMAT(BC4_SNORM,                  BC4_SNORM_BLOCK),
+    AR_VK_FORMAT(BC5_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC5_UNORM,                  BC5_UNORM_BLOCK),
+    AR_VK_FORMAT(BC5_SNORM,                  BC5_SNORM_BLOCK),
+    AR_VK_FORMAT(B5G6R5_UNORM,               R5G6B5_UNORM_PACK16),
+    AR_VK_FORMAT(B5G5R5A1_UNORM,             A1R5G5B5_UNORM_PACK16),
+    AR_VK_FORMAT(B8G8R8A8_UNORM,             B8G8R8A8_UNORM),
+    AR_VK_FORMAT(B8G8R8X8_UNORM,             B8G8R8A8_UNORM),
+    AR_VK_FORMAT(R10G10B10_XR_BIAS_A2_UNORM, UNDEFINED),
+    AR_VK_FORMAT(B8G8R8A8_TYPELESS,          UNDEFINED),
+    AR_VK_FORMAT(B8G8R8A8_UNORM_SRGB,        B8G8R8A8_SRGB),
+    AR_VK_FORMAT(B8G8R8X8_TYPELESS,          UNDEFINED),
+    AR_VK_FORMAT(B8G8R8X8_UNORM_SRGB,        B8G8R8A8_SRGB),
+    AR_VK_FORMAT(BC6H_TYPELESS,              UNDEFINED),
+    AR_VK_FORMAT(BC6H_UF16,                  BC6H_UFLOAT_BLOCK),
+    AR_VK_FORMAT(BC6H_SF16,                  BC6H_SFLOAT_BLOCK),
+    AR_VK_FORMAT(BC7_TYPELESS,               UNDEFINED),
+    AR_VK_FORMAT(BC7_UNORM,                  BC7_UNORM_BLOCK),
+    AR_VK_FORMAT(BC7_UNORM_SRGB,             BC7_SRGB_BLOCK),
+    AR_VK_FORMAT(AYUV,                       UNDEFINED),
+    AR_VK_FORMAT(Y410,                       UNDEFINED),
+    AR_VK_FORMAT(Y416,                       UNDEFINED),
+    AR_VK_FORMAT(NV12,                       G8_B8R8_2PLANE_420_UNORM),
+    AR_VK_FORMAT(P010,                       G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16),
+    AR_VK_FORMAT(P016,                       G16_B16R16_2PLANE_420_UNORM),
+    AR_VK_FORMAT(420_OPAQUE,                 G8_B8R8_2PLANE_420_UNORM),
+    AR_VK_FORMAT(YUY2,                       G8B8G8R8_422_UNORM),
+    AR_VK_FORMAT(Y210,                       G10X6B10X6G10X6R10X6_422_UNORM_4PACK16),
+    AR_VK_FORMAT(Y216,                       G16B16G16R16_422_UNORM),
+    AR_VK_FORMAT(NV11,                       UNDEFINED),
+    AR_VK_FORMAT(AI44,                       UNDEFINED),
+    AR_VK_FORMAT(IA44,                       UNDEFINED),
+    AR_VK_FORMAT(P8,                         UNDEFINED),
+    AR_VK_FORMAT(A8P8,                       UNDEFINED),
+    AR_VK_FORMAT(B4G4R4A4_UNORM,             A4R4G4B4_UNORM_PACK16),
+};
+
+#undef AR_VK_FORMAT
+
+/// Table entry count (formats past DXGI_FORMAT_B4G4R4A4_UNORM map to VK_FORMAT_UNDEFINED)
+constexpr uint32_t VkFormatCount = sizeof(VkFormatTable) / sizeof(VkFormatTable[0]);
+
+//=====================================================================================================================
+// Returns the Vulkan format matching a DXGI format (VK_FORMAT_UNDEFINED for typeless and unsupported formats)
+constexpr VkFormat ToVkFormat(DXGI_FORMAT format)
+{
+    return VkFormatTable[(static_cast<uint32_t>(format) < VkFormatCount) ? static_cast<uint32_t>(format) : 0].Vulkan;
+}
+
+//=====================================================================================================================
+// Returns true when every table entry sits at its own format index
+constexpr bool ValidateVkFormatTable()
+{
+    for (uint32_t i = 0; i < VkFormatCount; i++)
+    {
+        if (VkFormatTable[i].Format != i)
+        {
+            return false;
+        }
+    }
+
+    return (VkFormatCount == FormatInfoCount);
+}
+
+static_assert(ValidateVkFormatTable(), "VkFormatTable is out of order");
+
+/// Returns the Vulkan format an image for the builder is created with. Typeless formats resolve to their default
+/// view format, or to their depth format for depth-stencil resources.
+///
+/// @param builder [in] Resource builder
+///
+VkFormat GetVkImageFormat(const ResourceBuilder& builder);
+
+/// Returns the image creation info for a texture builder. Usage is derived from the resource flags (sampled unless
+/// shader resources are denied, plus attachment and storage usage for render target, depth-stencil and unordered
+/// access resources); typeless resources are created mutable-format.
+///
+/// @param builder [in] Texture resource builder
+///
+VkImageCreateInfo ToVkImageCreateInfo(const ResourceBuilder& builder);
+
+/// Returns the buffer creation info for a buffer builder
+///
+/// @param builder [in] Buffer resource builder
+///
+VkBufferCreateInfo ToVkBufferCreateInfo(const ResourceBuilder& builder);
+
+/// Returns the image view creation info matching a shader resource view of the builder (e.g. AsShaderResourceView).
+/// Views of depth-stencil images select the depth or stencil aspect from the view format.
+///
+/// @param builder  [in] Texture resource builder
+/// @param image    [in] Image created from ToVkImageCreateInfo(builder)
+/// @param viewDesc [in] Shader resource view description
+///
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc);
+
+/// Returns the image view creation info matching a color target view of the builder (e.g. AsColorTargetView).
+/// Texture3D color target views become 2D array views of the depth slices. Depth-stencil images have no color
+/// aspect, so their views come back with VK_FORMAT_UNDEFINED and an empty aspect mask.
+///
+/// @param builder  [in] Texture resource builder
+/// @param image    [in] Image created from ToVkImageCreateInfo(builder)
+/// @param viewDesc [in] Color target view description
+///
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc);
+
+/// Returns the image view creation info matching a depth-stencil view of the builder (e.g. AsDepthStencilView)
+///
+/// @param builder  [in] Texture resource builder
+/// @param image    [in] Image created from ToVkImageCreateInfo(builder)
+/// @param viewDesc [in] Depth-stencil view description
+///
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc);
+
+/// Returns the image view creation info matching an unordered access view of the builder (e.g.
+/// AsUnorderedAccessView) for use as a storage image. Texture3D views always cover every W slice of the mip.
+/// Depth-stencil images cannot be storage images, so their views come back with VK_FORMAT_UNDEFINED and an empty
+/// aspect mask.
+///
+/// @param builder  [in] Texture resource builder
+/// @param image    [in] Image created from ToVkImageCreateInfo(builder)
+/// @param viewDesc [in] Unordered access view description
+///
+VkImageViewCreateInfo ToVkImageViewCreateInfo(
+    const ResourceBuilder& builder, VkImage image, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc);
+
+/// Returns the buffer view creation info matching a buffer shader resource view (AsBufferResourceView). Only typed
+/// views need a VkBufferView; for structured and raw views the returned offset and range (format
+/// VK_FORMAT_UNDEFINED) describe the VkDescriptorBufferInfo instead.
+///
+/// @param builder  [in] Buffer resource builder
+/// @param buffer   [in] Buffer created from ToVkBufferCreateInfo(builder)
+/// @param viewDesc [in] Buffer shader resource view description
+///
+VkBufferViewCreateInfo ToVkBufferViewCreateInfo(
+    const ResourceBuilder& builder, VkBuffer buffer, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc);
+
+/// Fills image creation infos for an array of texture builders. No memory is allocated per item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param count       [in]  Item count
+/// @param pInfos      [out] Creation info array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildVkImageCreateInfos(
+    const ResourceBuilder* pBuilders,
+    uint32_t               count,
+    VkImageCreateInfo*     pInfos,
+    uint32_t               threadCount = 1);
+
+/// Fills buffer creation infos for an array of buffer builders. No memory is allocated per item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param count       [in]  Item count
+/// @param pInfos      [out] Creation info array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildVkBufferCreateInfos(
+    const ResourceBuilder* pBuilders,
+    uint32_t               count,
+    VkBufferCreateInfo*    pInfos,
+    uint32_t               threadCount = 1);
+
+/// Fills shader resource image view creation infos for an array of texture builders. Output is identical to
+/// translating BuildShaderResourceView for each item. No memory is allocated per item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pImages     [in]  Image array (one per builder)
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pInfos      [out] Creation info array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildVkShaderResourceViews(
+    const ResourceBuilder*          pBuilders,
+    const VkImage*                  pImages,
+    const ShaderResourceViewParams* pParams,
+    uint32_t                        count,
+    VkImageViewCreateInfo*          pInfos,
+    uint32_t                        threadCount = 1);
+
+/// Fills color target image view creation infos for an array of texture builders. Output is identical to
+/// translating BuildColorTargetView for each item. No memory is allocated per item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pImages     [in]  Image array (one per builder)
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pInfos      [out] Creation info array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildVkColorTargetViews(
+    const ResourceBuilder*       pBuilders,
+    const VkImage*               pImages,
+    const ColorTargetViewParams* pParams,
+    uint32_t                     count,
+    VkImageViewCreateInfo*       pInfos,
+    uint32_t                     threadCount = 1);
+
+/// Fills depth-stencil image view creation infos for an array of texture builders. Output is identical to
+/// translating BuildDepthStencilView for each item. No memory is allocated per item.
+///
+/// @param pBuilders   [in]  Builder array
+/// @param pImages     [in]  Image array (one per builder)
+/// @param pParams     [in]  Per-item view parameters, or nullptr to use defaults for every item
+/// @param count       [in]  Item count
+/// @param pInfos      [out] Creation info array with room for count items
+/// @param threadCount [optional] Worker thread count (0 selects the hardware concurrency)
+///
+void BuildVkDepthStencilViews(
+    const ResourceBuilder*        pBuilders,
+    const VkImage*                pImages,
+    const DepthStencilViewParams* pParams,
+    uint32_t                      count,
+    VkImageViewCreateInfo*        pInfos,
+    uint32_t                      threadCount = 1);
+} // AR
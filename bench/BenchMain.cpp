@@ -0,0 +1,556 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+#include "Benchmark.h"
+#include "MockResource.h"
+#include "TexelSource.h"
+#include "../BlockCompress.h"
+#include "../FormatConvert.h"
+#include "../MipGenerator.h"
+#include "../Parallel.h"
+#include "../ResourceBuilder.h"
+#include "../ResourceCache.h"
+#include "../ViewBatch.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef AR_BENCH_VERSION
+#define AR_BENCH_VERSION "unknown"
+#endif
+
+using namespace AR;
+using namespace AR::Bench;
+
+namespace {
+
+//=====================================================================================================================
+// Representative resource description measured by every benchmark
+struct BenchCase
+{
+    const char*     Name;                           ///< Case name appended to the benchmark name
+    void          (*Build)(ResourceBuilder* pBuilder); ///< Builder call under test
+};
+
+constexpr BenchCase BenchCases[] =
+{
+    { "Buffer_64KB",              [](ResourceBuilder* p) { p->Buffer(65536); } },
+    { "Texture1D_RGBA8_1024x8",   [](ResourceBuilder* p) { p->Texture1D(1024, DXGI_FORMAT_R8G8B8A8_UNORM, 8, 0); } },
+    { "Texture2D_RGBA8_1920x1080", [](ResourceBuilder* p) { p->Texture2D(1920, 1080, DXGI_FORMAT_R8G8B8A8_UNORM); } },
+    { "Texture2D_R32Typeless_4096",
+      [](ResourceBuilder* p) { p->Texture2D(4096, 4096, DXGI_FORMAT_R32_TYPELESS); } },
+    { "Texture2D_BC7_2048x6_Mips", [](ResourceBuilder* p) { p->Texture2D(2048, 2048, DXGI_FORMAT_BC7_UNORM, 6, 0); } },
+    { "Texture2D_RGBA16F_Array64",
+      [](ResourceBuilder* p) { p->Texture2D(512, 512, DXGI_FORMAT_R16G16B16A16_FLOAT, 64, 1); } },
+    { "Texture3D_R16F_128",       [](ResourceBuilder* p) { p->Texture3D(128, 128, 128, DXGI_FORMAT_R16_FLOAT, 0); } },
+};
+
+//=====================================================================================================================
+// Per-call latency of every builder, query and view method for one case
+void RunLatency(
+    Runner* pRunner, const BenchCase& benchCase)
+{
+    ResourceBuilder builder = {};
+    benchCase.Build(&builder);
+
+    const std::string suffix   = std::string("/") + benchCase.Name;
+    const bool        isBuffer = (builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+
+    pRunner->Latency("Build" + suffix, [&]()
+    {
+        ResourceBuilder result = {};
+        benchCase.Build(&result);
+        DoNotOptimize(result);
+    });
+
+    D3D12_HEAP_PROPERTIES heapProperties = {};
+    heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    MockResource* pResource = new MockResource(builder, heapProperties);
+
+    pRunner->Latency("FromExistingResource" + suffix, [&]()
+    {
+        ResourceBuilder result = {};
+        DoNotOptimize(result.FromExistingResource(pResource));
+    });
+
+    ResourceCache cache;
+
+    pRunner->Latency("ResourceCacheGet" + suffix, [&]()
+    {
+        DoNotOptimize(cache.Get(pResource));
+    });
+
+    pResource->Release();
+
+    // Each call goes through DoNotOptimize(builder) so the description cannot be folded into a constant
+    const auto measure = [&](const char* pMethod, const auto& func)
+    {
+        pRunner->Latency(pMethod + suffix, [&]()
+        {
+            DoNotOptimize(builder);
+            DoNotOptimize(func());
+        });
+    };
+
+    measure("SetFormat", [&]() { ResourceBuilder copy = builder; return copy.SetFormat(builder.Format); });
+    measure("SetHeapType", [&]() { ResourceBuilder copy = builder; return copy.SetHeapType(D3D12_HEAP_TYPE_UPLOAD); });
+    measure("SetSampleCount", [&]() { ResourceBuilder copy = builder; return copy.SetSampleCount(1); });
+    measure("SetFlags", [&]() { ResourceBuilder copy = builder; return copy.SetFlags(builder.Flags); });
+    measure("SetHeapFlags", [&]() { ResourceBuilder copy = builder; return copy.SetHeapFlags(D3D12_HEAP_FLAG_NONE); });
+    measure("GetHeapProperties", [&]() { return builder.GetHeapProperties(); });
+    measure("GetSRVDimension", [&]() { return builder.GetSRVDimension(true); });
+    measure("GetSubresourceCount", [&]() { return builder.GetSubresourceCount(); });
+    measure("GetAllocationInfo", [&]() { return builder.GetAllocationInfo(); });
+    measure("GetStandardTileShape", [&]() { return builder.GetStandardTileShape(); });
+
+    measure("GetCopyableFootprints", [&]()
+    {
+        uint64_t totalBytes = 0;
+        builder.GetCopyableFootprints(0, builder.GetSubresourceCount(), 0, nullptr, nullptr, nullptr, &totalBytes);
+        return totalBytes;
+    });
+
+    measure("GetResourceTiling", [&]()
+    {
+        uint32_t              tileCount = 0;
+        D3D12_PACKED_MIP_INFO PackedMips = {};
+        builder.GetResourceTiling(&tileCount, &PackedMips, nullptr, nullptr, 0, nullptr);
+        return tileCount + PackedMips.NumPackedMips;
+    });
+
+    if (isBuffer)
+    {
+        measure("AsBufferResourceView", [&]() { return builder.AsBufferResourceView(0, 4096, 16); });
+        return;
+    }
+
+    measure("AsColorTarget", [&]() { return builder.AsColorTarget(); });
+    measure("AsDepthTarget", [&]() { return builder.AsDepthTarget(); });
+    measure("AsColorTargetView", [&]() { return builder.AsColorTargetView(); });
+    measure("AsColorTargetViewArray", [&]() { return builder.AsColorTargetViewArray(); });
+    measure("AsDepthStencilView", [&]() { return builder.AsDepthStencilView(); });
+    measure("AsDepthStencilViewArray", [&]() { return builder.AsDepthStencilViewArray(); });
+    measure("AsShaderResourceView", [&]() { return builder.AsShaderResourceView(); });
+    measure("AsShaderResourceViewArray", [&]() { return builder.AsShaderResourceViewArray(); });
+    measure("AsUnorderedAccessView", [&]() { return builder.AsUnorderedAccessView(); });
+    measure("AsUnorderedAccessViewArray", [&]() { return builder.AsUnorderedAccessViewArray(); });
+
+    measure("BuildMipViews", [&]()
+    {
+        D3D12_SHADER_RESOURCE_VIEW_DESC  srvs[D3D12_REQ_MIP_LEVELS];
+        D3D12_UNORDERED_ACCESS_VIEW_DESC uavs[D3D12_REQ_MIP_LEVELS];
+
+        const uint32_t count = builder.BuildMipViews(MipViewRange{}, D3D12_REQ_MIP_LEVELS, srvs, uavs);
+        DoNotOptimize(srvs);
+        DoNotOptimize(uavs);
+        return count;
+    });
+}
+
+//=====================================================================================================================
+// Batch throughput of the builder and the batch view functions for one case. Multithreaded runs use threadCount
+// threads (0 selects the hardware concurrency).
+void RunThroughput(
+    Runner* pRunner, const BenchCase& benchCase, uint32_t batchSize, uint32_t threadCount)
+{
+    ResourceBuilder builder = {};
+    benchCase.Build(&builder);
+
+    const std::string                            suffix = std::string("/") + benchCase.Name;
+    std::vector<ResourceBuilder>                 builders(batchSize, builder);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> srvs(batchSize);
+    std::vector<D3D12_RENDER_TARGET_VIEW_DESC>   rtvs(batchSize);
+    std::vector<D3D12_DEPTH_STENCIL_VIEW_DESC>   dsvs(batchSize);
+
+    pRunner->Throughput("BuildBatch" + suffix, batchSize, 1, [&]()
+    {
+        for (ResourceBuilder& item : builders)
+        {
+            benchCase.Build(&item);
+        }
+
+        DoNotOptimize(builders.data());
+    });
+
+    // Single-threaded, then multithreaded
+    for (uint32_t threads : { 1u, threadCount })
+    {
+        const std::string threadSuffix = suffix + ((threads == 1) ? "/st" : "/mt");
+
+        pRunner->Throughput("BuildShaderResourceViews" + threadSuffix, batchSize, threads, [&]()
+        {
+            BuildShaderResourceViews(builders.data(), nullptr, batchSize, srvs.data(), threads);
+            DoNotOptimize(srvs.data());
+        });
+
+        if (builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        {
+            continue;
+        }
+
+        pRunner->Throughput("BuildColorTargetViews" + threadSuffix, batchSize, threads, [&]()
+        {
+            BuildColorTargetViews(builders.data(), nullptr, batchSize, rtvs.data(), threads);
+            DoNotOptimize(rtvs.data());
+        });
+
+        pRunner->Throughput("BuildDepthStencilViews" + threadSuffix, batchSize, threads, [&]()
+        {
+            BuildDepthStencilViews(builders.data(), nullptr, batchSize, dsvs.data(), threads);
+            DoNotOptimize(dsvs.data());
+        });
+    }
+}
+
+//=====================================================================================================================
+// Cost of dispatching an empty parallel loop to the worker pool, per call, at several batch sizes. Items per thread are
+// not limited, so every call wakes threadCount - 1 workers (0 selects the hardware concurrency).
+void RunDispatch(
+    Runner* pRunner, uint32_t threadCount)
+{
+    for (uint32_t count : { 256u, 4096u, 65536u })
+    {
+        pRunner->Latency("ParallelFor/" + std::to_string(count), [&]()
+        {
+            std::atomic<uint32_t> sum(0);
+
+            ParallelFor(count, threadCount, 1, [&](uint32_t begin, uint32_t end)
+            {
+                sum.fetch_add(end - begin, std::memory_order_relaxed);
+            });
+
+            DoNotOptimize(sum.load());
+        });
+    }
+}
+
+//=====================================================================================================================
+// Source and destination format pair measured by the conversion benchmarks
+struct ConvertCase
+{
+    const char* Name;      ///< Case name appended to the benchmark name
+    DXGI_FORMAT SrcFormat; ///< Source format
+    DXGI_FORMAT DstFormat; ///< Builder format
+};
+
+constexpr ConvertCase ConvertCases[] =
+{
+    { "RGBA8_BGRA8",           DXGI_FORMAT_R8G8B8A8_UNORM,      DXGI_FORMAT_B8G8R8A8_UNORM },
+    { "RGBA8_BGRA8_SRGB",      DXGI_FORMAT_R8G8B8A8_UNORM,      DXGI_FORMAT_B8G8R8A8_UNORM_SRGB },
+    { "RGBA8_R10G10B10A2",     DXGI_FORMAT_R8G8B8A8_UNORM,      DXGI_FORMAT_R10G10B10A2_UNORM },
+    { "RGBA8_SRGB_RGBA16F",    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DXGI_FORMAT_R16G16B16A16_FLOAT },
+    { "BGRA8_SRGB_RGBA8",      DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, DXGI_FORMAT_R8G8B8A8_UNORM },
+    { "BGRX8_RGBA8",           DXGI_FORMAT_B8G8R8X8_UNORM,      DXGI_FORMAT_R8G8B8A8_UNORM },
+    { "RGB32F_RGBA16F",        DXGI_FORMAT_R32G32B32_FLOAT,     DXGI_FORMAT_R16G16B16A16_FLOAT },
+    { "RGB32F_R11G11B10F",     DXGI_FORMAT_R32G32B32_FLOAT,     DXGI_FORMAT_R11G11B10_FLOAT },
+    { "RGBA32F_RGBA16F",       DXGI_FORMAT_R32G32B32A32_FLOAT,  DXGI_FORMAT_R16G16B16A16_FLOAT },
+    { "RGBA32F_RGBA8_SRGB",    DXGI_FORMAT_R32G32B32A32_FLOAT,  DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+    { "RGBA32F_R11G11B10F",    DXGI_FORMAT_R32G32B32A32_FLOAT,  DXGI_FORMAT_R11G11B10_FLOAT },
+    { "RGBA16F_RGBA8_SRGB",    DXGI_FORMAT_R16G16B16A16_FLOAT,  DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+    { "RGBA16F_RGBA32F",       DXGI_FORMAT_R16G16B16A16_FLOAT,  DXGI_FORMAT_R32G32B32A32_FLOAT },
+};
+
+// Conversion instruction sets and their benchmark names
+constexpr ConvertIsa ConvertIsas[]     = { ConvertIsa::Scalar, ConvertIsa::Sse41, ConvertIsa::Avx2 };
+constexpr const char* ConvertIsaNames[] = { "scalar", "sse41", "avx2" };
+
+//=====================================================================================================================
+// Throughput of converting a 2048x2048 source to the upload footprint layout of one builder format
+void RunConversion(
+    Runner* pRunner, const ConvertCase& convertCase)
+{
+    constexpr uint32_t Size = 2048;
+
+    ResourceBuilder builder = {};
+    builder.Texture2D(Size, Size, convertCase.DstFormat);
+
+    uint64_t totalBytes = 0;
+    builder.GetCopyableFootprints(0, 1, 0, nullptr, nullptr, nullptr, &totalBytes);
+
+    const uint32_t       srcSize = GetBytesPerBlock(convertCase.SrcFormat);
+    std::vector<uint8_t> source(size_t(Size) * Size * srcSize);
+    std::vector<uint8_t> upload(static_cast<size_t>(totalBytes));
+
+    FillConvertSource(convertCase.SrcFormat, &source, 1);
+
+    const ConvertSource convertSource = { source.data(), convertCase.SrcFormat, Size * srcSize,
+                                          uint64_t(Size) * Size * srcSize };
+
+    for (uint32_t i = 0; i < sizeof(ConvertIsas) / sizeof(ConvertIsas[0]); i++)
+    {
+        if (ConvertIsas[i] > GetSupportedConvertIsa())
+        {
+            continue;
+        }
+
+        // Single-threaded, then the hardware concurrency
+        for (uint32_t threads : { 1u, 0u })
+        {
+            const std::string name = std::string("ConvertSubresources/") + convertCase.Name + "/" +
+                                     ConvertIsaNames[i] + ((threads == 1) ? "/st" : "/mt");
+
+            pRunner->Throughput(name, Size * Size, threads, [&]()
+            {
+                ConvertSubresources(builder, 0, 1, 0, &convertSource, upload.data(), threads, ConvertIsas[i]);
+                DoNotOptimize(upload.data());
+            });
+        }
+    }
+}
+
+//=====================================================================================================================
+// Texture measured by the mip generation benchmarks
+struct MipCase
+{
+    const char*              Name;      ///< Benchmark name suffix
+    D3D12_RESOURCE_DIMENSION Dimension; ///< 2D (with array slices) or 3D
+    uint32_t                 Width;     ///< Mip 0 width
+    uint32_t                 Height;    ///< Mip 0 height
+    uint16_t                 Depth;     ///< Array size (2D) or depth (3D)
+    DXGI_FORMAT              Format;    ///< Texture format
+};
+
+constexpr MipCase MipCases[] =
+{
+    { "RGBA8_SRGB_2048",  D3D12_RESOURCE_DIMENSION_TEXTURE2D, 2048, 2048, 1,   DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+    { "RGBA16F_2048",     D3D12_RESOURCE_DIMENSION_TEXTURE2D, 2048, 2048, 1,   DXGI_FORMAT_R16G16B16A16_FLOAT  },
+    { "BGRA8_1000x600x6", D3D12_RESOURCE_DIMENSION_TEXTURE2D, 1000, 600,  6,   DXGI_FORMAT_B8G8R8A8_UNORM      },
+    { "RGBA8_3D_128",     D3D12_RESOURCE_DIMENSION_TEXTURE3D, 128,  128,  128, DXGI_FORMAT_R8G8B8A8_UNORM      },
+};
+
+constexpr MipFilter   MipFilters[]     = { MipFilter::Box, MipFilter::Kaiser };
+constexpr const char* MipFilterNames[] = { "box", "kaiser" };
+
+//=====================================================================================================================
+// Describes a mip generation texture with a full mip chain and fills mip 0 of every slice
+void InitMipCase(
+    const MipCase& mipCase, ResourceBuilder* pBuilder, std::vector<uint8_t>* pData)
+{
+    if (mipCase.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+        pBuilder->Texture3D(mipCase.Width, mipCase.Height, mipCase.Depth, mipCase.Format, 0);
+    }
+    else
+    {
+        pBuilder->Texture2D(mipCase.Width, mipCase.Height, mipCase.Format, mipCase.Depth, 0);
+    }
+
+    FillMipSource(*pBuilder, pData, mipCase.Width);
+}
+
+//=====================================================================================================================
+// Throughput of generating the full mip chain of one texture, per mip 0 texel
+void RunMips(
+    Runner* pRunner, const MipCase& mipCase)
+{
+    ResourceBuilder      builder = {};
+    std::vector<uint8_t> data;
+    InitMipCase(mipCase, &builder, &data);
+
+    const uint32_t texelCount = mipCase.Width * mipCase.Height * mipCase.Depth;
+
+    for (uint32_t f = 0; f < sizeof(MipFilters) / sizeof(MipFilters[0]); f++)
+    {
+        for (uint32_t i = 0; i < sizeof(ConvertIsas) / sizeof(ConvertIsas[0]); i++)
+        {
+            if (ConvertIsas[i] > GetSupportedConvertIsa())
+            {
+                continue;
+            }
+
+            // Single-threaded, then the hardware concurrency
+            for (uint32_t threads : { 1u, 0u })
+            {
+                const std::string name = std::string("GenerateMips/") + mipCase.Name + "/" + MipFilterNames[f] +
+                                         "/" + ConvertIsaNames[i] + ((threads == 1) ? "/st" : "/mt");
+
+                pRunner->Throughput(name, texelCount, threads, [&]()
+                {
+                    GenerateMips(builder, 0, data.data(), MipFilters[f], threads, ConvertIsas[i]);
+                    DoNotOptimize(data.data());
+                });
+            }
+        }
+    }
+}
+
+//=====================================================================================================================
+// Block compressed formats measured by the compression benchmarks
+struct CompressCase
+{
+    const char* Name;   ///< Benchmark name suffix
+    DXGI_FORMAT Format; ///< Destination format
+    bool        Opaque; ///< Source alpha is 255 (BC1 alpha below 128 selects transparent black)
+};
+
+constexpr CompressCase CompressCases[] =
+{
+    { "BC1", DXGI_FORMAT_BC1_UNORM, true  },
+    { "BC3", DXGI_FORMAT_BC3_UNORM, false },
+    { "BC4", DXGI_FORMAT_BC4_UNORM, false },
+    { "BC5", DXGI_FORMAT_BC5_UNORM, false },
+    { "BC7", DXGI_FORMAT_BC7_UNORM, false },
+};
+
+//=====================================================================================================================
+// Throughput of compressing a 1024x1024 RGBA8 source to the upload footprint layout of one block compressed format
+void RunCompression(
+    Runner* pRunner, const CompressCase& compressCase)
+{
+    constexpr uint32_t Size = 1024;
+
+    ResourceBuilder builder = {};
+    builder.Texture2D(Size, Size, compressCase.Format);
+
+    uint64_t totalBytes = 0;
+    builder.GetCopyableFootprints(0, 1, 0, nullptr, nullptr, nullptr, &totalBytes);
+
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> upload(static_cast<size_t>(totalBytes));
+
+    FillCompressSource(&source, Size, compressCase.Opaque);
+
+    const ConvertSource compressSource = { source.data(), DXGI_FORMAT_R8G8B8A8_UNORM, Size * 4,
+                                           uint64_t(Size) * Size * 4 };
+
+    for (uint32_t i = 0; i < sizeof(ConvertIsas) / sizeof(ConvertIsas[0]); i++)
+    {
+        // Index selection has scalar and SSE4.1 kernels only
+        if ((ConvertIsas[i] > GetSupportedConvertIsa()) || (ConvertIsas[i] == ConvertIsa::Avx2))
+        {
+            continue;
+        }
+
+        const std::string prefix = std::string("CompressSubresources/") + compressCase.Name + "/" + ConvertIsaNames[i];
+
+        // Single-threaded, then the hardware concurrency
+        for (uint32_t threads : { 1u, 0u })
+        {
+            pRunner->Throughput(prefix + ((threads == 1) ? "/st" : "/mt"), Size * Size, threads, [&]()
+            {
+                CompressSubresources(builder, 0, 1, 0, &compressSource, upload.data(), threads, ConvertIsas[i]);
+                DoNotOptimize(upload.data());
+            });
+        }
+    }
+}
+
+//=====================================================================================================================
+// Prints command line usage
+void PrintUsage(
+    const char* pProgram)
+{
+    fprintf(stderr,
+            "usage: %s [--json <path>] [--filter <text>] [--min-time-ms <ms>] [--repetitions <n>] [--batch <n>] "
+            "[--threads <n>]\n", pProgram);
+}
+} // anonymous namespace
+
+//=====================================================================================================================
+// Runs every ResourceBuilder benchmark and writes the results as JSON (stdout unless --json is given)
+int main(
+    int argc, char** argv)
+{
+    Options     options   = {};
+    const char* pJsonPath = nullptr;
+    uint32_t    batchSize = 65536;
+    uint32_t    threads   = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "--json") == 0) && hasValue)
+        {
+            pJsonPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--filter") == 0) && hasValue)
+        {
+            options.Filter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--min-time-ms") == 0) && hasValue)
+        {
+            options.MinTimeMs = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--repetitions") == 0) && hasValue)
+        {
+            options.Repetitions = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else if ((strcmp(argv[i], "--batch") == 0) && hasValue)
+        {
+            batchSize = std::max(1u, static_cast<uint32_t>(atoi(argv[++i])));
+        }
+        else if ((strcmp(argv[i], "--threads") == 0) && hasValue)
+        {
+            threads = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Runner runner(options);
+
+    for (const BenchCase& benchCase : BenchCases)
+    {
+        RunLatency(&runner, benchCase);
+    }
+
+    for (const BenchCase& benchCase : BenchCases)
+    {
+        RunThroughput(&runner, benchCase, batchSize, threads);
+    }
+
+    RunDispatch(&runner, threads);
+
+    for (const ConvertCase& convertCase : ConvertCases)
+    {
+        RunConversion(&runner, convertCase);
+    }
+
+    for (const MipCase& mipCase : MipCases)
+    {
+        RunMips(&runner, mipCase);
+    }
+
+    for (const CompressCase& compressCase : CompressCases)
+    {
+        RunCompression(&runner, compressCase);
+    }
+
+    FILE* pFile = (pJsonPath != nullptr) ? fopen(pJsonPath, "w") : stdout;
+
+    if (pFile == nullptr)
+    {
+        fprintf(stderr, "cannot open %s\n", pJsonPath);
+        return 1;
+    }
+
+    runner.WriteJson(pFile, AR_BENCH_VERSION);
+
+    if (pFile != stdout)
+    {
+        fclose(pFile);
+    }
+
+    return 0;
+}
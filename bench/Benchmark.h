@@ -0,0 +1,191 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace AR {
+namespace Bench {
+
+//=====================================================================================================================
+// Keeps a computed value alive so the compiler cannot drop the call that produced it
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* pSink = reinterpret_cast<const volatile char*>(&value);
+    (void)*pSink;
+#endif
+}
+
+//=====================================================================================================================
+// Measurement of one benchmark
+struct Result
+{
+    std::string Name;          ///< Benchmark name (method/case)
+    std::string Metric;        ///< "latency" for per-call timing, "throughput" for batch timing
+    uint64_t    Iterations;    ///< Calls (latency) or items (throughput) per repetition
+    uint32_t    Threads;       ///< Worker threads used by batch benchmarks
+    double      NsPerItem;     ///< Median nanoseconds per call or per batch item
+    double      MinNsPerItem;  ///< Fastest repetition
+    double      ItemsPerSec;   ///< Median items per second
+};
+
+//=====================================================================================================================
+// Benchmark runner options
+struct Options
+{
+    double      MinTimeMs   = 50.0; ///< Minimum time of one repetition
+    uint32_t    Repetitions = 5;    ///< Repetitions per benchmark (the median is reported)
+    std::string Filter;             ///< Only run benchmarks whose name contains this string
+};
+
+//=====================================================================================================================
+// Runs benchmarks and collects their results
+class Runner
+{
+public:
+    explicit Runner(const Options& options) : m_options(options) {}
+
+    /// Measures per-call latency of func(). The iteration count doubles until one repetition runs for at least
+    /// Options::MinTimeMs.
+    template <typename Func>
+    void Latency(const std::string& name, const Func& func)
+    {
+        Run(name, "latency", 1, 1, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                func();
+            }
+        });
+    }
+
+    /// Measures batch throughput of func(), which processes itemCount items per call
+    template <typename Func>
+    void Throughput(const std::string& name, uint32_t itemCount, uint32_t threads, const Func& func)
+    {
+        Run(name, "throughput", itemCount, threads, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                func();
+            }
+        });
+    }
+
+    /// Returns the collected results
+    const std::vector<Result>& GetResults() const { return m_results; }
+
+    /// Writes the collected results as JSON
+    void WriteJson(FILE* pFile, const char* pVersion) const
+    {
+        fprintf(pFile, "{\n  \"version\": \"%s\",\n  \"min_time_ms\": %.1f,\n  \"repetitions\": %u,\n",
+                pVersion, m_options.MinTimeMs, m_options.Repetitions);
+        fprintf(pFile, "  \"results\": [\n");
+
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            const Result& result = m_results[i];
+
+            fprintf(pFile,
+                    "    { \"name\": \"%s\", \"metric\": \"%s\", \"iterations\": %llu, \"threads\": %u, "
+                    "\"ns_per_item\": %.3f, \"min_ns_per_item\": %.3f, \"items_per_sec\": %.1f }%s\n",
+                    result.Name.c_str(), result.Metric.c_str(), static_cast<unsigned long long>(result.Iterations),
+                    result.Threads, result.NsPerItem, result.MinNsPerItem, result.ItemsPerSec,
+                    (i + 1 < m_results.size()) ? "," : "");
+        }
+
+        fprintf(pFile, "  ]\n}\n");
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// @internal Calibrates the iteration count, then times the repetitions
+    template <typename Loop>
+    void Run(const std::string& name, const char* pMetric, uint32_t itemsPerCall, uint32_t threads, const Loop& loop)
+    {
+        if ((m_options.Filter.empty() == false) && (name.find(m_options.Filter) == std::string::npos))
+        {
+            return;
+        }
+
+        uint64_t iterations = 1;
+
+        while (true)
+        {
+            const double elapsedMs = TimeMs(loop, iterations);
+
+            if ((elapsedMs >= m_options.MinTimeMs) || (iterations >= (1ull << 40)))
+            {
+                break;
+            }
+
+            // Jump close to the target once the timer resolution is no longer dominant
+            iterations = (elapsedMs > 1.0) ?
+                static_cast<uint64_t>(iterations * (m_options.MinTimeMs * 1.2 / elapsedMs)) + 1 : iterations * 2;
+        }
+
+        std::vector<double> samples;
+
+        for (uint32_t i = 0; i < std::max(1u, m_options.Repetitions); i++)
+        {
+            samples.push_back(TimeMs(loop, iterations) * 1.0e6 / (double(iterations) * itemsPerCall));
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result = {};
+        result.Name         = name;
+        result.Metric       = pMetric;
+        result.Iterations   = iterations * itemsPerCall;
+        result.Threads      = threads;
+        result.NsPerItem    = samples[samples.size() / 2];
+        result.MinNsPerItem = samples.front();
+        result.ItemsPerSec  = (result.NsPerItem > 0.0) ? (1.0e9 / result.NsPerItem) : 0.0;
+
+        fprintf(stderr, "%-64s %-10s %12.2f ns/item %16.0f items/s\n",
+                name.c_str(), pMetric, result.NsPerItem, result.ItemsPerSec);
+
+        m_results.push_back(result);
+    }
+
+    /// @internal Times one repetition
+    template <typename Loop>
+    static double TimeMs(const Loop& loop, uint64_t iterations)
+    {
+        const Clock::time_point start = Clock::now();
+        loop(iterations);
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    Options             m_options; ///< Runner options
+    std::vector<Result> m_results; ///< Collected results
+};
+} // Bench
+} // AR
@@ -0,0 +1,216 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <d3d12.h>
+#include <cstdint>
+#include <cstring>
+
+namespace AR {
+namespace Bench {
+
+//=====================================================================================================================
+// Reference decoder of the block formats written by the block compressor, used to measure its quality
+class BlockDecoder
+{
+public:
+    /// Decodes one block to 16 RGBA8 texels in row order. Channels the format does not store decode as 0 (alpha as
+    /// 255). Returns false for formats the decoder does not handle, including BC7 modes other than 6.
+    static bool Decode(DXGI_FORMAT format, const uint8_t* pBlock, uint8_t* pTexels)
+    {
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            pTexels[(t * 4) + 0] = 0;
+            pTexels[(t * 4) + 1] = 0;
+            pTexels[(t * 4) + 2] = 0;
+            pTexels[(t * 4) + 3] = 255;
+        }
+
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+            DecodeColor(pBlock, true, pTexels);
+            return true;
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            DecodeColor(pBlock + 8, false, pTexels);
+            DecodeChannel(pBlock, 3, pTexels);
+            return true;
+        case DXGI_FORMAT_BC4_UNORM:
+            DecodeChannel(pBlock, 0, pTexels);
+            return true;
+        case DXGI_FORMAT_BC5_UNORM:
+            DecodeChannel(pBlock, 0, pTexels);
+            DecodeChannel(pBlock + 8, 1, pTexels);
+            return true;
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            return DecodeBc7Mode6(pBlock, pTexels);
+        default:
+            return false;
+        }
+    }
+
+private:
+    /// @internal Decodes a BC1 color block (three-color mode is disabled for BC3 color blocks)
+    static void DecodeColor(const uint8_t* pBlock, bool allowThreeColor, uint8_t* pTexels)
+    {
+        const uint32_t color0    = uint32_t(pBlock[0]) | (uint32_t(pBlock[1]) << 8);
+        const uint32_t color1    = uint32_t(pBlock[2]) | (uint32_t(pBlock[3]) << 8);
+        const bool     fourColor = (allowThreeColor == false) || (color0 > color1);
+
+        uint32_t indices = 0;
+        std::memcpy(&indices, pBlock + 4, sizeof(indices));
+
+        uint32_t palette[4][4] = {};
+
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            const uint32_t shift = (c == 0) ? 11 : ((c == 1) ? 5 : 0);
+            const uint32_t bits  = (c == 1) ? 6 : 5;
+            const uint32_t a     = Expand((color0 >> shift) & ((1u << bits) - 1), bits);
+            const uint32_t b     = Expand((color1 >> shift) & ((1u << bits) - 1), bits);
+
+            palette[0][c] = a;
+            palette[1][c] = b;
+            palette[2][c] = fourColor ? (((2 * a) + b + 1) / 3) : ((a + b + 1) / 2);
+            palette[3][c] = fourColor ? ((a + (2 * b) + 1) / 3) : 0;
+        }
+
+        palette[0][3] = 255;
+        palette[1][3] = 255;
+        palette[2][3] = 255;
+        palette[3][3] = fourColor ? 255 : 0;
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            const uint32_t index = (indices >> (t * 2)) & 3;
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                pTexels[(t * 4) + c] = static_cast<uint8_t>(palette[index][c]);
+            }
+        }
+    }
+
+    /// @internal Decodes a BC4 block into one channel
+    static void DecodeChannel(const uint8_t* pBlock, uint32_t channel, uint8_t* pTexels)
+    {
+        const uint32_t value0 = pBlock[0];
+        const uint32_t value1 = pBlock[1];
+
+        uint32_t palette[8] = { value0, value1 };
+
+        if (value0 > value1)
+        {
+            for (uint32_t i = 1; i < 7; i++)
+            {
+                palette[i + 1] = (((7 - i) * value0) + (i * value1) + 3) / 7;
+            }
+        }
+        else
+        {
+            for (uint32_t i = 1; i < 5; i++)
+            {
+                palette[i + 1] = (((5 - i) * value0) + (i * value1) + 2) / 5;
+            }
+
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            indices |= uint64_t(pBlock[2 + i]) << (i * 8);
+        }
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            pTexels[(t * 4) + channel] = static_cast<uint8_t>(palette[(indices >> (t * 3)) & 7]);
+        }
+    }
+
+    /// @internal Decodes a BC7 mode 6 block
+    static bool DecodeBc7Mode6(const uint8_t* pBlock, uint8_t* pTexels)
+    {
+        static constexpr uint32_t Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        uint32_t position = 0;
+
+        if (ReadBits(pBlock, &position, 7) != (1u << 6))
+        {
+            return false;
+        }
+
+        uint32_t endpoints[2][4];
+
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            endpoints[0][c] = ReadBits(pBlock, &position, 7) << 1;
+            endpoints[1][c] = ReadBits(pBlock, &position, 7) << 1;
+        }
+
+        const uint32_t pbit0 = ReadBits(pBlock, &position, 1);
+        const uint32_t pbit1 = ReadBits(pBlock, &position, 1);
+
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            endpoints[0][c] |= pbit0;
+            endpoints[1][c] |= pbit1;
+        }
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            const uint32_t weight = Weights[ReadBits(pBlock, &position, (t == 0) ? 3 : 4)];
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                pTexels[(t * 4) + c] =
+                    static_cast<uint8_t>((((64 - weight) * endpoints[0][c]) + (weight * endpoints[1][c]) + 32) >> 6);
+            }
+        }
+
+        return true;
+    }
+
+    /// @internal Expands a 5- or 6-bit value to 8 bits
+    static uint32_t Expand(uint32_t value, uint32_t bits)
+    {
+        return (value << (8 - bits)) | (value >> ((2 * bits) - 8));
+    }
+
+    /// @internal Reads bits from a little-endian bit stream
+    static uint32_t ReadBits(const uint8_t* pData, uint32_t* pPosition, uint32_t bits)
+    {
+        uint32_t value = 0;
+
+        for (uint32_t i = 0; i < bits; i++, (*pPosition)++)
+        {
+            value |= uint32_t((pData[*pPosition >> 3] >> (*pPosition & 7)) & 1) << i;
+        }
+
+        return value;
+    }
+};
+} // Bench
+} // AR
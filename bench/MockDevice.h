@@ -0,0 +1,413 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "MockResource.h"
+
+namespace AR {
+namespace Bench {
+
+//=====================================================================================================================
+// Device-free ID3D12DescriptorHeap. Handles are fake addresses: they are never dereferenced by the mock device.
+class MockDescriptorHeap : public ID3D12DescriptorHeap
+{
+public:
+    MockDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc, uint64_t base, std::atomic<uint32_t>* pLiveCount) :
+        m_refCount(1),
+        m_desc(desc),
+        m_base(base),
+        m_pLiveCount(pLiveCount)
+    {
+        m_pLiveCount->fetch_add(1);
+    }
+
+    virtual ~MockDescriptorHeap() { m_pLiveCount->fetch_sub(1); }
+
+    MockDescriptorHeap(const MockDescriptorHeap&)            = delete;
+    MockDescriptorHeap& operator=(const MockDescriptorHeap&) = delete;
+
+    // IUnknown
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+    {
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+
+        if (refCount == 0)
+        {
+            delete this;
+        }
+
+        return refCount;
+    }
+
+    // ID3D12Object
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetName(LPCWSTR) override { return S_OK; }
+
+    // ID3D12DeviceChild
+    HRESULT STDMETHODCALLTYPE GetDevice(REFIID, void** ppvDevice) override
+    {
+        *ppvDevice = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    // ID3D12DescriptorHeap
+    D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE GetDesc() override { return m_desc; }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetCPUDescriptorHandleForHeapStart() override
+    {
+        return { static_cast<SIZE_T>(m_base) };
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetGPUDescriptorHandleForHeapStart() override
+    {
+        // Heaps that are not shader visible have no GPU address
+        return { ((m_desc.Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0) ? (m_base << 8) : 0 };
+    }
+
+private:
+    std::atomic<ULONG>         m_refCount;   ///< Reference count
+    D3D12_DESCRIPTOR_HEAP_DESC m_desc;       ///< Description returned by GetDesc
+    uint64_t                   m_base;       ///< Fake CPU address of descriptor 0
+    std::atomic<uint32_t>*     m_pLiveCount; ///< Live object count of the owning device
+};
+
+//=====================================================================================================================
+// Device-free ID3D12Device for the functional tests. Descriptor heaps and committed resources are mock objects, view
+// creation is counted, and every other method fails with E_NOTIMPL. Objects created by the device are counted until
+// they are destroyed so tests can check that nothing leaks.
+class MockDevice : public ID3D12Device
+{
+public:
+    /// Descriptor handle increment reported for every heap type
+    static constexpr UINT DescriptorIncrement = 32;
+
+    MockDevice() :
+        m_refCount(1),
+        m_liveObjects(0),
+        m_heapCount(0),
+        m_viewCount(0),
+        m_resourceCount(0)
+    {
+    }
+
+    virtual ~MockDevice() {}
+
+    MockDevice(const MockDevice&)            = delete;
+    MockDevice& operator=(const MockDevice&) = delete;
+
+    /// Returns the number of objects created by the device that were not destroyed
+    uint32_t GetLiveObjectCount() const { return m_liveObjects.load(); }
+
+    /// Returns the number of views written by the Create*View methods
+    uint32_t GetViewCount() const { return m_viewCount.load(); }
+
+    /// Returns the number of committed resources created
+    uint32_t GetResourceCount() const { return m_resourceCount.load(); }
+
+    // IUnknown
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+    {
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+
+        if (refCount == 0)
+        {
+            delete this;
+        }
+
+        return refCount;
+    }
+
+    // ID3D12Object
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetName(LPCWSTR) override { return S_OK; }
+
+    // ID3D12Device
+    UINT STDMETHODCALLTYPE GetNodeCount() override { return 1; }
+
+    HRESULT STDMETHODCALLTYPE CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC*, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateGraphicsPipelineState(
+        const D3D12_GRAPHICS_PIPELINE_STATE_DESC*, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateComputePipelineState(
+        const D3D12_COMPUTE_PIPELINE_STATE_DESC*, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateCommandList(
+        UINT, D3D12_COMMAND_LIST_TYPE, ID3D12CommandAllocator*, ID3D12PipelineState*, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D12_FEATURE, void*, UINT) override { return E_NOTIMPL; }
+
+    HRESULT STDMETHODCALLTYPE CreateDescriptorHeap(
+        const D3D12_DESCRIPTOR_HEAP_DESC* pDesc, REFIID, void** ppvHeap) override
+    {
+        if ((pDesc == nullptr) || (pDesc->NumDescriptors == 0))
+        {
+            return NotImplemented(ppvHeap);
+        }
+
+        // Heaps get disjoint fake address ranges
+        const uint64_t base = (m_heapCount.fetch_add(1) + 1) << 32;
+
+        *ppvHeap = static_cast<ID3D12DescriptorHeap*>(new MockDescriptorHeap(*pDesc, base, &m_liveObjects));
+        return S_OK;
+    }
+
+    UINT STDMETHODCALLTYPE GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE) override
+    {
+        return DescriptorIncrement;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateRootSignature(UINT, const void*, SIZE_T, REFIID, void** ppObject) override
+    {
+        return NotImplemented(ppObject);
+    }
+
+    void STDMETHODCALLTYPE CreateConstantBufferView(
+        const D3D12_CONSTANT_BUFFER_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CreateShaderResourceView(
+        ID3D12Resource*, const D3D12_SHADER_RESOURCE_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CreateUnorderedAccessView(
+        ID3D12Resource*, ID3D12Resource*, const D3D12_UNORDERED_ACCESS_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CreateRenderTargetView(
+        ID3D12Resource*, const D3D12_RENDER_TARGET_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CreateDepthStencilView(
+        ID3D12Resource*, const D3D12_DEPTH_STENCIL_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CreateSampler(const D3D12_SAMPLER_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override
+    {
+        m_viewCount++;
+    }
+
+    void STDMETHODCALLTYPE CopyDescriptors(
+        UINT,
+        const D3D12_CPU_DESCRIPTOR_HANDLE*,
+        const UINT*,
+        UINT,
+        const D3D12_CPU_DESCRIPTOR_HANDLE*,
+        const UINT*,
+        D3D12_DESCRIPTOR_HEAP_TYPE) override
+    {
+    }
+
+    void STDMETHODCALLTYPE CopyDescriptorsSimple(
+        UINT, D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_DESCRIPTOR_HEAP_TYPE) override
+    {
+    }
+
+    D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo(
+        UINT, UINT, const D3D12_RESOURCE_DESC*) override
+    {
+        return { UINT64_MAX, 0 };
+    }
+
+    D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE GetCustomHeapProperties(UINT, D3D12_HEAP_TYPE) override
+    {
+        return {};
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateCommittedResource(
+        const D3D12_HEAP_PROPERTIES* pHeapProperties,
+        D3D12_HEAP_FLAGS,
+        const D3D12_RESOURCE_DESC*   pDesc,
+        D3D12_RESOURCE_STATES,
+        const D3D12_CLEAR_VALUE*,
+        REFIID,
+        void**                       ppvResource) override
+    {
+        if ((pHeapProperties == nullptr) || (pDesc == nullptr) || (ppvResource == nullptr))
+        {
+            return NotImplemented(ppvResource);
+        }
+
+        m_resourceCount++;
+
+        *ppvResource = static_cast<ID3D12Resource*>(new MockResource(*pDesc, *pHeapProperties, &m_liveObjects));
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateHeap(const D3D12_HEAP_DESC*, REFIID, void** ppvHeap) override
+    {
+        return NotImplemented(ppvHeap);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreatePlacedResource(
+        ID3D12Heap*,
+        UINT64,
+        const D3D12_RESOURCE_DESC*,
+        D3D12_RESOURCE_STATES,
+        const D3D12_CLEAR_VALUE*,
+        REFIID,
+        void** ppvResource) override
+    {
+        return NotImplemented(ppvResource);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateReservedResource(
+        const D3D12_RESOURCE_DESC*,
+        D3D12_RESOURCE_STATES,
+        const D3D12_CLEAR_VALUE*,
+        REFIID,
+        void** ppvResource) override
+    {
+        return NotImplemented(ppvResource);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateSharedHandle(
+        ID3D12DeviceChild*, const SECURITY_ATTRIBUTES*, DWORD, LPCWSTR, HANDLE*) override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE OpenSharedHandle(HANDLE, REFIID, void** ppvObj) override
+    {
+        return NotImplemented(ppvObj);
+    }
+
+    HRESULT STDMETHODCALLTYPE OpenSharedHandleByName(LPCWSTR, DWORD, HANDLE*) override { return E_NOTIMPL; }
+
+    HRESULT STDMETHODCALLTYPE MakeResident(UINT, ID3D12Pageable* const*) override { return S_OK; }
+
+    HRESULT STDMETHODCALLTYPE Evict(UINT, ID3D12Pageable* const*) override { return S_OK; }
+
+    HRESULT STDMETHODCALLTYPE CreateFence(UINT64, D3D12_FENCE_FLAGS, REFIID, void** ppFence) override
+    {
+        return NotImplemented(ppFence);
+    }
+
+    HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override { return S_OK; }
+
+    void STDMETHODCALLTYPE GetCopyableFootprints(
+        const D3D12_RESOURCE_DESC*,
+        UINT,
+        UINT,
+        UINT64,
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT*,
+        UINT*,
+        UINT64*,
+        UINT64* pTotalBytes) override
+    {
+        if (pTotalBytes != nullptr)
+        {
+            *pTotalBytes = UINT64_MAX;
+        }
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateQueryHeap(const D3D12_QUERY_HEAP_DESC*, REFIID, void** ppvHeap) override
+    {
+        return NotImplemented(ppvHeap);
+    }
+
+    HRESULT STDMETHODCALLTYPE SetStablePowerState(BOOL) override { return E_NOTIMPL; }
+
+    HRESULT STDMETHODCALLTYPE CreateCommandSignature(
+        const D3D12_COMMAND_SIGNATURE_DESC*, ID3D12RootSignature*, REFIID, void** ppvCommandSignature) override
+    {
+        return NotImplemented(ppvCommandSignature);
+    }
+
+    void STDMETHODCALLTYPE GetResourceTiling(
+        ID3D12Resource*,
+        UINT*,
+        D3D12_PACKED_MIP_INFO*,
+        D3D12_TILE_SHAPE*,
+        UINT*,
+        UINT,
+        D3D12_SUBRESOURCE_TILING*) override
+    {
+    }
+
+    LUID STDMETHODCALLTYPE GetAdapterLuid() override { return {}; }
+
+private:
+    /// @internal Clears an output interface pointer and fails
+    static HRESULT NotImplemented(void** ppObject)
+    {
+        if (ppObject != nullptr)
+        {
+            *ppObject = nullptr;
+        }
+
+        return E_NOTIMPL;
+    }
+
+    std::atomic<ULONG>    m_refCount;      ///< Reference count
+    std::atomic<uint32_t> m_liveObjects;   ///< Created objects not yet destroyed
+    std::atomic<uint64_t> m_heapCount;     ///< Descriptor heaps created
+    std::atomic<uint32_t> m_viewCount;     ///< Views written
+    std::atomic<uint32_t> m_resourceCount; ///< Committed resources created
+};
+} // Bench
+} // AR
@@ -0,0 +1,264 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include <d3d12.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+// DXGI status codes live in winerror.h, which the Linux DirectX-Headers stubs do not provide
+#ifndef DXGI_ERROR_NOT_FOUND
+#define DXGI_ERROR_NOT_FOUND ((HRESULT)0x887A0002L)
+#endif
+
+#ifndef DXGI_ERROR_MORE_DATA
+#define DXGI_ERROR_MORE_DATA ((HRESULT)0x887A0003L)
+#endif
+
+namespace AR {
+namespace Bench {
+
+//=====================================================================================================================
+// Device-free ID3D12Resource returning a fixed description and heap properties. Private data is stored per GUID
+// (interfaces are AddRef'd) so code relying on SetPrivateDataInterface can be measured without a device. Resources
+// created by MockDevice are counted in the device's live object count until they are destroyed.
+class MockResource : public ID3D12Resource
+{
+public:
+    MockResource(
+        const D3D12_RESOURCE_DESC&   desc,
+        const D3D12_HEAP_PROPERTIES& heapProperties,
+        std::atomic<uint32_t>*       pLiveCount = nullptr) :
+        m_refCount(1),
+        m_desc(desc),
+        m_heapProperties(heapProperties),
+        m_pLiveCount(pLiveCount)
+    {
+        if (m_pLiveCount != nullptr)
+        {
+            m_pLiveCount->fetch_add(1);
+        }
+    }
+
+    virtual ~MockResource()
+    {
+        if (m_pLiveCount != nullptr)
+        {
+            m_pLiveCount->fetch_sub(1);
+        }
+
+        for (PrivateData& data : m_privateData)
+        {
+            if (data.pInterface != nullptr)
+            {
+                data.pInterface->Release();
+            }
+        }
+    }
+
+    MockResource(const MockResource&)            = delete;
+    MockResource& operator=(const MockResource&) = delete;
+
+    // IUnknown
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+    {
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+
+        if (refCount == 0)
+        {
+            delete this;
+        }
+
+        return refCount;
+    }
+
+    // ID3D12Object
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override
+    {
+        const PrivateData* pEntry = Find(guid);
+
+        if (pEntry == nullptr)
+        {
+            *pDataSize = 0;
+            return DXGI_ERROR_NOT_FOUND;
+        }
+
+        if (pEntry->pInterface != nullptr)
+        {
+            if ((pData != nullptr) && (*pDataSize >= sizeof(IUnknown*)))
+            {
+                pEntry->pInterface->AddRef();
+                memcpy(pData, &pEntry->pInterface, sizeof(IUnknown*));
+            }
+
+            *pDataSize = sizeof(IUnknown*);
+            return S_OK;
+        }
+
+        const UINT dataSize = static_cast<UINT>(pEntry->Data.size());
+
+        if ((pData != nullptr) && (*pDataSize < dataSize))
+        {
+            return DXGI_ERROR_MORE_DATA;
+        }
+
+        if (pData != nullptr)
+        {
+            memcpy(pData, pEntry->Data.data(), dataSize);
+        }
+
+        *pDataSize = dataSize;
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* pData) override
+    {
+        PrivateData& entry = Reset(guid);
+        entry.Data.assign(static_cast<const uint8_t*>(pData), static_cast<const uint8_t*>(pData) + dataSize);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override
+    {
+        PrivateData& entry = Reset(guid);
+        entry.pInterface   = const_cast<IUnknown*>(pData);
+
+        if (entry.pInterface != nullptr)
+        {
+            entry.pInterface->AddRef();
+        }
+
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetName(LPCWSTR) override { return S_OK; }
+
+    // ID3D12DeviceChild
+    HRESULT STDMETHODCALLTYPE GetDevice(REFIID, void** ppvDevice) override
+    {
+        *ppvDevice = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    // ID3D12Resource
+    HRESULT STDMETHODCALLTYPE Map(UINT, const D3D12_RANGE*, void** ppData) override
+    {
+        if (ppData != nullptr)
+        {
+            *ppData = nullptr;
+        }
+
+        return E_NOTIMPL;
+    }
+
+    void STDMETHODCALLTYPE Unmap(UINT, const D3D12_RANGE*) override {}
+
+    D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() override { return m_desc; }
+
+    D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() override { return 0; }
+
+    HRESULT STDMETHODCALLTYPE WriteToSubresource(UINT, const D3D12_BOX*, const void*, UINT, UINT) override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE ReadFromSubresource(void*, UINT, UINT, UINT, const D3D12_BOX*) override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetHeapProperties(
+        D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags) override
+    {
+        if (pHeapProperties != nullptr)
+        {
+            *pHeapProperties = m_heapProperties;
+        }
+
+        if (pHeapFlags != nullptr)
+        {
+            *pHeapFlags = D3D12_HEAP_FLAG_NONE;
+        }
+
+        return S_OK;
+    }
+
+private:
+    /// @internal Private data stored under a GUID
+    struct PrivateData
+    {
+        GUID                 Guid;
+        std::vector<uint8_t> Data;
+        IUnknown*            pInterface;
+    };
+
+    /// @internal Returns the private data stored under a GUID
+    const PrivateData* Find(REFGUID guid) const
+    {
+        for (const PrivateData& data : m_privateData)
+        {
+            if (memcmp(&data.Guid, &guid, sizeof(GUID)) == 0)
+            {
+                return &data;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /// @internal Returns an empty private data entry for a GUID, releasing any previous interface
+    PrivateData& Reset(REFGUID guid)
+    {
+        PrivateData* pEntry = const_cast<PrivateData*>(Find(guid));
+
+        if (pEntry == nullptr)
+        {
+            m_privateData.push_back({ guid, {}, nullptr });
+            return m_privateData.back();
+        }
+
+        if (pEntry->pInterface != nullptr)
+        {
+            pEntry->pInterface->Release();
+        }
+
+        pEntry->Data.clear();
+        pEntry->pInterface = nullptr;
+
+        return *pEntry;
+    }
+
+    std::atomic<ULONG>       m_refCount;       ///< Reference count
+    D3D12_RESOURCE_DESC      m_desc;           ///< Description returned by GetDesc
+    D3D12_HEAP_PROPERTIES    m_heapProperties; ///< Heap properties returned by GetHeapProperties
+    std::vector<PrivateData> m_privateData;    ///< Private data entries
+    std::atomic<uint32_t>*   m_pLiveCount;     ///< Live object count of the creating device (optional)
+};
+} // Bench
+} // AR
@@ -0,0 +1,3330 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#include "BlockDecode.h"
+#include "MockDevice.h"
+#include "TexelSource.h"
+#include "../AliasingPlanner.h"
+#include "../BlockCompress.h"
+#include "../DescriptorAllocator.h"
+#include "../FormatConvert.h"
+#include "../Instrumentation.h"
+#include "../MipGenerator.h"
+#include "../Parallel.h"
+#include "../RenderTargetPool.h"
+#include "../ResidencyPlanner.h"
+#include "../ResourceCache.h"
+#include "../ResourceManifest.h"
+#include "../StateTracker.h"
+#include "../TextureFile.h"
+#include "../UploadRing.h"
+#include "../ViewCache.h"
+#if AR_TEST_VULKAN
+#include "../VulkanBuilder.h"
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AR;
+using namespace AR::Bench;
+
+/// Counts and reports a failed check in a test function (which declares a uint32_t failures counter)
+#define AR_TEST_CHECK(condition)                                                                \
+    do                                                                                          \
+    {                                                                                           \
+        if ((condition) == false)                                                               \
+        {                                                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);       \
+            failures++;                                                                         \
+        }                                                                                       \
+    }                                                                                           \
+    while (false)
+
+namespace {
+
+//=====================================================================================================================
+// Plans transient resource aliasing: disjoint lifetimes share memory, overlapping lifetimes never share bytes, MSAA
+// and regular placement alignments hold, the aliasing barriers name the previous user when one covers the range,
+// and the live memory peak is measured against the unaliased sum. Returns the number of failed checks.
+uint32_t TestAliasingPlanner()
+{
+    uint32_t failures = 0;
+
+    ResourceBuilder target;
+    target.Texture2D(1024, 1024, DXGI_FORMAT_R8G8B8A8_UNORM).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+
+    ResourceBuilder wideTarget = target;
+    wideTarget.Width = 2048;
+
+    const uint64_t size = target.GetAllocationInfo().SizeInBytes;
+    AR_TEST_CHECK(wideTarget.GetAllocationInfo().SizeInBytes == 2 * size);
+
+    AliasingPlanner planner;
+
+    // Disjoint lifetimes share one offset, with a barrier naming the previous user
+    {
+        const TransientResource resources[] = { { target, 0, 1 }, { target, 2, 3 } };
+        const AliasingPlan&     plan        = planner.Plan(resources, 2);
+
+        AR_TEST_CHECK((plan.Heaps.size() == 1) && (plan.HeapBytes == size) && (plan.UnaliasedBytes == 2 * size));
+        AR_TEST_CHECK((plan.Placements[0].Offset == 0) && (plan.Placements[1].Offset == 0));
+        AR_TEST_CHECK((plan.Placements[0].HeapIndex == 0) && (plan.Placements[1].HeapIndex == 0));
+        AR_TEST_CHECK(plan.Barriers.size() == 1);
+        AR_TEST_CHECK((plan.Barriers.size() == 1) && (plan.Barriers[0].PassIndex == 2) &&
+                      (plan.Barriers[0].ResourceBefore == 0) && (plan.Barriers[0].ResourceAfter == 1));
+        AR_TEST_CHECK((plan.PeakLiveBytes == size) && (plan.PeakPass == 0));
+    }
+
+    // Side-by-side resources followed by one spanning both: the first reuse cannot name a single predecessor, the
+    // second can because the spanning resource covers its range
+    {
+        const TransientResource resources[] =
+        {
+            { target, 0, 1 }, { target, 0, 1 }, { wideTarget, 2, 3 }, { target, 4, 5 },
+        };
+        const AliasingPlan& plan = planner.Plan(resources, 4);
+
+        AR_TEST_CHECK((plan.Heaps.size() == 1) && (plan.HeapBytes == 2 * size));
+        AR_TEST_CHECK(plan.Placements[0].Offset != plan.Placements[1].Offset);
+        AR_TEST_CHECK((plan.Placements[2].Offset == 0) && (plan.Placements[3].Offset == 0));
+        AR_TEST_CHECK(plan.Barriers.size() == 2);
+
+        if (plan.Barriers.size() == 2)
+        {
+            AR_TEST_CHECK((plan.Barriers[0].PassIndex == 2) && (plan.Barriers[0].ResourceAfter == 2));
+            AR_TEST_CHECK(plan.Barriers[0].ResourceBefore == AnyAliasedResource);
+            AR_TEST_CHECK((plan.Barriers[1].PassIndex == 4) && (plan.Barriers[1].ResourceAfter == 3));
+            AR_TEST_CHECK(plan.Barriers[1].ResourceBefore == 2);
+        }
+
+        AR_TEST_CHECK((plan.PeakLiveBytes == 2 * size) && (plan.UnaliasedBytes == 5 * size));
+    }
+
+    // Random lifetimes and sizes: resources alive at the same time never share bytes, placements are aligned, and
+    // the heap memory sits between the live peak and the unaliased sum
+    std::mt19937 random(7);
+    std::vector<TransientResource> resources;
+
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        ResourceBuilder builder;
+
+        switch (random() % 3)
+        {
+        case 0:
+            builder.Buffer(1 + random() % (4u << 20));
+            break;
+        case 1:
+            builder.Texture2D(64 + random() % 2048, 64 + random() % 2048, DXGI_FORMAT_R16G16B16A16_FLOAT).SetFlags(
+                D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+            break;
+        default:
+            builder.Texture2D(64 + random() % 1024, 64 + random() % 1024, DXGI_FORMAT_R8G8B8A8_UNORM).SetSampleCount(
+                4).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+            break;
+        }
+
+        const uint32_t firstPass = random() % 64;
+        resources.push_back({ builder, firstPass, firstPass + uint32_t(random() % 16) });
+    }
+
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        AliasingPlanner     randomPlanner(64ull << 20, pass == 1);
+        const AliasingPlan& plan = randomPlanner.Plan(resources.data(), uint32_t(resources.size()));
+
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i < resources.size(); i++)
+        {
+            const TransientPlacement& a = plan.Placements[i];
+            sum += a.SizeInBytes;
+
+            AR_TEST_CHECK(a.HeapIndex < plan.Heaps.size());
+            AR_TEST_CHECK((a.Offset % a.Alignment) == 0);
+            AR_TEST_CHECK((a.HeapIndex < plan.Heaps.size()) &&
+                          (a.Offset + a.SizeInBytes <= plan.Heaps[a.HeapIndex].SizeInBytes));
+            AR_TEST_CHECK((a.HeapIndex < plan.Heaps.size()) && (plan.Heaps[a.HeapIndex].Alignment >= a.Alignment));
+            AR_TEST_CHECK(a.Alignment == resources[i].Builder.GetAllocationInfo().Alignment);
+
+            for (uint32_t j = i + 1; j < resources.size(); j++)
+            {
+                const TransientPlacement& b = plan.Placements[j];
+
+                const bool liveTogether = (resources[i].FirstPass <= resources[j].LastPass) &&
+                                          (resources[j].FirstPass <= resources[i].LastPass);
+                const bool shareBytes   = (a.HeapIndex == b.HeapIndex) &&
+                                          (a.Offset < b.Offset + b.SizeInBytes) &&
+                                          (b.Offset < a.Offset + a.SizeInBytes);
+
+                AR_TEST_CHECK((liveTogether && shareBytes) == false);
+            }
+        }
+
+        AR_TEST_CHECK(plan.UnaliasedBytes == sum);
+        AR_TEST_CHECK((plan.PeakLiveBytes <= plan.HeapBytes) && (plan.HeapBytes < plan.UnaliasedBytes));
+
+        // Heaps holding large MSAA resources are 4MB aligned; tier 1 heaps hold one category each
+        for (const TransientHeap& heap : plan.Heaps)
+        {
+            AR_TEST_CHECK((heap.Alignment == D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT) ||
+                          (heap.Alignment == D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT));
+            AR_TEST_CHECK((heap.SizeInBytes % D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT) == 0);
+            AR_TEST_CHECK((pass == 1) != (heap.Flags == D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES));
+        }
+
+        // Every barrier comes at the first pass of its resource and follows the previous user
+        for (size_t i = 0; i < plan.Barriers.size(); i++)
+        {
+            const AliasingBarrier& barrier = plan.Barriers[i];
+
+            AR_TEST_CHECK(barrier.PassIndex == resources[barrier.ResourceAfter].FirstPass);
+            AR_TEST_CHECK((barrier.ResourceBefore == AnyAliasedResource) ||
+                          (resources[barrier.ResourceBefore].LastPass < barrier.PassIndex));
+            AR_TEST_CHECK((i == 0) || (plan.Barriers[i - 1].PassIndex <= barrier.PassIndex));
+        }
+
+        // Replanning reuses the scratch storage and produces the same plan
+        const std::vector<TransientPlacement> placements = plan.Placements;
+        randomPlanner.Plan(resources.data(), uint32_t(resources.size()));
+        AR_TEST_CHECK(memcmp(placements.data(), randomPlanner.GetPlan().Placements.data(),
+                             placements.size() * sizeof(TransientPlacement)) == 0);
+    }
+
+    // MSAA placement alignment, peak versus the sum of sizes, and unplaced resources
+    {
+        ResourceBuilder msaa = target;
+        msaa.SetSampleCount(4);
+
+        const TransientResource mixed[] =
+        {
+            { target, 0, 0 }, { msaa, 1, 1 }, { target, 2, 2 }, { target, 5, 3 },
+        };
+        const AliasingPlan& plan = planner.Plan(mixed, 4);
+
+        AR_TEST_CHECK(plan.Placements[0].Alignment == D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+        AR_TEST_CHECK(plan.Placements[1].Alignment == D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT);
+        AR_TEST_CHECK((plan.Heaps.size() == 1) &&
+                      (plan.Heaps[0].Alignment == D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT));
+        AR_TEST_CHECK((plan.Placements[3].HeapIndex == UINT32_MAX) && (plan.Placements[3].Offset == UINT64_MAX));
+        AR_TEST_CHECK(plan.PeakLiveBytes == plan.Placements[1].SizeInBytes);
+        AR_TEST_CHECK(plan.PeakPass == 1);
+        AR_TEST_CHECK(plan.UnaliasedBytes == 2 * size + plan.Placements[1].SizeInBytes);
+        AR_TEST_CHECK(plan.HeapBytes == plan.Placements[1].SizeInBytes);
+    }
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks allocation estimates against the D3D12 placement rules for every dimension and the main format classes
+// (small, MSAA and 64KB alignments, block-compressed chains, invalid formats), the batch estimate that places them
+// back to back, and the standard tile shapes of the tiled cases. Returns the number of failed checks.
+uint32_t TestAllocationInfo()
+{
+    uint32_t failures = 0;
+
+    const D3D12_RESOURCE_FLAGS RenderTarget = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+    const D3D12_RESOURCE_FLAGS DepthStencil = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+    ResourceBuilder builders[12] = {};
+    builders[0].Buffer(1000);
+    builders[1].Buffer(70000);
+    builders[2].Texture1D(256, DXGI_FORMAT_R8G8B8A8_UNORM);
+    builders[3].Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM);
+    builders[4].Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM).SetFlags(RenderTarget);
+    builders[5].Texture2D(256, 256, DXGI_FORMAT_R8G8B8A8_UNORM);
+    builders[6].Texture2D(1920, 1080, DXGI_FORMAT_R8G8B8A8_UNORM).SetSampleCount(4).SetFlags(RenderTarget);
+    builders[7].Texture2D(128, 128, DXGI_FORMAT_R8_UNORM).SetSampleCount(2).SetFlags(RenderTarget);
+    builders[8].Texture3D(32, 32, 32, DXGI_FORMAT_R16_FLOAT);
+    builders[9].Texture2D(128, 128, DXGI_FORMAT_BC1_UNORM, 1, 0);
+    builders[10].Texture2D(1024, 1024, DXGI_FORMAT_D32_FLOAT).SetFlags(DepthStencil);
+    builders[11].Texture2D(64, 64, DXGI_FORMAT_UNKNOWN);
+
+    // { SizeInBytes, Alignment } per builder
+    const uint64_t expected[12][2] =
+    {
+        { 65536,    65536 }, { 131072,   65536 }, { 4096,     4096 },    { 16384,      4096 },
+        { 65536,    65536 }, { 262144,   65536 }, { 33554432, 4194304 }, { 65536,      65536 },
+        { 262144,   65536 }, { 20480,    4096 },  { 4194304,  65536 },   { UINT64_MAX, UINT64_MAX },
+    };
+
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        const D3D12_RESOURCE_ALLOCATION_INFO Info = builders[i].GetAllocationInfo();
+        AR_TEST_CHECK((Info.SizeInBytes == expected[i][0]) && (Info.Alignment == expected[i][1]));
+    }
+
+    D3D12_RESOURCE_ALLOCATION_INFO1 infos[12] = {};
+
+    // Valid resources are packed at their own alignment; an invalid one poisons the total and every later offset
+    const D3D12_RESOURCE_ALLOCATION_INFO Valid = GetAllocationInfo(builders, 11, infos);
+    uint64_t offset = 0;
+
+    for (uint32_t i = 0; i < 11; i++)
+    {
+        offset = (offset + expected[i][1] - 1) & ~(expected[i][1] - 1);
+        AR_TEST_CHECK((infos[i].Offset == offset) && (infos[i].SizeInBytes == expected[i][0]));
+        offset += expected[i][0];
+    }
+
+    AR_TEST_CHECK((Valid.SizeInBytes == offset) && (Valid.Alignment == 4194304));
+    AR_TEST_CHECK(GetAllocationInfo(builders, 12, infos).SizeInBytes == UINT64_MAX);
+    AR_TEST_CHECK(infos[11].Offset == UINT64_MAX);
+    AR_TEST_CHECK(GetAllocationInfo(builders, 0).SizeInBytes == 0);
+
+    AR_TEST_CHECK(builders[7].GetStandardTileShape().WidthInTexels == 128);
+    AR_TEST_CHECK(builders[7].GetStandardTileShape().HeightInTexels == 256);
+    AR_TEST_CHECK(builders[8].GetStandardTileShape().DepthInTexels == 32);
+    AR_TEST_CHECK(builders[9].GetStandardTileShape().WidthInTexels == 512);
+    AR_TEST_CHECK(builders[9].GetStandardTileShape().HeightInTexels == 256);
+    AR_TEST_CHECK(builders[2].GetStandardTileShape().WidthInTexels == 0);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Allocates and frees persistent descriptors from several threads, each with its own cache, and checks that no
+// descriptor is ever handed to two owners and that every descriptor is reachable again once the caches are flushed.
+// Also checks handle arithmetic, the transient ring sections and view creation. Returns the number of failed checks.
+uint32_t TestDescriptorAllocator()
+{
+    constexpr uint32_t PersistentCount = 4096;
+    constexpr uint32_t TransientCount  = 64;
+    constexpr uint32_t FrameCount      = 2;
+    constexpr uint32_t ThreadCount     = 8;
+    constexpr uint32_t Rounds          = 200;
+    constexpr uint32_t MaxHeld         = 300;
+
+    uint32_t    failures = 0;
+    MockDevice* pDevice  = new MockDevice();
+
+    {
+        DescriptorAllocator allocator;
+        AR_TEST_CHECK(allocator.Init(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, PersistentCount, TransientCount,
+                                     FrameCount, true) == S_OK);
+        AR_TEST_CHECK(allocator.Init(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 16, 0, 1, true) == E_INVALIDARG);
+        AR_TEST_CHECK(allocator.Init(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, PersistentCount, TransientCount,
+                                     FrameCount, true) == S_OK);
+        AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 1);
+
+        // Owner of each persistent descriptor (0 when free); a second owner means a descriptor was handed out twice
+        std::unique_ptr<std::atomic<uint32_t>[]> owners(new std::atomic<uint32_t>[PersistentCount]);
+        std::atomic<uint32_t>                    doubleAllocations(0);
+        std::atomic<uint32_t>                    badHandles(0);
+        std::vector<std::thread>                 threads;
+
+        for (uint32_t i = 0; i < PersistentCount; i++)
+        {
+            owners[i].store(0);
+        }
+
+        for (uint32_t t = 0; t < ThreadCount; t++)
+        {
+            threads.emplace_back([&, t]()
+            {
+                const Descriptor first     = allocator.GetDescriptor(0);
+                const uint32_t   increment = MockDevice::DescriptorIncrement;
+                DescriptorCache  cache;
+                uint32_t         held[MaxHeld];
+
+                for (uint32_t round = 0; round < Rounds; round++)
+                {
+                    // Vary the batch size so frees overflow the cache and spill to the global list
+                    const uint32_t count = 1 + ((round * 37 + t * 11) % MaxHeld);
+
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        const Descriptor descriptor = allocator.Allocate(&cache);
+                        held[i] = descriptor.Index;
+
+                        if ((descriptor.Index >= PersistentCount) ||
+                            (descriptor.Cpu.ptr != first.Cpu.ptr + descriptor.Index * increment) ||
+                            (descriptor.Gpu.ptr != first.Gpu.ptr + descriptor.Index * increment))
+                        {
+                            badHandles++;
+                            held[i] = InvalidDescriptorIndex;
+                        }
+                        else if (owners[descriptor.Index].exchange(t + 1) != 0)
+                        {
+                            doubleAllocations++;
+                        }
+                    }
+
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        if (held[i] != InvalidDescriptorIndex)
+                        {
+                            owners[held[i]].store(0);
+                            allocator.Free(&cache, held[i]);
+                        }
+                    }
+                }
+
+                allocator.FlushCache(&cache);
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        AR_TEST_CHECK(doubleAllocations.load() == 0);
+        AR_TEST_CHECK(badHandles.load() == 0);
+
+        // Every descriptor is reachable again, exactly once
+        DescriptorCache   cache;
+        std::vector<bool> seen(PersistentCount, false);
+        uint32_t          allocated = 0;
+
+        for (uint32_t i = 0; i < PersistentCount; i++)
+        {
+            const Descriptor descriptor = allocator.Allocate(&cache);
+
+            if (descriptor.IsValid() && (descriptor.Index < PersistentCount) && (seen[descriptor.Index] == false))
+            {
+                seen[descriptor.Index] = true;
+                allocated++;
+            }
+        }
+
+        AR_TEST_CHECK(allocated == PersistentCount);
+        AR_TEST_CHECK(allocator.Allocate(&cache).IsValid() == false);
+
+        // Transient ranges are contiguous inside the frame's section and fail once the section is full
+        allocator.BeginFrame(0);
+        const Descriptor range = allocator.AllocateTransient(60);
+        AR_TEST_CHECK(range.Index == PersistentCount);
+        AR_TEST_CHECK(allocator.AllocateTransient(8).IsValid() == false);
+        AR_TEST_CHECK(allocator.AllocateTransient(4).Index == PersistentCount + 60);
+        AR_TEST_CHECK(allocator.AllocateTransient(1).IsValid() == false);
+        AR_TEST_CHECK(allocator.AllocateTransient(0).IsValid() == false);
+
+        allocator.BeginFrame(1);
+        std::atomic<uint32_t> transientCount(0);
+        std::atomic<uint64_t> transientMask(0);
+        threads.clear();
+
+        for (uint32_t t = 0; t < ThreadCount; t++)
+        {
+            threads.emplace_back([&]()
+            {
+                for (Descriptor d = allocator.AllocateTransient(1); d.IsValid(); d = allocator.AllocateTransient(1))
+                {
+                    transientCount++;
+                    transientMask.fetch_or(1ull << (d.Index - PersistentCount - TransientCount));
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        AR_TEST_CHECK(transientCount.load() == TransientCount);
+        AR_TEST_CHECK(transientMask.load() == UINT64_MAX);
+
+        allocator.BeginFrame(2);
+        AR_TEST_CHECK(allocator.AllocateTransient(1).Index == PersistentCount);
+
+        // Views are written into freshly allocated descriptors of matching heaps only
+        MockResource* pTexture = new MockResource(ResourceBuilder().Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM),
+                                                  ResourceBuilder().GetHeapProperties());
+        DescriptorCache viewCache;
+
+        for (uint32_t i = 0; i < PersistentCount; i++)
+        {
+            allocator.Free(&viewCache, i);
+        }
+
+        AR_TEST_CHECK(allocator.CreateShaderResourceView(&viewCache, pTexture, ResourceBuilder().Texture2D(
+                          64, 64, DXGI_FORMAT_R8G8B8A8_UNORM)).IsValid());
+        AR_TEST_CHECK(allocator.CreateTransientShaderResourceView(pTexture, ResourceBuilder().Texture2D(
+                          64, 64, DXGI_FORMAT_R8G8B8A8_UNORM)).IsValid());
+        AR_TEST_CHECK(allocator.CreateColorTargetView(&viewCache, pTexture, ResourceBuilder().Texture2D(
+                          64, 64, DXGI_FORMAT_R8G8B8A8_UNORM)).IsValid() == false);
+        AR_TEST_CHECK(pDevice->GetViewCount() == 2);
+
+        pTexture->Release();
+    }
+
+    AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 0);
+    pDevice->Release();
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks that every END_ONLY barrier repeats an outstanding BEGIN_ONLY barrier exactly (same subresource and states)
+// and records new BEGIN_ONLY barriers. Returns the number of unmatched END_ONLY barriers.
+uint32_t MatchSplitBarriers(
+    const std::vector<D3D12_RESOURCE_BARRIER>& barriers, std::vector<D3D12_RESOURCE_TRANSITION_BARRIER>* pOutstanding)
+{
+    uint32_t unmatched = 0;
+
+    for (const D3D12_RESOURCE_BARRIER& barrier : barriers)
+    {
+        if (barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+        {
+            pOutstanding->push_back(barrier.Transition);
+        }
+        else if (barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+        {
+            const auto begin = std::find_if(pOutstanding->begin(), pOutstanding->end(),
+                [&](const D3D12_RESOURCE_TRANSITION_BARRIER& transition)
+                {
+                    return (transition.pResource == barrier.Transition.pResource) &&
+                           (transition.Subresource == barrier.Transition.Subresource) &&
+                           (transition.StateBefore == barrier.Transition.StateBefore) &&
+                           (transition.StateAfter == barrier.Transition.StateAfter);
+                });
+
+            if (begin == pOutstanding->end())
+            {
+                unmatched++;
+            }
+            else
+            {
+                pOutstanding->erase(begin);
+            }
+        }
+    }
+
+    return unmatched;
+}
+
+//=====================================================================================================================
+// Checks barrier coalescing into ALL_SUBRESOURCES barriers and state runs, read-only state merging, and split
+// barriers whose END_ONLY halves must repeat their BEGIN_ONLY halves. Returns the number of failed checks.
+uint32_t TestStateTracker()
+{
+    constexpr uint32_t All = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+
+    // 4 mips and 2 array slices: 8 subresources
+    const ResourceBuilder texture = ResourceBuilder().Texture2D(256, 256, DXGI_FORMAT_R8G8B8A8_UNORM, 2, 4);
+
+    uint32_t                            failures = 0;
+    StateTracker                        tracker;
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+    const auto flush = [&]()
+    {
+        barriers.clear();
+        return tracker.Flush(&barriers);
+    };
+
+    const auto isBarrier = [&](uint32_t i, uint32_t subresource, D3D12_RESOURCE_STATES before,
+                               D3D12_RESOURCE_STATES after, D3D12_RESOURCE_BARRIER_FLAGS flags)
+    {
+        return (i < barriers.size()) && (barriers[i].Flags == flags) &&
+               (barriers[i].Transition.Subresource == subresource) &&
+               (barriers[i].Transition.StateBefore == before) && (barriers[i].Transition.StateAfter == after);
+    };
+
+    // Coalescing: whole-resource moves are one ALL_SUBRESOURCES barrier, partial moves split and re-merge the runs
+    const uint32_t h = tracker.Register(nullptr, texture, D3D12_RESOURCE_STATE_COMMON);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_RENDER_TARGET,
+                            D3D12_RESOURCE_BARRIER_FLAG_NONE));
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    AR_TEST_CHECK(flush() == 0);
+
+    tracker.TransitionSlices(h, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, 1, 1, 0, 2);
+    AR_TEST_CHECK(flush() == 2);
+    AR_TEST_CHECK(isBarrier(0, 1, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                            D3D12_RESOURCE_BARRIER_FLAG_NONE));
+    AR_TEST_CHECK(isBarrier(1, 5, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                            D3D12_RESOURCE_BARRIER_FLAG_NONE));
+    AR_TEST_CHECK(tracker.IsUniform(h) == false);
+    AR_TEST_CHECK(tracker.GetRangeCount(h) == 5);
+    AR_TEST_CHECK(tracker.GetState(h, 5) == D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    AR_TEST_CHECK(tracker.GetState(h, 6) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    // The last request for a subresource in a pass wins
+    tracker.Transition(h, D3D12_RESOURCE_STATE_COPY_DEST, 0, 8);
+    tracker.Transition(h, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, 0, 8);
+    AR_TEST_CHECK(flush() == 6);
+    AR_TEST_CHECK(tracker.IsUniform(h));
+    AR_TEST_CHECK(tracker.GetState(h, 0) == D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_COPY_SOURCE, 0, 8);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE,
+                            D3D12_RESOURCE_BARRIER_FLAG_NONE));
+
+    // Read-only merging: read requests in one pass combine, and a state covering a later read request needs nothing
+    constexpr D3D12_RESOURCE_STATES ShaderRead = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
+                                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    tracker.Transition(h, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_COPY_SOURCE, ShaderRead, D3D12_RESOURCE_BARRIER_FLAG_NONE));
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 2, 3);
+    AR_TEST_CHECK(flush() == 0);
+    AR_TEST_CHECK(tracker.IsUniform(h));
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 2, 1);
+    tracker.Transition(h, D3D12_RESOURCE_STATE_COPY_SOURCE, 2, 1);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, 2, ShaderRead, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
+                            D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_BARRIER_FLAG_NONE));
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_COPY_DEST);
+    AR_TEST_CHECK(flush() == 8);
+    AR_TEST_CHECK(tracker.IsUniform(h));
+
+    // Split barriers: a whole-resource BEGIN_ONLY is ended by one matching ALL_SUBRESOURCES END_ONLY as soon as any
+    // subresource is touched, and later requests issue no further END_ONLY barriers
+    std::vector<D3D12_RESOURCE_TRANSITION_BARRIER> outstanding;
+
+    tracker.BeginSplitTransition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                            D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY));
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 3, 1);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                            D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+    AR_TEST_CHECK(outstanding.empty());
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    AR_TEST_CHECK(flush() == 0);
+    AR_TEST_CHECK(tracker.IsUniform(h));
+
+    // Ending the split with a transition to another state emits the END_ONLY before the new transition
+    tracker.BeginSplitTransition(h, D3D12_RESOURCE_STATE_COPY_SOURCE, 0, 8);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_RENDER_TARGET, 7, 1);
+    AR_TEST_CHECK(flush() == 2);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE,
+                            D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+    AR_TEST_CHECK(isBarrier(1, 7, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET,
+                            D3D12_RESOURCE_BARRIER_FLAG_NONE));
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+    AR_TEST_CHECK(outstanding.empty());
+
+    // Per-subresource BEGIN_ONLY barriers are ended per subresource, never by an ALL_SUBRESOURCES END_ONLY
+    tracker.BeginSplitTransition(h, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, 0, 7);
+    AR_TEST_CHECK(flush() == 7);
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+    AR_TEST_CHECK(tracker.GetRangeCount(h) == 8);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, 2, 1);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, 2, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                            D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+
+    tracker.Transition(h, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    AR_TEST_CHECK(flush() == 7);
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+    AR_TEST_CHECK(outstanding.empty());
+    AR_TEST_CHECK(tracker.IsUniform(h));
+
+    // Resources are tracked independently and single-subresource resources always use ALL_SUBRESOURCES
+    const uint32_t buffer = tracker.Register(nullptr, ResourceBuilder().Buffer(4096), D3D12_RESOURCE_STATE_COMMON);
+
+    tracker.BeginSplitTransition(buffer, D3D12_RESOURCE_STATE_COPY_DEST);
+    tracker.Transition(h, D3D12_RESOURCE_STATE_COPY_DEST, 0, 1);
+    AR_TEST_CHECK(flush() == 2);
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+
+    tracker.Transition(buffer, D3D12_RESOURCE_STATE_COPY_DEST, 0, 1);
+    AR_TEST_CHECK(flush() == 1);
+    AR_TEST_CHECK(isBarrier(0, All, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST,
+                            D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+    AR_TEST_CHECK(MatchSplitBarriers(barriers, &outstanding) == 0);
+    AR_TEST_CHECK(outstanding.empty());
+
+    return failures;
+}
+
+#if AR_ENABLE_INSTRUMENTATION
+//=====================================================================================================================
+// Records builder calls from several short-lived batches of threads and checks that exited threads hand their rings
+// to later threads (so rings stay bounded by the peak thread count) without losing counts or events. Returns the
+// number of failed checks.
+uint32_t TestInstrumentation()
+{
+    constexpr uint32_t Batches        = 4;
+    constexpr uint32_t ThreadCount    = 8;
+    constexpr uint32_t CallsPerThread = 100;
+
+    uint32_t failures = 0;
+
+    Instrumentation::Reset();
+
+    for (uint32_t batch = 0; batch < Batches; batch++)
+    {
+        std::vector<std::thread> threads;
+
+        for (uint32_t t = 0; t < ThreadCount; t++)
+        {
+            threads.emplace_back([t]()
+            {
+                for (uint32_t i = 0; i < CallsPerThread; i++)
+                {
+                    ResourceBuilder builder;
+                    builder.Buffer(uint64_t(t + 1) * (i + 1));
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::vector<InstrumentationEvent> events;
+    Instrumentation::CollectEvents(&events);
+
+    uint32_t bufferEvents = 0;
+    uint32_t ringCount    = 0;
+
+    for (const InstrumentationEvent& event : events)
+    {
+        bufferEvents += (event.Method == InstrumentedMethod::Buffer) ? 1 : 0;
+        ringCount     = std::max(ringCount, event.Thread + 1);
+    }
+
+    // Earlier tests ran at most ThreadCount workers next to the main thread
+    AR_TEST_CHECK(ringCount <= ThreadCount + 1);
+    AR_TEST_CHECK(bufferEvents == Batches * ThreadCount * CallsPerThread);
+    AR_TEST_CHECK(Instrumentation::GetCallCount(InstrumentedMethod::Buffer) == Batches * ThreadCount * CallsPerThread);
+    AR_TEST_CHECK(Instrumentation::GetDimensionCount(D3D12_RESOURCE_DIMENSION_BUFFER) ==
+                  Batches * ThreadCount * CallsPerThread);
+
+    return failures;
+}
+#endif
+
+//=====================================================================================================================
+// Checks that parallel loops cover every item exactly once, that the worker pool keeps its threads between loops, and
+// that loops started from inside a loop or from several threads at once still complete. Returns the number of failed
+// checks.
+uint32_t TestParallelFor()
+{
+    uint32_t failures = 0;
+
+    for (uint32_t count : { 0u, 1u, 7u, 100u, 4097u })
+    {
+        for (uint32_t threads : { 1u, 2u, 4u, 9u })
+        {
+            // Chunks are disjoint, so every item is written by one thread
+            std::vector<uint32_t> hits(count, 0);
+
+            ParallelFor(count, threads, 1, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    hits[i]++;
+                }
+            });
+
+            AR_TEST_CHECK(std::count(hits.begin(), hits.end(), 1u) == count);
+        }
+    }
+
+    const uint32_t workerCount = WorkerPool::Get().GetWorkerCount();
+    AR_TEST_CHECK((workerCount >= 3) && (workerCount <= WorkerPool::MaxWorkers));
+
+    // Workers are reused: repeated loops start no threads and run on at most the pool's threads and the caller
+    std::mutex                   lock;
+    std::vector<std::thread::id> ids;
+
+    for (uint32_t call = 0; call < 50; call++)
+    {
+        ParallelFor(64, 4, 1, [&](uint32_t, uint32_t)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (std::find(ids.begin(), ids.end(), std::this_thread::get_id()) == ids.end())
+            {
+                ids.push_back(std::this_thread::get_id());
+            }
+        });
+    }
+
+    AR_TEST_CHECK(WorkerPool::Get().GetWorkerCount() == workerCount);
+    AR_TEST_CHECK(ids.size() <= workerCount + 1);
+
+    // A loop inside a loop runs on the calling worker
+    std::atomic<uint32_t> nested(0);
+
+    ParallelFor(8, 4, 1, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            ParallelFor(100, 4, 1, [&](uint32_t innerBegin, uint32_t innerEnd) { nested += innerEnd - innerBegin; });
+        }
+    });
+
+    AR_TEST_CHECK(nested.load() == 800);
+
+    // Loops from several threads share the pool; the ones that find it busy run on their own thread
+    std::atomic<uint32_t>    total(0);
+    std::vector<std::thread> threads;
+
+    for (uint32_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (uint32_t call = 0; call < 100; call++)
+            {
+                ParallelFor(1000, 4, 1, [&](uint32_t begin, uint32_t end) { total += end - begin; });
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    AR_TEST_CHECK(total.load() == 4 * 100 * 1000);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks render target pool hits and misses, reuse gated by the release fence, least recently released eviction under
+// the memory budget, and the statistics. Returns the number of failed checks.
+uint32_t TestRenderTargetPool()
+{
+    constexpr D3D12_RESOURCE_STATES RenderTarget = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    constexpr D3D12_RESOURCE_STATES ShaderRead   = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+    // Equally sized targets with distinct keys
+    const auto makeTarget = [](DXGI_FORMAT format)
+    {
+        return ResourceBuilder().Texture2D(256, 256, format).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+    };
+
+    const ResourceBuilder color    = makeTarget(DXGI_FORMAT_R8G8B8A8_UNORM);
+    const ResourceBuilder swizzled = makeTarget(DXGI_FORMAT_B8G8R8A8_UNORM);
+    const ResourceBuilder single   = makeTarget(DXGI_FORMAT_R32_FLOAT);
+    const ResourceBuilder pair     = makeTarget(DXGI_FORMAT_R16G16_FLOAT);
+    const uint64_t        size     = color.GetAllocationInfo().SizeInBytes;
+
+    uint32_t    failures = 0;
+    MockDevice* pDevice  = new MockDevice();
+
+    AR_TEST_CHECK(MakePoolKey(ResourceBuilder().Texture2D(256, 256, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 0)).MipLevels == 9);
+    AR_TEST_CHECK(HashPoolKey(MakePoolKey(color)) == HashPoolKey(MakePoolKey(makeTarget(DXGI_FORMAT_R8G8B8A8_UNORM))));
+    AR_TEST_CHECK(HashPoolKey(MakePoolKey(color)) != HashPoolKey(MakePoolKey(swizzled)));
+
+    {
+        // Hit and miss, with reuse gated by the fence value of the release
+        RenderTargetPool      pool(pDevice, 16 * size);
+        ID3D12Resource*       pFirst  = nullptr;
+        ID3D12Resource*       pSecond = nullptr;
+        ID3D12Resource*       pThird  = nullptr;
+        ID3D12Resource*       pReused = nullptr;
+        D3D12_RESOURCE_STATES state   = D3D12_RESOURCE_STATE_COMMON;
+
+        AR_TEST_CHECK(pool.Acquire(color, RenderTarget, nullptr, &pFirst, &state) == S_OK);
+        AR_TEST_CHECK((pFirst != nullptr) && (state == RenderTarget));
+        AR_TEST_CHECK(pool.Release(pFirst, ShaderRead, 5));
+        AR_TEST_CHECK(pool.Release(pFirst, ShaderRead, 5) == false);
+
+        AR_TEST_CHECK(pool.Acquire(color, RenderTarget, nullptr, &pSecond) == S_OK);
+        AR_TEST_CHECK((pSecond != nullptr) && (pSecond != pFirst));
+        AR_TEST_CHECK(pool.Release(pSecond, RenderTarget, 6));
+
+        pool.BeginFrame(5);
+        AR_TEST_CHECK(pool.Acquire(swizzled, RenderTarget, nullptr, &pThird) == S_OK);
+        AR_TEST_CHECK((pThird != pFirst) && (pThird != pSecond));
+        AR_TEST_CHECK(pool.Acquire(color, RenderTarget, nullptr, &pReused, &state) == S_OK);
+        AR_TEST_CHECK((pReused == pFirst) && (state == ShaderRead));
+
+        const RenderTargetPoolStats stats = pool.GetStats();
+        AR_TEST_CHECK((stats.AcquireCount == 4) && (stats.HitCount == 1) && (stats.MissCount == 3));
+        AR_TEST_CHECK((stats.InUseBytes == 2 * size) && (stats.WastedBytes == size) && (stats.PeakBytes == 3 * size));
+        AR_TEST_CHECK(stats.EvictionCount == 0);
+        AR_TEST_CHECK(pool.GetHitRate() == 0.25);
+        AR_TEST_CHECK(pDevice->GetResourceCount() == 3);
+
+        // Trim only destroys idle resources the GPU finished with
+        pool.Trim();
+        AR_TEST_CHECK(pool.GetStats().WastedBytes == size);
+        pool.BeginFrame(6);
+        pool.Trim();
+        AR_TEST_CHECK((pool.GetStats().WastedBytes == 0) && (pool.GetStats().EvictionCount == 1));
+        AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 2);
+
+        // Adopted resources are pooled like created ones
+        ID3D12Resource* pAdopted = new MockResource(single, single.GetHeapProperties());
+        pool.Adopt(pAdopted, single);
+        AR_TEST_CHECK(pool.GetStats().InUseBytes == 3 * size);
+        AR_TEST_CHECK(pool.Release(pAdopted, ShaderRead, 6));
+        AR_TEST_CHECK((pool.Acquire(single, RenderTarget, nullptr, &pReused) == S_OK) && (pReused == pAdopted));
+
+        AR_TEST_CHECK(pool.Release(pFirst, ShaderRead, 7));
+        AR_TEST_CHECK(pool.Release(pThird, ShaderRead, 7));
+        AR_TEST_CHECK(pool.Release(pAdopted, ShaderRead, 7));
+        AR_TEST_CHECK(pool.Release(nullptr, ShaderRead, 7) == false);
+    }
+
+    // Destroying the pool releases its idle resources
+    AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 0);
+
+    {
+        // Least recently released idle resources are evicted first once the budget is exceeded
+        RenderTargetPool       pool(pDevice, 3 * size);
+        ID3D12Resource*        pResources[4] = {};
+        const ResourceBuilder* pBuilders[4]  = { &color, &swizzled, &single, &pair };
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            AR_TEST_CHECK(pool.Acquire(*pBuilders[i], RenderTarget, nullptr, &pResources[i]) == S_OK);
+        }
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            AR_TEST_CHECK(pool.Release(pResources[i], ShaderRead, i + 1));
+        }
+
+        pool.BeginFrame(3);
+        AR_TEST_CHECK(pool.GetStats().EvictionCount == 0);
+
+        AR_TEST_CHECK(pool.Acquire(pair, RenderTarget, nullptr, &pResources[3]) == S_OK);
+        AR_TEST_CHECK(pool.GetStats().EvictionCount == 1);
+        AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 3);
+
+        // color was evicted, swizzled goes next
+        ID3D12Resource* pResource = nullptr;
+        AR_TEST_CHECK(pool.Acquire(color, RenderTarget, nullptr, &pResource) == S_OK);
+        AR_TEST_CHECK(pool.GetStats().MissCount == 5);
+        AR_TEST_CHECK(pool.GetStats().EvictionCount == 2);
+        AR_TEST_CHECK((pool.Acquire(single, RenderTarget, nullptr, &pResources[2]) == S_OK));
+        AR_TEST_CHECK(pool.GetStats().HitCount == 1);
+
+        // Idle resources still used by the GPU are kept over the budget until their fence completes
+        AR_TEST_CHECK(pool.Release(pResource, ShaderRead, 10));
+        AR_TEST_CHECK(pool.Release(pResources[2], ShaderRead, 3));
+        pool.SetBudget(0);
+        AR_TEST_CHECK(pool.GetStats().WastedBytes == size);
+        AR_TEST_CHECK(pool.GetStats().EvictionCount == 3);
+
+        pool.BeginFrame(10);
+        AR_TEST_CHECK(pool.GetStats().WastedBytes == 0);
+        AR_TEST_CHECK(pool.GetStats().EvictionCount == 4);
+        AR_TEST_CHECK(pool.GetStats().InUseBytes == size);
+
+        // Misses make room before creating, so the pool never held more than the budget
+        AR_TEST_CHECK(pool.GetStats().PeakBytes == 3 * size);
+
+        pResources[3]->Release();
+    }
+
+    AR_TEST_CHECK(pDevice->GetLiveObjectCount() == 0);
+    pDevice->Release();
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks upload ring planning: 512-byte aligned placement, wrap-around at the ring end, reclaiming space by fence
+// value, grouping of copies per destination and writing source rows into the planned footprints. Returns the number
+// of failed checks.
+uint32_t TestUploadRing()
+{
+    constexpr uint64_t RingSize = 65536;
+
+    const ResourceBuilder mipChain = ResourceBuilder().Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 3);
+
+    uint32_t          failures = 0;
+    UploadRingPlanner planner(RingSize);
+
+    // Ring offset of the first copy of the last plan
+    const auto firstOffset = [&]()
+    {
+        return planner.GetPlan().Copies.empty() ? UINT64_MAX : planner.GetPlan().Copies[0].Footprint.Offset;
+    };
+
+    // Placement: every block and footprint starts on a 512-byte boundary, copies are grouped per destination
+    const UploadRequest requests[] =
+    {
+        { mipChain,                        1, 0, 1 },
+        { ResourceBuilder().Buffer(1000),  2, 0, 1 },
+        { mipChain,                        1, 1, 2 },
+        { ResourceBuilder().Buffer(100),   3, 0, 1 },
+    };
+
+    const UploadPlan& plan = planner.Plan(requests, 4, 1);
+
+    AR_TEST_CHECK(plan.RequestCount == 4);
+    AR_TEST_CHECK(plan.Copies.size() == 5);
+    AR_TEST_CHECK(plan.Groups.size() == 3);
+
+    for (const UploadCopy& copy : plan.Copies)
+    {
+        AR_TEST_CHECK((copy.Footprint.Offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) == 0);
+    }
+
+    if ((plan.Copies.size() == 5) && (plan.Groups.size() == 3))
+    {
+        AR_TEST_CHECK((plan.Groups[0].Destination == 1) && (plan.Groups[0].FirstCopy == 0) &&
+                      (plan.Groups[0].CopyCount == 3));
+        AR_TEST_CHECK((plan.Groups[1].Destination == 2) && (plan.Groups[1].FirstCopy == 3) &&
+                      (plan.Groups[1].CopyCount == 1));
+        AR_TEST_CHECK((plan.Groups[2].Destination == 3) && (plan.Groups[2].FirstCopy == 4) &&
+                      (plan.Groups[2].CopyCount == 1));
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            AR_TEST_CHECK(plan.Copies[i].Subresource == i);
+        }
+
+        AR_TEST_CHECK((plan.Copies[0].Request == 0) && (plan.Copies[1].Request == 2) && (plan.Copies[3].Request == 1));
+        AR_TEST_CHECK(plan.Copies[0].Footprint.Offset == 0);
+        AR_TEST_CHECK(plan.Copies[0].Footprint.Footprint.RowPitch == 256);
+        AR_TEST_CHECK((plan.Copies[0].NumRows == 64) && (plan.Copies[0].RowSizeInBytes == 256));
+        AR_TEST_CHECK(plan.Copies[3].Footprint.Offset == 16384);
+        AR_TEST_CHECK(plan.Copies[1].Footprint.Offset == 16384 + 1024);
+        AR_TEST_CHECK(plan.Copies[1].Footprint.Footprint.RowPitch == 256);
+        AR_TEST_CHECK(plan.Copies[4].Footprint.Offset > plan.Copies[2].Footprint.Offset);
+    }
+
+    AR_TEST_CHECK(planner.GetUsedBytes() == plan.AllocatedBytes);
+    planner.Retire(0);
+    AR_TEST_CHECK(planner.GetUsedBytes() == plan.AllocatedBytes);
+    planner.Retire(1);
+    AR_TEST_CHECK(planner.GetUsedBytes() == 0);
+
+    // Requests that cannot be described or do not fit end the plan
+    const UploadRequest invalid[] =
+    {
+        { ResourceBuilder().Buffer(4000),   1, 0, 1 },
+        { mipChain,                         2, 3, 1 },
+        { ResourceBuilder().Buffer(4000),   3, 0, 1 },
+    };
+
+    AR_TEST_CHECK(UploadRingPlanner::GetRequiredBytes(invalid[1]) == UINT64_MAX);
+    AR_TEST_CHECK(planner.Plan(invalid, 3, 2).RequestCount == 1);
+
+    const UploadRequest oversized = { ResourceBuilder().Buffer(RingSize + 1), 1, 0, 1 };
+    AR_TEST_CHECK(planner.Plan(&oversized, 1, 2).RequestCount == 0);
+    planner.Retire(2);
+
+    // Wrap-around: a block that does not fit before the ring end starts at offset zero once the oldest plan retired
+    const UploadRequest first  = { ResourceBuilder().Buffer(40000), 1, 0, 1 };
+    const UploadRequest second = { ResourceBuilder().Buffer(20000), 2, 0, 1 };
+    const UploadRequest third  = { ResourceBuilder().Buffer(10000), 3, 0, 1 };
+
+    AR_TEST_CHECK((planner.Plan(&first, 1, 3).RequestCount == 1) && (firstOffset() == 0));
+    AR_TEST_CHECK((planner.Plan(&second, 1, 4).RequestCount == 1) && (firstOffset() == 40448));
+    AR_TEST_CHECK(planner.GetPlan().AllocatedBytes == 20448);
+    AR_TEST_CHECK(planner.Plan(&third, 1, 5).RequestCount == 0);
+
+    planner.Retire(3);
+    AR_TEST_CHECK(planner.GetUsedBytes() == 20448);
+    AR_TEST_CHECK(planner.Plan(&third, 1, 5).RequestCount == 1);
+    AR_TEST_CHECK(firstOffset() == 0);
+    AR_TEST_CHECK(planner.GetPlan().AllocatedBytes == (RingSize - 60448) + 10000);
+    AR_TEST_CHECK(planner.GetUsedBytes() == 20448 + (RingSize - 60448) + 10000);
+
+    // The freed space before the oldest plan in use is not handed out twice
+    const UploadRequest fourth = { ResourceBuilder().Buffer(29000), 4, 0, 1 };
+    const UploadRequest fifth  = { ResourceBuilder().Buffer(30000), 4, 0, 1 };
+    AR_TEST_CHECK(planner.Plan(&fifth, 1, 5).RequestCount == 0);
+    AR_TEST_CHECK(planner.Plan(&fourth, 1, 5).RequestCount == 1);
+    AR_TEST_CHECK(firstOffset() == 10240);
+    AR_TEST_CHECK(planner.Plan(&third, 1, 6).RequestCount == 0);
+
+    // Plans sharing a fence value retire together
+    planner.Retire(4);
+    AR_TEST_CHECK(planner.GetUsedBytes() == (RingSize - 60448) + 10000 + 240 + 29000);
+    planner.Retire(5);
+    AR_TEST_CHECK(planner.GetUsedBytes() == 0);
+
+    // Source rows land at the footprint row pitch
+    const UploadRequest mip     = { mipChain, 1, 2, 1 };
+    const UploadPlan&   mipPlan = planner.Plan(&mip, 1, 7);
+    AR_TEST_CHECK(mipPlan.Copies.size() == 1);
+
+    if (mipPlan.Copies.size() == 1)
+    {
+        const UploadCopy&    copy = mipPlan.Copies[0];
+        std::vector<uint8_t> ring(RingSize, 0);
+        std::vector<uint8_t> source(16 * 4 * 16);
+
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            source[i] = static_cast<uint8_t>(i + 1);
+        }
+
+        UploadRingPlanner::WriteSubresource(ring.data(), copy, source.data(), 64, 64 * 16);
+
+        const uint8_t* pRow = ring.data() + copy.Footprint.Offset + 5 * copy.Footprint.Footprint.RowPitch;
+        AR_TEST_CHECK((copy.NumRows == 16) && (copy.RowSizeInBytes == 64));
+        AR_TEST_CHECK(memcmp(pRow, source.data() + 5 * 64, 64) == 0);
+        AR_TEST_CHECK(pRow[64] == 0);
+    }
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Writes a little-endian value into a test file
+template <typename T>
+void WriteValue(
+    std::vector<uint8_t>* pFile, size_t offset, T value)
+{
+    memcpy(pFile->data() + offset, &value, sizeof(value));
+}
+
+//=====================================================================================================================
+// Header fields of a DDS test file (the DX10 fields are written when FourCC is 'DX10')
+struct DdsFields
+{
+    uint32_t    Width      = 1;
+    uint32_t    Height     = 1;
+    uint32_t    Depth      = 0;
+    uint32_t    MipCount   = 0;
+    uint32_t    Flags      = 0x00001007; ///< DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT
+    uint32_t    Caps2      = 0;
+    uint32_t    PixelFlags = 0x00000004; ///< DDPF_FOURCC
+    uint32_t    FourCC     = 0x30315844; ///< 'DX10'
+    uint32_t    BitCount   = 0;
+    uint32_t    Masks[4]   = {};
+    DXGI_FORMAT Format     = DXGI_FORMAT_R8G8B8A8_UNORM;
+    uint32_t    Dimension  = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    uint32_t    MiscFlag   = 0;
+    uint32_t    ArraySize  = 1;
+};
+
+//=====================================================================================================================
+// Builds a DDS file followed by dataSize texel bytes. Every byte of the texel data holds its offset modulo 251, so
+// subresource offsets can be checked against the file contents.
+std::vector<uint8_t> MakeDds(
+    const DdsFields& fields, size_t dataSize)
+{
+    const bool           isDx10     = (fields.FourCC == 0x30315844);
+    const size_t         dataOffset = 128 + (isDx10 ? 20 : 0);
+    std::vector<uint8_t> file(dataOffset + dataSize, 0);
+
+    WriteValue<uint32_t>(&file, 0, 0x20534444);
+    WriteValue<uint32_t>(&file, 4, 124);
+    WriteValue(&file, 8, fields.Flags);
+    WriteValue(&file, 12, fields.Height);
+    WriteValue(&file, 16, fields.Width);
+    WriteValue(&file, 24, fields.Depth);
+    WriteValue(&file, 28, fields.MipCount);
+    WriteValue<uint32_t>(&file, 76, 32);
+    WriteValue(&file, 80, fields.PixelFlags);
+    WriteValue(&file, 84, fields.FourCC);
+    WriteValue(&file, 88, fields.BitCount);
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        WriteValue(&file, 92 + (i * 4), fields.Masks[i]);
+    }
+
+    WriteValue<uint32_t>(&file, 108, 0x00001000);
+    WriteValue(&file, 112, fields.Caps2);
+
+    if (isDx10)
+    {
+        WriteValue(&file, 128, static_cast<uint32_t>(fields.Format));
+        WriteValue(&file, 132, fields.Dimension);
+        WriteValue(&file, 136, fields.MiscFlag);
+        WriteValue(&file, 140, fields.ArraySize);
+    }
+
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        file[dataOffset + i] = static_cast<uint8_t>(i % 251);
+    }
+
+    return file;
+}
+
+//=====================================================================================================================
+// Header fields of an RGBA8 KTX2 test file
+struct Ktx2Fields
+{
+    uint32_t VkFormat         = 37; ///< VK_FORMAT_R8G8B8A8_UNORM
+    uint32_t Width            = 1;
+    uint32_t Height           = 1;
+    uint32_t Depth            = 0;
+    uint32_t LayerCount       = 0;
+    uint32_t FaceCount        = 1;
+    uint32_t LevelCount       = 1;
+    uint32_t Supercompression = 0;
+};
+
+//=====================================================================================================================
+// Builds a KTX2 file with 4-byte texels, levels stored smallest first after the level index. Every texel byte of
+// level L holds L + 1.
+std::vector<uint8_t> MakeKtx2(
+    const Ktx2Fields& fields)
+{
+    const uint32_t levelCount = std::max(1u, fields.LevelCount);
+    const uint32_t layerCount = std::max(1u, fields.LayerCount);
+
+    std::vector<uint64_t> levelSizes(levelCount);
+    uint64_t              offset = 80 + (uint64_t(levelCount) * 24);
+
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        levelSizes[level] = uint64_t(std::max(1u, fields.Width >> level)) * std::max(1u, fields.Height >> level) *
+                            std::max(1u, fields.Depth >> level) * layerCount * fields.FaceCount * 4;
+    }
+
+    std::vector<uint8_t> file(static_cast<size_t>(offset), 0);
+    const uint8_t        identifier[12] = { 0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n' };
+
+    memcpy(file.data(), identifier, sizeof(identifier));
+    WriteValue(&file, 12, fields.VkFormat);
+    WriteValue<uint32_t>(&file, 16, 1);
+    WriteValue(&file, 20, fields.Width);
+    WriteValue(&file, 24, fields.Height);
+    WriteValue(&file, 28, fields.Depth);
+    WriteValue(&file, 32, fields.LayerCount);
+    WriteValue(&file, 36, fields.FaceCount);
+    WriteValue(&file, 40, fields.LevelCount);
+    WriteValue(&file, 44, fields.Supercompression);
+
+    for (uint32_t level = levelCount; level-- > 0;)
+    {
+        WriteValue<uint64_t>(&file, 80 + (level * 24), file.size());
+        WriteValue<uint64_t>(&file, 80 + (level * 24) + 8, levelSizes[level]);
+        WriteValue<uint64_t>(&file, 80 + (level * 24) + 16, levelSizes[level]);
+        file.resize(file.size() + levelSizes[level], static_cast<uint8_t>(level + 1));
+    }
+
+    return file;
+}
+
+//=====================================================================================================================
+// Checks DDS and KTX2 header parsing: round trips of valid files down to the subresource data offsets, and rejection
+// of truncated headers and data, dimensions and mip counts over the D3D12 limits, bad DX10 headers and KTX2 level
+// indices pointing outside the file. Also scans a directory of fixtures. Returns the number of failed checks.
+uint32_t TestTextureFile()
+{
+    uint32_t          failures = 0;
+    ResourceBuilder   builder  = {};
+    TextureFileLayout layout   = {};
+
+    const auto isDds = [&](const std::vector<uint8_t>& file)
+    {
+        return FromDDS(file.data(), file.size(), &builder, &layout);
+    };
+
+    const auto isKtx2 = [&](const std::vector<uint8_t>& file)
+    {
+        return FromKTX2(file.data(), file.size(), &builder, &layout);
+    };
+
+    // DX10 2D array: every slice stores its full mip chain (64x32, 32x16 and 16x8 texels of 4 bytes)
+    DdsFields array = {};
+    array.Width     = 64;
+    array.Height    = 32;
+    array.MipCount  = 3;
+    array.ArraySize = 2;
+
+    constexpr size_t           ArraySliceSize = (64 * 32 + 32 * 16 + 16 * 8) * 4;
+    const std::vector<uint8_t> arrayFile      = MakeDds(array, 2 * ArraySliceSize);
+
+    AR_TEST_CHECK(isDds(arrayFile));
+    AR_TEST_CHECK((builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D) && (builder.Width == 64) &&
+                  (builder.Height == 32) && (builder.DepthOrArraySize == 2) && (builder.MipLevels == 3) &&
+                  (builder.Format == DXGI_FORMAT_R8G8B8A8_UNORM));
+    AR_TEST_CHECK((layout.Type == TextureFileType::DDS) && (layout.FaceCount == 1) && (layout.DataOffset == 148) &&
+                  (layout.DataSize == 2 * ArraySliceSize));
+
+    TextureSubresourceData data = {};
+    AR_TEST_CHECK(GetTextureSubresourceData(builder, layout, 4, &data));
+    AR_TEST_CHECK((data.Offset == 148 + ArraySliceSize + (64 * 32 * 4)) && (data.RowPitch == 128) &&
+                  (data.NumRows == 16) && (data.SlicePitch == 2048) && (data.Depth == 1));
+    AR_TEST_CHECK(arrayFile[static_cast<size_t>(data.Offset)] == (ArraySliceSize + (64 * 32 * 4)) % 251);
+    AR_TEST_CHECK(GetTextureSubresourceData(builder, layout, 6, &data) == false);
+    AR_TEST_CHECK(FromTextureFile(arrayFile.data(), arrayFile.size(), &builder));
+
+    // Truncated headers and texel data
+    for (size_t size = 0; size < 148; size++)
+    {
+        AR_TEST_CHECK(FromDDS(arrayFile.data(), size, &builder) == false);
+    }
+
+    AR_TEST_CHECK(FromDDS(arrayFile.data(), arrayFile.size() - 1, &builder) == false);
+    AR_TEST_CHECK(FromDDS(nullptr, arrayFile.size(), &builder) == false);
+
+    // Cube maps count their faces in the array size
+    DdsFields cube = array;
+    cube.Width     = 16;
+    cube.Height    = 16;
+    cube.MipCount  = 1;
+    cube.MiscFlag  = 0x4;
+    AR_TEST_CHECK(isDds(MakeDds(cube, 6 * 2 * 16 * 16 * 4)));
+    AR_TEST_CHECK((builder.DepthOrArraySize == 12) && (layout.FaceCount == 6));
+
+    // Bad DX10 headers: unknown dimension, empty array, 3D arrays, cube arrays over the array limit, unknown format
+    DdsFields bad = cube;
+    bad.Dimension = 5;
+    AR_TEST_CHECK(isDds(MakeDds(bad, 6 * 2 * 16 * 16 * 4)) == false);
+    bad           = cube;
+    bad.ArraySize = 0;
+    AR_TEST_CHECK(isDds(MakeDds(bad, 6 * 2 * 16 * 16 * 4)) == false);
+    bad           = cube;
+    bad.ArraySize = (D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION / 6) + 1;
+    AR_TEST_CHECK(isDds(MakeDds(bad, size_t(bad.ArraySize) * 6 * 16 * 16 * 4)) == false);
+    bad           = cube;
+    bad.Format    = static_cast<DXGI_FORMAT>(0xffff);
+    AR_TEST_CHECK(isDds(MakeDds(bad, 6 * 2 * 16 * 16 * 4)) == false);
+    bad           = {};
+    bad.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
+    bad.Depth     = 1;
+    bad.ArraySize = 2;
+    AR_TEST_CHECK(isDds(MakeDds(bad, 8)) == false);
+    bad           = {};
+    bad.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
+    bad.Height    = 2;
+    AR_TEST_CHECK(isDds(MakeDds(bad, 8)) == false);
+
+    // 2D limits apply to 1D and 2D textures, the smaller 3D limit to every axis of a volume
+    DdsFields wide = {};
+    wide.Format    = DXGI_FORMAT_R8_UNORM;
+    wide.Width     = D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+    AR_TEST_CHECK(isDds(MakeDds(wide, D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION)));
+    wide.Width     = D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION + 1;
+    AR_TEST_CHECK(isDds(MakeDds(wide, D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION + 1)) == false);
+
+    const uint32_t volumeLimit = D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION;
+
+    for (uint32_t axis = 0; axis < 3; axis++)
+    {
+        DdsFields volume = {};
+        volume.Format    = DXGI_FORMAT_R8_UNORM;
+        volume.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
+        volume.Depth     = 1;
+
+        uint32_t* pExtent = (axis == 0) ? &volume.Width : ((axis == 1) ? &volume.Height : &volume.Depth);
+
+        *pExtent = volumeLimit;
+        AR_TEST_CHECK(isDds(MakeDds(volume, volumeLimit)));
+        AR_TEST_CHECK((builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) && (builder.GetArraySize() == 1));
+
+        *pExtent = volumeLimit + 1;
+        AR_TEST_CHECK(isDds(MakeDds(volume, volumeLimit + 1)) == false);
+    }
+
+    // Mip counts beyond the full chain of the extent or the D3D12 limit
+    DdsFields mips = {};
+    mips.Width     = 4;
+    mips.Height    = 4;
+    mips.MipCount  = 3;
+    AR_TEST_CHECK(isDds(MakeDds(mips, (16 + 4 + 1) * 4)));
+    mips.MipCount  = 4;
+    AR_TEST_CHECK(isDds(MakeDds(mips, (16 + 4 + 1 + 1) * 4)) == false);
+    mips.Width     = 1u << 20;
+    mips.Height    = 1;
+    mips.MipCount  = D3D12_REQ_MIP_LEVELS + 1;
+    AR_TEST_CHECK(isDds(MakeDds(mips, 0)) == false);
+
+    // Legacy headers: the mip count is read without DDSD_MIPMAPCOUNT, and a zero count means one level
+    DdsFields legacy = {};
+    legacy.Width     = 16;
+    legacy.Height    = 8;
+    legacy.MipCount  = 3;
+    legacy.FourCC    = 0x31545844; // 'DXT1'
+    AR_TEST_CHECK(isDds(MakeDds(legacy, (4 * 2 + 2 * 1 + 1 * 1) * 8)));
+    AR_TEST_CHECK((builder.Format == DXGI_FORMAT_BC1_UNORM) && (builder.MipLevels == 3) &&
+                  (layout.DataOffset == 128) && (layout.DataSize == 88));
+    legacy.MipCount  = 0;
+    AR_TEST_CHECK(isDds(MakeDds(legacy, 4 * 2 * 8)) && (builder.MipLevels == 1));
+
+    DdsFields rgba  = {};
+    rgba.Width      = 4;
+    rgba.Height     = 4;
+    rgba.PixelFlags = 0x00000041; // DDPF_RGB | DDPF_ALPHAPIXELS
+    rgba.FourCC     = 0;
+    rgba.BitCount   = 32;
+    rgba.Masks[0]   = 0x00ff0000;
+    rgba.Masks[1]   = 0x0000ff00;
+    rgba.Masks[2]   = 0x000000ff;
+    rgba.Masks[3]   = 0xff000000;
+    AR_TEST_CHECK(isDds(MakeDds(rgba, 64)) && (builder.Format == DXGI_FORMAT_B8G8R8A8_UNORM));
+    rgba.PixelFlags = 0x00000040;
+    AR_TEST_CHECK(isDds(MakeDds(rgba, 64)) && (builder.Format == DXGI_FORMAT_B8G8R8X8_UNORM));
+    rgba.BitCount   = 24;
+    AR_TEST_CHECK(isDds(MakeDds(rgba, 64)) == false);
+
+    DdsFields partialCube = legacy;
+    partialCube.Caps2     = 0x00000200 | 0x00000400;
+    AR_TEST_CHECK(isDds(MakeDds(partialCube, 6 * 4 * 2 * 8)) == false);
+    partialCube.Caps2     = 0x00000200 | 0x0000fc00;
+    AR_TEST_CHECK(isDds(MakeDds(partialCube, 6 * 4 * 2 * 8)) && (builder.DepthOrArraySize == 6));
+
+    DdsFields legacyVolume = legacy;
+    legacyVolume.Depth     = 4;
+    legacyVolume.Caps2     = 0x00200000;
+    AR_TEST_CHECK(isDds(MakeDds(legacyVolume, 4 * 4 * 2 * 8)) &&
+                  (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) && (builder.DepthOrArraySize == 4));
+
+    // KTX2 2D array with 3 levels: every level stores all layers, and levels are stored smallest first
+    Ktx2Fields ktx = {};
+    ktx.Width      = 8;
+    ktx.Height     = 4;
+    ktx.LayerCount = 2;
+    ktx.LevelCount = 3;
+
+    const std::vector<uint8_t> ktxFile = MakeKtx2(ktx);
+    const uint64_t             index   = 80 + (3 * 24);
+
+    AR_TEST_CHECK(isKtx2(ktxFile));
+    AR_TEST_CHECK((builder.Width == 8) && (builder.Height == 4) && (builder.DepthOrArraySize == 2) &&
+                  (builder.MipLevels == 3) && (builder.Format == DXGI_FORMAT_R8G8B8A8_UNORM));
+    AR_TEST_CHECK((layout.Type == TextureFileType::KTX2) && (layout.DataOffset == index) &&
+                  (layout.DataSize == ktxFile.size() - index));
+    AR_TEST_CHECK((layout.LevelOffsets[2] == index) && (layout.LevelOffsets[1] == index + 16) &&
+                  (layout.LevelOffsets[0] == index + 16 + 64));
+    AR_TEST_CHECK(GetTextureSubresourceData(builder, layout, 4, &data));
+    AR_TEST_CHECK((data.Offset == index + 16 + 32) && (data.RowPitch == 16) && (data.NumRows == 2));
+    AR_TEST_CHECK(ktxFile[static_cast<size_t>(data.Offset)] == 2);
+    AR_TEST_CHECK(FromTextureFile(ktxFile.data(), ktxFile.size(), &builder));
+
+    for (size_t size = 0; size < index; size++)
+    {
+        AR_TEST_CHECK(FromKTX2(ktxFile.data(), size, &builder) == false);
+    }
+
+    AR_TEST_CHECK(FromKTX2(ktxFile.data(), ktxFile.size() - 1, &builder) == false);
+
+    // Level indices pointing past the end, wrapping around, or too short for the level
+    const uint64_t badIndices[][2] =
+    {
+        { ktxFile.size() + 1,   16         },
+        { ktxFile.size() - 8,   16         },
+        { UINT64_MAX - 7,       16         },
+        { index,                UINT64_MAX },
+        { index,                15         },
+    };
+
+    for (const uint64_t(&badIndex)[2] : badIndices)
+    {
+        std::vector<uint8_t> file = ktxFile;
+        WriteValue(&file, 80 + (2 * 24), badIndex[0]);
+        WriteValue(&file, 80 + (2 * 24) + 8, badIndex[1]);
+        AR_TEST_CHECK(isKtx2(file) == false);
+    }
+
+    // Header values the parser cannot lay out
+    Ktx2Fields badKtx       = ktx;
+    badKtx.Supercompression = 1;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(badKtx)) == false);
+    badKtx                  = ktx;
+    badKtx.FaceCount        = 3;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(badKtx)) == false);
+    badKtx                  = ktx;
+    badKtx.VkFormat         = 1000;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(badKtx)) == false);
+    badKtx                  = ktx;
+    badKtx.LevelCount       = 5;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(badKtx)) == false);
+    badKtx                  = ktx;
+    badKtx.Width            = 1u << 16;
+    badKtx.Height           = 1;
+    badKtx.LevelCount       = D3D12_REQ_MIP_LEVELS + 1;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(badKtx)) == false);
+
+    Ktx2Fields volume = {};
+    volume.Width      = 4;
+    volume.Height     = 4;
+    volume.Depth      = D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(volume)) && (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D));
+    volume.Depth      = D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION + 1;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(volume)) == false);
+
+    Ktx2Fields cubeKtx = ktx;
+    cubeKtx.FaceCount  = 6;
+    AR_TEST_CHECK(isKtx2(MakeKtx2(cubeKtx)) && (builder.DepthOrArraySize == 12) && (layout.FaceCount == 6));
+
+    // Directory scans keep only .dds and .ktx2 files, sorted by path, and flag files that fail to parse
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    const fs::path  directory = fs::temp_directory_path(error) /
+                                ("ResourceBuilderTests." + std::to_string(std::random_device()()));
+
+    AR_TEST_CHECK(fs::create_directories(directory / "nested", error));
+
+    const auto writeFile = [&](const fs::path& path, const std::vector<uint8_t>& contents)
+    {
+        FILE* pFile = fopen(path.string().c_str(), "wb");
+        AR_TEST_CHECK((pFile != nullptr) && (fwrite(contents.data(), 1, contents.size(), pFile) == contents.size()));
+
+        if (pFile != nullptr)
+        {
+            fclose(pFile);
+        }
+    };
+
+    writeFile(directory / "a.dds", arrayFile);
+    writeFile(directory / "b.KTX2", ktxFile);
+    writeFile(directory / "c.dds", std::vector<uint8_t>(arrayFile.begin(), arrayFile.begin() + 100));
+    writeFile(directory / "d.txt", arrayFile);
+    writeFile(directory / "nested" / "e.dds", MakeDds(cube, 6 * 2 * 16 * 16 * 4));
+
+    std::vector<TextureFileEntry> entries;
+    AR_TEST_CHECK(ScanTextureDirectory(directory.string().c_str(), false, &entries, 4));
+    AR_TEST_CHECK(entries.size() == 3);
+
+    if (entries.size() == 3)
+    {
+        AR_TEST_CHECK(entries[0].IsValid && (entries[0].Builder.DepthOrArraySize == 2));
+        AR_TEST_CHECK(entries[1].IsValid && (entries[1].Layout.Type == TextureFileType::KTX2));
+        AR_TEST_CHECK(entries[2].IsValid == false);
+    }
+
+    AR_TEST_CHECK(ScanTextureDirectory(directory.string().c_str(), true, &entries, 4));
+    AR_TEST_CHECK((entries.size() == 4) && entries.back().IsValid && (entries.back().Layout.FaceCount == 6));
+    AR_TEST_CHECK(ScanTextureDirectory((directory / "missing").string().c_str(), true, &entries) == false);
+    AR_TEST_CHECK(entries.empty());
+
+    fs::remove_all(directory, error);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Writes a manifest and reads it back from memory and from a file: lookups by name and by hash, names sharing a hash,
+// and rejection of wrong versions, bad checksums and name ranges outside the string block (checked even when the
+// checksum is skipped). Returns the number of failed checks.
+uint32_t TestResourceManifest()
+{
+    uint32_t failures = 0;
+
+    ResourceBuilder albedo;
+    albedo.Texture2D(256, 256, DXGI_FORMAT_BC7_UNORM_SRGB, 1, 9);
+
+    ResourceBuilder shadow;
+    shadow.Texture2D(2048, 2048, DXGI_FORMAT_R32_TYPELESS).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+
+    ResourceBuilder target;
+    target.Texture2D(1920, 1080, DXGI_FORMAT_R16G16B16A16_FLOAT).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+
+    ResourceBuilder buffer;
+    buffer.Buffer(65536);
+
+    ManifestWriter writer;
+    writer.Add("textures/albedo", albedo);
+    writer.Add("shadow", shadow);
+    writer.Add("hdr", target);
+    writer.Add("buffers/instances", buffer);
+
+    std::vector<uint8_t> data;
+    writer.Write(&data);
+
+    ResourceManifest manifest;
+    AR_TEST_CHECK(manifest.OpenMemory(data.data(), data.size()));
+    AR_TEST_CHECK(manifest.GetEntryCount() == 4);
+
+    for (uint32_t i = 1; i < manifest.GetEntryCount(); i++)
+    {
+        AR_TEST_CHECK(manifest.GetEntry(i - 1).NameHash <= manifest.GetEntry(i).NameHash);
+    }
+
+    const ManifestEntry* pAlbedo = manifest.Find("textures/albedo");
+    AR_TEST_CHECK((pAlbedo != nullptr) && (strcmp(manifest.GetName(*pAlbedo), "textures/albedo") == 0));
+    AR_TEST_CHECK((pAlbedo != nullptr) && (memcmp(&pAlbedo->Builder, &albedo, sizeof(albedo)) == 0));
+    AR_TEST_CHECK((pAlbedo != nullptr) && (pAlbedo->Views == ManifestViewShaderResource));
+    AR_TEST_CHECK((pAlbedo != nullptr) && (pAlbedo->ShaderResourceView.Texture2D.MipLevels == 9));
+    AR_TEST_CHECK(manifest.FindHash(HashManifestName("textures/albedo", 15)) == pAlbedo);
+
+    const ManifestEntry* pShadow = manifest.Find("shadow");
+    AR_TEST_CHECK((pShadow != nullptr) &&
+                  (pShadow->Views == (ManifestViewShaderResource | ManifestViewDepthStencil)));
+    AR_TEST_CHECK((pShadow != nullptr) && (pShadow->DepthStencilView.Format == DXGI_FORMAT_D32_FLOAT));
+
+    const ManifestEntry* pTarget = manifest.Find("hdr");
+    AR_TEST_CHECK((pTarget != nullptr) && ((pTarget->Views & ManifestViewColorTarget) != 0));
+
+    const ManifestEntry* pBuffer = manifest.Find("buffers/instances");
+    AR_TEST_CHECK((pBuffer != nullptr) && (pBuffer->ShaderResourceView.Buffer.NumElements == 65536 / 4));
+
+    AR_TEST_CHECK(manifest.Find("missing") == nullptr);
+    AR_TEST_CHECK(manifest.Find("shadow2") == nullptr);
+    AR_TEST_CHECK(manifest.FindHash(HashManifestName("missing", 7)) == nullptr);
+
+    // Files are mapped rather than read
+    std::error_code error;
+    const std::filesystem::path path = std::filesystem::temp_directory_path(error) /
+                                       ("ResourceBuilderTests." + std::to_string(std::random_device()()) + ".armf");
+
+    AR_TEST_CHECK(writer.Write(path.string().c_str()));
+
+    ResourceManifest fileManifest;
+    AR_TEST_CHECK(fileManifest.Open(path.string().c_str()));
+    AR_TEST_CHECK((fileManifest.GetEntryCount() == 4) && (fileManifest.Find("hdr") != nullptr));
+    fileManifest.Close();
+    AR_TEST_CHECK(fileManifest.GetEntryCount() == 0);
+    AR_TEST_CHECK(fileManifest.Open((path.string() + ".missing").c_str()) == false);
+
+    std::filesystem::remove(path, error);
+
+    // Rewrites the checksum of a patched copy
+    const auto reseal = [](std::vector<uint8_t>* pData)
+    {
+        ManifestHeader header;
+        memcpy(&header, pData->data(), sizeof(header));
+        header.Checksum = HashManifestName(reinterpret_cast<const char*>(pData->data() + sizeof(header)),
+                                           pData->size() - sizeof(header));
+        memcpy(pData->data(), &header, sizeof(header));
+    };
+
+    ManifestHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+
+    // Names sharing a hash: Find compares names across the whole run of equal hashes
+    {
+        ManifestWriter pairWriter;
+        pairWriter.Add("a", albedo);
+        pairWriter.Add("b", buffer);
+
+        std::vector<uint8_t> pair;
+        pairWriter.Write(&pair);
+
+        const uint64_t sharedHash = HashManifestName("b", 1);
+        ManifestEntry* pEntries   = reinterpret_cast<ManifestEntry*>(pair.data() + sizeof(ManifestHeader));
+
+        // Restore the writer order for equal hashes (by name): "a", at string offset 0, first
+        pEntries[0].NameHash = sharedHash;
+        pEntries[1].NameHash = sharedHash;
+
+        if (pEntries[0].NameOffset != 0)
+        {
+            std::swap(pEntries[0], pEntries[1]);
+        }
+
+        reseal(&pair);
+
+        ResourceManifest collisions;
+        AR_TEST_CHECK(collisions.OpenMemory(pair.data(), pair.size()));
+
+        const ManifestEntry* pFound = collisions.Find("b");
+        AR_TEST_CHECK((pFound != nullptr) && (strcmp(collisions.GetName(*pFound), "b") == 0));
+        AR_TEST_CHECK((pFound != nullptr) && (pFound->Builder.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER));
+        AR_TEST_CHECK(collisions.FindHash(sharedHash) == &collisions.GetEntry(0));
+        AR_TEST_CHECK(strcmp(collisions.GetName(collisions.GetEntry(0)), "a") == 0);
+        AR_TEST_CHECK(collisions.Find("a") == nullptr);
+    }
+
+    // Wrong version
+    {
+        std::vector<uint8_t> patched = data;
+        reinterpret_cast<ManifestHeader*>(patched.data())->Version = ManifestVersion - 1;
+
+        ResourceManifest rejected;
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size()) == false);
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size(), false) == false);
+    }
+
+    // Bad checksum: rejected unless the checksum is skipped
+    {
+        std::vector<uint8_t> patched = data;
+        reinterpret_cast<ManifestEntry*>(patched.data() + header.EntryOffset)->Builder.Width++;
+
+        ResourceManifest rejected;
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size()) == false);
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size(), false));
+    }
+
+    // Name ranges outside the string block are rejected with or without the checksum
+    for (uint32_t field = 0; field < 2; field++)
+    {
+        std::vector<uint8_t> patched = data;
+        ManifestEntry*       pEntry  = reinterpret_cast<ManifestEntry*>(patched.data() + header.EntryOffset) + 3;
+
+        if (field == 0)
+        {
+            pEntry->NameOffset = header.StringSize;
+        }
+        else
+        {
+            pEntry->NameLength = header.StringSize - pEntry->NameOffset;
+        }
+
+        reseal(&patched);
+
+        ResourceManifest rejected;
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size()) == false);
+        AR_TEST_CHECK(rejected.OpenMemory(patched.data(), patched.size(), false) == false);
+    }
+
+    // Truncated files
+    AR_TEST_CHECK(ResourceManifest().OpenMemory(data.data(), sizeof(ManifestHeader) - 8, false) == false);
+    AR_TEST_CHECK(ResourceManifest().OpenMemory(data.data(), data.size() - 1, false) == false);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Plans tile residency for reserved textures and buffers: tile counts with and without packed mips, regions at the
+// edges of a mip, regions reaching UINT32_MAX, coarser mip selection, de-duplication and region merging. Returns the
+// number of failed checks.
+uint32_t TestResidencyPlanner()
+{
+    uint32_t failures = 0;
+
+    // 1024x1024 RGBA8 uses 128x128 tiles: mips 0-3 take 64 + 16 + 4 + 1 tiles and mips 4-10 pack into one tile
+    ResourceBuilder texture;
+    texture.Texture2D(1024, 1024, DXGI_FORMAT_R8G8B8A8_UNORM, 2, 11);
+
+    const ResidencyPlanner planner(texture);
+    AR_TEST_CHECK((planner.GetTileShape().WidthInTexels == 128) && (planner.GetTileShape().HeightInTexels == 128));
+    AR_TEST_CHECK(planner.GetTileCount() == 2 * 86);
+    AR_TEST_CHECK((planner.GetPackedMipInfo().NumStandardMips == 4) && (planner.GetPackedMipInfo().NumPackedMips == 7));
+    AR_TEST_CHECK(planner.GetPackedMipInfo().NumTilesForPackedMips == 1);
+    AR_TEST_CHECK(planner.GetPackedMipInfo().StartTileIndexInOverallResource == 85);
+    AR_TEST_CHECK(planner.GetSubresourceTiling(1).StartTileIndexInOverallResource == 64);
+    AR_TEST_CHECK(planner.GetSubresourceTiling(11 + 2).StartTileIndexInOverallResource == 86 + 80);
+    AR_TEST_CHECK(planner.GetSubresourceTiling(5).StartTileIndexInOverallResource == D3D12_PACKED_TILE);
+
+    std::vector<ResidentTile> tiles;
+
+    const auto request = [&](uint32_t mip, uint32_t slice, D3D12_BOX region, bool coarser)
+    {
+        tiles.clear();
+        const TileRequest item = { mip, slice, region };
+        return planner.GetTiles(&item, 1, coarser, &tiles);
+    };
+
+    // One texel in the corner of mip 0, alone and with every coarser mip down to the packed tile
+    AR_TEST_CHECK((request(0, 0, { 0, 0, 0, 1, 1, 1 }, false) == 1) && (tiles[0].TileIndex == 0));
+    AR_TEST_CHECK(request(0, 0, { 0, 0, 0, 1, 1, 1 }, true) == 5);
+    AR_TEST_CHECK((tiles.size() == 5) && (tiles[1].TileIndex == 64) && (tiles[2].TileIndex == 80) &&
+                  (tiles[3].TileIndex == 84) && (tiles[4].TileIndex == 85));
+    AR_TEST_CHECK((tiles.size() == 5) && (tiles[4].Coordinate.Subresource == 4));
+
+    // Regions at the far edge of the mip, clamped to it, and reaching UINT32_MAX in every coarser mip
+    AR_TEST_CHECK((request(0, 0, { 1000, 1000, 0, 1024, 1024, 1 }, false) == 1) && (tiles[0].TileIndex == 63));
+    AR_TEST_CHECK((tiles[0].Coordinate.X == 7) && (tiles[0].Coordinate.Y == 7));
+    AR_TEST_CHECK((request(0, 0, { 1000, 1000, 0, 5000, 5000, 1 }, false) == 1) && (tiles[0].TileIndex == 63));
+    AR_TEST_CHECK(request(0, 0, { 1000, 1000, 0, UINT32_MAX, UINT32_MAX, 1 }, true) == 5);
+    AR_TEST_CHECK((tiles.size() == 5) && (tiles[1].TileIndex == 64 + 15) && (tiles[2].TileIndex == 80 + 3));
+
+    // Straddling a tile boundary selects both tiles; an empty box selects the whole mip
+    AR_TEST_CHECK(request(1, 0, { 127, 0, 0, 129, 1, 1 }, false) == 2);
+    AR_TEST_CHECK(request(1, 1, {}, false) == 16);
+    AR_TEST_CHECK((tiles.front().TileIndex == 86 + 64) && (tiles.back().TileIndex == 86 + 79));
+
+    // Packed mips select the packed tiles of their slice; out-of-range requests are ignored
+    AR_TEST_CHECK((request(6, 1, {}, false) == 1) && (tiles[0].TileIndex == 86 + 85));
+    AR_TEST_CHECK((tiles[0].Coordinate.Subresource == 11 + 4) && (tiles[0].Coordinate.X == 0));
+    AR_TEST_CHECK(request(11, 0, {}, false) == 0);
+    AR_TEST_CHECK(request(0, 2, {}, false) == 0);
+
+    // Overlapping requests are de-duplicated, then merged into one region per run of tiles in a subresource
+    const TileRequest overlapping[] =
+    {
+        { 1, 0, { 0, 0, 0, 256, 128, 1 } },
+        { 1, 0, { 128, 0, 0, 512, 128, 1 } },
+        { 0, 0, { 0, 0, 0, 1, 1, 1 } },
+        { 2, 0, {} },
+    };
+
+    tiles.clear();
+    AR_TEST_CHECK(planner.GetTiles(overlapping, 4, false, &tiles) == 9);
+
+    for (size_t i = 1; i < tiles.size(); i++)
+    {
+        AR_TEST_CHECK(tiles[i - 1].TileIndex < tiles[i].TileIndex);
+    }
+
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE> coordinates;
+    std::vector<D3D12_TILE_REGION_SIZE>          sizes;
+    AR_TEST_CHECK(ResidencyPlanner::BuildTileRegions(tiles.data(), uint32_t(tiles.size()), &coordinates, &sizes) == 3);
+    AR_TEST_CHECK((sizes.size() == 3) && (sizes[0].NumTiles == 1) && (sizes[1].NumTiles == 4) &&
+                  (sizes[2].NumTiles == 4));
+    AR_TEST_CHECK((coordinates.size() == 3) && (coordinates[1].Subresource == 1) && (coordinates[2].Subresource == 2));
+
+    // Without packed mips every mip has its own tiles
+    ResourceBuilder unpacked;
+    unpacked.Texture2D(512, 256, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 2);
+
+    const ResidencyPlanner unpackedPlanner(unpacked);
+    AR_TEST_CHECK((unpackedPlanner.GetTileCount() == 8 + 2) && (unpackedPlanner.GetPackedMipInfo().NumPackedMips == 0));
+
+    tiles.clear();
+    const TileRequest corner = { 0, 0, { 511, 255, 0, 512, 256, 1 } };
+    AR_TEST_CHECK(unpackedPlanner.GetTiles(&corner, 1, true, &tiles) == 2);
+    AR_TEST_CHECK((tiles.size() == 2) && (tiles[0].TileIndex == 7) && (tiles[1].TileIndex == 9));
+
+    // 3D textures tile in depth too (32x32x16 texel tiles for RGBA8)
+    ResourceBuilder volume;
+    volume.Texture3D(64, 64, 32, DXGI_FORMAT_R8G8B8A8_UNORM);
+
+    const ResidencyPlanner volumePlanner(volume);
+    AR_TEST_CHECK(volumePlanner.GetTileShape().DepthInTexels == 16);
+    AR_TEST_CHECK(volumePlanner.GetTileCount() == 8);
+
+    tiles.clear();
+    const TileRequest slab = { 0, 0, { 32, 0, 16, 64, 32, 32 } };
+    AR_TEST_CHECK((volumePlanner.GetTiles(&slab, 1, false, &tiles) == 1) && (tiles[0].TileIndex == 5));
+
+    // Buffers tile in 64KB ranges; formats without a standard tile shape cannot be planned
+    ResourceBuilder buffer;
+    buffer.Buffer(4 * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+
+    const ResidencyPlanner bufferPlanner(buffer);
+    AR_TEST_CHECK(bufferPlanner.GetTileCount() == 4);
+
+    tiles.clear();
+    const TileRequest range = { 0, 0, { 65535, 0, 0, 65537, 1, 1 } };
+    AR_TEST_CHECK(bufferPlanner.GetTiles(&range, 1, false, &tiles) == 2);
+
+    ResourceBuilder line;
+    line.Texture1D(4096, DXGI_FORMAT_R8G8B8A8_UNORM);
+
+    const ResidencyPlanner linePlanner(line);
+    tiles.clear();
+    AR_TEST_CHECK((linePlanner.GetTileCount() == 0) && (linePlanner.GetTiles(&corner, 1, true, &tiles) == 0));
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Mock resource for the resource cache tests: it can report no heap, as reserved resources do, and refuse private data
+// interfaces. Tracks whether an interface is attached (the tests use one cache per resource).
+class CacheMockResource final : public MockResource
+{
+public:
+    CacheMockResource(
+        const ResourceBuilder& builder, bool reserved = false, bool refuseInterfaces = false) :
+        MockResource(builder, builder.GetHeapProperties()),
+        m_reserved(reserved),
+        m_refuseInterfaces(refuseInterfaces),
+        m_hasInterface(false)
+    {
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override
+    {
+        if (m_refuseInterfaces && (pData != nullptr))
+        {
+            return E_FAIL;
+        }
+
+        m_hasInterface = (pData != nullptr);
+        return MockResource::SetPrivateDataInterface(guid, pData);
+    }
+
+    HRESULT STDMETHODCALLTYPE GetHeapProperties(
+        D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags) override
+    {
+        return m_reserved ? E_INVALIDARG : MockResource::GetHeapProperties(pHeapProperties, pHeapFlags);
+    }
+
+    /// Returns true when a private data interface is attached
+    bool HasInterface() const { return m_hasInterface; }
+
+private:
+    bool m_reserved;         ///< GetHeapProperties fails
+    bool m_refuseInterfaces; ///< SetPrivateDataInterface fails for non-null interfaces
+    bool m_hasInterface;     ///< An interface is attached
+};
+
+//=====================================================================================================================
+// Exercises the resource cache: hit and miss counts, Invalidate detaching the release token, entries dropped when
+// their resource is destroyed, resources without heaps or refusing the token, a full table returning builders
+// uncached, Compact, and a cache destroyed before its resources. Returns the number of failed checks.
+uint32_t TestResourceCache()
+{
+    uint32_t failures = 0;
+
+    ResourceBuilder texture;
+    texture.Texture2D(512, 256, DXGI_FORMAT_R16G16B16A16_FLOAT, 2, 10).SetHeapType(D3D12_HEAP_TYPE_UPLOAD);
+
+    const auto matches = [&](const ResourceBuilder& builder)
+    {
+        return (builder.Width == texture.Width) && (builder.Height == texture.Height) &&
+               (builder.DepthOrArraySize == texture.DepthOrArraySize) && (builder.MipLevels == texture.MipLevels) &&
+               (builder.Format == texture.Format) && (builder.GetHeapProperties().Type == D3D12_HEAP_TYPE_UPLOAD);
+    };
+
+    {
+        ResourceCache   cache(16);
+        ResourceBuilder found;
+
+        // Null resources are neither looked up nor cached
+        AR_TEST_CHECK(cache.Get(nullptr).Width == 0);
+        AR_TEST_CHECK((cache.GetHitCount() == 0) && (cache.GetMissCount() == 0));
+
+        // The first Get misses and attaches a release token, later lookups hit
+        CacheMockResource* pTexture = new CacheMockResource(texture);
+        AR_TEST_CHECK(matches(cache.Get(pTexture)));
+        AR_TEST_CHECK((cache.GetHitCount() == 0) && (cache.GetMissCount() == 1));
+        AR_TEST_CHECK(cache.GetSize() == 1);
+        AR_TEST_CHECK(pTexture->HasInterface());
+        AR_TEST_CHECK(matches(cache.Get(pTexture)));
+        AR_TEST_CHECK(cache.Find(pTexture, &found) && matches(found));
+        AR_TEST_CHECK((cache.GetHitCount() == 2) && (cache.GetMissCount() == 1));
+
+        // Invalidate drops the entry and detaches the token; the next Get queries the resource again
+        cache.Invalidate(pTexture);
+        AR_TEST_CHECK(cache.GetSize() == 0);
+        AR_TEST_CHECK(pTexture->HasInterface() == false);
+        AR_TEST_CHECK(cache.Find(pTexture, &found) == false);
+        AR_TEST_CHECK(matches(cache.Get(pTexture)));
+        AR_TEST_CHECK((cache.GetSize() == 1) && pTexture->HasInterface());
+        AR_TEST_CHECK((cache.GetHitCount() == 2) && (cache.GetMissCount() == 3));
+
+        // Destroying the resource releases the token, which drops the entry
+        pTexture->Release();
+        AR_TEST_CHECK(cache.GetSize() == 0);
+        AR_TEST_CHECK(cache.Find(pTexture, &found) == false);
+
+        // Resources without a heap are cached with cleared heap properties
+        CacheMockResource* pReserved = new CacheMockResource(texture, true);
+        const ResourceBuilder reserved = cache.Get(pReserved);
+        AR_TEST_CHECK((reserved.Width == texture.Width) && (reserved.GetHeapProperties().Type == 0));
+        AR_TEST_CHECK(reserved.GetHeapFlags() == D3D12_HEAP_FLAG_NONE);
+        AR_TEST_CHECK(cache.GetSize() == 1);
+        pReserved->Release();
+        AR_TEST_CHECK(cache.GetSize() == 0);
+
+        // A resource refusing the token still returns its builder but is never cached
+        CacheMockResource* pRefusing = new CacheMockResource(texture, false, true);
+        AR_TEST_CHECK(matches(cache.Get(pRefusing)));
+        AR_TEST_CHECK(matches(cache.Get(pRefusing)));
+        AR_TEST_CHECK(cache.GetSize() == 0);
+        AR_TEST_CHECK(cache.Find(pRefusing, &found) == false);
+        pRefusing->Release();
+    }
+
+    {
+        // A 16-slot table holds 12 entries; further resources are returned uncached and cached ones still hit
+        ResourceCache                   cache(16);
+        ResourceBuilder                 found;
+        std::vector<CacheMockResource*> resources;
+
+        for (uint32_t i = 0; i < 13; i++)
+        {
+            resources.push_back(new CacheMockResource(texture));
+        }
+
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            AR_TEST_CHECK(matches(cache.Get(resources[i])));
+        }
+
+        AR_TEST_CHECK(cache.GetSize() == 12);
+        AR_TEST_CHECK(matches(cache.Get(resources[12])));
+        AR_TEST_CHECK(cache.GetSize() == 12);
+        AR_TEST_CHECK(resources[12]->HasInterface() == false);
+        AR_TEST_CHECK(cache.Find(resources[12], &found) == false);
+
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            AR_TEST_CHECK(cache.Find(resources[i], &found) && matches(found));
+        }
+
+        // Invalidated slots stay used until Compact reclaims them
+        cache.Invalidate(resources[0]);
+        cache.Get(resources[12]);
+        AR_TEST_CHECK(cache.Find(resources[12], &found) == false);
+
+        cache.Compact();
+        AR_TEST_CHECK(matches(cache.Get(resources[12])));
+        AR_TEST_CHECK(cache.Find(resources[12], &found));
+        AR_TEST_CHECK(cache.GetSize() == 12);
+
+        for (uint32_t i = 1; i < 13; i++)
+        {
+            AR_TEST_CHECK(cache.Find(resources[i], &found) && matches(found));
+        }
+
+        resources[0]->Release();
+        resources.erase(resources.begin());
+
+        // Resources outliving the cache keep their tokens, which no longer reach the destroyed cache
+        {
+            ResourceCache other;
+            AR_TEST_CHECK(matches(other.Get(resources[0])));
+        }
+
+        for (CacheMockResource* pResource : resources)
+        {
+            pResource->Release();
+        }
+
+        AR_TEST_CHECK(cache.GetSize() == 0);
+    }
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Exercises the view cache: keys ignore unused union members, threads racing to insert the same keys all get the
+// first inserted descriptor, invalidation tombstones are reclaimed by Compact, and a full table refuses inserts while
+// still returning cached keys. Returns the number of failed checks.
+uint32_t TestViewCache()
+{
+    uint32_t failures = 0;
+
+    ResourceBuilder texture;
+    texture.Texture2D(256, 256, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 9);
+
+    // Bytes of other union members never reach the key
+    D3D12_SHADER_RESOURCE_VIEW_DESC noisy;
+    memset(&noisy, 0xab, sizeof(noisy));
+    noisy.Format                  = DXGI_FORMAT_R8G8B8A8_UNORM;
+    noisy.ViewDimension           = D3D12_SRV_DIMENSION_TEXTURE2D;
+    noisy.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    noisy.Texture2D               = texture.AsShaderResourceView().Texture2D;
+
+    const ViewKey srvKey   = MakeViewKey(1, texture.AsShaderResourceView());
+    const ViewKey noisyKey = MakeViewKey(1, noisy);
+    AR_TEST_CHECK(memcmp(&noisyKey, &srvKey, sizeof(ViewKey)) == 0);
+    AR_TEST_CHECK(HashViewKey(noisyKey) == HashViewKey(srvKey));
+    AR_TEST_CHECK(HashViewKey(MakeViewKey(1, texture.AsShaderResourceView(DXGI_FORMAT_UNKNOWN, 1))) !=
+                  HashViewKey(srvKey));
+    AR_TEST_CHECK(HashViewKey(MakeViewKey(2, texture.AsShaderResourceView())) != HashViewKey(srvKey));
+    AR_TEST_CHECK(HashViewKey(MakeViewKey(1, texture.AsUnorderedAccessView())) != HashViewKey(srvKey));
+
+    // Threads race to insert the same keys; exactly one insert wins per key and every thread sees its descriptor
+    constexpr uint32_t ThreadCount = 8;
+    constexpr uint32_t KeyCount    = 2000;
+
+    ViewCache                          cache(4096);
+    std::vector<std::vector<uint64_t>> seen(ThreadCount, std::vector<uint64_t>(KeyCount));
+    std::vector<std::atomic<uint32_t>> inserts(KeyCount);
+    std::vector<std::thread>           threads;
+
+    for (uint32_t t = 0; t < ThreadCount; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (uint32_t i = 0; i < KeyCount; i++)
+            {
+                // Threads walk the keys from different starting points so finds and inserts interleave
+                const uint32_t k   = (i + t * (KeyCount / ThreadCount)) % KeyCount;
+                const ViewKey  key = MakeViewKey(k, texture.AsShaderResourceView(DXGI_FORMAT_UNKNOWN, k % 9));
+
+                uint64_t descriptor = 0;
+
+                if (cache.Find(key, &descriptor) == false)
+                {
+                    bool inserted = false;
+                    descriptor    = cache.FindOrInsert(key, (uint64_t(t) << 32) | k, &inserted);
+
+                    if (inserted)
+                    {
+                        inserts[k].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                seen[t][k] = descriptor;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (uint32_t k = 0; k < KeyCount; k++)
+    {
+        AR_TEST_CHECK(inserts[k].load() == 1);
+        AR_TEST_CHECK((seen[0][k] & 0xffffffff) == k);
+
+        for (uint32_t t = 1; t < ThreadCount; t++)
+        {
+            AR_TEST_CHECK(seen[t][k] == seen[0][k]);
+        }
+    }
+
+    AR_TEST_CHECK(cache.GetSize() == KeyCount);
+    AR_TEST_CHECK(cache.GetHitCount() + cache.GetMissCount() == uint64_t(ThreadCount) * KeyCount);
+    AR_TEST_CHECK(cache.GetMissCount() >= KeyCount);
+
+    // Invalidation releases every view of the resource and leaves the others
+    std::vector<uint64_t> released;
+    const ViewKey         key5 = MakeViewKey(5, texture.AsShaderResourceView(DXGI_FORMAT_UNKNOWN, 5));
+    uint64_t              descriptor = 0;
+
+    AR_TEST_CHECK((cache.Invalidate(5, &released) == 1) && (released.size() == 1) && (released[0] == seen[0][5]));
+    AR_TEST_CHECK(cache.Find(key5, &descriptor) == false);
+    AR_TEST_CHECK(cache.Find(MakeViewKey(6, texture.AsShaderResourceView(DXGI_FORMAT_UNKNOWN, 6)), &descriptor));
+    AR_TEST_CHECK((descriptor == seen[0][6]) && (cache.GetSize() == KeyCount - 1));
+    AR_TEST_CHECK(cache.Invalidate(5) == 0);
+
+    // A full table refuses new keys but still returns cached ones; Compact reclaims the tombstones
+    ViewCache small(16);
+    bool      inserted = false;
+
+    for (uint32_t k = 0; k < 12; k++)
+    {
+        AR_TEST_CHECK(small.FindOrInsert(MakeViewKey(k, texture.AsShaderResourceView()), k, &inserted) == k);
+        AR_TEST_CHECK(inserted);
+    }
+
+    const ViewKey extra = MakeViewKey(100, texture.AsShaderResourceView());
+    AR_TEST_CHECK(small.FindOrInsert(extra, 100, &inserted) == UINT64_MAX);
+    AR_TEST_CHECK(inserted == false);
+    AR_TEST_CHECK(small.FindOrInsert(MakeViewKey(3, texture.AsShaderResourceView()), 300, &inserted) == 3);
+    AR_TEST_CHECK((inserted == false) && (small.GetSize() == 12));
+
+    AR_TEST_CHECK(small.Invalidate(3) == 1);
+    AR_TEST_CHECK(small.FindOrInsert(extra, 100) == UINT64_MAX);
+
+    small.Compact();
+    AR_TEST_CHECK(small.GetSize() == 11);
+    AR_TEST_CHECK((small.FindOrInsert(extra, 100, &inserted) == 100) && inserted);
+    AR_TEST_CHECK(small.Find(MakeViewKey(11, texture.AsShaderResourceView()), &descriptor) && (descriptor == 11));
+    AR_TEST_CHECK(small.Find(MakeViewKey(3, texture.AsShaderResourceView()), &descriptor) == false);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Instruction sets compared against the scalar kernels by the conversion, compression and mip tests
+constexpr ConvertIsa  SimdIsas[]     = { ConvertIsa::Sse41, ConvertIsa::Avx2 };
+constexpr const char* SimdIsaNames[] = { "sse41", "avx2" };
+
+//=====================================================================================================================
+// Converts rows of texels between two formats with ConvertRows, returning the destination texels
+std::vector<uint8_t> ConvertTexels(
+    DXGI_FORMAT srcFormat, const void* pSrc, DXGI_FORMAT dstFormat, uint32_t width, ConvertIsa isa = ConvertIsa::Auto)
+{
+    std::vector<uint8_t> result(size_t(width) * GetBytesPerBlock(dstFormat), 0xcd);
+
+    if (ConvertRows(srcFormat, pSrc, uint64_t(width) * GetBytesPerBlock(srcFormat), dstFormat, result.data(),
+                    result.size(), width, 1, isa) == false)
+    {
+        result.clear();
+    }
+
+    return result;
+}
+
+//=====================================================================================================================
+// Returns the PSNR in dB of the leading channels of a block compressed subresource, decoded with BlockDecoder, against
+// its square RGBA8 source
+double GetCompressionPsnr(
+    DXGI_FORMAT                 format,
+    uint32_t                    channelCount,
+    const std::vector<uint8_t>& source,
+    uint32_t                    size,
+    const uint8_t*              pData,
+    uint64_t                    rowPitch)
+{
+    const uint32_t blockBytes   = GetBytesPerBlock(format);
+    double         squaredError = 0.0;
+
+    for (uint32_t by = 0; by < size / 4; by++)
+    {
+        for (uint32_t bx = 0; bx < size / 4; bx++)
+        {
+            uint8_t texels[64];
+            BlockDecoder::Decode(format, pData + (rowPitch * by) + (bx * blockBytes), texels);
+
+            for (uint32_t t = 0; t < 16; t++)
+            {
+                const uint8_t* pSource = source.data() + ((((size_t(by) * 4) + (t / 4)) * size) + (bx * 4) +
+                                                          (t % 4)) * 4;
+
+                for (uint32_t c = 0; c < channelCount; c++)
+                {
+                    const double diff = double(texels[(t * 4) + c]) - double(pSource[c]);
+                    squaredError     += diff * diff;
+                }
+            }
+        }
+    }
+
+    const double meanError = squaredError / (double(size) * size * channelCount);
+    return (meanError > 0.0) ? (10.0 * std::log10(255.0 * 255.0 / meanError)) : 99.0;
+}
+
+//=====================================================================================================================
+// Checks the block compressor: every format decodes above its PSNR floor on a synthetic texture, the SSE4.1 index
+// selection writes the same blocks as the scalar kernels (whole textures and random or degenerate blocks), BC1 keeps
+// punch-through alpha, partial edge blocks repeat the last row and column, sRGB formats encode their sources, and
+// unsupported formats are rejected without writing. Returns the number of failed checks.
+uint32_t TestBlockCompress()
+{
+    uint32_t failures = 0;
+
+    const bool hasSse41 = (GetSupportedConvertIsa() >= ConvertIsa::Sse41);
+
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC1_UNORM_SRGB));
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC3_UNORM));
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC5_UNORM));
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC7_TYPELESS));
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC2_UNORM) == false);
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC4_SNORM) == false);
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_BC6H_UF16) == false);
+    AR_TEST_CHECK(IsBlockCompressionSupported(DXGI_FORMAT_R8G8B8A8_UNORM) == false);
+
+    // Decoded quality floors (0.2 to 0.3 dB below the measured PSNR) on a 1024x1024 texture-like source
+    struct QualityCase
+    {
+        DXGI_FORMAT Format;
+        uint32_t    ChannelCount;
+        bool        Opaque;
+        double      MinPsnr;
+    };
+
+    constexpr uint32_t    Size           = 1024;
+    constexpr QualityCase QualityCases[] =
+    {
+        { DXGI_FORMAT_BC1_UNORM, 3, true,  39.5 },
+        { DXGI_FORMAT_BC3_UNORM, 4, false, 40.7 },
+        { DXGI_FORMAT_BC4_UNORM, 1, false, 54.3 },
+        { DXGI_FORMAT_BC5_UNORM, 2, false, 54.4 },
+        { DXGI_FORMAT_BC7_UNORM, 4, false, 42.5 },
+    };
+
+    for (const QualityCase& qualityCase : QualityCases)
+    {
+        ResourceBuilder builder;
+        builder.Texture2D(Size, Size, qualityCase.Format);
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout     = {};
+        uint64_t                           totalBytes = 0;
+        builder.GetCopyableFootprints(0, 1, 0, &layout, nullptr, nullptr, &totalBytes);
+
+        std::vector<uint8_t> source;
+        FillCompressSource(&source, Size, qualityCase.Opaque);
+
+        const ConvertSource compressSource = { source.data(), DXGI_FORMAT_R8G8B8A8_UNORM, Size * 4,
+                                               uint64_t(Size) * Size * 4 };
+
+        std::vector<uint8_t> expected(static_cast<size_t>(totalBytes));
+        AR_TEST_CHECK(CompressSubresources(builder, 0, 1, 0, &compressSource, expected.data(), 0,
+                                           ConvertIsa::Scalar));
+
+        const double psnr = GetCompressionPsnr(qualityCase.Format, qualityCase.ChannelCount, source, Size,
+                                               expected.data(), layout.Footprint.RowPitch);
+        AR_TEST_CHECK(psnr >= qualityCase.MinPsnr);
+
+        if (hasSse41)
+        {
+            std::vector<uint8_t> result(expected.size(), 0xcd);
+            CompressSubresources(builder, 0, 1, 0, &compressSource, result.data(), 1, ConvertIsa::Sse41);
+            AR_TEST_CHECK(result == expected);
+        }
+    }
+
+    // Random, flat, two-color, gradient and punch-through blocks compress identically with every kernel
+    constexpr DXGI_FORMAT BlockFormats[] =
+    {
+        DXGI_FORMAT_BC1_UNORM, DXGI_FORMAT_BC3_UNORM, DXGI_FORMAT_BC4_UNORM, DXGI_FORMAT_BC5_UNORM,
+        DXGI_FORMAT_BC7_UNORM,
+    };
+
+    std::mt19937 random(11);
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        const uint32_t kind = i % 5;
+        uint8_t        texels[64];
+        uint8_t        colors[2][4];
+
+        for (uint32_t c = 0; c < 8; c++)
+        {
+            colors[c / 4][c % 4] = static_cast<uint8_t>(random());
+        }
+
+        for (uint32_t t = 0; t < 16; t++)
+        {
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                texels[(t * 4) + c] =
+                    (kind == 0) ? static_cast<uint8_t>(random()) :
+                    (kind == 1) ? colors[0][c] :
+                    (kind == 2) ? colors[random() % 2][c] :
+                    (kind == 3) ? static_cast<uint8_t>(((colors[0][c] * (15 - t)) + (colors[1][c] * t)) / 15) :
+                    ((c == 3) ? static_cast<uint8_t>(((t % 3) == 0) ? 0 : 255) : static_cast<uint8_t>(random()));
+            }
+        }
+
+        for (DXGI_FORMAT format : BlockFormats)
+        {
+            uint8_t expected[16] = {};
+            uint8_t result[16]   = {};
+
+            AR_TEST_CHECK(CompressBlock(format, texels, expected, ConvertIsa::Scalar));
+
+            if (hasSse41)
+            {
+                CompressBlock(format, texels, result, ConvertIsa::Sse41);
+                AR_TEST_CHECK(memcmp(result, expected, GetBytesPerBlock(format)) == 0);
+            }
+        }
+    }
+
+    // BC1 texels with alpha below 128 decode as transparent black; flat representable values decode exactly
+    uint8_t texels[64];
+    uint8_t block[16];
+    uint8_t decoded[64];
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        texels[(t * 4) + 0] = 255;
+        texels[(t * 4) + 1] = 0;
+        texels[(t * 4) + 2] = 255;
+        texels[(t * 4) + 3] = ((t % 3) == 0) ? 100 : 200;
+    }
+
+    AR_TEST_CHECK(CompressBlock(DXGI_FORMAT_BC1_UNORM, texels, block));
+    BlockDecoder::Decode(DXGI_FORMAT_BC1_UNORM, block, decoded);
+
+    for (uint32_t t = 0; t < 16; t++)
+    {
+        const bool     transparent = ((t % 3) == 0);
+        const uint8_t* pTexel      = decoded + (t * 4);
+
+        AR_TEST_CHECK(transparent ? ((pTexel[0] == 0) && (pTexel[2] == 0) && (pTexel[3] == 0)) :
+                                    ((pTexel[0] == 255) && (pTexel[1] == 0) && (pTexel[2] == 255) &&
+                                     (pTexel[3] == 255)));
+    }
+
+    AR_TEST_CHECK(CompressBlock(DXGI_FORMAT_BC5_UNORM, texels, block));
+    BlockDecoder::Decode(DXGI_FORMAT_BC5_UNORM, block, decoded);
+    AR_TEST_CHECK((decoded[0] == 255) && (decoded[1] == 0) && (decoded[60] == 255) && (decoded[61] == 0));
+
+    AR_TEST_CHECK(CompressBlock(DXGI_FORMAT_BC2_UNORM, texels, block) == false);
+
+    // Blocks past the edge of a 37x21 texture repeat its last column and row
+    ResourceBuilder edge;
+    edge.Texture2D(37, 21, DXGI_FORMAT_BC7_UNORM);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT edgeLayout = {};
+    uint64_t                           edgeBytes  = 0;
+    edge.GetCopyableFootprints(0, 1, 0, &edgeLayout, nullptr, nullptr, &edgeBytes);
+
+    std::vector<uint8_t> edgeSource(37 * 21 * 4);
+    FillConvertSource(DXGI_FORMAT_R8G8B8A8_UNORM, &edgeSource, 37);
+
+    const ConvertSource  edgeConvert = { edgeSource.data(), DXGI_FORMAT_R8G8B8A8_UNORM, 37 * 4, 37 * 21 * 4 };
+    std::vector<uint8_t> edgeData(static_cast<size_t>(edgeBytes), 0xcd);
+    AR_TEST_CHECK(CompressSubresources(edge, 0, 1, 0, &edgeConvert, edgeData.data()));
+
+    for (uint32_t by = 0; by < 6; by++)
+    {
+        for (uint32_t bx = 0; bx < 10; bx++)
+        {
+            for (uint32_t t = 0; t < 16; t++)
+            {
+                const uint32_t x = std::min((bx * 4) + (t % 4), 36u);
+                const uint32_t y = std::min((by * 4) + (t / 4), 20u);
+                memcpy(texels + (t * 4), edgeSource.data() + (((y * 37) + x) * 4), 4);
+            }
+
+            AR_TEST_CHECK(CompressBlock(DXGI_FORMAT_BC7_UNORM, texels, block));
+            AR_TEST_CHECK(memcmp(edgeData.data() + (edgeLayout.Footprint.RowPitch * by) + (bx * 16), block, 16) == 0);
+        }
+    }
+
+    // sRGB formats compress sRGB encoded texels: an sRGB source matches a UNORM source into a UNORM format, and a
+    // linear float source is encoded first
+    ResourceBuilder srgb;
+    srgb.Texture2D(37, 21, DXGI_FORMAT_BC7_UNORM_SRGB);
+
+    std::vector<uint8_t> srgbData(edgeData.size(), 0xcd);
+    const ConvertSource  srgbConvert = { edgeSource.data(), DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 37 * 4, 37 * 21 * 4 };
+    AR_TEST_CHECK(CompressSubresources(srgb, 0, 1, 0, &srgbConvert, srgbData.data()));
+    AR_TEST_CHECK(srgbData == edgeData);
+
+    const std::vector<uint8_t> linear = ConvertTexels(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, edgeSource.data(),
+                                                      DXGI_FORMAT_R32G32B32A32_FLOAT, 37 * 21);
+    const ConvertSource        linearConvert = { linear.data(), DXGI_FORMAT_R32G32B32A32_FLOAT, 37 * 16, 37 * 21 * 16 };
+
+    std::fill(srgbData.begin(), srgbData.end(), uint8_t(0xcd));
+    AR_TEST_CHECK(CompressSubresources(srgb, 0, 1, 0, &linearConvert, srgbData.data()));
+    AR_TEST_CHECK(srgbData == edgeData);
+
+    // Unsupported builder and source formats are rejected without writing
+    const ConvertSource  packedConvert = { edgeSource.data(), DXGI_FORMAT_R11G11B10_FLOAT, 37 * 4, 37 * 21 * 4 };
+    std::vector<uint8_t> untouched(edgeData.size(), 0xcd);
+
+    srgbData = untouched;
+    AR_TEST_CHECK(CompressSubresources(ResourceBuilder().Texture2D(37, 21, DXGI_FORMAT_BC2_UNORM), 0, 1, 0,
+                                       &edgeConvert, srgbData.data()) == false);
+    AR_TEST_CHECK(CompressSubresources(edge, 0, 1, 0, &packedConvert, srgbData.data()) == false);
+    AR_TEST_CHECK(srgbData == untouched);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks the texel format conversions: every SIMD kernel the CPU supports writes the same bits as the scalar kernels
+// for every format pair and row tail, 8-bit and half values survive round trips through the float formats, half,
+// R11G11B10_FLOAT, R10G10B10A2_UNORM and sRGB encoding round and saturate at the range edges, and
+// ConvertSubresources writes every subresource at its upload footprint. Returns the number of failed checks.
+uint32_t TestFormatConvert()
+{
+    uint32_t failures = 0;
+
+    const ConvertIsa supported = GetSupportedConvertIsa();
+
+    // SIMD kernels match the scalar kernels bit for bit, over whole vectors and every tail length
+    constexpr DXGI_FORMAT Formats[] =
+    {
+        DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DXGI_FORMAT_B8G8R8A8_UNORM,
+        DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, DXGI_FORMAT_B8G8R8X8_UNORM, DXGI_FORMAT_B8G8R8X8_UNORM_SRGB,
+        DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT,
+        DXGI_FORMAT_R11G11B10_FLOAT, DXGI_FORMAT_R10G10B10A2_UNORM,
+    };
+
+    constexpr uint32_t Widths[] = { 1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 31, 600, 1029 };
+    constexpr uint32_t Rows     = 3;
+
+    for (DXGI_FORMAT srcFormat : Formats)
+    {
+        for (DXGI_FORMAT dstFormat : Formats)
+        {
+            // Only the packed float and 10-bit formats are destination-only
+            const bool isDestinationOnly = (srcFormat == DXGI_FORMAT_R11G11B10_FLOAT) ||
+                                           (srcFormat == DXGI_FORMAT_R10G10B10A2_UNORM);
+
+            AR_TEST_CHECK(IsConversionSupported(srcFormat, dstFormat) != isDestinationOnly);
+
+            if (isDestinationOnly)
+            {
+                continue;
+            }
+
+            const uint32_t srcSize = GetBytesPerBlock(srcFormat);
+            const uint32_t dstSize = GetBytesPerBlock(dstFormat);
+
+            for (uint32_t width : Widths)
+            {
+                std::vector<uint8_t> source(size_t(width) * srcSize * Rows);
+                std::vector<uint8_t> expected(size_t(width) * dstSize * Rows);
+                std::vector<uint8_t> result(expected.size());
+
+                FillConvertSource(srcFormat, &source, width);
+                AR_TEST_CHECK(ConvertRows(srcFormat, source.data(), width * srcSize, dstFormat, expected.data(),
+                                          width * dstSize, width, Rows, ConvertIsa::Scalar));
+
+                for (uint32_t i = 0; i < sizeof(SimdIsas) / sizeof(SimdIsas[0]); i++)
+                {
+                    if (SimdIsas[i] > supported)
+                    {
+                        continue;
+                    }
+
+                    std::fill(result.begin(), result.end(), uint8_t(0xcd));
+                    ConvertRows(srcFormat, source.data(), width * srcSize, dstFormat, result.data(), width * dstSize,
+                                width, Rows, SimdIsas[i]);
+
+                    const bool matches = (result == expected);
+
+                    if (matches == false)
+                    {
+                        fprintf(stderr, "conversion mismatch: format %u to %u, %s, width %u\n", srcFormat, dstFormat,
+                                SimdIsaNames[i], width);
+                    }
+
+                    AR_TEST_CHECK(matches);
+                }
+            }
+        }
+    }
+
+    // Every 8-bit value survives a round trip through the float formats, in UNORM and sRGB encodings
+    std::vector<uint8_t> bytes(256 * 4);
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        bytes[(i * 4) + 0] = static_cast<uint8_t>(i);
+        bytes[(i * 4) + 1] = static_cast<uint8_t>(255 - i);
+        bytes[(i * 4) + 2] = static_cast<uint8_t>(i * 7);
+        bytes[(i * 4) + 3] = static_cast<uint8_t>(i * 13);
+    }
+
+    for (DXGI_FORMAT format : { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+                                DXGI_FORMAT_B8G8R8A8_UNORM_SRGB })
+    {
+        for (DXGI_FORMAT floatFormat : { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT })
+        {
+            const std::vector<uint8_t> floats = ConvertTexels(format, bytes.data(), floatFormat, 256);
+            AR_TEST_CHECK(ConvertTexels(floatFormat, floats.data(), format, 256) == bytes);
+        }
+    }
+
+    // UNORM and sRGB bytes swizzle without a float round trip; X8 formats read and write an opaque alpha
+    const std::vector<uint8_t> bgra = ConvertTexels(DXGI_FORMAT_R8G8B8A8_UNORM, bytes.data(),
+                                                    DXGI_FORMAT_B8G8R8A8_UNORM, 256);
+    const std::vector<uint8_t> bgrx = ConvertTexels(DXGI_FORMAT_R8G8B8A8_UNORM, bytes.data(),
+                                                    DXGI_FORMAT_B8G8R8X8_UNORM, 256);
+    const std::vector<uint8_t> rgbx = ConvertTexels(DXGI_FORMAT_B8G8R8X8_UNORM, bytes.data(),
+                                                    DXGI_FORMAT_R8G8B8A8_UNORM, 256);
+
+    AR_TEST_CHECK((bgra[0x2a * 4] == bytes[(0x2a * 4) + 2]) && (bgra[(0x2a * 4) + 2] == 0x2a));
+    AR_TEST_CHECK(ConvertTexels(DXGI_FORMAT_B8G8R8A8_UNORM, bgra.data(), DXGI_FORMAT_R8G8B8A8_UNORM, 256) == bytes);
+    AR_TEST_CHECK((bgrx[(0x2a * 4) + 3] == 255) && (rgbx[(0x2a * 4) + 3] == 255) && (rgbx[(0x2a * 4) + 2] == 0x2a));
+
+    // Every half except NaN survives a round trip through RGBA32F (NaNs stay NaN but may change payload)
+    std::vector<uint16_t> halves(65536);
+
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+        halves[i] = (((i & 0x7c00) == 0x7c00) && ((i & 0x3ff) != 0)) ? 0 : static_cast<uint16_t>(i);
+    }
+
+    const std::vector<uint8_t> halfFloats = ConvertTexels(DXGI_FORMAT_R16G16B16A16_FLOAT, halves.data(),
+                                                          DXGI_FORMAT_R32G32B32A32_FLOAT, 16384);
+    const std::vector<uint8_t> halfBytes  = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, halfFloats.data(),
+                                                          DXGI_FORMAT_R16G16B16A16_FLOAT, 16384);
+
+    AR_TEST_CHECK(memcmp(halfBytes.data(), halves.data(), halfBytes.size()) == 0);
+
+    // Half rounding to nearest even, overflow to infinity, denormals, signed zeros and quiet NaN
+    const float halfInputs[20] =
+    {
+        0.0f, -0.0f, 1.0f, -2.0f, 65504.0f, 65519.0f, 65520.0f, 70000.0f, -70000.0f, INFINITY, -INFINITY, NAN,
+        std::ldexp(1.0f, -14), std::ldexp(1.0f, -24), std::ldexp(1.0f, -25), std::ldexp(3.0f, -26),
+        1.0f + std::ldexp(1.0f, -11), 1.0f + std::ldexp(3.0f, -11), 1.0e-40f, -1.0e-40f,
+    };
+
+    const uint16_t expectedHalves[20] =
+    {
+        0x0000, 0x8000, 0x3c00, 0xc000, 0x7bff, 0x7bff, 0x7c00, 0x7c00, 0xfc00, 0x7c00, 0xfc00, 0x7e00,
+        0x0400, 0x0001, 0x0000, 0x0001, 0x3c00, 0x3c02, 0x0000, 0x8000,
+    };
+
+    // Packed 11-11-10 floats: 1.0, saturation of large, negative and NaN values, denormals and ties to even
+    const float packedInputs[16] =
+    {
+        1.0f, 1.0f, 1.0f, 0.0f,
+        65024.0f, 70000.0f, INFINITY, 0.0f,
+        -1.0f, NAN, -INFINITY, 0.0f,
+        std::ldexp(1.0f, -20), std::ldexp(3.0f, -21), std::ldexp(1.0f, -19), 0.0f,
+    };
+
+    const uint32_t expectedPacked[4] =
+    {
+        0x3c0 | (0x3c0 << 11) | (0x1e0u << 22),
+        0x7bf | (0x7bf << 11) | (0x3dfu << 22),
+        0,
+        1 | (2 << 11) | (1u << 22),
+    };
+
+    // R10G10B10A2 and sRGB encodings: ties to even and saturation (NaN to zero)
+    const float    unormInputs[8]         = { 1.0f, 0.5f, -1.0f, 0.5f, NAN, 2.0f, 0.25f, 1.0f };
+    const uint8_t  expectedSrgb[8]        = { 255, 188, 0, 128, 0, 255, 137, 255 };
+    const uint32_t expectedR10G10B10A2[2] =
+    {
+        1023 | (512 << 10) | (2u << 30),
+        (1023 << 10) | (256 << 20) | (3u << 30),
+    };
+
+    for (ConvertIsa isa : { ConvertIsa::Scalar, ConvertIsa::Sse41, ConvertIsa::Avx2 })
+    {
+        if (isa > supported)
+        {
+            continue;
+        }
+
+        std::vector<uint8_t> result = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, halfInputs,
+                                                    DXGI_FORMAT_R16G16B16A16_FLOAT, 5, isa);
+        AR_TEST_CHECK(memcmp(result.data(), expectedHalves, sizeof(expectedHalves)) == 0);
+
+        result = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, packedInputs, DXGI_FORMAT_R11G11B10_FLOAT, 4, isa);
+        AR_TEST_CHECK(memcmp(result.data(), expectedPacked, sizeof(expectedPacked)) == 0);
+
+        result = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, unormInputs, DXGI_FORMAT_R10G10B10A2_UNORM, 2, isa);
+        AR_TEST_CHECK(memcmp(result.data(), expectedR10G10B10A2, sizeof(expectedR10G10B10A2)) == 0);
+
+        result = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, unormInputs, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 2, isa);
+        AR_TEST_CHECK(memcmp(result.data(), expectedSrgb, sizeof(expectedSrgb)) == 0);
+    }
+
+    // RGB32F reads an opaque alpha
+    const float rgb[3] = { 0.25f, 0.5f, 0.75f };
+    float       rgba[4];
+    memcpy(rgba, ConvertTexels(DXGI_FORMAT_R32G32B32_FLOAT, rgb, DXGI_FORMAT_R32G32B32A32_FLOAT, 1).data(),
+           sizeof(rgba));
+    AR_TEST_CHECK((rgba[0] == 0.25f) && (rgba[2] == 0.75f) && (rgba[3] == 1.0f));
+
+    // ConvertSubresources writes every subresource at its footprint, rows converted like ConvertRows
+    ResourceBuilder texture;
+    texture.Texture2D(37, 21, DXGI_FORMAT_R16G16B16A16_FLOAT, 2, 3);
+
+    constexpr uint32_t SubresourceCount = 6;
+    constexpr uint64_t BaseOffset       = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT layouts[SubresourceCount];
+    uint32_t                           numRows[SubresourceCount];
+    uint64_t                           totalBytes = 0;
+    texture.GetCopyableFootprints(0, SubresourceCount, BaseOffset, layouts, numRows, nullptr, &totalBytes);
+
+    std::vector<std::vector<uint8_t>> sources(SubresourceCount);
+    std::vector<ConvertSource>        convertSources(SubresourceCount);
+
+    for (uint32_t i = 0; i < SubresourceCount; i++)
+    {
+        const uint32_t width = layouts[i].Footprint.Width;
+
+        sources[i].resize(size_t(width) * numRows[i] * 4);
+        FillConvertSource(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, &sources[i], i);
+        convertSources[i] = { sources[i].data(), DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, uint64_t(width) * 4,
+                              uint64_t(width) * numRows[i] * 4 };
+    }
+
+    std::vector<uint8_t> upload(static_cast<size_t>(BaseOffset + totalBytes), 0xcd);
+    AR_TEST_CHECK(ConvertSubresources(texture, 0, SubresourceCount, BaseOffset, convertSources.data(),
+                                      upload.data()));
+
+    for (uint32_t i = 0; i < SubresourceCount; i++)
+    {
+        const uint32_t width = layouts[i].Footprint.Width;
+
+        for (uint32_t y = 0; y < numRows[i]; y++)
+        {
+            const std::vector<uint8_t> row = ConvertTexels(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+                                                           sources[i].data() + (size_t(y) * width * 4),
+                                                           DXGI_FORMAT_R16G16B16A16_FLOAT, width);
+            AR_TEST_CHECK(memcmp(upload.data() + layouts[i].Offset + (uint64_t(y) * layouts[i].Footprint.RowPitch),
+                                 row.data(), row.size()) == 0);
+        }
+    }
+
+    AR_TEST_CHECK(upload[BaseOffset - 1] == 0xcd);
+
+    // Buffers and block compressed textures are rejected without writing
+    std::vector<uint8_t> untouched(upload.size(), 0xcd);
+    upload = untouched;
+
+    AR_TEST_CHECK(ConvertSubresources(ResourceBuilder().Buffer(65536), 0, 1, 0, convertSources.data(),
+                                      upload.data()) == false);
+    AR_TEST_CHECK(ConvertSubresources(ResourceBuilder().Texture2D(64, 64, DXGI_FORMAT_BC7_UNORM), 0, 1, 0,
+                                      convertSources.data(), upload.data()) == false);
+    AR_TEST_CHECK(upload == untouched);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Reads texel (x, y, z) of a subresource as RGBA floats from a buffer in the layout of
+// ResourceBuilder::GetCopyableFootprints over all subresources
+void ReadTexel(
+    const ResourceBuilder&      builder,
+    const std::vector<uint8_t>& data,
+    uint32_t                    subresource,
+    uint32_t                    x,
+    uint32_t                    y,
+    uint32_t                    z,
+    float*                      pRgba)
+{
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresource + 1);
+    builder.GetCopyableFootprints(0, subresource + 1, 0, layouts.data(), nullptr, nullptr, nullptr);
+
+    const D3D12_SUBRESOURCE_FOOTPRINT& footprint = layouts[subresource].Footprint;
+    const uint64_t                     row       = (uint64_t(footprint.Height) * z) + y;
+    const uint8_t*                     pTexel    = data.data() + layouts[subresource].Offset +
+                                                   (footprint.RowPitch * row) +
+                                                   (uint64_t(x) * GetBytesPerBlock(builder.Format));
+
+    memcpy(pRgba, ConvertTexels(builder.Format, pTexel, DXGI_FORMAT_R32G32B32A32_FLOAT, 1).data(), 16);
+}
+
+//=====================================================================================================================
+// Checks mip generation: every SIMD filter kernel the CPU supports writes the same chain as the scalar kernels on odd,
+// non-power-of-two, array and 3D textures, mip 0 is never modified, flat textures stay flat through every level with
+// both filters, box averages are coverage weighted and gamma correct along every axis, and unsupported textures are
+// rejected without writing. Returns the number of failed checks.
+uint32_t TestMipGenerator()
+{
+    uint32_t failures = 0;
+
+    // Texture checked against the scalar kernels: dimension, size and format
+    struct ParityCase
+    {
+        D3D12_RESOURCE_DIMENSION Dimension;
+        uint32_t                 Width;
+        uint32_t                 Height;
+        uint16_t                 Depth;  ///< Array size (2D) or depth (3D)
+        DXGI_FORMAT              Format;
+    };
+
+    constexpr ParityCase ParityCases[] =
+    {
+        { D3D12_RESOURCE_DIMENSION_TEXTURE2D, 64,  64, 1, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE2D, 37,  21, 3, DXGI_FORMAT_R16G16B16A16_FLOAT  },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE2D, 999, 3,  1, DXGI_FORMAT_R32G32B32A32_FLOAT  },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE2D, 5,   7,  2, DXGI_FORMAT_B8G8R8X8_UNORM      },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE2D, 1,   13, 1, DXGI_FORMAT_R32G32B32_FLOAT     },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE3D, 19,  12, 7, DXGI_FORMAT_B8G8R8A8_UNORM_SRGB },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE3D, 16,  16, 16, DXGI_FORMAT_R16G16B16A16_FLOAT },
+        { D3D12_RESOURCE_DIMENSION_TEXTURE3D, 3,   1,  9, DXGI_FORMAT_R8G8B8A8_UNORM      },
+    };
+
+    const ConvertIsa supported = GetSupportedConvertIsa();
+
+    for (const ParityCase& parityCase : ParityCases)
+    {
+        ResourceBuilder builder;
+
+        if (parityCase.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+        {
+            builder.Texture3D(parityCase.Width, parityCase.Height, parityCase.Depth, parityCase.Format, 0);
+        }
+        else
+        {
+            builder.Texture2D(parityCase.Width, parityCase.Height, parityCase.Format, parityCase.Depth, 0);
+        }
+
+        std::vector<uint8_t> source;
+        FillMipSource(builder, &source, parityCase.Width);
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT mip0      = {};
+        uint64_t                           mip0Bytes = 0;
+        builder.GetCopyableFootprints(0, 1, 0, &mip0, nullptr, nullptr, &mip0Bytes);
+
+        for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser })
+        {
+            std::vector<uint8_t> expected = source;
+            AR_TEST_CHECK(GenerateMips(builder, 0, expected.data(), filter, 1, ConvertIsa::Scalar));
+            AR_TEST_CHECK(memcmp(expected.data(), source.data(), static_cast<size_t>(mip0Bytes)) == 0);
+            AR_TEST_CHECK(expected != source);
+
+            for (uint32_t i = 0; i < sizeof(SimdIsas) / sizeof(SimdIsas[0]); i++)
+            {
+                if (SimdIsas[i] > supported)
+                {
+                    continue;
+                }
+
+                std::vector<uint8_t> result = source;
+                GenerateMips(builder, 0, result.data(), filter, 0, SimdIsas[i]);
+
+                const bool matches = (result == expected);
+
+                if (matches == false)
+                {
+                    fprintf(stderr, "mip mismatch: %ux%ux%u format %u, filter %u, %s\n", parityCase.Width,
+                            parityCase.Height, parityCase.Depth, parityCase.Format, uint32_t(filter),
+                            SimdIsaNames[i]);
+                }
+
+                AR_TEST_CHECK(matches);
+            }
+        }
+    }
+
+    // Flat textures stay flat through every level of odd sizes and depths with both filters
+    for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser })
+    {
+        for (bool is3D : { false, true })
+        {
+            ResourceBuilder builder;
+
+            if (is3D)
+            {
+                builder.Texture3D(13, 7, 5, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 0);
+            }
+            else
+            {
+                builder.Texture2D(37, 21, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 2, 0);
+            }
+
+            const uint32_t mipCount   = builder.GetMipCount();
+            const uint32_t sliceCount = is3D ? 1u : 2u;
+
+            std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(size_t(mipCount) * sliceCount);
+            std::vector<uint32_t>                           numRows(layouts.size());
+            uint64_t                                        totalBytes = 0;
+            builder.GetCopyableFootprints(0, mipCount * sliceCount, 0, layouts.data(), numRows.data(), nullptr,
+                                          &totalBytes);
+
+            const uint8_t        flat[4] = { 200, 90, 17, 128 };
+            std::vector<uint8_t> data(static_cast<size_t>(totalBytes), 0);
+
+            for (uint32_t slice = 0; slice < sliceCount; slice++)
+            {
+                const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[slice * mipCount];
+
+                for (uint32_t row = 0; row < numRows[slice * mipCount] * layout.Footprint.Depth; row++)
+                {
+                    for (uint32_t x = 0; x < layout.Footprint.Width; x++)
+                    {
+                        memcpy(data.data() + layout.Offset + (uint64_t(layout.Footprint.RowPitch) * row) + (x * 4),
+                               flat, 4);
+                    }
+                }
+            }
+
+            AR_TEST_CHECK(GenerateMips(builder, 0, data.data(), filter));
+
+            uint32_t flatTexels = 0;
+            uint32_t texelCount = 0;
+
+            for (uint32_t i = 0; i < layouts.size(); i++)
+            {
+                const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[i];
+
+                for (uint32_t row = 0; row < numRows[i] * layout.Footprint.Depth; row++)
+                {
+                    for (uint32_t x = 0; x < layout.Footprint.Width; x++, texelCount++)
+                    {
+                        flatTexels += (memcmp(data.data() + layout.Offset +
+                                              (uint64_t(layout.Footprint.RowPitch) * row) + (x * 4), flat, 4) == 0);
+                    }
+                }
+            }
+
+            AR_TEST_CHECK(flatTexels == texelCount);
+        }
+    }
+
+    // Box averages are gamma correct (black and white average to sRGB 188) and alpha stays linear
+    ResourceBuilder checker;
+    checker.Texture2D(2, 2, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1, 0);
+
+    std::vector<uint8_t> checkerData;
+    FillMipSource(checker, &checkerData, 1);
+
+    const uint32_t checkerPitch = D3D12_TEXTURE_DATA_PITCH_ALIGNMENT;
+
+    for (uint32_t t = 0; t < 4; t++)
+    {
+        const uint8_t value = ((t == 0) || (t == 3)) ? 255 : 0;
+        const uint8_t texel[4] = { value, value, value, value };
+        memcpy(checkerData.data() + ((t / 2) * checkerPitch) + ((t % 2) * 4), texel, 4);
+    }
+
+    float rgba[4];
+    AR_TEST_CHECK(GenerateMips(checker, 0, checkerData.data()));
+    ReadTexel(checker, checkerData, 1, 0, 0, 0, rgba);
+    const std::vector<uint8_t> encoded = ConvertTexels(DXGI_FORMAT_R32G32B32A32_FLOAT, rgba,
+                                                       DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1);
+    AR_TEST_CHECK((encoded[0] == 188) && (encoded[1] == 188) && (encoded[2] == 188));
+    AR_TEST_CHECK(std::fabs(rgba[3] - (128.0f / 255.0f)) < 0.002f);
+
+    // Odd sizes are weighted by coverage: 3 texels average to one, and depth slices average like rows
+    ResourceBuilder row;
+    row.Texture2D(3, 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0);
+
+    const float rowTexels[12] = { 0.0f, 0.0f, 0.0f, 0.0f, 3.0f, 3.0f, 3.0f, 3.0f, 6.0f, 6.0f, 6.0f, 6.0f };
+
+    std::vector<uint8_t> rowData;
+    FillMipSource(row, &rowData, 1);
+    memcpy(rowData.data(), rowTexels, sizeof(rowTexels));
+
+    AR_TEST_CHECK(row.GetMipCount() == 2);
+    AR_TEST_CHECK(GenerateMips(row, 0, rowData.data()));
+    ReadTexel(row, rowData, 1, 0, 0, 0, rgba);
+    AR_TEST_CHECK(std::fabs(rgba[0] - 3.0f) < 1.0e-5f);
+
+    ResourceBuilder volume;
+    volume.Texture3D(2, 2, 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 0);
+
+    std::vector<uint8_t> volumeData;
+    FillMipSource(volume, &volumeData, 1);
+
+    for (uint32_t t = 0; t < 8; t++)
+    {
+        const float value[4] = { float(t / 4), 1.0f, 2.0f * float(t % 2), 1.0f };
+        memcpy(volumeData.data() + (((t / 2) * D3D12_TEXTURE_DATA_PITCH_ALIGNMENT) + ((t % 2) * 16)), value, 16);
+    }
+
+    AR_TEST_CHECK(GenerateMips(volume, 0, volumeData.data()));
+    ReadTexel(volume, volumeData, 1, 0, 0, 0, rgba);
+    AR_TEST_CHECK((rgba[0] == 0.5f) && (rgba[1] == 1.0f) && (rgba[2] == 1.0f) && (rgba[3] == 1.0f));
+
+    // Buffers, multisampled textures and formats without conversion kernels are rejected without writing
+    std::vector<uint8_t> untouched(65536, 0xcd);
+    std::vector<uint8_t> data = untouched;
+
+    AR_TEST_CHECK(IsMipGenerationSupported(DXGI_FORMAT_R8G8B8A8_TYPELESS));
+    AR_TEST_CHECK(IsMipGenerationSupported(DXGI_FORMAT_R11G11B10_FLOAT) == false);
+    AR_TEST_CHECK(GenerateMips(ResourceBuilder().Buffer(65536), 0, data.data()) == false);
+    AR_TEST_CHECK(GenerateMips(ResourceBuilder().Texture2D(16, 16, DXGI_FORMAT_R8G8B8A8_UNORM).SetSampleCount(4), 0,
+                               data.data()) == false);
+    AR_TEST_CHECK(GenerateMips(ResourceBuilder().Texture2D(16, 16, DXGI_FORMAT_BC7_UNORM, 1, 0), 0,
+                               data.data()) == false);
+    AR_TEST_CHECK(GenerateMips(ResourceBuilder().Texture2D(16, 16, DXGI_FORMAT_R11G11B10_FLOAT, 1, 0), 0,
+                               data.data()) == false);
+    AR_TEST_CHECK(data == untouched);
+
+    return failures;
+}
+
+//=====================================================================================================================
+// Checks per-mip view sets: array ranges and per-slice ordering of 2D arrays, views of 3D textures covering every depth
+// slice of their mip, and rejection of per-slice or offset ranges on 3D textures, buffers, UAVs of MSAA textures and
+// too little storage. Returns the number of failed checks.
+uint32_t TestMipViews()
+{
+    uint32_t failures = 0;
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC  srvs[16];
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavs[16];
+
+    // Per-slice views of a 2D array are slice-major and cover one slice; other sets cover the whole array range
+    ResourceBuilder array;
+    array.Texture2D(64, 32, DXGI_FORMAT_R16G16B16A16_FLOAT, 3, 0);
+
+    MipViewRange range = {};
+    range.BaseMip      = 2;
+    range.BaseArray    = 1;
+    range.ArraySize    = 2;
+    range.PerSlice     = true;
+
+    AR_TEST_CHECK(array.GetMipViewCount(range) == 10);
+    AR_TEST_CHECK(array.BuildMipViews(range, 9, srvs, uavs) == 0);
+    AR_TEST_CHECK(array.BuildMipViews(range, 16, srvs, uavs) == 10);
+    AR_TEST_CHECK((srvs[6].Texture2DArray.MostDetailedMip == 3) && (srvs[6].Texture2DArray.MipLevels == 1));
+    AR_TEST_CHECK((srvs[6].Texture2DArray.FirstArraySlice == 2) && (srvs[6].Texture2DArray.ArraySize == 1));
+    AR_TEST_CHECK((uavs[6].Texture2DArray.MipSlice == 3) && (uavs[6].Texture2DArray.FirstArraySlice == 2));
+    AR_TEST_CHECK(uavs[9].Texture2DArray.MipSlice == 6);
+
+    range.PerSlice = false;
+    AR_TEST_CHECK(array.BuildMipViews(range, 16, srvs, uavs) == 5);
+    AR_TEST_CHECK((srvs[4].Texture2DArray.MostDetailedMip == 6) && (srvs[4].Texture2DArray.FirstArraySlice == 1));
+    AR_TEST_CHECK((uavs[0].Texture2DArray.ArraySize == 2) && (uavs[4].Texture2DArray.ArraySize == 2));
+
+    range.BaseArray = 3;
+    AR_TEST_CHECK(array.GetMipViewCount(range) == 0);
+
+    // Views of a 3D texture cover every depth slice of their mip, whatever the array size
+    ResourceBuilder volume;
+    volume.Texture3D(64, 32, 16, DXGI_FORMAT_R16G16B16A16_FLOAT, 0);
+
+    range           = {};
+    range.ArraySize = 4;
+    AR_TEST_CHECK(volume.BuildMipViews(range, 16, srvs, uavs) == 7);
+
+    for (uint32_t mip = 0; mip < 7; mip++)
+    {
+        AR_TEST_CHECK((srvs[mip].ViewDimension == D3D12_SRV_DIMENSION_TEXTURE3D) &&
+                      (srvs[mip].Texture3D.MostDetailedMip == mip) && (srvs[mip].Texture3D.MipLevels == 1));
+        AR_TEST_CHECK((uavs[mip].ViewDimension == D3D12_UAV_DIMENSION_TEXTURE3D) &&
+                      (uavs[mip].Texture3D.MipSlice == mip) && (uavs[mip].Texture3D.FirstWSlice == 0) &&
+                      (uavs[mip].Texture3D.WSize == std::max(1u, 16u >> mip)));
+    }
+
+    // Per-slice sets and array ranges starting past slice 0 are rejected on 3D textures without writing
+    D3D12_UNORDERED_ACCESS_VIEW_DESC untouched;
+    memset(&untouched, 0xcd, sizeof(untouched));
+    uavs[0] = untouched;
+
+    range          = {};
+    range.PerSlice = true;
+    AR_TEST_CHECK(volume.GetMipViewCount(range) == 0);
+    AR_TEST_CHECK(volume.BuildMipViews(range, 16, nullptr, uavs) == 0);
+
+    range           = {};
+    range.BaseArray = 1;
+    AR_TEST_CHECK(volume.GetMipViewCount(range) == 0);
+    AR_TEST_CHECK(volume.BuildMipViews(range, 16, nullptr, uavs) == 0);
+    AR_TEST_CHECK(memcmp(&uavs[0], &untouched, sizeof(untouched)) == 0);
+
+    // Buffers have no mip views; MSAA textures have shader resource views only
+    ResourceBuilder msaa;
+    msaa.Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM).SetSampleCount(4);
+
+    AR_TEST_CHECK(ResourceBuilder().Buffer(65536).GetMipViewCount(MipViewRange{}) == 0);
+    AR_TEST_CHECK(msaa.BuildMipViews(MipViewRange{}, 16, srvs, nullptr) == 1);
+    AR_TEST_CHECK(srvs[0].ViewDimension == D3D12_SRV_DIMENSION_TEXTURE2DMS);
+    AR_TEST_CHECK(msaa.BuildMipViews(MipViewRange{}, 16, srvs, uavs) == 0);
+
+    return failures;
+}
+
+#if AR_TEST_VULKAN
+//=====================================================================================================================
+// Checks the Vulkan translation against the D3D12 builder output: the format table against the format traits, image
+// usage and flags against the resource flags, and view types, formats, aspects and subresource ranges against the
+// As*View descriptions. Depth-stencil images must reject color target and storage views. Returns the number of failed
+// checks.
+uint32_t TestVulkanBuilder()
+{
+    uint32_t failures = 0;
+
+    // Format table: typeless color families have no Vulkan format but their default view format does, sRGB formats
+    // pair with a distinct linear format, and every typed depth format maps to a Vulkan depth format
+    for (uint32_t i = 0; i < VkFormatCount; i++)
+    {
+        const DXGI_FORMAT format   = static_cast<DXGI_FORMAT>(i);
+        const VkFormat    vkFormat = ToVkFormat(format);
+
+        if (IsTypeless(format) && (IsDepthFormat(format) == false) && (GetDefaultDepthViewFormat(format) == 0))
+        {
+            AR_TEST_CHECK(vkFormat == VK_FORMAT_UNDEFINED);
+
+            if (GetDefaultViewFormat(format) != DXGI_FORMAT_UNKNOWN)
+            {
+                AR_TEST_CHECK(ToVkFormat(GetDefaultViewFormat(format)) != VK_FORMAT_UNDEFINED);
+            }
+        }
+
+        if (IsSrgb(format) && (vkFormat != VK_FORMAT_UNDEFINED))
+        {
+            AR_TEST_CHECK(ToVkFormat(GetLinearFormat(format)) != VK_FORMAT_UNDEFINED);
+            AR_TEST_CHECK(ToVkFormat(GetLinearFormat(format)) != vkFormat);
+        }
+
+        if (IsDepthFormat(format) && (IsTypeless(format) == false))
+        {
+            AR_TEST_CHECK((vkFormat == VK_FORMAT_D16_UNORM) || (vkFormat == VK_FORMAT_D32_SFLOAT) ||
+                          (vkFormat == VK_FORMAT_D24_UNORM_S8_UINT) || (vkFormat == VK_FORMAT_D32_SFLOAT_S8_UINT));
+        }
+    }
+
+    AR_TEST_CHECK(ToVkFormat(static_cast<DXGI_FORMAT>(VkFormatCount)) == VK_FORMAT_UNDEFINED);
+    AR_TEST_CHECK(ToVkFormat(DXGI_FORMAT_R10G10B10A2_UNORM) == VK_FORMAT_A2B10G10R10_UNORM_PACK32);
+    AR_TEST_CHECK(ToVkFormat(DXGI_FORMAT_B8G8R8X8_UNORM) == VK_FORMAT_B8G8R8A8_UNORM);
+
+    // Image formats resolve like the default D3D12 views: typeless color images take their default view format and
+    // typeless depth images their depth format
+    ResourceBuilder color;
+    color.Texture2D(64, 32, DXGI_FORMAT_R8G8B8A8_TYPELESS, 4, 3);
+
+    ResourceBuilder depth;
+    depth.Texture2D(64, 64, DXGI_FORMAT_R24G8_TYPELESS, 6).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+
+    AR_TEST_CHECK(GetVkImageFormat(color) == ToVkFormat(color.AsShaderResourceView().Format));
+    AR_TEST_CHECK(GetVkImageFormat(depth) == ToVkFormat(depth.AsDepthStencilView().Format));
+
+    // Usage follows the resource flags
+    const VkImageCreateInfo colorInfo = ToVkImageCreateInfo(color.AsColorTarget(true));
+    AR_TEST_CHECK((colorInfo.imageType == VK_IMAGE_TYPE_2D) && (colorInfo.format == VK_FORMAT_R8G8B8A8_UNORM));
+    AR_TEST_CHECK((colorInfo.extent.width == 64) && (colorInfo.extent.height == 32) && (colorInfo.extent.depth == 1));
+    AR_TEST_CHECK((colorInfo.mipLevels == 3) && (colorInfo.arrayLayers == 4));
+    AR_TEST_CHECK((colorInfo.usage & VK_IMAGE_USAGE_SAMPLED_BIT) != 0);
+    AR_TEST_CHECK((colorInfo.usage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) != 0);
+    AR_TEST_CHECK((colorInfo.usage & VK_IMAGE_USAGE_STORAGE_BIT) != 0);
+    AR_TEST_CHECK((colorInfo.usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) == 0);
+    AR_TEST_CHECK((colorInfo.flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT) != 0);
+    AR_TEST_CHECK((colorInfo.flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) == 0);
+
+    const VkImageCreateInfo depthInfo = ToVkImageCreateInfo(depth.AsDepthTarget(false));
+    AR_TEST_CHECK(depthInfo.format == VK_FORMAT_D24_UNORM_S8_UINT);
+    AR_TEST_CHECK((depthInfo.usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0);
+    AR_TEST_CHECK((depthInfo.usage & (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT)) == 0);
+    AR_TEST_CHECK((depthInfo.flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT) == 0);
+    AR_TEST_CHECK((depthInfo.flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) != 0);
+
+    ResourceBuilder volume;
+    volume.Texture3D(32, 16, 8, DXGI_FORMAT_R16G16B16A16_FLOAT, 2).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+
+    const VkImageCreateInfo volumeInfo = ToVkImageCreateInfo(volume);
+    AR_TEST_CHECK((volumeInfo.imageType == VK_IMAGE_TYPE_3D) && (volumeInfo.extent.depth == 8));
+    AR_TEST_CHECK((volumeInfo.arrayLayers == 1) && (volumeInfo.mipLevels == 2));
+    AR_TEST_CHECK((volumeInfo.flags & VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT) != 0);
+
+    ResourceBuilder msaa;
+    msaa.Texture2D(64, 64, DXGI_FORMAT_R8G8B8A8_UNORM, 6).SetSampleCount(4);
+    AR_TEST_CHECK(ToVkImageCreateInfo(msaa).samples == VK_SAMPLE_COUNT_4_BIT);
+    AR_TEST_CHECK((ToVkImageCreateInfo(msaa).flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) == 0);
+
+    ResourceBuilder buffer;
+    buffer.Buffer(4096);
+    AR_TEST_CHECK(ToVkBufferCreateInfo(buffer).size == 4096);
+    AR_TEST_CHECK((ToVkBufferCreateInfo(buffer).usage & VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT) == 0);
+    buffer.SetFlags(D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+    AR_TEST_CHECK((ToVkBufferCreateInfo(buffer).usage & VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT) != 0);
+
+    // View types and subresource ranges follow the D3D12 views of every resource shape
+    struct ViewTypeCase
+    {
+        ResourceBuilder Builder;   ///< Resource
+        bool            IsArray;   ///< Build array views
+        VkImageViewType SrvType;   ///< Expected shader resource view type
+        VkImageViewType RtvType;   ///< Expected color target view type
+        VkImageViewType UavType;   ///< Expected storage view type
+    };
+
+    ViewTypeCase cases[6] = {};
+    cases[0] = { ResourceBuilder().Texture1D(64, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 4), false,
+                 VK_IMAGE_VIEW_TYPE_1D, VK_IMAGE_VIEW_TYPE_1D, VK_IMAGE_VIEW_TYPE_1D };
+    cases[1] = { ResourceBuilder().Texture1D(64, DXGI_FORMAT_R8G8B8A8_UNORM, 5, 4), true,
+                 VK_IMAGE_VIEW_TYPE_1D_ARRAY, VK_IMAGE_VIEW_TYPE_1D_ARRAY, VK_IMAGE_VIEW_TYPE_1D_ARRAY };
+    cases[2] = { ResourceBuilder().Texture2D(64, 32, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 4), false,
+                 VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_VIEW_TYPE_2D };
+    cases[3] = { ResourceBuilder().Texture2D(64, 32, DXGI_FORMAT_R8G8B8A8_UNORM, 5, 4), true,
+                 VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_VIEW_TYPE_2D_ARRAY };
+    cases[4] = { ResourceBuilder().Texture3D(32, 16, 8, DXGI_FORMAT_R8G8B8A8_UNORM, 3), true,
+                 VK_IMAGE_VIEW_TYPE_3D, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_VIEW_TYPE_3D };
+    cases[5] = { ResourceBuilder().Texture2D(64, 32, DXGI_FORMAT_R8G8B8A8_UNORM, 5).SetSampleCount(4), true,
+                 VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_VIEW_TYPE_2D_ARRAY };
+
+    VkImage image = reinterpret_cast<VkImage>(uintptr_t(0x1000));
+
+    for (const ViewTypeCase& viewCase : cases)
+    {
+        const ResourceBuilder& builder = viewCase.Builder;
+
+        const D3D12_SHADER_RESOURCE_VIEW_DESC srv = viewCase.IsArray ?
+            builder.AsShaderResourceViewArray(DXGI_FORMAT_UNKNOWN, 1, 1) : builder.AsShaderResourceView();
+        const VkImageViewCreateInfo srvInfo = ToVkImageViewCreateInfo(builder, image, srv);
+
+        AR_TEST_CHECK(srvInfo.sType == VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO);
+        AR_TEST_CHECK((srvInfo.image == image) && (srvInfo.viewType == viewCase.SrvType));
+        AR_TEST_CHECK(srvInfo.format == ToVkFormat(srv.Format));
+        AR_TEST_CHECK(srvInfo.subresourceRange.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT);
+        AR_TEST_CHECK(srvInfo.components.r == VK_COMPONENT_SWIZZLE_IDENTITY);
+
+        if (builder.SampleDesc.Count > 1)
+        {
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseMipLevel == 0) && (srvInfo.subresourceRange.levelCount == 1));
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseArrayLayer == 1) &&
+                          (srvInfo.subresourceRange.layerCount == 4));
+        }
+        else if (viewCase.SrvType == VK_IMAGE_VIEW_TYPE_1D_ARRAY)
+        {
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseMipLevel == 1) && (srvInfo.subresourceRange.levelCount == 3));
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseArrayLayer == 1) &&
+                          (srvInfo.subresourceRange.layerCount == 4));
+        }
+        else if (viewCase.SrvType == VK_IMAGE_VIEW_TYPE_2D_ARRAY)
+        {
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseMipLevel == 1) && (srvInfo.subresourceRange.levelCount == 3));
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseArrayLayer == 1) &&
+                          (srvInfo.subresourceRange.layerCount == 4));
+        }
+        else
+        {
+            const uint32_t baseMip = viewCase.IsArray ? 1 : 0;
+            AR_TEST_CHECK(srvInfo.subresourceRange.baseMipLevel == baseMip);
+            AR_TEST_CHECK(srvInfo.subresourceRange.levelCount == builder.GetMipCount() - baseMip);
+            AR_TEST_CHECK((srvInfo.subresourceRange.baseArrayLayer == 0) &&
+                          (srvInfo.subresourceRange.layerCount == 1));
+        }
+
+        const D3D12_RENDER_TARGET_VIEW_DESC rtv = viewCase.IsArray ?
+            builder.AsColorTargetViewArray(DXGI_FORMAT_UNKNOWN, 0, 1) : builder.AsColorTargetView();
+        const VkImageViewCreateInfo rtvInfo = ToVkImageViewCreateInfo(builder, image, rtv);
+
+        AR_TEST_CHECK(rtvInfo.viewType == viewCase.RtvType);
+        AR_TEST_CHECK(rtvInfo.format == ToVkFormat(rtv.Format));
+        AR_TEST_CHECK(rtvInfo.subresourceRange.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT);
+        AR_TEST_CHECK(rtvInfo.subresourceRange.levelCount == 1);
+
+        if (viewCase.IsArray)
+        {
+            // Array views (and 3D views, as 2D arrays of depth slices) start at slice 1 and cover the rest
+            const uint32_t slices = (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ?
+                builder.DepthOrArraySize : builder.GetArraySize();
+            AR_TEST_CHECK((rtvInfo.subresourceRange.baseArrayLayer == 1) &&
+                          (rtvInfo.subresourceRange.layerCount == slices - 1));
+        }
+
+        if (builder.SampleDesc.Count == 1)
+        {
+            const D3D12_UNORDERED_ACCESS_VIEW_DESC uav = viewCase.IsArray ?
+                builder.AsUnorderedAccessViewArray(DXGI_FORMAT_UNKNOWN, 1) : builder.AsUnorderedAccessView();
+            const VkImageViewCreateInfo uavInfo = ToVkImageViewCreateInfo(builder, image, uav);
+
+            AR_TEST_CHECK(uavInfo.viewType == viewCase.UavType);
+            AR_TEST_CHECK(uavInfo.format == ToVkFormat(uav.Format));
+            AR_TEST_CHECK(uavInfo.subresourceRange.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT);
+            AR_TEST_CHECK((uavInfo.subresourceRange.baseMipLevel == (viewCase.IsArray ? 1u : 0u)) &&
+                          (uavInfo.subresourceRange.levelCount == 1));
+        }
+    }
+
+    // Cube views are chosen by the caller on the D3D12 side
+    D3D12_SHADER_RESOURCE_VIEW_DESC cube = depth.AsShaderResourceView();
+    cube.ViewDimension                  = D3D12_SRV_DIMENSION_TEXTURECUBE;
+    cube.TextureCube.MostDetailedMip    = 0;
+    cube.TextureCube.MipLevels          = 1;
+    AR_TEST_CHECK(ToVkImageViewCreateInfo(depth, image, cube).viewType == VK_IMAGE_VIEW_TYPE_CUBE);
+    AR_TEST_CHECK(ToVkImageViewCreateInfo(depth, image, cube).subresourceRange.layerCount == 6);
+
+    // Depth-stencil images: shader resource views select one plane, depth-stencil views both, and color target or
+    // storage views are rejected
+    const VkImageViewCreateInfo depthSrv =
+        ToVkImageViewCreateInfo(depth, image, depth.AsShaderResourceView(DXGI_FORMAT_R24_UNORM_X8_TYPELESS));
+    AR_TEST_CHECK(depthSrv.format == VK_FORMAT_D24_UNORM_S8_UINT);
+    AR_TEST_CHECK(depthSrv.subresourceRange.aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    const VkImageViewCreateInfo stencilSrv =
+        ToVkImageViewCreateInfo(depth, image, depth.AsShaderResourceView(DXGI_FORMAT_X24_TYPELESS_G8_UINT));
+    AR_TEST_CHECK(stencilSrv.format == VK_FORMAT_D24_UNORM_S8_UINT);
+    AR_TEST_CHECK(stencilSrv.subresourceRange.aspectMask == VK_IMAGE_ASPECT_STENCIL_BIT);
+
+    const VkImageViewCreateInfo dsv = ToVkImageViewCreateInfo(depth, image, depth.AsDepthStencilViewArray());
+    AR_TEST_CHECK((dsv.format == VK_FORMAT_D24_UNORM_S8_UINT) && (dsv.viewType == VK_IMAGE_VIEW_TYPE_2D_ARRAY));
+    AR_TEST_CHECK(dsv.subresourceRange.aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT));
+    AR_TEST_CHECK(dsv.subresourceRange.layerCount == 6);
+
+    ResourceBuilder depthOnly;
+    depthOnly.Texture2D(64, 64, DXGI_FORMAT_D32_FLOAT).SetFlags(D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+    const VkImageViewCreateInfo depthOnlyDsv =
+        ToVkImageViewCreateInfo(depthOnly, image, depthOnly.AsDepthStencilView());
+    AR_TEST_CHECK(depthOnlyDsv.subresourceRange.aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    const VkImageViewCreateInfo depthUav =
+        ToVkImageViewCreateInfo(depthOnly, image, depthOnly.AsUnorderedAccessView(DXGI_FORMAT_R32_FLOAT));
+    AR_TEST_CHECK((depthUav.format == VK_FORMAT_UNDEFINED) && (depthUav.subresourceRange.aspectMask == 0));
+
+    const VkImageViewCreateInfo depthRtv =
+        ToVkImageViewCreateInfo(depthOnly, image, depthOnly.AsColorTargetView(DXGI_FORMAT_R32_FLOAT));
+    AR_TEST_CHECK((depthRtv.format == VK_FORMAT_UNDEFINED) && (depthRtv.subresourceRange.aspectMask == 0));
+
+    // BGRX views read alpha as one
+    ResourceBuilder bgrx;
+    bgrx.Texture2D(16, 16, DXGI_FORMAT_B8G8R8X8_UNORM);
+    AR_TEST_CHECK(ToVkImageViewCreateInfo(bgrx, image, bgrx.AsShaderResourceView()).components.a ==
+                  VK_COMPONENT_SWIZZLE_ONE);
+
+    // Buffer views: typed views get a VkBufferView range in bytes, structured and raw views an offset and range
+    VkBuffer vkBuffer = reinterpret_cast<VkBuffer>(uintptr_t(0x2000));
+
+    const VkBufferViewCreateInfo typed =
+        ToVkBufferViewCreateInfo(buffer, vkBuffer, buffer.AsBufferResourceView(16, 32, 0, DXGI_FORMAT_R32_FLOAT));
+    AR_TEST_CHECK((typed.buffer == vkBuffer) && (typed.format == VK_FORMAT_R32_SFLOAT));
+    AR_TEST_CHECK((typed.offset == 64) && (typed.range == 128));
+
+    const VkBufferViewCreateInfo structured =
+        ToVkBufferViewCreateInfo(buffer, vkBuffer, buffer.AsBufferResourceView(2, 4, 48));
+    AR_TEST_CHECK((structured.format == VK_FORMAT_UNDEFINED) && (structured.offset == 96));
+    AR_TEST_CHECK(structured.range == 192);
+
+    AR_TEST_CHECK(ToVkBufferViewCreateInfo(buffer, vkBuffer, buffer.AsBufferResourceView(8)).range == VK_WHOLE_SIZE);
+    AR_TEST_CHECK(ToVkBufferViewCreateInfo(buffer, vkBuffer, buffer.AsBufferResourceView(0, 2048)).range ==
+                  VK_WHOLE_SIZE);
+
+    // Batch translation matches the per-item functions on every thread count
+    std::vector<ResourceBuilder> builders;
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        builders.push_back(cases[i % 5].Builder);
+    }
+
+    std::vector<VkImage>               images(builders.size(), image);
+    std::vector<VkImageCreateInfo>     imageInfos(builders.size());
+    std::vector<VkImageViewCreateInfo> viewInfos(builders.size());
+
+    BuildVkImageCreateInfos(builders.data(), uint32_t(builders.size()), imageInfos.data(), 0);
+    BuildVkShaderResourceViews(builders.data(), images.data(), nullptr, uint32_t(builders.size()), viewInfos.data(), 4);
+
+    for (size_t i = 0; i < builders.size(); i++)
+    {
+        const VkImageCreateInfo     expectedImage = ToVkImageCreateInfo(builders[i]);
+        const VkImageViewCreateInfo expectedView  =
+            ToVkImageViewCreateInfo(builders[i], image, builders[i].AsShaderResourceView());
+
+        AR_TEST_CHECK(memcmp(&imageInfos[i], &expectedImage, sizeof(expectedImage)) == 0);
+        AR_TEST_CHECK(memcmp(&viewInfos[i], &expectedView, sizeof(expectedView)) == 0);
+    }
+
+    return failures;
+}
+#endif
+
+//=====================================================================================================================
+// Functional test run by main
+struct TestCase
+{
+    const char* Name;    ///< Test name matched by --filter
+    uint32_t  (*Run)();  ///< Test function returning the number of failed checks
+};
+
+constexpr TestCase TestCases[] =
+{
+    { "AliasingPlanner",     TestAliasingPlanner },
+    { "AllocationInfo",      TestAllocationInfo },
+    { "BlockCompress",       TestBlockCompress },
+    { "DescriptorAllocator", TestDescriptorAllocator },
+    { "FormatConvert",       TestFormatConvert },
+#if AR_ENABLE_INSTRUMENTATION
+    { "Instrumentation",     TestInstrumentation },
+#endif
+    { "MipGenerator",        TestMipGenerator },
+    { "MipViews",            TestMipViews },
+    { "ParallelFor",         TestParallelFor },
+    { "RenderTargetPool",    TestRenderTargetPool },
+    { "ResidencyPlanner",    TestResidencyPlanner },
+    { "ResourceCache",       TestResourceCache },
+    { "ResourceManifest",    TestResourceManifest },
+    { "StateTracker",        TestStateTracker },
+    { "TextureFile",         TestTextureFile },
+    { "UploadRing",          TestUploadRing },
+    { "ViewCache",           TestViewCache },
+#if AR_TEST_VULKAN
+    { "VulkanBuilder",       TestVulkanBuilder },
+#endif
+};
+} // anonymous namespace
+
+//=====================================================================================================================
+// Runs every functional test (or those whose name contains the --filter text). Returns 1 when a check failed.
+int main(
+    int argc, char** argv)
+{
+    const char* pFilter = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+        {
+            pFilter = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter <text>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    uint32_t failedTests = 0;
+
+    for (const TestCase& testCase : TestCases)
+    {
+        if ((pFilter != nullptr) && (strstr(testCase.Name, pFilter) == nullptr))
+        {
+            continue;
+        }
+
+        const uint32_t failures = testCase.Run();
+        printf("%-24s %s\n", testCase.Name, (failures == 0) ? "ok" : "FAILED");
+
+        if (failures != 0)
+        {
+            failedTests++;
+        }
+    }
+
+    return (failedTests == 0) ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+//=====================================================================================================================
+/* Copyright (c) 2017 Rohan Mehalwal
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions
+of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+//=====================================================================================================================
+
+#pragma once
+#include "../FormatConvert.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace AR {
+namespace Bench {
+
+//=====================================================================================================================
+// Fills conversion source texels. Float channels mix in-range values with negative, large, tiny, infinite and NaN
+// values so the saturation and rounding paths of every kernel are covered; other formats get random bits.
+inline void FillConvertSource(
+    DXGI_FORMAT format, std::vector<uint8_t>* pData, uint32_t seed)
+{
+    std::mt19937 random(seed);
+
+    if ((format == DXGI_FORMAT_R32G32B32_FLOAT) || (format == DXGI_FORMAT_R32G32B32A32_FLOAT))
+    {
+        static const float Specials[] =
+        {
+            0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 65504.0f, 65520.0f, 70000.0f, 65024.0f, 64512.0f, 1.0e-5f, 6.0e-8f,
+            3.0e-8f, 1.0e-40f, INFINITY, -INFINITY, NAN
+        };
+
+        std::uniform_real_distribution<float> unit(-0.25f, 1.25f);
+        std::uniform_real_distribution<float> exponent(-30.0f, 17.0f);
+
+        for (size_t i = 0; i + 4 <= pData->size(); i += 4)
+        {
+            const uint32_t kind  = random() % 8;
+            float          value = (kind == 0) ? Specials[random() % (sizeof(Specials) / sizeof(Specials[0]))] :
+                                   (kind == 1) ? std::exp2(exponent(random)) : unit(random);
+
+            std::memcpy(pData->data() + i, &value, sizeof(value));
+        }
+    }
+    else
+    {
+        for (uint8_t& byte : *pData)
+        {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+}
+
+//=====================================================================================================================
+// Fills a synthetic RGBA8 image resembling texture content: smooth gradients and low-frequency waves with fine noise,
+// hard-edged shapes and an alpha ramp (unless opaque)
+inline void FillCompressSource(
+    std::vector<uint8_t>* pSource, uint32_t size, bool opaque)
+{
+    std::mt19937                          random(7);
+    std::uniform_real_distribution<float> noise(-6.0f, 6.0f);
+
+    pSource->resize(size_t(size) * size * 4);
+
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            const float u    = float(x) / float(size);
+            const float v    = float(y) / float(size);
+            const bool  edge = (((x / 96) + (y / 80)) % 5) == 0;
+
+            const float rgba[4] =
+            {
+                (edge ? 40.0f : 200.0f * u) + (30.0f * std::sin(v * 19.0f)) + noise(random),
+                (160.0f * v) + (50.0f * std::cos((u + v) * 11.0f)) + noise(random),
+                edge ? 220.0f : (120.0f + (90.0f * std::sin(u * 7.0f) * std::cos(v * 5.0f)) + noise(random)),
+                opaque ? 255.0f : (255.0f * (0.5f + (0.5f * std::sin((u * 3.0f) + (v * 2.0f))))),
+            };
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                (*pSource)[(((size_t(y) * size) + x) * 4) + c] =
+                    static_cast<uint8_t>(std::lround(std::min(std::max(rgba[c], 0.0f), 255.0f)));
+            }
+        }
+    }
+}
+
+//=====================================================================================================================
+// Fills mip 0 of every array slice of a texture with random finite values in the layout of
+// ResourceBuilder::GetCopyableFootprints over all subresources, leaving the other levels zero (NaN inputs may
+// propagate with a different sign per instruction set)
+inline void FillMipSource(
+    const ResourceBuilder& builder, std::vector<uint8_t>* pData, uint32_t seed)
+{
+    const bool     is3D       = (builder.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D);
+    const uint32_t mipCount   = builder.GetMipCount();
+    const uint32_t sliceCount = is3D ? 1u : builder.GetArraySize();
+    const uint32_t width      = static_cast<uint32_t>(builder.Width);
+    const uint32_t height     = builder.Height;
+    const uint32_t depth      = is3D ? builder.DepthOrArraySize : 1u;
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(size_t(mipCount) * sliceCount);
+    uint64_t                                        totalBytes = 0;
+
+    builder.GetCopyableFootprints(0, mipCount * sliceCount, 0, layouts.data(), nullptr, nullptr, &totalBytes);
+    pData->assign(static_cast<size_t>(totalBytes), 0);
+
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> value(-0.25f, 4.0f);
+    std::vector<float>                    texels(size_t(width) * height * depth * 4);
+
+    const ConvertSource source = { texels.data(), DXGI_FORMAT_R32G32B32A32_FLOAT, uint64_t(width) * 16,
+                                   uint64_t(width) * height * 16 };
+
+    for (uint32_t slice = 0; slice < sliceCount; slice++)
+    {
+        for (float& texel : texels)
+        {
+            texel = value(random);
+        }
+
+        ConvertSubresources(builder, slice * mipCount, 1, layouts[slice * mipCount].Offset, &source, pData->data());
+    }
+}
+} // Bench
+} // AR